@@ -0,0 +1,125 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+
+#include <netflex/netflex>
+
+//!
+//! serialization of a typical small response
+//!
+static void
+response_to_http_packet(benchmark::State& state) {
+  netflex::http::response response;
+  response.add_header({"Content-Type", "application/json"});
+  response.set_body("{\"status\":\"ok\"}");
+  response.add_header({"Content-Length", response.get_body().length()});
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(response.to_http_packet());
+}
+BENCHMARK(response_to_http_packet);
+
+//!
+//! serialization depending on the number of headers
+//!
+static void
+response_to_http_packet_headers(benchmark::State& state) {
+  netflex::http::response response;
+
+  for (int64_t i = 0; i < state.range(0); ++i)
+    response.add_header({"X-Custom-Header-" + std::to_string(i), "some custom header value"});
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(response.to_http_packet());
+}
+BENCHMARK(response_to_http_packet_headers)->RangeMultiplier(4)->Range(1, 64);
+
+//!
+//! serialization depending on the body size
+//!
+static void
+response_to_http_packet_body(benchmark::State& state) {
+  netflex::http::response response;
+  response.set_body(std::string(state.range(0), 'x'));
+  response.add_header({"Content-Length", response.get_body().length()});
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(response.to_http_packet());
+
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(response_to_http_packet_body)->RangeMultiplier(16)->Range(64, 1 << 20);
+
+//!
+//! same small response, preserialized as a static response
+//!
+static void
+static_response_serialize(benchmark::State& state) {
+  netflex::http::response response;
+  response.add_header({"Content-Type", "application/json"});
+  response.set_body("{\"status\":\"ok\"}");
+
+  netflex::http::static_response static_response(response);
+  std::vector<char> buffer;
+
+  for (auto _ : state) {
+    static_response.serialize(buffer, *netflex::misc::http_date(), true);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+}
+BENCHMARK(static_response_serialize);
+
+//!
+//! same large payload returned by many responses: copied into each response, or shared
+//!
+static void
+response_copied_body(benchmark::State& state) {
+  std::string payload(static_cast<std::size_t>(state.range(0)), 'x');
+  std::vector<char> buffer;
+
+  for (auto _ : state) {
+    netflex::http::response response;
+    response.set_body(payload);
+    response.serialize(buffer);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(response_copied_body)->Arg(64 * 1024)->Arg(1 << 20);
+
+static void
+response_shared_body(benchmark::State& state) {
+  auto payload = std::make_shared<const std::string>(static_cast<std::size_t>(state.range(0)), 'x');
+  std::vector<char> buffer;
+
+  for (auto _ : state) {
+    netflex::http::response response;
+    response.set_body(payload);
+    response.serialize(buffer);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(response_shared_body)->Arg(64 * 1024)->Arg(1 << 20);
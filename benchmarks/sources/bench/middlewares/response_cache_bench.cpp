@@ -0,0 +1,70 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <benchmark/benchmark.h>
+
+#include <netflex/netflex>
+
+//!
+//! request served through the cache, compared to the route it caches
+//!
+static void
+run_pipeline(benchmark::State& state, bool with_cache) {
+  netflex::middlewares::response_cache cache;
+  std::list<netflex::routing::middleware_t> middlewares;
+
+  if (with_cache)
+    middlewares.push_back(cache.get_middleware());
+
+  middlewares.push_back([](netflex::routing::middleware_chain&, netflex::http::request&, netflex::http::response& response) {
+    response.add_header({"Cache-Control", "max-age=60"});
+    response.set_body(std::string(4096, 'x'));
+    response.add_header({"Content-Length", response.get_body().length()});
+  });
+
+  netflex::routing::middleware_pipeline pipeline(middlewares);
+
+  netflex::http::request request;
+  request.set_raw_method("GET");
+  request.set_target("/articles?page=3");
+
+  for (auto _ : state) {
+    netflex::http::response response;
+    netflex::routing::middleware_chain chain(pipeline, request, response);
+    chain.proceed();
+
+    benchmark::DoNotOptimize(response.to_http_packet());
+  }
+}
+
+static void
+response_cache_hit(benchmark::State& state) {
+  run_pipeline(state, true);
+}
+BENCHMARK(response_cache_hit);
+
+static void
+response_cache_uncached(benchmark::State& state) {
+  run_pipeline(state, false);
+}
+BENCHMARK(response_cache_uncached);
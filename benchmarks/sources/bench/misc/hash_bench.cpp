@@ -0,0 +1,42 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <netflex/netflex>
+
+//!
+//! hashing of response bodies of various sizes, as done for ETags
+//!
+static void
+xxhash64(benchmark::State& state) {
+  std::string body(static_cast<std::size_t>(state.range(0)), 'x');
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(netflex::misc::xxhash64(body.data(), body.size()));
+
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(xxhash64)->Arg(64)->Arg(4096)->Arg(1 << 20);
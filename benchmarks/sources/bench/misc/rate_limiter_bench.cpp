@@ -0,0 +1,61 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <netflex/netflex>
+
+//!
+//! rate limiting check of a request, over a pool of client addresses
+//!
+static void
+rate_limiter_allowed(benchmark::State& state) {
+  netflex::misc::rate_limiter limiter(1e6, 1000000);
+  std::vector<std::string> clients;
+
+  for (int i = 0; i < 1000; ++i)
+    clients.push_back("10.0." + std::to_string(i / 256) + "." + std::to_string(i % 256));
+
+  std::size_t i = 0;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(limiter.try_acquire(clients[i++ % clients.size()]));
+}
+BENCHMARK(rate_limiter_allowed);
+
+//!
+//! flooding client, over its limit
+//!
+static void
+rate_limiter_rejected(benchmark::State& state) {
+  netflex::misc::rate_limiter limiter(1, 1);
+  std::string client = "10.0.0.1";
+
+  limiter.try_acquire(client);
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(limiter.try_acquire(client));
+}
+BENCHMARK(rate_limiter_rejected);
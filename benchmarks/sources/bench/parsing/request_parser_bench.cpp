@@ -0,0 +1,149 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+
+#include <netflex/netflex>
+
+//!
+//! request corpora
+//!
+static const std::string SMALL_GET_REQUEST =
+  "GET /index.html HTTP/1.1\r\n"
+  "Host: localhost:3000\r\n"
+  "Accept: */*\r\n"
+  "\r\n";
+
+static const std::string POST_REQUEST =
+  "POST /users/42/articles/84 HTTP/1.1\r\n"
+  "Host: localhost:3000\r\n"
+  "Content-Type: application/json\r\n"
+  "Content-Length: 27\r\n"
+  "\r\n"
+  "{\"title\":\"hello\",\"id\":84}\r\n";
+
+//! browser-like request, with long user-agent, accept and cookie headers
+static std::string
+large_headers_request(void) {
+  std::string request =
+    "GET /dashboard?tab=overview&range=7d HTTP/1.1\r\n"
+    "Host: www.example.com\r\n"
+    "Connection: keep-alive\r\n"
+    "Cache-Control: max-age=0\r\n"
+    "Upgrade-Insecure-Requests: 1\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/61.0.3163.100 Safari/537.36\r\n"
+    "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,image/webp,image/apng,*/*;q=0.8\r\n"
+    "Accept-Encoding: gzip, deflate, br\r\n"
+    "Accept-Language: en-US,en;q=0.9,fr;q=0.8\r\n"
+    "Referer: https://www.example.com/login?next=%2Fdashboard\r\n"
+    "Cookie: ";
+
+  for (int i = 0; i < 40; ++i)
+    request += "session_cookie_" + std::to_string(i) + "=a3f5c9e1b7d24f6a8c0e2b4d6f8a0c2e; ";
+
+  return request + "theme=dark\r\n\r\n";
+}
+
+//!
+//! feed a full request at once
+//!
+static void
+feed_whole_request(benchmark::State& state, const std::string& request) {
+  netflex::parsing::request_parser parser;
+
+  for (auto _ : state) {
+    parser << request;
+    benchmark::DoNotOptimize(parser.get_front());
+    parser.pop_front();
+  }
+
+  state.SetBytesProcessed(state.iterations() * request.size());
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void
+request_parser_small_get(benchmark::State& state) {
+  feed_whole_request(state, SMALL_GET_REQUEST);
+}
+BENCHMARK(request_parser_small_get);
+
+static void
+request_parser_post_with_body(benchmark::State& state) {
+  feed_whole_request(state, POST_REQUEST);
+}
+BENCHMARK(request_parser_post_with_body);
+
+static void
+request_parser_large_headers(benchmark::State& state) {
+  feed_whole_request(state, large_headers_request());
+}
+BENCHMARK(request_parser_large_headers);
+
+//!
+//! pipelined burst: multiple requests received in a single read
+//!
+static void
+request_parser_pipelined_burst(benchmark::State& state) {
+  netflex::parsing::request_parser parser;
+  std::string burst;
+
+  for (int64_t i = 0; i < state.range(0); ++i)
+    burst += SMALL_GET_REQUEST;
+
+  for (auto _ : state) {
+    parser << burst;
+
+    while (parser.request_available()) {
+      benchmark::DoNotOptimize(parser.get_front());
+      parser.pop_front();
+    }
+  }
+
+  state.SetBytesProcessed(state.iterations() * burst.size());
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(request_parser_pipelined_burst)->Arg(4)->Arg(16)->Arg(64);
+
+//!
+//! fragmented feed: request received one byte at a time
+//!
+static void
+request_parser_fragmented(benchmark::State& state) {
+  netflex::parsing::request_parser parser;
+  std::string request = large_headers_request();
+  std::vector<std::string> fragments;
+
+  for (char c : request)
+    fragments.push_back(std::string(1, c));
+
+  for (auto _ : state) {
+    for (const auto& fragment : fragments)
+      parser << fragment;
+
+    benchmark::DoNotOptimize(parser.get_front());
+    parser.pop_front();
+  }
+
+  state.SetBytesProcessed(state.iterations() * request.size());
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(request_parser_fragmented);
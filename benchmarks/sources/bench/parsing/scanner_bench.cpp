@@ -0,0 +1,50 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+
+#include <netflex/parsing/scanner.hpp>
+
+//!
+//! scan a cookie-like header value for its CR terminator, with each implementation
+//!
+static void
+scanner_find_first_of(benchmark::State& state) {
+  auto impl         = static_cast<netflex::parsing::scanner::implementation>(state.range(0));
+  auto default_impl = netflex::parsing::scanner::get_implementation();
+
+  if (!netflex::parsing::scanner::set_implementation(impl)) {
+    state.SkipWithError("implementation not supported by the cpu");
+    return;
+  }
+
+  netflex::parsing::scanner::char_set set("\x0b\x0c\r");
+  std::string input(state.range(1), 'a');
+  input += "\r\n";
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(netflex::parsing::scanner::find_first_of(input.data(), input.size(), set));
+
+  state.SetBytesProcessed(state.iterations() * input.size());
+  netflex::parsing::scanner::set_implementation(default_impl);
+}
+BENCHMARK(scanner_find_first_of)->ArgNames({"impl", "size"})->ArgsProduct({{0, 1, 2}, {16, 128, 1024}});
@@ -0,0 +1,83 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+
+#include <netflex/netflex>
+#include <netflex/parsing/utils.hpp>
+
+static const std::string USER_AGENT = "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/61.0.3163.100 Safari/537.36\r\n";
+
+static void
+utils_split(benchmark::State& state) {
+  const std::string encodings = "gzip, deflate, br, compress, identity, chunked";
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(netflex::parsing::utils::split(encodings, ','));
+}
+BENCHMARK(utils_split);
+
+static void
+utils_consume_whitespaces(benchmark::State& state) {
+  const std::string input = "    \t \t  value";
+
+  for (auto _ : state) {
+    std::string buffer = input;
+    benchmark::DoNotOptimize(netflex::parsing::utils::consume_whitespaces(buffer));
+  }
+}
+BENCHMARK(utils_consume_whitespaces);
+
+static void
+utils_consume_word(benchmark::State& state) {
+  const std::string input = "/users/42/articles/84/comments?sort=desc&page=3 HTTP/1.1\r\n";
+
+  for (auto _ : state) {
+    std::string buffer = input;
+    benchmark::DoNotOptimize(netflex::parsing::utils::consume_word(buffer));
+  }
+
+  state.SetBytesProcessed(state.iterations() * input.find(' '));
+}
+BENCHMARK(utils_consume_word);
+
+static void
+utils_consume_words(benchmark::State& state) {
+  for (auto _ : state) {
+    std::string buffer = USER_AGENT;
+    benchmark::DoNotOptimize(netflex::parsing::utils::consume_words(buffer));
+  }
+
+  state.SetBytesProcessed(state.iterations() * USER_AGENT.size());
+}
+BENCHMARK(utils_consume_words);
+
+static void
+utils_consume_word_with_ending(benchmark::State& state) {
+  const std::string input = "Accept-Language: en-US,en;q=0.9\r\n";
+
+  for (auto _ : state) {
+    std::string buffer = input;
+    benchmark::DoNotOptimize(netflex::parsing::utils::consume_word_with_ending(buffer, ':'));
+  }
+}
+BENCHMARK(utils_consume_word_with_ending);
@@ -0,0 +1,52 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+
+#include <netflex/netflex>
+
+//!
+//! cost of running a middleware chain depending on its depth
+//! each middleware simply proceeds to the next one
+//!
+static void
+middleware_chain_proceed(benchmark::State& state) {
+  std::list<netflex::routing::middleware_t> middlewares;
+
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    middlewares.push_back([](netflex::routing::middleware_chain& chain, netflex::http::request&, netflex::http::response&) {
+      chain.proceed();
+    });
+  }
+
+  netflex::routing::middleware_pipeline pipeline(middlewares);
+  netflex::http::request request;
+  netflex::http::response response;
+
+  for (auto _ : state) {
+    netflex::routing::middleware_chain chain(pipeline, request, response);
+    chain.proceed();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(middleware_chain_proceed)->RangeMultiplier(2)->Range(1, 64);
@@ -0,0 +1,65 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <benchmark/benchmark.h>
+
+#include <netflex/netflex>
+
+//!
+//! query string lookups on a typical target
+//!
+static const std::string target = "/users/42/articles?sort=desc&page=3&author=simon+says&tag=a&tag=b";
+
+static void
+query_from_target(benchmark::State& state) {
+  for (auto _ : state)
+    benchmark::DoNotOptimize(netflex::routing::query::from_target(target));
+}
+BENCHMARK(query_from_target);
+
+static void
+query_get_raw_value(benchmark::State& state) {
+  netflex::routing::query query = netflex::routing::query::from_target(target);
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(query.get_raw_value("author"));
+}
+BENCHMARK(query_get_raw_value);
+
+static void
+query_get(benchmark::State& state) {
+  netflex::routing::query query = netflex::routing::query::from_target(target);
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(query.get("author"));
+}
+BENCHMARK(query_get);
+
+static void
+query_get_all(benchmark::State& state) {
+  netflex::routing::query query = netflex::routing::query::from_target(target);
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(query.get_all("tag"));
+}
+BENCHMARK(query_get_all);
@@ -0,0 +1,122 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+
+#include <netflex/netflex>
+
+//!
+//! build a set of routes similar to a REST api
+//!
+static std::vector<netflex::routing::route>
+build_routes(int64_t nb_routes) {
+  std::vector<netflex::routing::route> routes;
+
+  for (int64_t i = 0; i < nb_routes; ++i)
+    routes.push_back({netflex::http::method::GET, "/resources_" + std::to_string(i) + "/:id/items/:item_id", nullptr});
+
+  return routes;
+}
+
+//!
+//! single route_matcher::match call, with and without query string
+//!
+static void
+route_matcher_match(benchmark::State& state) {
+  netflex::routing::route_matcher matcher("/users/:user_id/articles/:article_id");
+
+  for (auto _ : state) {
+    netflex::routing::params_t params;
+    benchmark::DoNotOptimize(matcher.match("/users/42/articles/84", params));
+  }
+}
+BENCHMARK(route_matcher_match);
+
+static void
+route_matcher_match_with_query_string(benchmark::State& state) {
+  netflex::routing::route_matcher matcher("/users/:user_id/articles/:article_id");
+
+  for (auto _ : state) {
+    netflex::routing::params_t params;
+    benchmark::DoNotOptimize(matcher.match("/users/42/articles/84?sort=desc&page=3&author=simon", params));
+  }
+}
+BENCHMARK(route_matcher_match_with_query_string);
+
+//!
+//! linear lookup over the routes of a server, as done on dispatch
+//! the requested route is the last one registered (worst case)
+//!
+static void
+route_lookup(benchmark::State& state) {
+  std::vector<netflex::routing::route> routes = build_routes(state.range(0));
+
+  netflex::http::request request;
+  request.set_method(netflex::http::method::GET);
+  request.set_target("/resources_" + std::to_string(state.range(0) - 1) + "/42/items/84");
+
+  for (auto _ : state) {
+    for (const auto& route : routes) {
+      if (route.match(request)) {
+        benchmark::DoNotOptimize(request.get_params());
+        break;
+      }
+    }
+  }
+}
+BENCHMARK(route_lookup)->Arg(10)->Arg(100)->Arg(1000);
+
+//!
+//! same lookups with typed routes, matched by path_pattern instead of regex
+//!
+static void
+path_pattern_match(benchmark::State& state) {
+  netflex::routing::path_pattern pattern("/users/:user_id<u64>/articles/:article_id<u64>");
+  netflex::routing::path_params_t params;
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(pattern.match("/users/42/articles/84", params));
+}
+BENCHMARK(path_pattern_match);
+
+static void
+typed_route_lookup(benchmark::State& state) {
+  std::vector<netflex::routing::route> routes;
+
+  for (int64_t i = 0; i < state.range(0); ++i)
+    routes.push_back(netflex::routing::make_route<std::uint64_t, std::uint64_t>(netflex::http::method::GET, "/resources_" + std::to_string(i) + "/:id<u64>/items/:item_id<u64>",
+      [](const netflex::http::request&, netflex::http::response&, std::uint64_t, std::uint64_t) {}));
+
+  netflex::http::request request;
+  request.set_method(netflex::http::method::GET);
+  request.set_target("/resources_" + std::to_string(state.range(0) - 1) + "/42/items/84");
+
+  for (auto _ : state) {
+    for (const auto& route : routes) {
+      if (route.match(request)) {
+        benchmark::DoNotOptimize(request.get_path_params());
+        break;
+      }
+    }
+  }
+}
+BENCHMARK(typed_route_lookup)->Arg(10)->Arg(100)->Arg(1000);
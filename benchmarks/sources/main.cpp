@@ -20,18 +20,16 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
-#include <netflex/parsing/parser_iface.hpp>
+#include <benchmark/benchmark.h>
 
-namespace netflex {
+int
+main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
 
-namespace parsing {
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
 
-//!
-//! ctor & virtual dtor
-//!
-parser_iface::parser_iface(http::request& request)
-: m_request(request) {}
+  ::benchmark::RunSpecifiedBenchmarks();
 
-} // namespace parsing
-
-} // namespace netflex
+  return 0;
+}
@@ -0,0 +1,814 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+//!
+//! loopback load generator for netflex servers
+//! opens a configurable number of keep-alive (or not) connections, sends a weighted mix of requests (optionally pipelined)
+//! and reports the throughput and the latency percentiles (corrected for coordinated omission)
+//!
+//! by default, a netflex server is started in-process and driven over loopback
+//! use --host and --port to target an already running server instead
+//!
+//! linux only (relies on epoll)
+//!
+
+#include <netflex/netflex>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+//!
+//! maximum number of connections opened from a single loopback source address
+//! (keeps a safe margin below the default ephemeral ports range)
+//!
+static const std::size_t MAX_CONNECTIONS_PER_SOURCE_ADDRESS = 20000;
+
+//!
+//! load generator options
+//!
+struct options {
+  //! target host (empty to start an embedded server)
+  std::string host;
+  //! target port
+  unsigned int port = 3002;
+  //! number of connections
+  std::size_t connections = 64;
+  //! number of worker threads
+  std::size_t threads = 1;
+  //! test duration, in seconds
+  std::size_t duration = 10;
+  //! maximum number of in-flight requests per connection
+  std::size_t pipeline = 1;
+  //! whether connections are kept alive between requests
+  bool keep_alive = true;
+  //! target throughput for all connections, in requests per second (0 for closed loop, as fast as possible)
+  double rate = 0;
+  //! requests mix: "METHOD PATH" strings with their weights
+  std::vector<std::pair<std::string, unsigned int>> requests;
+};
+
+//!
+//! prebuilt request, ready to be written
+//!
+struct request_template {
+  //! http packet
+  std::string packet;
+  //! cumulated weight (used for weighted random selection)
+  unsigned int cumulated_weight;
+};
+
+//!
+//! statistics shared by all workers
+//!
+struct statistics {
+  //! completed requests
+  std::atomic<std::uint64_t> completed{0};
+  //! completed requests with a non 2xx/3xx status
+  std::atomic<std::uint64_t> non_success{0};
+  //! requests lost because of a connection error
+  std::atomic<std::uint64_t> errors{0};
+  //! failed connection attempts
+  std::atomic<std::uint64_t> connect_errors{0};
+  //! bytes received
+  std::atomic<std::uint64_t> bytes_read{0};
+  //! raw latencies, in nanoseconds
+  netflex::misc::latency_histogram latencies;
+};
+
+//!
+//! client connection state
+//!
+struct connection {
+  //! global index of the connection (used to pick the source address)
+  std::size_t index = 0;
+  //! socket
+  int fd = -1;
+  //! whether connect() completed
+  bool connected = false;
+  //! whether EPOLLOUT is currently requested
+  bool want_write = false;
+  //! pending output
+  std::string out;
+  //! already written bytes of the pending output
+  std::size_t out_offset = 0;
+  //! received bytes not parsed yet
+  std::string in;
+  //! start timestamps of the in-flight requests (intended send times in open loop)
+  std::deque<std::uint64_t> in_flight;
+  //! intended send time of the next request (open loop only)
+  std::uint64_t next_intended = 0;
+  //! time for which a timer is currently armed (open loop only)
+  std::uint64_t armed_at = 0;
+};
+
+//!
+//! monotonic clock, in nanoseconds
+//!
+static std::uint64_t
+now(void) {
+  return netflex::misc::request_timing::now();
+}
+
+//!
+//! human readable duration
+//!
+static std::string
+format_duration(std::uint64_t ns) {
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(2);
+
+  if (ns < 1000)
+    os << ns << "ns";
+  else if (ns < 1000000)
+    os << ns / 1e3 << "us";
+  else if (ns < 1000000000)
+    os << ns / 1e6 << "ms";
+  else
+    os << ns / 1e9 << "s";
+
+  return os.str();
+}
+
+//!
+//! case insensitive search of the Content-Length header in a response head
+//!
+static std::size_t
+find_content_length(const std::string& buffer, std::size_t begin, std::size_t end) {
+  static const char header[] = "\r\ncontent-length:";
+  static const std::size_t header_length = sizeof(header) - 1;
+
+  for (std::size_t i = begin; i + header_length <= end; ++i) {
+    std::size_t j = 0;
+
+    while (j < header_length && std::tolower(buffer[i + j]) == header[j])
+      ++j;
+
+    if (j == header_length)
+      return std::strtoul(buffer.c_str() + i + header_length, nullptr, 10);
+  }
+
+  return 0;
+}
+
+//!
+//! worker thread: manages a slice of the connections with its own epoll instance
+//!
+class worker {
+public:
+  worker(const options& opts, const std::vector<request_template>& templates, std::size_t first_connection, std::size_t nb_connections, statistics& stats)
+  : m_options(opts)
+  , m_templates(templates)
+  , m_connections(nb_connections)
+  , m_stats(stats)
+  , m_epoll_fd(epoll_create1(0))
+  , m_random(static_cast<unsigned int>(first_connection + 1)) {
+    for (std::size_t i = 0; i < nb_connections; ++i)
+      m_connections[i].index = first_connection + i;
+
+    //! each connection sends one request every interval (open loop)
+    if (m_options.rate > 0)
+      m_interval = static_cast<std::uint64_t>(1e9 * m_options.connections / m_options.rate);
+  }
+
+  ~worker(void) {
+    for (auto& conn : m_connections)
+      if (conn.fd != -1)
+        ::close(conn.fd);
+
+    ::close(m_epoll_fd);
+  }
+
+  worker(const worker&) = delete;
+  worker& operator=(const worker&) = delete;
+
+public:
+  //!
+  //! run the worker until the deadline
+  //!
+  void
+  run(std::uint64_t start, std::uint64_t deadline) {
+    //! spread the first requests over one interval to avoid synchronized bursts
+    std::uniform_int_distribution<std::uint64_t> offset(0, m_interval ? m_interval - 1 : 0);
+
+    for (auto& conn : m_connections) {
+      conn.next_intended = start + offset(m_random);
+      open(conn);
+    }
+
+    std::vector<epoll_event> events(1024);
+
+    for (std::uint64_t current = now(); current < deadline; current = now()) {
+      int nb_events = epoll_wait(m_epoll_fd, events.data(), static_cast<int>(events.size()), next_timeout(current, deadline));
+
+      for (int i = 0; i < nb_events; ++i) {
+        connection& conn = m_connections[events[i].data.u64];
+
+        if (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP))
+          on_readable(conn);
+        else if (events[i].events & EPOLLOUT)
+          on_writable(conn);
+      }
+
+      process_timers(now());
+    }
+  }
+
+private:
+  //!
+  //! epoll_wait timeout: wake up for the next timer, or periodically to check the deadline
+  //!
+  int
+  next_timeout(std::uint64_t current, std::uint64_t deadline) const {
+    std::uint64_t wake_up = std::min(deadline, current + 100000000);
+
+    if (!m_timers.empty())
+      wake_up = std::min(wake_up, m_timers.top().first);
+
+    return wake_up > current ? static_cast<int>((wake_up - current + 999999) / 1000000) : 0;
+  }
+
+  //!
+  //! open (or reopen) a connection
+  //!
+  void
+  open(connection& conn) {
+    conn.fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (conn.fd == -1) {
+      ++m_stats.connect_errors;
+      return;
+    }
+
+    int one = 1;
+    setsockopt(conn.fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port   = htons(m_options.port);
+    inet_pton(AF_INET, m_options.host.c_str(), &addr.sin_addr);
+
+    //! spread connections over several loopback source addresses, so that C100k does not exhaust the ephemeral ports
+    if (m_options.connections > MAX_CONNECTIONS_PER_SOURCE_ADDRESS && (ntohl(addr.sin_addr.s_addr) >> 24) == 127) {
+      sockaddr_in source;
+      std::memset(&source, 0, sizeof(source));
+      source.sin_family      = AF_INET;
+      source.sin_addr.s_addr = htonl((127U << 24) + 1 + static_cast<std::uint32_t>(conn.index / MAX_CONNECTIONS_PER_SOURCE_ADDRESS));
+      bind(conn.fd, reinterpret_cast<sockaddr*>(&source), sizeof(source));
+    }
+
+    if (connect(conn.fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == -1 && errno != EINPROGRESS) {
+      ++m_stats.connect_errors;
+      ::close(conn.fd);
+      conn.fd = -1;
+      return;
+    }
+
+    epoll_event event;
+    event.events   = EPOLLIN | EPOLLOUT;
+    event.data.u64 = &conn - m_connections.data();
+    epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, conn.fd, &event);
+
+    conn.connected  = false;
+    conn.want_write = true;
+  }
+
+  //!
+  //! close a connection, count its in-flight requests as errors if any, and reopen it
+  //!
+  void
+  reopen(connection& conn, bool failure) {
+    if (failure)
+      m_stats.errors += conn.in_flight.size();
+
+    ::close(conn.fd);
+    conn.fd = -1;
+    conn.in_flight.clear();
+    conn.out.clear();
+    conn.out_offset = 0;
+    conn.in.clear();
+
+    open(conn);
+  }
+
+  //!
+  //! connection became writable: connection established or room for pending output
+  //!
+  void
+  on_writable(connection& conn) {
+    if (!conn.connected) {
+      int err         = 0;
+      socklen_t len   = sizeof(err);
+      getsockopt(conn.fd, SOL_SOCKET, SO_ERROR, &err, &len);
+
+      if (err) {
+        ++m_stats.connect_errors;
+        reopen(conn, false);
+        return;
+      }
+
+      conn.connected = true;
+      fill(conn, now());
+      return;
+    }
+
+    flush(conn);
+  }
+
+  //!
+  //! data (or error) available on the connection
+  //!
+  void
+  on_readable(connection& conn) {
+    if (!conn.connected) {
+      on_writable(conn);
+
+      if (!conn.connected)
+        return;
+    }
+
+    char buffer[65536];
+    bool closed = false;
+
+    for (;;) {
+      ssize_t nb_bytes = recv(conn.fd, buffer, sizeof(buffer), 0);
+
+      if (nb_bytes > 0) {
+        m_stats.bytes_read += nb_bytes;
+        conn.in.append(buffer, nb_bytes);
+        continue;
+      }
+
+      //! connection closed or failed
+      closed = nb_bytes == 0 || (errno != EAGAIN && errno != EWOULDBLOCK);
+      break;
+    }
+
+    //! responses received right before the connection got closed still count
+    if (!parse_responses(conn) && closed)
+      reopen(conn, true);
+  }
+
+  //!
+  //! parse the complete responses received on the connection
+  //! responses must be delimited by a Content-Length header (or have no body)
+  //!
+  //! \return whether the connection has been reopened
+  //!
+  bool
+  parse_responses(connection& conn) {
+    std::size_t offset      = 0;
+    std::size_t nb_received = 0;
+    std::uint64_t completed = now();
+
+    while (!conn.in_flight.empty()) {
+      std::size_t head_end = conn.in.find("\r\n\r\n", offset);
+      if (head_end == std::string::npos)
+        break;
+
+      std::size_t response_end = head_end + 4 + find_content_length(conn.in, offset, head_end);
+      if (response_end > conn.in.size())
+        break;
+
+      //! status code right after "HTTP/1.1 "
+      unsigned long status = std::strtoul(conn.in.c_str() + offset + 9, nullptr, 10);
+      if (status < 200 || status >= 400)
+        ++m_stats.non_success;
+
+      m_stats.latencies.record(completed - conn.in_flight.front());
+      conn.in_flight.pop_front();
+      offset = response_end;
+      ++nb_received;
+    }
+
+    if (!nb_received)
+      return false;
+
+    conn.in.erase(0, offset);
+    m_stats.completed += nb_received;
+
+    if (!m_options.keep_alive) {
+      reopen(conn, false);
+      return true;
+    }
+
+    fill(conn, completed);
+    return false;
+  }
+
+  //!
+  //! send as many requests as allowed on the connection
+  //!  > closed loop: keep the pipeline full
+  //!  > open loop: send the requests whose intended time is reached, as long as the pipeline is not full
+  //!
+  void
+  fill(connection& conn, std::uint64_t current) {
+    if (conn.fd == -1 || !conn.connected)
+      return;
+
+    while (conn.in_flight.size() < m_options.pipeline) {
+      if (m_interval) {
+        if (conn.next_intended > current)
+          break;
+
+        //! latency is measured from the intended send time, whether or not we managed to send at that time
+        conn.in_flight.push_back(conn.next_intended);
+        conn.next_intended += m_interval;
+      }
+      else {
+        conn.in_flight.push_back(current);
+      }
+
+      conn.out += pick_request();
+    }
+
+    //! wait for the next intended send time
+    if (m_interval && conn.in_flight.size() < m_options.pipeline && conn.armed_at != conn.next_intended) {
+      conn.armed_at = conn.next_intended;
+      m_timers.push({conn.next_intended, &conn - m_connections.data()});
+    }
+
+    flush(conn);
+  }
+
+  //!
+  //! trigger the connections whose next intended send time is reached
+  //!
+  void
+  process_timers(std::uint64_t current) {
+    while (!m_timers.empty() && m_timers.top().first <= current) {
+      auto timer = m_timers.top();
+      m_timers.pop();
+
+      connection& conn = m_connections[timer.second];
+
+      //! outdated timer
+      if (conn.armed_at != timer.first)
+        continue;
+
+      conn.armed_at = 0;
+      fill(conn, current);
+    }
+  }
+
+  //!
+  //! write pending output
+  //!
+  void
+  flush(connection& conn) {
+    while (conn.out_offset < conn.out.size()) {
+      ssize_t nb_bytes = send(conn.fd, conn.out.data() + conn.out_offset, conn.out.size() - conn.out_offset, MSG_NOSIGNAL);
+
+      if (nb_bytes == -1) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+          break;
+
+        reopen(conn, true);
+        return;
+      }
+
+      conn.out_offset += nb_bytes;
+    }
+
+    if (conn.out_offset == conn.out.size()) {
+      conn.out.clear();
+      conn.out_offset = 0;
+    }
+
+    //! only ask for EPOLLOUT when there is something left to write
+    bool want_write = !conn.out.empty();
+    if (want_write != conn.want_write) {
+      epoll_event event;
+      event.events   = EPOLLIN | (want_write ? static_cast<std::uint32_t>(EPOLLOUT) : 0);
+      event.data.u64 = &conn - m_connections.data();
+      epoll_ctl(m_epoll_fd, EPOLL_CTL_MOD, conn.fd, &event);
+
+      conn.want_write = want_write;
+    }
+  }
+
+  //!
+  //! weighted random selection in the requests mix
+  //!
+  const std::string&
+  pick_request(void) {
+    if (m_templates.size() == 1)
+      return m_templates.front().packet;
+
+    std::uniform_int_distribution<unsigned int> distribution(0, m_templates.back().cumulated_weight - 1);
+    unsigned int draw = distribution(m_random);
+
+    for (const auto& request : m_templates)
+      if (draw < request.cumulated_weight)
+        return request.packet;
+
+    return m_templates.back().packet;
+  }
+
+private:
+  const options& m_options;
+  const std::vector<request_template>& m_templates;
+  std::vector<connection> m_connections;
+  statistics& m_stats;
+  int m_epoll_fd;
+  std::minstd_rand m_random;
+
+  //! interval between two requests on the same connection, in nanoseconds (0 for closed loop)
+  std::uint64_t m_interval = 0;
+
+  //! (intended send time, connection index), earliest first
+  typedef std::pair<std::uint64_t, std::size_t> timer_t;
+  std::priority_queue<timer_t, std::vector<timer_t>, std::greater<timer_t>> m_timers;
+};
+
+//!
+//! usage
+//!
+static void
+usage(const char* name) {
+  std::cerr << "usage: " << name << " [options]" << std::endl
+            << "  --host HOST          target server (default: start an embedded server on 127.0.0.1)" << std::endl
+            << "  --port PORT          target port (default: 3002)" << std::endl
+            << "  --connections N      number of connections (default: 64)" << std::endl
+            << "  --threads N          number of worker threads (default: 1)" << std::endl
+            << "  --duration SECONDS   test duration (default: 10)" << std::endl
+            << "  --pipeline N         in-flight requests per connection (default: 1)" << std::endl
+            << "  --no-keep-alive      reconnect after each response" << std::endl
+            << "  --rate RPS           target throughput, open loop (default: closed loop)" << std::endl
+            << "  --request 'METHOD PATH[=WEIGHT]'" << std::endl
+            << "                       add a request to the mix (default: 'GET /')" << std::endl
+            << "  --scenario NAME      preset: c10k (10k connections, 10k rps) or c100k (100k connections, 100k rps)" << std::endl;
+}
+
+//!
+//! command line parsing
+//!
+static bool
+parse_options(int argc, char** argv, options& opts) {
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool has_value  = i + 1 < argc;
+
+    if (arg == "--no-keep-alive") {
+      opts.keep_alive = false;
+    }
+    else if (!has_value) {
+      return false;
+    }
+    else if (arg == "--host") {
+      opts.host = argv[++i];
+    }
+    else if (arg == "--port") {
+      opts.port = std::strtoul(argv[++i], nullptr, 10);
+    }
+    else if (arg == "--connections") {
+      opts.connections = std::strtoul(argv[++i], nullptr, 10);
+    }
+    else if (arg == "--threads") {
+      opts.threads = std::strtoul(argv[++i], nullptr, 10);
+    }
+    else if (arg == "--duration") {
+      opts.duration = std::strtoul(argv[++i], nullptr, 10);
+    }
+    else if (arg == "--pipeline") {
+      opts.pipeline = std::strtoul(argv[++i], nullptr, 10);
+    }
+    else if (arg == "--rate") {
+      opts.rate = std::strtod(argv[++i], nullptr);
+    }
+    else if (arg == "--request") {
+      std::string request = argv[++i];
+      std::size_t weight  = request.rfind('=');
+      unsigned int value  = 1;
+
+      if (weight != std::string::npos && request.find('?') == std::string::npos) {
+        value   = std::strtoul(request.c_str() + weight + 1, nullptr, 10);
+        request = request.substr(0, weight);
+      }
+
+      opts.requests.push_back({request, value});
+    }
+    else if (arg == "--scenario") {
+      std::string scenario = argv[++i];
+
+      if (scenario == "c10k") {
+        opts.connections = 10000;
+        opts.rate        = 10000;
+      }
+      else if (scenario == "c100k") {
+        opts.connections = 100000;
+        opts.rate        = 100000;
+      }
+      else {
+        return false;
+      }
+    }
+    else {
+      return false;
+    }
+  }
+
+  if (!opts.connections || !opts.threads || !opts.pipeline || !opts.duration)
+    return false;
+
+  //! a connection without keep-alive can only carry one request
+  if (!opts.keep_alive)
+    opts.pipeline = 1;
+
+  if (opts.threads > opts.connections)
+    opts.threads = opts.connections;
+
+  if (opts.requests.empty())
+    opts.requests.push_back({"GET /", 1});
+
+  return true;
+}
+
+//!
+//! build the requests packets
+//!
+static std::vector<request_template>
+build_templates(const options& opts) {
+  std::vector<request_template> templates;
+  unsigned int cumulated_weight = 0;
+
+  for (const auto& request : opts.requests) {
+    std::string method = request.first.substr(0, request.first.find(' '));
+    std::string path   = request.first.substr(method.size() + 1);
+    std::string body   = (method == "POST" || method == "PUT" || method == "PATCH") ? "{\"name\":\"netflex\",\"value\":42}" : "";
+
+    std::string packet = method + " " + path + " HTTP/1.1\r\n"
+                         + "Host: " + opts.host + ":" + std::to_string(opts.port) + "\r\n"
+                         + "User-Agent: netflex-load-generator\r\n";
+
+    if (!opts.keep_alive)
+      packet += "Connection: close\r\n";
+
+    if (!body.empty())
+      packet += "Content-Type: application/json\r\nContent-Length: " + std::to_string(body.size()) + "\r\n";
+
+    cumulated_weight += request.second;
+    templates.push_back({packet + "\r\n" + body, cumulated_weight});
+  }
+
+  return templates;
+}
+
+//!
+//! raise the open files limit to fit all the connections (and the embedded server side of them)
+//!
+static void
+raise_open_files_limit(const options& opts, bool embedded) {
+  rlimit limit;
+  getrlimit(RLIMIT_NOFILE, &limit);
+
+  rlim_t needed = (embedded ? 2 : 1) * opts.connections + 64;
+  if (limit.rlim_cur < needed) {
+    limit.rlim_cur = std::min(needed, limit.rlim_max);
+    setrlimit(RLIMIT_NOFILE, &limit);
+  }
+
+  if (limit.rlim_cur < needed)
+    std::cerr << "warning: open files limit (" << limit.rlim_cur << ") is lower than the " << needed << " needed descriptors, raise it with ulimit -n" << std::endl;
+}
+
+//!
+//! routes of the embedded server
+//!
+static void
+add_embedded_routes(netflex::http::server& server) {
+  server.add_route({netflex::http::method::GET, "/",
+    [](const netflex::http::request&, netflex::http::response& response) {
+      response.set_body("Hello, World!");
+      response.add_header({"Content-Length", response.get_body().length()});
+    }});
+
+  server.add_route({netflex::http::method::GET, "/users/:user_id",
+    [](const netflex::http::request& request, netflex::http::response& response) {
+      response.add_header({"Content-Type", "application/json"});
+      response.set_body("{\"id\":\"" + request.get_params().at("user_id") + "\",\"name\":\"netflex\"}");
+      response.add_header({"Content-Length", response.get_body().length()});
+    }});
+
+  server.add_route({netflex::http::method::POST, "/echo",
+    [](const netflex::http::request& request, netflex::http::response& response) {
+      response.set_body(request.get_body());
+      response.add_header({"Content-Length", response.get_body().length()});
+    }});
+}
+
+int
+main(int argc, char** argv) {
+  options opts;
+
+  if (!parse_options(argc, argv, opts)) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  bool embedded = opts.host.empty();
+  if (embedded)
+    opts.host = "127.0.0.1";
+
+  raise_open_files_limit(opts, embedded);
+
+  //! embedded server
+  netflex::http::server server;
+  if (embedded) {
+    add_embedded_routes(server);
+    server.start(opts.host, opts.port);
+  }
+
+  std::vector<request_template> templates = build_templates(opts);
+  statistics stats;
+
+  std::cout << "running " << opts.duration << "s test @ " << opts.host << ":" << opts.port << (embedded ? " (embedded server)" : "") << std::endl
+            << "  " << opts.connections << " connections, " << opts.threads << " threads, pipeline " << opts.pipeline
+            << (opts.keep_alive ? ", keep-alive" : ", no keep-alive") << std::endl
+            << "  " << (opts.rate > 0 ? "open loop @ " + std::to_string(static_cast<std::uint64_t>(opts.rate)) + " requests/s" : std::string("closed loop")) << std::endl;
+
+  //! spread connections over workers
+  std::vector<std::unique_ptr<worker>> workers;
+  std::size_t first_connection = 0;
+
+  for (std::size_t i = 0; i < opts.threads; ++i) {
+    std::size_t nb_connections = opts.connections / opts.threads + (i < opts.connections % opts.threads ? 1 : 0);
+
+    workers.emplace_back(new worker(opts, templates, first_connection, nb_connections, stats));
+    first_connection += nb_connections;
+  }
+
+  std::uint64_t start    = now();
+  std::uint64_t deadline = start + opts.duration * 1000000000ULL;
+  std::vector<std::thread> threads;
+
+  for (auto& w : workers)
+    threads.emplace_back([&w, start, deadline]() { w->run(start, deadline); });
+
+  for (auto& thread : threads)
+    thread.join();
+
+  double elapsed = (now() - start) / 1e9;
+
+  if (embedded)
+    server.stop();
+
+  //! closed loop hides the requests that would have been sent during stalls: backfill them, using the median latency as the expected interval
+  //! open loop is measured from the intended send times and needs no correction
+  netflex::misc::latency_histogram corrected;
+  corrected.add_corrected(stats.latencies, opts.rate > 0 ? 0 : stats.latencies.get_percentile(50));
+
+  std::cout << std::endl
+            << "  requests:        " << stats.completed << " (" << stats.non_success << " non 2xx/3xx)" << std::endl
+            << "  errors:          " << stats.errors << " lost requests, " << stats.connect_errors << " failed connections" << std::endl
+            << "  throughput:      " << std::fixed << std::setprecision(2) << stats.completed / elapsed << " requests/s, "
+            << stats.bytes_read / elapsed / (1024 * 1024) << " MB/s" << std::endl
+            << std::endl
+            << "  latency (corrected for coordinated omission)" << std::endl
+            << "    mean     " << format_duration(static_cast<std::uint64_t>(corrected.get_mean())) << std::endl;
+
+  for (double percentile : {50.0, 75.0, 90.0, 99.0, 99.9, 99.99})
+    std::cout << "    p" << std::left << std::setw(7) << percentile << " " << format_duration(corrected.get_percentile(percentile)) << std::endl;
+
+  std::cout << "    max      " << format_duration(corrected.get_max()) << std::endl;
+
+  return 0;
+}
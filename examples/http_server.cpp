@@ -68,6 +68,7 @@ main(void) {
       __NETFLEX_LOG(info, "/users/:user_name/articles/:post_id callback triggered");
       __NETFLEX_LOG(info, "Headers: " + netflex::misc::printable_header_list(request.get_headers()));
       __NETFLEX_LOG(info, "Params: " + netflex::misc::printable_params_list(request.get_params()));
+      __NETFLEX_LOG(info, "Query: " + request.get_query().get_raw().to_string());
       __NETFLEX_LOG(info, "Body: " + request.get_body());
 
       response.set_body("What's up?!\n");
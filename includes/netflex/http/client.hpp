@@ -24,11 +24,13 @@
 
 #include <memory>
 
-#include <tacopie/tacopie>
-
 #include <netflex/http/request.hpp>
 #include <netflex/http/response.hpp>
+#include <netflex/http/static_response.hpp>
+#include <netflex/misc/request_timing.hpp>
+#include <netflex/parsing/parse_error.hpp>
 #include <netflex/parsing/request_parser.hpp>
+#include <netflex/transport/connection.hpp>
 
 namespace netflex {
 
@@ -43,9 +45,9 @@ public:
   //!
   //! ctor
   //!
-  //! \param tcp_client underlying tcp connection
+  //! \param connection underlying connection
   //!
-  explicit client(const std::shared_ptr<tacopie::tcp_client>& tcp_client);
+  explicit client(const std::shared_ptr<transport::connection>& connection);
 
   //! default dtor
   ~client(void) = default;
@@ -76,7 +78,13 @@ public:
   //!
   //! notify on client disconnection
   //!
-  typedef tacopie::tcp_client::disconnection_handler_t disconnection_handler_t;
+  typedef transport::connection::disconnection_handler_t disconnection_handler_t;
+
+  //!
+  //! notify once a response has been fully written on the socket
+  //! takes as parameter the timing breakdown of the request associated to the response
+  //!
+  typedef std::function<void(const misc::request_timing&)> response_sent_handler_t;
 
   //!
   //! define the callback to be called on new valid or invalid http requests
@@ -92,14 +100,84 @@ public:
   //!
   void set_disconnection_handler(const disconnection_handler_t& cb);
 
+  //!
+  //! define the callback to be called once a response has been written
+  //!
+  //! \param cb callback to be called
+  //!
+  void set_response_sent_handler(const response_sent_handler_t& cb);
+
 public:
   //!
   //! send http response to the client
   //! this should only be called as a result of receiving a valid http request
+  //! shared bodies reaching the zero copy threshold are written without being copied (see set_zerocopy_threshold)
+  //!
+  //! \param response response to be sent
+  //! \param timing timing breakdown of the associated request, completed with the serialize and write phases and forwarded to the response sent callback
+  //!
+  void send_response(const response& response, const misc::request_timing& timing = misc::request_timing());
+
+  //!
+  //! send a constant response to the client, with the current Date header
+  //! same as send_response, without serializing the response
+  //!
+  //! \param response response to be sent
+  //! \param with_body whether to send the body (false for HEAD requests)
+  //! \param timing timing breakdown of the associated request
+  //!
+  void send_static_response(const static_response& response, bool with_body, const misc::request_timing& timing = misc::request_timing());
+
+  //!
+  //! send a preserialized error response to the client and close the connection once it has been written
+  //! the disconnection callback is called once the connection is closed
+  //!
+  //! \param status error status code
+  //!
+  void send_error(unsigned int status);
+
+  //!
+  //! \return description of the parsing failure, valid once an invalid request has been notified
+  //!
+  const parsing::parse_error& get_parse_error(void) const;
+
+  //!
+  //! set the size limits of the requests received from the client
+  //! requests exceeding them are notified as invalid requests
+  //!
+  //! \param limits limits to be enforced
+  //!
+  void set_request_limits(const parsing::request_limits& limits);
+
+  //!
+  //! \return number of bytes requested by the next read on the socket
+  //!
+  std::size_t get_read_size(void) const;
+
+  //!
+  //! write the shared bodies of at least the given size without copying them (MSG_ZEROCOPY, on backends supporting it)
+  //! worth it for large generated payloads only: the kernel notifies the end of each zero copy send separately
+  //!
+  //! \param threshold minimum body size, 0 to always copy bodies
+  //!
+  void set_zerocopy_threshold(std::size_t threshold);
+
+  //!
+  //! \return minimum size of the bodies written without copy, 0 if disabled
   //!
-  void send_response(const response& response);
+  std::size_t get_zerocopy_threshold(void) const;
 
 private:
+  //!
+  //! write a serialized response and notify the response sent callback once written
+  //!
+  //! \param buffer serialized response, or its head only if a body is given
+  //! \param body body to be written without copy after the head, nullptr if the buffer holds the whole response
+  //! \param serialize_start timestamp at which the serialization of the response started
+  //! \param timing timing breakdown of the associated request
+  //!
+  void write_response(std::vector<char>&& buffer, const std::shared_ptr<const std::string>& body, std::uint64_t serialize_start, const misc::request_timing& timing);
+
   //!
   //! call the request_handler callback
   //!
@@ -107,11 +185,11 @@ private:
 
 public:
   //!
-  //! tcp_client callback called on async_read operation completion
+  //! connection callback called on async_read operation completion
   //!
   //! \param res read operation result
   //!
-  void on_async_read_result(tacopie::tcp_client::read_result& res);
+  void on_async_read_result(transport::read_result& res);
 
 private:
   //!
@@ -119,21 +197,53 @@ private:
   //!
   void async_read(void);
 
+  //!
+  //! adapt the size of the next read to the amount of data received by the last one
+  //!
+  //! \param nb_bytes number of bytes received by the last read
+  //!
+  void adapt_read_size(std::size_t nb_bytes);
+
 private:
   //!
-  //! tcp connection
+  //! underlying connection
   //!
-  std::shared_ptr<tacopie::tcp_client> m_tcp_client;
+  std::shared_ptr<transport::connection> m_connection;
 
   //!
   //! callback to be called on new http requests
   //!
   request_handler_t m_request_received_callback;
 
+  //!
+  //! callback to be called once responses have been written
+  //!
+  response_sent_handler_t m_response_sent_callback;
+
+  //!
+  //! callback to be called on disconnection (also called when the connection is closed after an error response)
+  //!
+  disconnection_handler_t m_disconnection_callback;
+
   //!
   //! request parser used to parse the incoming http requests
   //!
   parsing::request_parser m_parser;
+
+  //!
+  //! number of bytes requested by the next read
+  //!
+  std::size_t m_read_size;
+
+  //!
+  //! read completion callback, built once and copied into each read request without allocating
+  //!
+  transport::connection::read_callback_t m_read_callback;
+
+  //!
+  //! minimum size of the shared bodies written without copy, 0 if disabled
+  //!
+  std::size_t m_zerocopy_threshold;
 };
 
 } // namespace http
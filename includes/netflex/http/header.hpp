@@ -86,6 +86,26 @@ struct header {
 //!
 typedef std::unordered_map<std::string, std::string> header_list_t;
 
+//!
+//! find a header by name, case insensitively (header names are stored as received or as set)
+//!
+//! \param headers headers to search
+//! \param name name of the header
+//! \return value of the header, nullptr if not found
+//!
+const std::string* find_header(const header_list_t& headers, const std::string& name);
+
+//!
+//! look for a token in a comma separated header value (Cache-Control, Connection, ...), case insensitively
+//! tokens followed by a parameter (private="Set-Cookie") match as well
+//!
+//! \param headers headers to search
+//! \param name name of the header
+//! \param token token to look for
+//! \return whether the header is present and lists the token
+//!
+bool has_header_token(const header_list_t& headers, const std::string& name, const std::string& token);
+
 } // namespace http
 
 } // namespace netflex
@@ -26,7 +26,10 @@
 
 #include <netflex/http/header.hpp>
 #include <netflex/http/method.hpp>
+#include <netflex/misc/request_timing.hpp>
 #include <netflex/routing/params.hpp>
+#include <netflex/routing/path_pattern.hpp>
+#include <netflex/routing/query.hpp>
 
 namespace netflex {
 
@@ -43,10 +46,15 @@ public:
   //! default dtor
   ~request(void) = default;
 
-  //! copy ctor
-  request(const request&) = default;
-  //! assignment operator
-  request& operator=(const request&) = default;
+  //! copy ctor (str path params are rebound to the copied target)
+  request(const request& other);
+  //! assignment operator (str path params are rebound to the copied target)
+  request& operator=(const request& other);
+
+  //! move ctor (str path params are rebound to the moved target, small targets being copied)
+  request(request&& other);
+  //! move assignment operator (str path params are rebound to the moved target, small targets being copied)
+  request& operator=(request&& other);
 
 public:
   //!
@@ -150,10 +158,23 @@ public:
   const std::string& get_path(void) const;
 
   //!
-  //! \return request params (route params and GET params)
+  //! \return request params (route params only, GET params are available through get_query())
   //!
   const routing::params_t& get_params(void) const;
 
+  //!
+  //! query string params of the request target (GET params), parsed lazily on lookup
+  //! the returned query is a view over the target: it must not outlive the request, nor be used after set_target()
+  //!
+  //! \return query string of the request target
+  //!
+  routing::query get_query(void) const;
+
+  //!
+  //! \return typed path params, set by routes with typed params (see routing::path_pattern)
+  //!
+  const routing::path_params_t& get_path_params(void) const;
+
   //!
   //! set requested path
   //!
@@ -168,6 +189,14 @@ public:
   //!
   void set_params(const routing::params_t& params);
 
+  //!
+  //! set typed path params
+  //! str params are views over the target: the target must not be modified afterwards
+  //!
+  //! \param params new typed path params
+  //!
+  void set_path_params(const routing::path_params_t& params);
+
 public:
   //!
   //! \return request body
@@ -181,12 +210,33 @@ public:
   //!
   void set_body(const std::string& body);
 
+public:
+  //!
+  //! \return timing breakdown of the request processing
+  //!
+  misc::request_timing& get_timing(void);
+
+  //!
+  //! \return timing breakdown of the request processing
+  //!
+  const misc::request_timing& get_timing(void) const;
+
 public:
   //!
   //! \return printable version of the request (for logging purpose)
   //!
   std::string to_string(void) const;
 
+private:
+  //!
+  //! rebind the str path params, views over the target of the request copied or moved from, to the target of this request
+  //! views not within the source target are left untouched
+  //!
+  //! \param source_target data of the source target
+  //! \param source_size size of the source target
+  //!
+  void rebind_path_params(const char* source_target, std::size_t source_size);
+
 private:
   //!
   //! request http verb
@@ -223,10 +273,20 @@ private:
   //!
   routing::params_t m_params;
 
+  //!
+  //! typed path params
+  //!
+  routing::path_params_t m_path_params;
+
   //!
   //! request body
   //!
   std::string m_body;
+
+  //!
+  //! timing breakdown
+  //!
+  misc::request_timing m_timing;
 };
 
 } // namespace http
@@ -22,7 +22,9 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <netflex/http/header.hpp>
 
@@ -106,7 +108,7 @@ public:
 
 public:
   //!
-  //! \return response body
+  //! \return response body (shared body if any)
   //!
   const std::string& get_body(void) const;
 
@@ -117,6 +119,34 @@ public:
   //!
   void set_body(const std::string& body);
 
+  //!
+  //! same as set_body, taking the ownership of the body instead of copying it
+  //!
+  //! \param body new body to be returned
+  //!
+  void set_body(std::string&& body);
+
+  //!
+  //! set an immutable body shared with other responses (cached page, configuration blob, broadcast message, ...)
+  //! the body is neither copied into the response nor when serializing it, only into the write buffer
+  //!
+  //! \param body shared body
+  //!
+  void set_body(const std::shared_ptr<const std::string>& body);
+
+  //!
+  //! \return shared body set by set_body, nullptr if the body is owned by the response
+  //!
+  const std::shared_ptr<const std::string>& get_shared_body(void) const;
+
+  //!
+  //! turn an owned body into a shared body, without copying it, so that it can outlive the response (zero copy writes)
+  //! no-op if the body is already shared
+  //!
+  //! \return shared body
+  //!
+  const std::shared_ptr<const std::string>& share_body(void);
+
 public:
   //!
   //! convert response to http packet
@@ -125,6 +155,41 @@ public:
   //!
   std::string to_http_packet(void) const;
 
+  //!
+  //! serialize the response into a write buffer, in a single allocation
+  //! raw packets are copied as is
+  //!
+  //! \param buffer buffer to fill (replaced)
+  //!
+  void serialize(std::vector<char>& buffer) const;
+
+  //!
+  //! serialize the status line and headers only, the body being written separately
+  //!
+  //! \param buffer buffer to fill (replaced)
+  //!
+  void serialize_head(std::vector<char>& buffer) const;
+
+public:
+  //!
+  //! set an already serialized http packet to be sent as is, instead of serializing the response
+  //! used to serve cached responses: status line, headers and body are then only informative
+  //!
+  //! \param packet serialized http packet, nullptr to serialize the response again
+  //!
+  void set_raw_packet(const std::shared_ptr<const std::string>& packet);
+
+  //!
+  //! \return serialized http packet set by set_raw_packet, nullptr if none
+  //!
+  const std::shared_ptr<const std::string>& get_raw_packet(void) const;
+
+private:
+  //!
+  //! \return serialized status line and headers, followed by the empty line
+  //!
+  std::string serialize_head(void) const;
+
 private:
   //!
   //! response http version
@@ -147,9 +212,15 @@ private:
   header_list_t m_headers;
 
   //!
-  //! response body
+  //! response body, owned or shared
   //!
   std::string m_body;
+  std::shared_ptr<const std::string> m_shared_body;
+
+  //!
+  //! already serialized http packet, if any
+  //!
+  std::shared_ptr<const std::string> m_raw_packet;
 };
 
 } // namespace http
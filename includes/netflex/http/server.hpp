@@ -22,15 +22,28 @@
 
 #pragma once
 
+#include <atomic>
+#include <functional>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <tuple>
 #include <vector>
 
-#include <tacopie/tacopie>
-
 #include <netflex/http/client.hpp>
+#include <netflex/http/static_response.hpp>
+#include <netflex/misc/concurrency_limiter.hpp>
+#include <netflex/misc/rate_limiter.hpp>
+#include <netflex/misc/request_metrics.hpp>
+#include <netflex/parsing/request_limits.hpp>
 #include <netflex/routing/middleware_chain.hpp>
+#include <netflex/routing/middleware_pipeline.hpp>
 #include <netflex/routing/route.hpp>
+#include <netflex/routing/route_table.hpp>
+#include <netflex/routing/route_table_publisher.hpp>
+#include <netflex/routing/router.hpp>
+#include <netflex/transport/listener.hpp>
 
 namespace netflex {
 
@@ -42,8 +55,19 @@ namespace http {
 //!
 class server {
 public:
+  //!
   //! default ctor
+  //! connections are handled by the tacopie backend
+  //!
   server(void);
+
+  //!
+  //! ctor
+  //!
+  //! \param listener I/O backend accepting and driving the connections (transport::epoll_listener on linux, for instance)
+  //!
+  explicit server(const std::shared_ptr<transport::listener>& listener);
+
   //! default dtor
   ~server(void) = default;
 
@@ -77,6 +101,19 @@ public:
   //!
   server& set_route(const std::vector<routing::route>& routes);
 
+public:
+  //!
+  //! add a route answering a constant response, serialized once
+  //! requests matching its method and exact path (query string ignored) are answered right away, without running any middleware, regardless of their Host header
+  //! meant for health checks, robots.txt, fixed json, ...
+  //!
+  //! \param m method of the route, GET routes also answer HEAD requests
+  //! \param path exact path of the route
+  //! \param response response to be sent, the Date header being set when it is sent
+  //! \return reference to the current object
+  //!
+  server& add_static_route(http::method m, const std::string& path, const http::response& response);
+
 public:
   //!
   //! add middleware to the server
@@ -108,9 +145,121 @@ public:
   //!
   server& set_middlewares(const std::list<routing::middleware_t>& middlewares);
 
+public:
+  //!
+  //! mount a router at a path prefix
+  //! requests whose target is under the prefix (longest prefix wins) run the server middlewares, then the router middlewares, and are dispatched to the router routes only
+  //! other requests run the server middlewares and are dispatched to the server routes
+  //!
+  //! \param prefix path prefix (for example /api), router routes paths are relative to it
+  //! \param router router to be mounted
+  //! \return reference to the current object
+  //!
+  server& mount(const std::string& prefix, const routing::router& router);
+
+  //!
+  //! add a virtual host, served by its own router
+  //! requests whose Host header matches the host run the server middlewares, then the router middlewares, and are dispatched to the router routes only
+  //! requests matching no virtual host are processed by the server routes and mounted routers
+  //!
+  //! \param host exact host (api.example.com) or wildcard on subdomains (*.example.com), case insensitive, port ignored
+  //! \param router router serving the virtual host
+  //! \return reference to the current object
+  //!
+  server& add_virtual_host(const std::string& host, const routing::router& router);
+
+public:
+  //!
+  //! set the size limits of the requests (request-line, header fields, message body)
+  //! requests exceeding them are rejected while being received, with 414, 431 or 413, and their connection is closed
+  //! must be called before starting the server (throws otherwise, the connections reading them concurrently)
+  //!
+  //! \param limits limits to be enforced
+  //! \return reference to the current object
+  //!
+  server& set_request_limits(const parsing::request_limits& limits);
+
+  //!
+  //! \return size limits of the requests
+  //!
+  const parsing::request_limits& get_request_limits(void) const;
+
+public:
+  //!
+  //! write the response bodies of at least the given size without copying them (MSG_ZEROCOPY, epoll backend only)
+  //! bodies set by the handlers are moved to a shared buffer, released once the kernel is done with it
+  //! meant for large generated payloads (exports, ...), smaller bodies being cheaper to copy than to track
+  //! must be called before starting the server (throws otherwise, the connections reading it concurrently)
+  //!
+  //! \param threshold minimum body size, 0 to disable zero copy writes
+  //! \return reference to the current object
+  //!
+  server& set_zerocopy_threshold(std::size_t threshold);
+
+  //!
+  //! \return minimum size of the bodies written without copy, 0 if disabled
+  //!
+  std::size_t get_zerocopy_threshold(void) const;
+
+public:
+  //!
+  //! limit the rate of requests of each client, with a token bucket per client
+  //! requests over the limit are answered with 429 Too Many Requests and a Retry-After header, before running any middleware
+  //! must be called before starting the server
+  //!
+  //! \param requests_per_second sustained rate allowed per client
+  //! \param burst number of requests a client can send at once after an idle period
+  //! \param key_header header identifying the clients (an api key), clients are identified by their address if empty or if the request does not have the header
+  //!                   the header is chosen by the client: keyed requests are charged to the address of the client as well, so that rotating keys does not bypass the limit
+  //! \param max_clients number of clients tracked at the same time, clients over it are not limited when identified by their address, and charged to their address (rejected if untracked) when identified by key_header
+  //! \return reference to the current object
+  //!
+  server& set_rate_limit(double requests_per_second, std::uint32_t burst, const std::string& key_header = "", std::size_t max_clients = 65536);
+
+  //!
+  //! \return rate limiter of the server, nullptr if rate limiting is disabled
+  //!
+  const misc::rate_limiter* get_rate_limiter(void) const;
+
+public:
+  //!
+  //! limit the number of requests processed at the same time, adapting the limit to the latency of the requests (see misc::concurrency_limiter)
+  //! requests over the limit are answered with 503 Service Unavailable and a Retry-After header, before running any middleware
+  //! must be called before starting the server
+  //!
+  //! \param initial_limit limit before any request completes
+  //! \param min_limit lowest limit
+  //! \param max_limit highest limit
+  //! \return reference to the current object
+  //!
+  server& set_adaptive_concurrency_limit(std::uint32_t initial_limit = 20, std::uint32_t min_limit = 1, std::uint32_t max_limit = 1000);
+
+  //!
+  //! \return concurrency limiter of the server, nullptr if concurrency limiting is disabled
+  //!
+  const misc::concurrency_limiter* get_concurrency_limiter(void) const;
+
+  //!
+  //! limit the number of connections
+  //! connections over the limit are answered with 503 Service Unavailable and a Retry-After header, then closed, without reading their requests
+  //!
+  //! \param max_connections maximum number of connections, 0 for no limit
+  //! \return reference to the current object
+  //!
+  server& set_max_connections(std::size_t max_connections);
+
+  //!
+  //! \return number of connections currently open
+  //!
+  std::size_t get_nb_connections(void) const;
+
 public:
   //!
   //! start the server at the given host and port
+  //! routes, middlewares and mounted routers are frozen into a route table snapshot used to process requests
+  //! while the server is running, each change of the routing publishes a new snapshot: requests being processed keep the previous one, new requests use the new one
+  //! routing can be changed from any thread, including from route handlers and middlewares
+  //! as each change rebuilds the whole snapshot, prefer add_routes/set_route over many add_route calls on a running server
   //!
   //! \param host host to bind
   //! \param port port to bind
@@ -127,14 +276,26 @@ public:
   //!
   bool is_running(void) const;
 
+public:
+  //!
+  //! \return per-phase timing metrics of the requests processed by the server
+  //!         can be used to query the histograms or to enable slow requests tracing
+  //!
+  misc::request_metrics& get_metrics(void);
+
+  //!
+  //! \return per-phase timing metrics of the requests processed by the server
+  //!
+  const misc::request_metrics& get_metrics(void) const;
+
 private:
   //!
-  //! tacopie::tcp_server callback
-  //! called whenever the tcp server receives a new connection
+  //! listener callback
+  //! called whenever the listener accepts a new connection
   //!
-  //! \return whether the server takes charge of the management of the connection or not (always true in our case)
+  //! \param connection accepted connection
   //!
-  bool on_connection_received(const std::shared_ptr<tacopie::tcp_client>& client);
+  void on_connection_received(const std::shared_ptr<transport::connection>& connection);
 
   //!
   //! convenience typedef
@@ -151,6 +312,14 @@ private:
   //!
   void on_http_request_received(bool success, request& request, client_iterator_t client);
 
+  //!
+  //! client callback
+  //! called whenever a response has been written to a client
+  //!
+  //! \param timing timing breakdown of the request associated to the response
+  //!
+  void on_http_response_sent(const misc::request_timing& timing);
+
   //!
   //! client callback
   //! called whenever a client disconnected from the server
@@ -160,34 +329,141 @@ private:
   void on_client_disconnected(client_iterator_t client);
 
   //!
-  //! dispatch the request and its response by using the specified middleware chain
+  //! \param request received http request
+  //! \param client client that sent the request
+  //! \return whether the request is allowed by the rate limiter
+  //!
+  bool is_request_allowed(const request& request, const client& client);
+
   //!
-  //! \param chain chain of middlewares to be executed
+  //! dispatch the request to the first matching route
+  //! last middleware of each pipeline
+  //!
+  //! \param routes routes to match the request against
   //! \param request received http request
   //! \param response response to be sent
   //!
-  void dispatch(routing::middleware_chain& chain, http::request& request, http::response& response);
+  void dispatch(const std::vector<routing::route>& routes, http::request& request, http::response& response);
+
+  //!
+  //! freeze routes, middlewares and mounted routers into a route table
+  //!
+  //! \return route table
+  //!
+  routing::route_table build_route_table(void);
+
+  //!
+  //! apply a change to the routing configuration, and publish a new route table if the server is running
+  //!
+  //! \param update change to apply, called with the routing mutex held
+  //!
+  void update_routing(const std::function<void(void)>& update);
 
 private:
   //!
-  //! underlying tcp server
+  //! I/O backend
   //!
-  tacopie::tcp_server m_tcp_server;
+  std::shared_ptr<transport::listener> m_listener;
 
   //!
   //! server routes
   //!
   std::vector<routing::route> m_routes;
 
+  //!
+  //! static routes: method, path and preserialized response
+  //!
+  std::vector<std::tuple<http::method, std::string, std::shared_ptr<const static_response>>> m_static_routes;
+
   //!
   //! server middlewares
   //!
   std::list<routing::middleware_t> m_middlewares;
 
+  //!
+  //! mounted routers, with their prefix
+  //!
+  std::vector<std::pair<std::string, routing::router>> m_mounts;
+
+  //!
+  //! virtual hosts routers, with their host
+  //!
+  std::vector<std::pair<std::string, routing::router>> m_virtual_hosts;
+
+  //!
+  //! published routing snapshot, shared by all the requests
+  //!
+  routing::route_table_publisher m_route_table;
+
+  //!
+  //! whether routing changes must be published right away (server started)
+  //!
+  bool m_routing_live;
+
+  //!
+  //! protect routes, middlewares, mounts and publication ordering
+  //!
+  std::mutex m_routing_mutex;
+
   //!
   //! clients
   //!
   std::list<client> m_clients;
+
+  //!
+  //! protect m_clients, connections being accepted and closed by several I/O threads
+  //!
+  std::mutex m_clients_mutex;
+
+  //!
+  //! size limits of the requests
+  //!
+  parsing::request_limits m_request_limits;
+
+  //!
+  //! minimum size of the bodies written without copy, 0 if disabled
+  //!
+  std::size_t m_zerocopy_threshold;
+
+  //!
+  //! per-client rate limiter, nullptr if disabled
+  //!
+  std::unique_ptr<misc::rate_limiter> m_rate_limiter;
+
+  //!
+  //! header identifying the clients for rate limiting, clients addresses if empty
+  //!
+  std::string m_rate_limit_key_header;
+
+  //!
+  //! preserialized response of the rate limited requests
+  //!
+  response m_rate_limited_response;
+
+  //!
+  //! adaptive concurrency limiter, nullptr if disabled
+  //!
+  std::unique_ptr<misc::concurrency_limiter> m_concurrency_limiter;
+
+  //!
+  //! preserialized response of the requests rejected by the concurrency limiter
+  //!
+  response m_overloaded_response;
+
+  //!
+  //! maximum number of connections, 0 for no limit
+  //!
+  std::size_t m_max_connections;
+
+  //!
+  //! number of connections currently open
+  //!
+  std::atomic<std::size_t> m_nb_connections;
+
+  //!
+  //! requests timing metrics
+  //!
+  misc::request_metrics m_metrics;
 };
 
 } // namespace http
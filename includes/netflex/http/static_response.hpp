@@ -20,79 +20,77 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+
 #pragma once
 
 #include <string>
+#include <vector>
 
-#include <netflex/parsing/parser_iface.hpp>
+#include <netflex/http/response.hpp>
 
 namespace netflex {
 
-namespace parsing {
+namespace http {
 
 //!
-//! parser for a Content-Length body
+//! response with a constant content (health checks, robots.txt, fixed json, ...), serialized once
+//! the Date header is the only part written per request, so that sending it is a matter of copying three buffers
 //!
-class message_body_content_length_parser : public parser_iface {
+class static_response {
 public:
   //!
-  //! default ctor
+  //! ctor
+  //! Content-Length is added if missing, Date headers are ignored and replaced by the current date when sent
   //!
-  //! \param request request to be initialized
+  //! \param response response to be serialized (status line, headers and body)
   //!
-  explicit message_body_content_length_parser(http::request& request);
+  explicit static_response(const response& response);
+
   //! default dtor
-  ~message_body_content_length_parser(void) = default;
+  ~static_response(void) = default;
 
   //! copy ctor
-  message_body_content_length_parser(const message_body_content_length_parser&) = delete;
+  static_response(const static_response&) = default;
   //! assignment operator
-  message_body_content_length_parser& operator=(const message_body_content_length_parser&) = delete;
+  static_response& operator=(const static_response&) = default;
 
 public:
   //!
-  //! consume input data to parse it and init the request
-  //! if not enough data is passed in, this method would need to be called again later
-  //! input data is modified whenever a token is consumed by parsing, even if parsing is incomplete or invalid
-  //! invalid data would lead to a raised exception
+  //! write the packet into a buffer
   //!
-  //! \param data input data to be parsed
-  //! \return reference to the current object
+  //! \param buffer buffer to fill (replaced)
+  //! \param date value of the Date header
+  //! \param with_body whether to include the body (false for HEAD requests)
   //!
-  parser_iface& operator<<(std::string& data);
+  void serialize(std::vector<char>& buffer, const std::string& date, bool with_body) const;
 
   //!
-  //! \return whether the parsing is done or not
+  //! \return status code of the response
   //!
-  bool is_done(void) const;
+  unsigned int get_status_code(void) const;
 
 private:
   //!
-  //! fetch body
+  //! status line, with its CRLF
   //!
-  //! \param str input data
-  //!
-  void fetch_body(std::string& str);
+  std::string m_status_line;
 
   //!
-  //! fetch content length from headers
-  //!
-  //! \return content length
+  //! header fields, followed by the empty line
   //!
-  unsigned int fetch_content_length(void) const;
+  std::string m_headers;
 
-private:
   //!
-  //! content length
+  //! message body
   //!
-  unsigned int m_content_length;
+  std::string m_body;
 
   //!
-  //! body
+  //! status code
   //!
-  std::string m_body;
+  unsigned int m_status;
 };
 
-} // namespace parsing
+} // namespace http
 
 } // namespace netflex
@@ -0,0 +1,60 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <string>
+
+namespace netflex {
+
+namespace http {
+
+//!
+//! convert a status code to its standard reason phrase
+//!
+//! \param status status code to convert
+//! \return reason phrase ("Unknown" for non-standard status codes)
+//!
+const char* status_to_reason_phrase(unsigned int status);
+
+//!
+//! preserialized HTTP/1.1 status line of a status code, with its standard reason phrase
+//! lines are built once, returning them does not allocate
+//!
+//! \param status status code
+//! \return status line, ending with CRLF, nullptr for non-standard status codes
+//!
+const std::string* status_to_status_line(unsigned int status);
+
+//!
+//! preserialized response for an error status code
+//! the response has a short plain text body and asks the client to close the connection
+//! packets are built once, returning them does not allocate
+//!
+//! \param status error status code (4xx or 5xx)
+//! \return http packet
+//!
+const std::string& status_to_error_packet(unsigned int status);
+
+} // namespace http
+
+} // namespace netflex
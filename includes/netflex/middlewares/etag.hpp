@@ -0,0 +1,183 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <netflex/http/request.hpp>
+#include <netflex/http/response.hpp>
+#include <netflex/routing/middleware_chain.hpp>
+
+namespace netflex {
+
+namespace middlewares {
+
+//!
+//! strong ETags and conditional GET
+//!
+//! 200 responses to GET and HEAD requests get an ETag computed by hashing their body (XXH64), unless they already have one
+//! requests whose If-None-Match matches the ETag are answered with a body-less 304, so that polling clients transfer nothing and the body is never serialized
+//!
+//! ETags can also be cached per target for a given ttl: a request whose If-None-Match matches the cached ETag is then answered with a 304 without proceeding the chain
+//! this skips the route for unchanged resources, at the cost of answering 304 for up to ttl after a change: only enable it for targets that tolerate this staleness
+//!
+//! the middleware must be added before the response cache and the single flight: their responses then still get validated, while a cache hit would otherwise skip it
+//! responses set as raw packets are left untouched, as their headers cannot be changed
+//!
+class etag {
+public:
+  //!
+  //! ctor
+  //!
+  //! \param cache_ttl how long the ETag of a target is trusted without calling its route, 0 to always call it
+  //! \param max_cached_etags maximum number of cached ETags
+  //!
+  explicit etag(std::chrono::milliseconds cache_ttl = std::chrono::milliseconds(0), std::size_t max_cached_etags = 10000);
+
+  //! default dtor
+  ~etag(void) = default;
+
+  //! copy ctor
+  etag(const etag&) = delete;
+  //! assignment operator
+  etag& operator=(const etag&) = delete;
+
+public:
+  //!
+  //! middleware to be added to a server or a router
+  //! the etag must outlive the server or router using it
+  //!
+  //! \return middleware
+  //!
+  routing::middleware_t get_middleware(void);
+
+  //!
+  //! process a request: answer it from the cached ETag, or proceed the chain and tag its response
+  //!
+  //! \param chain middleware chain
+  //! \param request request to be processed
+  //! \param response response to be sent
+  //!
+  void process(routing::middleware_chain& chain, http::request& request, http::response& response);
+
+public:
+  //!
+  //! compute the strong ETag of a body
+  //!
+  //! \param body body to tag
+  //! \return quoted ETag
+  //!
+  static std::string compute(const std::string& body);
+
+  //!
+  //! check whether an If-None-Match header value matches an ETag (weak comparison, as required for If-None-Match)
+  //!
+  //! \param if_none_match value of the If-None-Match header (list of ETags, or *)
+  //! \param etag ETag of the current representation
+  //! \return whether one of the ETags matches
+  //!
+  static bool matches(const std::string& if_none_match, const std::string& etag);
+
+  //!
+  //! turn a response into a 304 Not Modified one: no body, nor body related headers
+  //!
+  //! \param response response to transform
+  //! \param etag ETag of the representation
+  //!
+  static void set_not_modified(http::response& response, const std::string& etag);
+
+public:
+  //!
+  //! \return number of requests answered with a 304
+  //!
+  std::uint64_t get_nb_not_modified(void) const;
+
+  //!
+  //! \return number of 304 answered from the cached ETags, without proceeding the chain
+  //!
+  std::uint64_t get_nb_cache_hits(void) const;
+
+private:
+  //!
+  //! cached ETag of a target
+  //!
+  struct cached_etag {
+    //! quoted ETag
+    std::string value;
+
+    //! time until which the ETag is trusted
+    std::chrono::steady_clock::time_point expires_at;
+  };
+
+  //!
+  //! \param key method and target
+  //! \param value place where to store the cached ETag
+  //! \return whether a fresh ETag is cached for key
+  //!
+  bool get_cached_etag(const std::string& key, std::string& value);
+
+  //!
+  //! cache the ETag of a target
+  //!
+  //! \param key method and target
+  //! \param value quoted ETag
+  //!
+  void cache_etag(const std::string& key, const std::string& value);
+
+private:
+  //!
+  //! how long cached ETags are trusted
+  //!
+  std::chrono::milliseconds m_cache_ttl;
+
+  //!
+  //! maximum number of cached ETags
+  //!
+  std::size_t m_max_cached_etags;
+
+  //!
+  //! cached ETags, by method and target
+  //!
+  std::unordered_map<std::string, cached_etag> m_cached_etags;
+
+  //!
+  //! protect m_cached_etags
+  //!
+  std::mutex m_mutex;
+
+  //!
+  //! counters
+  //!
+  std::atomic<std::uint64_t> m_nb_not_modified;
+  std::atomic<std::uint64_t> m_nb_cache_hits;
+};
+
+} // namespace middlewares
+
+} // namespace netflex
@@ -0,0 +1,245 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <netflex/http/request.hpp>
+#include <netflex/http/response.hpp>
+#include <netflex/routing/middleware_chain.hpp>
+
+namespace netflex {
+
+namespace middlewares {
+
+//!
+//! in-memory cache of http responses (shared cache semantics)
+//!
+//! GET and HEAD responses are stored as their status, headers and shared body, keyed by method, Host, target and the request headers listed in their Vary header
+//! hits are served without proceeding the middleware chain: neither the subsequent middlewares nor the route are called
+//! hits get a fresh Date and an Age header (seconds since stored), the body being shared instead of copied; responses set as raw packets are not stored
+//! freshness comes from the response Cache-Control (s-maxage, then max-age), or from the default ttl if the response has none
+//! responses with Cache-Control no-store, no-cache or private, with Set-Cookie, or with Vary: * are never stored
+//! requests with Cache-Control no-store, or with Authorization, bypass the cache; requests with Cache-Control no-cache are not served from the cache but refresh it
+//!
+//! entries are spread over shards, each with its own lock and LRU list, so that concurrent requests rarely contend
+//! the memory cap is split evenly between shards: least recently used entries of a shard are evicted when it is exceeded
+//!
+//! the middleware should be added after the middlewares that must run for every request (authentication, rate limiting, ...), as the following ones are skipped on hits
+//!
+class response_cache {
+public:
+  //!
+  //! ctor
+  //!
+  //! \param max_memory memory cap of the cache, in bytes (keys, headers and bodies)
+  //! \param default_ttl freshness of the responses without Cache-Control freshness, 0 to store only the responses with explicit freshness
+  //! \param nb_shards number of shards
+  //!
+  explicit response_cache(std::size_t max_memory = 64 * 1024 * 1024, std::chrono::seconds default_ttl = std::chrono::seconds(0), std::size_t nb_shards = 16);
+
+  //! default dtor
+  ~response_cache(void) = default;
+
+  //! copy ctor
+  response_cache(const response_cache&) = delete;
+  //! assignment operator
+  response_cache& operator=(const response_cache&) = delete;
+
+public:
+  //!
+  //! middleware to be added to a server or a router
+  //! the cache must outlive the server or router using it
+  //!
+  //! \return middleware
+  //!
+  routing::middleware_t get_middleware(void);
+
+  //!
+  //! process a request: serve it from the cache, or proceed the chain and store its response
+  //!
+  //! \param chain middleware chain
+  //! \param request request to be processed
+  //! \param response response to be sent
+  //!
+  void process(routing::middleware_chain& chain, http::request& request, http::response& response);
+
+public:
+  //!
+  //! remove all the entries
+  //!
+  void clear(void);
+
+  //!
+  //! \return number of stored entries
+  //!
+  std::size_t size(void) const;
+
+  //!
+  //! \return memory used by the stored entries, in bytes
+  //!
+  std::size_t get_memory_usage(void) const;
+
+  //!
+  //! \return number of requests served from the cache
+  //!
+  std::uint64_t get_nb_hits(void) const;
+
+  //!
+  //! \return number of cacheable requests not served from the cache
+  //!
+  std::uint64_t get_nb_misses(void) const;
+
+private:
+  //!
+  //! cached response
+  //!
+  struct entry {
+    //! base key (method, host and target)
+    std::string base_key;
+
+    //! full key (method, host, target and vary headers values)
+    std::string key;
+
+    //! response status code
+    unsigned int status;
+
+    //! response reason phrase
+    std::string reason;
+
+    //! response headers, except Date and Age
+    http::header_list_t headers;
+
+    //! response body, shared with the responses served from the entry
+    std::shared_ptr<const std::string> body;
+
+    //! storage time
+    std::chrono::steady_clock::time_point stored_at;
+
+    //! expiration time
+    std::chrono::steady_clock::time_point expires_at;
+
+    //! memory accounted for the entry
+    std::size_t memory;
+  };
+
+  //!
+  //! Vary request headers of a target, with the number of entries stored for it
+  //!
+  struct vary_headers {
+    //! lowercase names of the headers
+    std::vector<std::string> names;
+
+    //! number of entries of the target
+    std::size_t nb_entries;
+  };
+
+  //!
+  //! shard: LRU list (most recently used first) and index, protected by a lock
+  //!
+  struct shard {
+    //! protect the shard
+    std::mutex mutex;
+
+    //! entries, most recently used first
+    std::list<entry> lru;
+
+    //! entries by full key
+    std::unordered_map<std::string, std::list<entry>::iterator> entries;
+
+    //! names of the Vary request headers, by base key (method, host and target)
+    std::unordered_map<std::string, vary_headers> vary;
+
+    //! memory used by the entries of the shard
+    std::size_t memory;
+  };
+
+private:
+  //!
+  //! \param base_key method, host and target
+  //! \return shard storing the entries of base_key
+  //!
+  shard& get_shard(const std::string& base_key);
+
+  //!
+  //! look for a fresh entry matching the request
+  //!
+  //! \param request request to be served
+  //! \param base_key method, host and target of the request
+  //! \param response response to fill on hit
+  //! \return whether the request was served from the cache
+  //!
+  bool lookup(const http::request& request, const std::string& base_key, http::response& response);
+
+  //!
+  //! store the response, if cacheable
+  //!
+  //! \param request processed request
+  //! \param base_key method, host and target of the request
+  //! \param response response of the request, its body being shared with the entry
+  //!
+  void store(const http::request& request, const std::string& base_key, http::response& response);
+
+  //!
+  //! remove an entry from its shard (shard lock held)
+  //!
+  //! \param shard shard of the entry
+  //! \param it entry to remove
+  //!
+  void remove(shard& shard, std::list<entry>::iterator it);
+
+private:
+  //!
+  //! shards
+  //!
+  std::vector<std::unique_ptr<shard>> m_shards;
+
+  //!
+  //! memory cap of each shard
+  //!
+  std::size_t m_max_shard_memory;
+
+  //!
+  //! freshness of responses without explicit freshness
+  //!
+  std::chrono::seconds m_default_ttl;
+
+  //!
+  //! hits and misses counters
+  //!
+  std::atomic<std::uint64_t> m_nb_hits;
+  std::atomic<std::uint64_t> m_nb_misses;
+};
+
+} // namespace middlewares
+
+} // namespace netflex
@@ -0,0 +1,194 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <netflex/http/request.hpp>
+#include <netflex/http/response.hpp>
+#include <netflex/routing/middleware_chain.hpp>
+
+namespace netflex {
+
+namespace middlewares {
+
+//!
+//! coalesce identical concurrent GET and HEAD requests (single-flight)
+//!
+//! the first request for a key (leader) proceeds the chain, while the identical requests received meanwhile (followers) wait for it and share its response, the body being shared instead of copied
+//! the key is the method, the Host, the target and the values of the configured request headers (those the responses depend on, such as Accept-Encoding)
+//! followers give up waiting after max_wait and proceed the chain themselves, as they also do if the leader fails
+//!
+//! requests with Authorization or Cookie are not coalesced, unless these headers are part of the key
+//! responses with Set-Cookie, with Cache-Control private or no-store, or varying on a header not part of the key, are not shared: the followers then proceed the chain themselves
+//!
+//! followers block the I/O loop thread processing them, delaying all the other connections of that loop for up to max_wait: keep it short
+//! the middleware is meant to be added last, right before the dispatch to the route, and after the response cache if any
+//!
+class single_flight {
+public:
+  //!
+  //! ctor
+  //!
+  //! \param key_headers request headers the responses depend on, part of the key
+  //! \param max_wait maximum time a follower waits for its leader, blocking its I/O loop thread
+  //!
+  explicit single_flight(const std::vector<std::string>& key_headers = {}, std::chrono::milliseconds max_wait = std::chrono::milliseconds(100));
+
+  //! default dtor
+  ~single_flight(void) = default;
+
+  //! copy ctor
+  single_flight(const single_flight&) = delete;
+  //! assignment operator
+  single_flight& operator=(const single_flight&) = delete;
+
+public:
+  //!
+  //! middleware to be added to a server or a router
+  //! the single_flight must outlive the server or router using it
+  //!
+  //! \return middleware
+  //!
+  routing::middleware_t get_middleware(void);
+
+  //!
+  //! process a request: proceed the chain as a leader, or wait for the leader of an identical request
+  //!
+  //! \param chain middleware chain
+  //! \param request request to be processed
+  //! \param response response to be sent
+  //!
+  void process(routing::middleware_chain& chain, http::request& request, http::response& response);
+
+public:
+  //!
+  //! \return number of requests currently being computed by a leader
+  //!
+  std::size_t get_nb_in_flight(void) const;
+
+  //!
+  //! \return number of requests served with the response of a leader
+  //!
+  std::uint64_t get_nb_coalesced(void) const;
+
+private:
+  //!
+  //! request being computed by a leader
+  //!
+  struct flight {
+    //! whether the leader completed
+    bool done;
+
+    //! whether the leader produced a response shareable with the followers
+    bool shared;
+
+    //! response of the leader, its body being shared
+    http::response response;
+
+    //! notified when the leader completes
+    std::condition_variable completed;
+  };
+
+  //!
+  //! \param request request to build the key of
+  //! \return key of the request
+  //!
+  std::string build_key(const http::request& request) const;
+
+  //!
+  //! \param request request to check
+  //! \return whether the request carries credentials (Authorization, Cookie) that are not part of the key
+  //!
+  bool carries_credentials(const http::request& request) const;
+
+  //!
+  //! \param name request header name
+  //! \return whether the header is part of the key (Host or configured header)
+  //!
+  bool is_keyed(const std::string& name) const;
+
+  //!
+  //! \param headers response headers
+  //! \return whether the response only varies on headers part of the key
+  //!
+  bool is_keyed_vary(const http::header_list_t& headers) const;
+
+  //!
+  //! proceed the chain as a leader, and publish the response to the followers
+  //!
+  //! \param chain middleware chain
+  //! \param response response to be sent
+  //! \param key key of the request
+  //! \param current flight of the request
+  //!
+  void lead(routing::middleware_chain& chain, http::response& response, const std::string& key, const std::shared_ptr<flight>& current);
+
+  //!
+  //! wait for the leader, and use its response
+  //!
+  //! \param chain middleware chain, proceeded if the leader does not deliver
+  //! \param response response to be sent
+  //! \param current flight of the leader
+  //!
+  void follow(routing::middleware_chain& chain, http::response& response, const std::shared_ptr<flight>& current);
+
+private:
+  //!
+  //! request headers part of the key
+  //!
+  std::vector<std::string> m_key_headers;
+
+  //!
+  //! maximum time a follower waits for its leader
+  //!
+  std::chrono::milliseconds m_max_wait;
+
+  //!
+  //! flights, by key
+  //!
+  std::unordered_map<std::string, std::shared_ptr<flight>> m_flights;
+
+  //!
+  //! protect m_flights and the flights
+  //!
+  mutable std::mutex m_mutex;
+
+  //!
+  //! number of requests served with the response of a leader
+  //!
+  std::atomic<std::uint64_t> m_nb_coalesced;
+};
+
+} // namespace middlewares
+
+} // namespace netflex
@@ -20,52 +20,60 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+
 #pragma once
 
-#include <netflex/parsing/parser_iface.hpp>
+#include <cstddef>
+#include <vector>
 
 namespace netflex {
 
-namespace parsing {
+namespace misc {
 
 //!
-//! parser for a compressed body
+//! per-thread pool of recycled byte buffers
+//! buffers released by a thread are handed back to the next acquisitions of the same thread, keeping their capacity, so that building a packet does not allocate
+//! each thread keeps a bounded number of buffers of bounded capacity: larger or extra buffers are freed
 //!
-class message_body_compress_parser : public parser_iface {
+class buffer_pool {
 public:
   //!
-  //! default ctor
-  //!
-  //! \param request request to be initialized
+  //! maximum number of buffers kept per thread
   //!
-  explicit message_body_compress_parser(http::request& request);
-
-  //! default dtor
-  ~message_body_compress_parser(void) = default;
+  static const std::size_t max_buffers_per_thread = 16;
 
-  //! copy ctor
-  message_body_compress_parser(const message_body_compress_parser&) = delete;
-  //! assignment operator
-  message_body_compress_parser& operator=(const message_body_compress_parser&) = delete;
+  //!
+  //! maximum capacity of the buffers kept
+  //!
+  static const std::size_t max_buffer_capacity = 256 * 1024;
 
 public:
   //!
-  //! consume input data to parse it and init the request
-  //! if not enough data is passed in, this method would need to be called again later
-  //! input data is modified whenever a token is consumed by parsing, even if parsing is incomplete or invalid
-  //! invalid data would lead to a raised exception
+  //! get an empty buffer, recycled if one is available in the current thread
+  //!
+  //! \param capacity minimum capacity of the buffer
+  //! \return empty buffer
+  //!
+  static std::vector<char> acquire(std::size_t capacity = 0);
+
+  //!
+  //! give a buffer back to the pool of the current thread
+  //!
+  //! \param buffer buffer to recycle (its content is discarded)
+  //!
+  static void release(std::vector<char>&& buffer);
+
   //!
-  //! \param data input data to be parsed
-  //! \return reference to the current object
+  //! \return number of buffers kept by the current thread
   //!
-  parser_iface& operator<<(std::string& data);
+  static std::size_t size(void);
 
   //!
-  //! \return whether the parsing is done or not
+  //! free the buffers kept by the current thread
   //!
-  bool is_done(void) const;
+  static void clear(void);
 };
 
-} // namespace parsing
+} // namespace misc
 
 } // namespace netflex
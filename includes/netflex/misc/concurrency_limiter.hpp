@@ -0,0 +1,186 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace netflex {
+
+namespace misc {
+
+//!
+//! adaptive limit of the number of requests processed at the same time (gradient algorithm)
+//!
+//! the latency of the completed requests is tracked by two moving averages: a short one, following the current latency, and a long one, following the latency without load
+//! as long as the short term latency stays within a tolerance of the long term one, the limit grows by a small margin, otherwise it shrinks by the ratio of the two
+//! so that requests over the limit are rejected instead of waiting behind slow ones, keeping the latency of the admitted requests stable
+//!
+//! admission only uses atomics, updates are done by a single completing request at a time and skipped under contention
+//!
+class concurrency_limiter {
+public:
+  //!
+  //! ctor
+  //!
+  //! \param initial_limit limit before any request completes
+  //! \param min_limit lowest limit
+  //! \param max_limit highest limit
+  //!
+  explicit concurrency_limiter(std::uint32_t initial_limit = 20, std::uint32_t min_limit = 1, std::uint32_t max_limit = 1000);
+
+  //! default dtor
+  ~concurrency_limiter(void) = default;
+
+  //! copy ctor
+  concurrency_limiter(const concurrency_limiter&) = delete;
+  //! assignment operator
+  concurrency_limiter& operator=(const concurrency_limiter&) = delete;
+
+public:
+  //!
+  //! admission of a request, released on destruction if not released explicitly (request failing with an exception)
+  //! the latency is then measured since the admission
+  //!
+  class permit {
+  public:
+    //! ctor: no admitted request
+    permit(void);
+
+    //! dtor: release the request if still admitted
+    ~permit(void);
+
+    //! copy ctor
+    permit(const permit&) = delete;
+    //! assignment operator
+    permit& operator=(const permit&) = delete;
+
+  public:
+    //!
+    //! admit a request
+    //!
+    //! \param limiter limiter to admit the request
+    //! \return whether the request is admitted (false if the limit is reached)
+    //!
+    bool acquire(concurrency_limiter& limiter);
+
+    //!
+    //! complete the admitted request, no-op if none
+    //!
+    //! \param latency latency of the request, in nanoseconds
+    //!
+    void release(std::uint64_t latency);
+
+  private:
+    //!
+    //! limiter having admitted the request, nullptr if none
+    //!
+    concurrency_limiter* m_limiter;
+
+    //!
+    //! admission time
+    //!
+    std::chrono::steady_clock::time_point m_acquired_at;
+  };
+
+public:
+  //!
+  //! admit a request, release() must be called once it completes (see permit)
+  //!
+  //! \return whether the request is admitted (false if the limit is reached)
+  //!
+  bool try_acquire(void);
+
+  //!
+  //! complete an admitted request and update the limit
+  //!
+  //! \param latency latency of the request, in nanoseconds
+  //!
+  void release(std::uint64_t latency);
+
+public:
+  //!
+  //! \return current limit
+  //!
+  std::uint32_t get_limit(void) const;
+
+  //!
+  //! \return number of admitted requests not yet completed
+  //!
+  std::uint32_t get_nb_in_flight(void) const;
+
+  //!
+  //! \return number of rejected requests
+  //!
+  std::uint64_t get_nb_rejected(void) const;
+
+private:
+  //!
+  //! update the limit with a new latency sample
+  //!
+  //! \param latency latency of the completed request
+  //! \param in_flight number of requests in flight when it completed, itself included
+  //!
+  void update(double latency, std::uint32_t in_flight);
+
+private:
+  //!
+  //! limits
+  //!
+  std::atomic<std::uint32_t> m_limit;
+  std::uint32_t m_min_limit;
+  std::uint32_t m_max_limit;
+
+  //!
+  //! limit before rounding
+  //!
+  double m_estimated_limit;
+
+  //!
+  //! moving averages of the latency, 0 before the first sample
+  //!
+  double m_short_latency;
+  double m_long_latency;
+
+  //!
+  //! serialize updates
+  //!
+  std::mutex m_update_mutex;
+
+  //!
+  //! requests in flight
+  //!
+  std::atomic<std::uint32_t> m_in_flight;
+
+  //!
+  //! rejected requests
+  //!
+  std::atomic<std::uint64_t> m_nb_rejected;
+};
+
+} // namespace misc
+
+} // namespace netflex
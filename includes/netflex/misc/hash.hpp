@@ -20,32 +20,27 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
-#include <netflex/parsing/message_body_compress_parser.hpp>
 
-namespace netflex {
+#pragma once
 
-namespace parsing {
+#include <cstddef>
+#include <cstdint>
 
-//!
-//! ctor
-//!
-message_body_compress_parser::message_body_compress_parser(http::request& request)
-: parser_iface(request) {}
+namespace netflex {
 
+namespace misc {
 
 //!
-//! parser_iface impl
+//! fast non-cryptographic 64 bits hash (XXH64 algorithm)
+//! portable implementation, giving the same results as the reference one on little and big endian platforms
 //!
-parser_iface&
-message_body_compress_parser::operator<<(std::string&) {
-  return *this;
-}
-
-bool
-message_body_compress_parser::is_done(void) const {
-  return true;
-}
+//! \param data data to hash
+//! \param size size of data, in bytes
+//! \param seed seed of the hash
+//! \return hash of data
+//!
+std::uint64_t xxhash64(const void* data, std::size_t size, std::uint64_t seed = 0);
 
-} // namespace parsing
+} // namespace misc
 
 } // namespace netflex
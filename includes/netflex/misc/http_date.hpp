@@ -0,0 +1,52 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <ctime>
+#include <memory>
+#include <string>
+
+namespace netflex {
+
+namespace misc {
+
+//!
+//! format a time for http headers (IMF-fixdate, RFC 7231 7.1.1.1), independently of the locale
+//!
+//! \param time time to format
+//! \return formatted time, for example "Sun, 06 Nov 1994 08:49:37 GMT"
+//!
+std::string format_http_date(std::time_t time);
+
+//!
+//! current time formatted for the Date header
+//! formatted at most once per second, the value being shared by all the threads
+//!
+//! \return current http date
+//!
+std::shared_ptr<const std::string> http_date(void);
+
+} // namespace misc
+
+} // namespace netflex
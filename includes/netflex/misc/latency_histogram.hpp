@@ -0,0 +1,156 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace netflex {
+
+namespace misc {
+
+//!
+//! lock-free log-linear histogram of latencies
+//! each power of two range is divided in 16 linear sub-buckets, giving a relative precision of 6.25% over the whole uint64 range
+//! recording is wait-free and can be done concurrently from multiple threads
+//!
+class latency_histogram {
+public:
+  //! ctor
+  latency_histogram(void);
+  //! default dtor
+  ~latency_histogram(void) = default;
+
+  //! copy ctor
+  latency_histogram(const latency_histogram&) = delete;
+  //! assignment operator
+  latency_histogram& operator=(const latency_histogram&) = delete;
+
+public:
+  //!
+  //! record a value
+  //!
+  //! \param value value to record
+  //! \param count number of times the value has been observed
+  //!
+  void record(std::uint64_t value, std::uint64_t count = 1);
+
+  //!
+  //! record a value, correcting for coordinated omission
+  //! if the value is higher than the expected interval between two samples, the samples that would have been taken during that time are also recorded (value - interval, value - 2 * interval, ...)
+  //!
+  //! \param value value to record
+  //! \param expected_interval expected interval between two samples (no correction if 0)
+  //! \param count number of times the value has been observed
+  //!
+  void record_corrected(std::uint64_t value, std::uint64_t expected_interval, std::uint64_t count = 1);
+
+  //!
+  //! add all the values of another histogram, correcting them for coordinated omission
+  //!
+  //! \param other histogram to add
+  //! \param expected_interval expected interval between two samples (no correction if 0)
+  //!
+  void add_corrected(const latency_histogram& other, std::uint64_t expected_interval);
+
+  //!
+  //! reset all the recorded values
+  //! values recorded concurrently to a reset may or may not be discarded
+  //!
+  void reset(void);
+
+public:
+  //!
+  //! \return number of recorded values
+  //!
+  std::uint64_t get_count(void) const;
+
+  //!
+  //! \return highest recorded value
+  //!
+  std::uint64_t get_max(void) const;
+
+  //!
+  //! \return mean of the recorded values
+  //!
+  double get_mean(void) const;
+
+  //!
+  //! \param percentile requested percentile, between 0 and 100
+  //! \return approximation of the value at the given percentile (0 if nothing has been recorded)
+  //!
+  std::uint64_t get_percentile(double percentile) const;
+
+private:
+  //!
+  //! number of bits used for linear sub-buckets
+  //!
+  static const unsigned int sub_bucket_bits = 4;
+
+  //!
+  //! number of linear sub-buckets per power of two range
+  //!
+  static const unsigned int sub_bucket_count = 1 << sub_bucket_bits;
+
+  //!
+  //! total number of buckets needed to cover the uint64 range
+  //!
+  static const unsigned int bucket_count = (64 - sub_bucket_bits + 1) * sub_bucket_count;
+
+  //!
+  //! \param value value to locate
+  //! \return index of the bucket containing the value
+  //!
+  static unsigned int bucket_index(std::uint64_t value);
+
+  //!
+  //! \param index bucket index
+  //! \return highest value that can be stored in the bucket
+  //!
+  static std::uint64_t bucket_upper_bound(unsigned int index);
+
+private:
+  //!
+  //! buckets counters
+  //!
+  std::atomic<std::uint64_t> m_buckets[bucket_count];
+
+  //!
+  //! number of recorded values
+  //!
+  std::atomic<std::uint64_t> m_count;
+
+  //!
+  //! sum of recorded values
+  //!
+  std::atomic<std::uint64_t> m_sum;
+
+  //!
+  //! highest recorded value
+  //!
+  std::atomic<std::uint64_t> m_max;
+};
+
+} // namespace misc
+
+} // namespace netflex
@@ -53,6 +53,14 @@ std::string printable_params_list(const routing::params_t& params);
 //!
 std::string header_list_to_http_packet(const http::header_list_t& headers);
 
+//!
+//! headers formatting for http response, appended to a packet being built
+//!
+//! \param packet packet to append the formatted headers to
+//! \param headers headers to format
+//!
+void append_header_list(std::string& packet, const http::header_list_t& headers);
+
 //!
 //! status line formatting for http response
 //!
@@ -63,6 +71,17 @@ std::string header_list_to_http_packet(const http::header_list_t& headers);
 //!
 std::string status_line_to_http_packet(const std::string& http_version, unsigned int status_code, const std::string& reason_phrase);
 
+//!
+//! status line formatting for http response, appended to a packet being built
+//! HTTP/1.1 status lines with standard reason phrases are copied from their preserialized version
+//!
+//! \param packet packet to append the formatted status line to
+//! \param http_version http version used by the http server
+//! \param status_code status code returned by the http server
+//! \param reason_phrase reason phrase associated to the status code returned by the http server
+//!
+void append_status_line(std::string& packet, const std::string& http_version, unsigned int status_code, const std::string& reason_phrase);
+
 } // namespace misc
 
 } // namespace netflex
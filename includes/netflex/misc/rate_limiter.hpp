@@ -0,0 +1,226 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace netflex {
+
+namespace misc {
+
+//!
+//! per-client rate limiter: one token bucket per key (client address, api key, ...)
+//!
+//! each bucket holds up to burst tokens and is refilled at the given rate, a request consumes one token and is rejected if the bucket is empty
+//!
+//! buckets are stored in a fixed size hash table, split into shards, without any lock: each slot holds the hash of its key and the bucket state (tokens and last refill time) packed in a single atomic word updated by compare-and-swap
+//! buckets left idle long enough to be full again are equivalent to new ones: their slot is lazily reused by the next key probing it, without any cleanup pass
+//! keys finding no slot (table full of active clients) are not limited, so that an attack over many addresses cannot lock out new legitimate clients
+//! keys chosen by the clients (api key header, ...) must come with a fallback key the client cannot choose (its address): once the table is saturated, requests are charged to the fallback key, and rejected if it finds no slot either, so that random keys cannot escape the limit
+//! keys are identified by a 64 bits hash: colliding keys, extremely unlikely, share a bucket
+//!
+class rate_limiter {
+public:
+  //!
+  //! ctor
+  //!
+  //! \param requests_per_second refill rate of the buckets, can be below 1 (0.1 for 6 requests per minute)
+  //! \param burst capacity of the buckets, number of requests allowed at once after an idle period
+  //! \param max_clients number of buckets that can be tracked at the same time
+  //! \param nb_shards number of shards of the table
+  //!
+  rate_limiter(double requests_per_second, std::uint32_t burst, std::size_t max_clients = 65536, std::size_t nb_shards = 16);
+
+  //! default dtor
+  ~rate_limiter(void) = default;
+
+  //! copy ctor
+  rate_limiter(const rate_limiter&) = delete;
+  //! assignment operator
+  rate_limiter& operator=(const rate_limiter&) = delete;
+
+public:
+  //!
+  //! consume a token from the bucket of the key
+  //!
+  //! \param key client key
+  //! \return whether the request is allowed (false if the client exceeded its limit)
+  //!
+  bool try_acquire(const std::string& key);
+
+  //!
+  //! consume a token from the bucket of the key, at the given time
+  //!
+  //! \param key client key
+  //! \param now current time, in milliseconds since the creation of the limiter (see now())
+  //! \return whether the request is allowed (false if the client exceeded its limit)
+  //!
+  bool try_acquire(const std::string& key, std::uint32_t now);
+
+  //!
+  //! consume a token from the bucket of a key chosen by the client, or from the bucket of the fallback key if the table is saturated
+  //! requests are rejected if neither key finds a slot
+  //!
+  //! \param key client chosen key
+  //! \param fallback_key key not chosen by the client (its address)
+  //! \return whether the request is allowed
+  //!
+  bool try_acquire(const std::string& key, const std::string& fallback_key);
+
+  //!
+  //! same as try_acquire(key, fallback_key), at the given time
+  //!
+  //! \param key client chosen key
+  //! \param fallback_key key not chosen by the client (its address)
+  //! \param now current time, in milliseconds since the creation of the limiter (see now())
+  //! \return whether the request is allowed
+  //!
+  bool try_acquire(const std::string& key, const std::string& fallback_key, std::uint32_t now);
+
+  //!
+  //! \return current time, in milliseconds since the creation of the limiter (wraps after 49 days)
+  //!
+  std::uint32_t now(void) const;
+
+public:
+  //!
+  //! \return number of seconds after which a rejected client gets a new token (Retry-After value)
+  //!
+  std::uint32_t get_retry_after(void) const;
+
+  //!
+  //! \return number of rejected requests
+  //!
+  std::uint64_t get_nb_rejected(void) const;
+
+  //!
+  //! \return number of requests allowed without being tracked, the table being full
+  //!
+  std::uint64_t get_nb_untracked(void) const;
+
+  //!
+  //! scan the table: meant for monitoring, not for the request path
+  //!
+  //! \param now current time, in milliseconds since the creation of the limiter
+  //! \return number of tracked keys whose bucket is not yet full
+  //!
+  std::size_t get_nb_active(std::uint32_t now) const;
+
+private:
+  //!
+  //! table slot
+  //! key is 0 while the slot has never been used
+  //! state packs the last refill time (32 high bits, milliseconds) and the tokens (32 low bits, thousandths of tokens)
+  //!
+  struct slot {
+    //! hash of the key
+    std::atomic<std::uint64_t> key;
+
+    //! bucket state
+    std::atomic<std::uint64_t> state;
+  };
+
+  //!
+  //! shard: fixed size open addressing table
+  //!
+  struct shard {
+    //! slots, a power of 2
+    std::unique_ptr<slot[]> slots;
+
+    //! number of slots - 1
+    std::size_t mask;
+  };
+
+private:
+  //!
+  //! \param state bucket state
+  //! \param now current time
+  //! \return milliseconds elapsed since the last refill of the bucket
+  //!
+  std::uint32_t get_elapsed(std::uint64_t state, std::uint32_t now) const;
+
+  //!
+  //! find the slot of the key, or take a reusable one
+  //!
+  //! \param key client key
+  //! \param now current time
+  //! \return slot owned by the key, nullptr if the probed slots are all owned by active clients
+  //!
+  slot* find_slot(const std::string& key, std::uint32_t now);
+
+  //!
+  //! consume a token from the bucket of a slot
+  //!
+  //! \param bucket slot owned by the key
+  //! \param now current time
+  //! \return whether a token was available
+  //!
+  bool consume(slot& bucket, std::uint32_t now);
+
+private:
+  //!
+  //! tokens refilled per millisecond, in thousandths of tokens
+  //!
+  double m_refill_rate;
+
+  //!
+  //! capacity of the buckets, in thousandths of tokens
+  //!
+  std::uint32_t m_capacity;
+
+  //!
+  //! milliseconds needed to refill an empty bucket: buckets idle for that long can be reused
+  //!
+  std::uint32_t m_idle_timeout;
+
+  //!
+  //! Retry-After value, in seconds
+  //!
+  std::uint32_t m_retry_after;
+
+  //!
+  //! time reference
+  //!
+  std::chrono::steady_clock::time_point m_start;
+
+  //!
+  //! shards
+  //!
+  std::vector<shard> m_shards;
+
+  //!
+  //! counters
+  //!
+  std::atomic<std::uint64_t> m_nb_rejected;
+  std::atomic<std::uint64_t> m_nb_untracked;
+};
+
+} // namespace misc
+
+} // namespace netflex
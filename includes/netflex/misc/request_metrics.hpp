@@ -0,0 +1,134 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+#include <netflex/misc/latency_histogram.hpp>
+#include <netflex/misc/request_timing.hpp>
+
+namespace netflex {
+
+namespace misc {
+
+//!
+//! aggregate the timing breakdown of the requests processed by a server
+//! keep one latency histogram per phase (plus one for the total) and optionally trace slow requests
+//!
+class request_metrics {
+public:
+  //! ctor
+  request_metrics(void);
+  //! default dtor
+  ~request_metrics(void) = default;
+
+  //! copy ctor
+  request_metrics(const request_metrics&) = delete;
+  //! assignment operator
+  request_metrics& operator=(const request_metrics&) = delete;
+
+public:
+  //!
+  //! callback called for each request whose total duration exceeds the slow request threshold
+  //! takes as parameter the full timing breakdown of the request
+  //!
+  typedef std::function<void(const request_timing&)> slow_request_handler_t;
+
+  //!
+  //! enable slow requests tracing
+  //!
+  //! \param threshold total duration (in nanoseconds) above which a request is considered slow
+  //! \param handler callback to be called for each slow request
+  //!
+  void set_slow_request_handler(std::uint64_t threshold, const slow_request_handler_t& handler);
+
+  //!
+  //! \return whether slow requests tracing is enabled or not
+  //!
+  bool is_slow_request_tracing_enabled(void) const;
+
+  //!
+  //! \param timing timing breakdown of a request, possibly not fully processed yet
+  //! \return whether the request already exceeds the slow request threshold (false if tracing is disabled)
+  //!
+  bool is_slow_request(const request_timing& timing) const;
+
+public:
+  //!
+  //! record the timing breakdown of a fully processed request
+  //! can be called concurrently from multiple threads
+  //!
+  //! \param timing timing breakdown of the request
+  //!
+  void record(const request_timing& timing);
+
+  //!
+  //! reset all the histograms
+  //!
+  void reset(void);
+
+public:
+  //!
+  //! \param phase phase to retrieve
+  //! \return histogram of the durations (in nanoseconds) of the given phase
+  //!
+  const latency_histogram& get_histogram(request_phase phase) const;
+
+  //!
+  //! \return histogram of the total durations (in nanoseconds) of the requests
+  //!
+  const latency_histogram& get_total_histogram(void) const;
+
+private:
+  //!
+  //! histograms, indexed by request_phase
+  //!
+  latency_histogram m_histograms[nb_request_phases];
+
+  //!
+  //! histogram of total durations
+  //!
+  latency_histogram m_total_histogram;
+
+  //!
+  //! slow request threshold in nanoseconds (0 when tracing is disabled)
+  //!
+  std::atomic<std::uint64_t> m_slow_request_threshold;
+
+  //!
+  //! slow request callback
+  //!
+  slow_request_handler_t m_slow_request_handler;
+
+  //!
+  //! protect the slow request callback
+  //!
+  std::mutex m_slow_request_handler_mutex;
+};
+
+} // namespace misc
+
+} // namespace netflex
@@ -0,0 +1,137 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace netflex {
+
+namespace misc {
+
+//!
+//! phases of the processing of a request, in order of execution
+//!
+enum class request_phase {
+  //! time spent in the request parser
+  parse,
+  //! time spent in the middleware chain (including route lookup, excluding the route callback)
+  middleware,
+  //! time spent in the route callback
+  handler,
+  //! time spent converting the response into an http packet
+  serialize,
+  //! time spent waiting for the response to be written on the socket
+  write
+};
+
+//!
+//! number of phases in request_phase
+//!
+const std::size_t nb_request_phases = 5;
+
+//!
+//! per-phase timing breakdown of a single request
+//! durations are expressed in nanoseconds and measured with a monotonic clock
+//!
+class request_timing {
+public:
+  //! ctor
+  request_timing(void);
+  //! default dtor
+  ~request_timing(void) = default;
+
+  //! copy ctor
+  request_timing(const request_timing&) = default;
+  //! assignment operator
+  request_timing& operator=(const request_timing&) = default;
+
+public:
+  //!
+  //! \return current value of the monotonic clock, in nanoseconds
+  //!
+  static std::uint64_t now(void);
+
+public:
+  //!
+  //! add time spent in a given phase
+  //! can be called multiple times for the same phase (durations are accumulated)
+  //!
+  //! \param phase phase to update
+  //! \param duration duration to add, in nanoseconds
+  //!
+  void add(request_phase phase, std::uint64_t duration);
+
+  //!
+  //! \param phase phase to retrieve
+  //! \return time spent in the given phase, in nanoseconds
+  //!
+  std::uint64_t get(request_phase phase) const;
+
+  //!
+  //! \return time spent in all phases, in nanoseconds
+  //!
+  std::uint64_t get_total(void) const;
+
+public:
+  //!
+  //! \return description of the request (only set for requests already slow once processed, requests slowed down by the write only being traced without description)
+  //!
+  const std::string& get_description(void) const;
+
+  //!
+  //! set description of the request, used to identify traced slow requests
+  //!
+  //! \param description request description
+  //!
+  void set_description(const std::string& description);
+
+public:
+  //!
+  //! \return printable version of the timing breakdown (for logging purpose)
+  //!
+  std::string to_string(void) const;
+
+private:
+  //!
+  //! durations, indexed by request_phase
+  //!
+  std::uint64_t m_durations[nb_request_phases];
+
+  //!
+  //! request description
+  //!
+  std::string m_description;
+};
+
+//!
+//! convert a phase to a string
+//!
+//! \param phase phase to convert
+//! \return conversion
+//!
+const char* request_phase_to_string(request_phase phase);
+
+} // namespace misc
+
+} // namespace netflex
@@ -0,0 +1,151 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+namespace netflex {
+
+namespace misc {
+
+//!
+//! non-owning view over a sequence of chars (subset of C++17 std::string_view)
+//! viewed chars must outlive the view
+//!
+class string_view {
+public:
+  //! position returned by find on failure
+  static const std::size_t npos = static_cast<std::size_t>(-1);
+
+public:
+  //! default ctor (empty view)
+  string_view(void);
+
+  //!
+  //! ctor
+  //!
+  //! \param data first char of the view
+  //! \param size number of chars in the view
+  //!
+  string_view(const char* data, std::size_t size);
+
+  //!
+  //! ctor (implicit, so that string_view parameters can take strings)
+  //!
+  //! \param str nul-terminated string to view
+  //!
+  string_view(const char* str);
+
+  //!
+  //! ctor (implicit, so that string_view parameters can take strings)
+  //!
+  //! \param str string to view
+  //!
+  string_view(const std::string& str);
+
+  //! default dtor
+  ~string_view(void) = default;
+
+  //! copy ctor
+  string_view(const string_view&) = default;
+  //! assignment operator
+  string_view& operator=(const string_view&) = default;
+
+public:
+  //!
+  //! \return first char of the view
+  //!
+  const char* data(void) const;
+
+  //!
+  //! \return number of chars in the view
+  //!
+  std::size_t size(void) const;
+
+  //!
+  //! \return whether the view is empty
+  //!
+  bool empty(void) const;
+
+  //!
+  //! \return iterators over the chars of the view
+  //!
+  const char* begin(void) const;
+  const char* end(void) const;
+
+  //!
+  //! \param index index of the char to get, must be lower than size()
+  //! \return char at index
+  //!
+  char operator[](std::size_t index) const;
+
+public:
+  //!
+  //! \param pos first char of the subview, clamped to size()
+  //! \param count number of chars of the subview, clamped to the end of the view
+  //! \return subview
+  //!
+  string_view substr(std::size_t pos, std::size_t count = npos) const;
+
+  //!
+  //! \param c char to find
+  //! \param pos position to start the search at
+  //! \return position of the first occurrence of c at or after pos, npos if none
+  //!
+  std::size_t find(char c, std::size_t pos = 0) const;
+
+  //!
+  //! \return copy of the viewed chars
+  //!
+  std::string to_string(void) const;
+
+public:
+  //!
+  //! \return whether both views contain the same chars
+  //!
+  bool operator==(const string_view& rhs) const;
+  bool operator!=(const string_view& rhs) const;
+
+private:
+  //!
+  //! first char of the view
+  //!
+  const char* m_data;
+
+  //!
+  //! number of chars in the view
+  //!
+  std::size_t m_size;
+};
+
+//!
+//! output the viewed chars
+//!
+std::ostream& operator<<(std::ostream& os, const string_view& view);
+
+} // namespace misc
+
+} // namespace netflex
@@ -0,0 +1,93 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+
+namespace netflex {
+
+namespace parsing {
+
+//!
+//! different http packet parsing stages
+//! high level breakdown
+//!
+enum class parsing_stage {
+  start_line,
+  header_fields,
+  message_body
+};
+
+//!
+//! \param stage stage to convert
+//! \return printable version of the stage
+//!
+const char* parsing_stage_to_string(parsing_stage stage);
+
+//!
+//! description of a parsing failure
+//! reported by the request parser instead of raising an exception, so that malformed input stays cheap to reject
+//!
+struct parse_error {
+  //! default ctor (no error)
+  parse_error(void);
+
+  //!
+  //! ctor
+  //!
+  //! \param stage stage at which the parsing failed
+  //! \param offset offset of the invalid byte, relative to the beginning of the request
+  //! \param status http status code to answer with
+  //! \param reason static description of the failure
+  //!
+  parse_error(parsing_stage stage, std::size_t offset, unsigned int status, const char* reason);
+
+  //!
+  //! \return whether an error occurred
+  //!
+  explicit operator bool(void) const;
+
+  //!
+  //! stage at which the parsing failed
+  //!
+  parsing_stage stage;
+
+  //!
+  //! offset of the invalid byte, relative to the beginning of the request
+  //!
+  std::size_t offset;
+
+  //!
+  //! http status code to answer with (400, 413, 414, 431, 501), 0 if no error occurred
+  //!
+  unsigned int status;
+
+  //!
+  //! static description of the failure
+  //!
+  const char* reason;
+};
+
+} // namespace parsing
+
+} // namespace netflex
@@ -20,50 +20,49 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+
 #pragma once
 
-#include <netflex/parsing/parser_iface.hpp>
+#include <cstddef>
+#include <cstdint>
 
 namespace netflex {
 
 namespace parsing {
 
 //!
-//! parser for a gziped body
+//! size limits of the requests, enforced by the request parser as the data comes in
+//! exceeding a limit fails the parsing right away, before buffering the rest of the request
+//! each limit can be set to 0 to disable it
 //!
-class message_body_gzip_parser : public parser_iface {
-public:
-  //!
-  //! default ctor
+struct request_limits {
+  //! default ctor (default limits)
+  request_limits(void);
+
   //!
-  //! \param request request to be initialized
+  //! maximum size of the request-line (method, target and version), answered with 414 URI Too Long
   //!
-  explicit message_body_gzip_parser(http::request& request);
-
-  //! default dtor
-  ~message_body_gzip_parser(void) = default;
+  std::size_t max_request_line_size;
 
-  //! copy ctor
-  message_body_gzip_parser(const message_body_gzip_parser&) = delete;
-  //! assignment operator
-  message_body_gzip_parser& operator=(const message_body_gzip_parser&) = delete;
+  //!
+  //! maximum size of a header field (name and value), answered with 431 Request Header Fields Too Large
+  //!
+  std::size_t max_header_field_size;
 
-public:
   //!
-  //! consume input data to parse it and init the request
-  //! if not enough data is passed in, this method would need to be called again later
-  //! input data is modified whenever a token is consumed by parsing, even if parsing is incomplete or invalid
-  //! invalid data would lead to a raised exception
+  //! maximum number of header fields, answered with 431 Request Header Fields Too Large
+  //!
+  std::size_t max_nb_header_fields;
+
   //!
-  //! \param data input data to be parsed
-  //! \return reference to the current object
+  //! maximum size of all the header fields (names and values), answered with 431 Request Header Fields Too Large
   //!
-  parser_iface& operator<<(std::string& data);
+  std::size_t max_header_section_size;
 
   //!
-  //! \return whether the parsing is done or not
+  //! maximum size of the message body (Content-Length or sum of the chunks), answered with 413 Payload Too Large
   //!
-  bool is_done(void) const;
+  std::uint64_t max_body_size;
 };
 
 } // namespace parsing
@@ -22,13 +22,13 @@
 
 #pragma once
 
+#include <cstdint>
 #include <deque>
-#include <memory>
 #include <string>
 
 #include <netflex/http/request.hpp>
-#include <netflex/parsing/parser_iface.hpp>
-#include <netflex/parsing/parsers_factory.hpp>
+#include <netflex/parsing/parse_error.hpp>
+#include <netflex/parsing/request_limits.hpp>
 
 namespace netflex {
 
@@ -36,10 +36,10 @@ namespace parsing {
 
 //!
 //! request parser
-//! connect all parsers between each other and make sure the right order is followed
-//! can handle multiple requests
+//! single table-driven state machine covering the request-line, the header fields and the message body (content-length or chunked)
+//! parses the input in place, without buffering it, and reuses its internal buffers from one request to the next
+//! can handle multiple (pipelined) requests
 //!
-
 class request_parser {
 public:
   //! default ctor
@@ -55,12 +55,23 @@ public:
 public:
   //!
   //! add data to the parser. This data will be used for parsing.
+  //! invalid data stops the parsing and is reported through has_error and get_error, further data is ignored
+  //! requests fully parsed before the invalid data remain available
   //!
   //! \param data data to feed the parser
   //! \return reference to the current object
   //!
   request_parser& operator<<(const std::string& data);
 
+  //!
+  //! same as operator<<, for raw buffers
+  //!
+  //! \param data data to feed the parser
+  //! \param size number of bytes in data
+  //! \return reference to the current object
+  //!
+  request_parser& feed(const char* data, std::size_t size);
+
   //!
   //! same as get_front
   //!
@@ -88,34 +99,151 @@ public:
   //!
   bool request_available(void) const;
 
-private:
   //!
-  //! build request
+  //! \return whether the beginning of a request has been received, but not the whole request
+  //!
+  bool is_parsing_request(void) const;
+
+  //!
+  //! \return whether invalid data has been received
+  //!
+  bool has_error(void) const;
+
+  //!
+  //! \return description of the parsing failure, if any
+  //!
+  const parse_error& get_error(void) const;
+
+public:
+  //!
+  //! set the size limits of the requests, applied from the next parsed byte
+  //!
+  //! \param limits limits to be enforced
   //!
-  //! \return whether the request is fully built
+  void set_limits(const request_limits& limits);
+
+  //!
+  //! \return size limits of the requests
+  //!
+  const request_limits& get_limits(void) const;
+
+public:
   //!
-  bool build_request(void);
+  //! parsing states (defined along with the transition table)
+  //!
+  enum class state : unsigned char;
 
 private:
   //!
-  //! buffer
+  //! run the state machine over the input
+  //!
+  //! \param data data to parse
+  //! \param size number of bytes in data
   //!
-  std::string m_buffer;
+  void parse(const char* data, std::size_t size);
 
   //!
-  //! request currently being built
+  //! store the request-line information in the request
   //!
-  http::request m_current_request;
+  void on_request_line(void);
+
+  //!
+  //! store the header field in the request, keeping track of the message body framing headers
+  //!
+  void on_header_field(void);
+
+  //!
+  //! determine the message body framing once all header fields have been parsed
+  //!
+  //! \return next state
+  //!
+  state on_header_fields_end(void);
+
+  //!
+  //! make the current request available and prepare the parsing of the next one
+  //!
+  void on_request_end(void);
 
+  //!
+  //! fail the parsing if the request-line exceeds its limit
+  //!
+  void check_request_line_size(void);
+
+  //!
+  //! fail the parsing if the header field being parsed exceeds its limits
+  //!
+  void check_header_field_size(void);
+
+  //!
+  //! mark the parser as failed
+  //!
+  //! \param stage stage at which the parsing failed
+  //! \param status http status code to answer with
+  //! \param reason static description of the failure
+  //!
+  void fail(parsing_stage stage, unsigned int status, const char* reason);
+
+private:
   //!
   //! current parsing state
   //!
-  parsing_stage m_current_stage;
+  state m_state;
 
   //!
-  //! current parser
+  //! tokens of the request being parsed
+  //! cleared rather than released between requests, so that their storage is reused
+  //!
+  std::string m_method;
+  std::string m_target;
+  std::string m_http_version;
+  std::string m_field_name;
+  std::string m_field_value;
+  std::string m_body;
+
+  //!
+  //! size limits, and sizes of the header section parsed so far
+  //!
+  request_limits m_limits;
+  std::size_t m_nb_header_fields;
+  std::size_t m_header_section_size;
+
+  //!
+  //! message body framing
+  //!
+  bool m_has_content_length;
+  std::uint64_t m_content_length;
+  std::string m_transfer_encoding;
+
   //!
-  std::unique_ptr<parser_iface> m_current_parser;
+  //! remaining bytes of the message body (content-length) or of the current chunk (chunked)
+  //!
+  std::uint64_t m_remaining;
+
+  //!
+  //! number of digits of the chunk-size being parsed
+  //!
+  unsigned int m_chunk_size_digits;
+
+  //!
+  //! timestamp at which the parsing of the current request resumed
+  //!
+  std::uint64_t m_parse_start;
+
+  //!
+  //! position of the byte being parsed: offset of the current buffer relative to the beginning of the request, and index in the buffer
+  //!
+  std::int64_t m_buffer_offset;
+  std::size_t m_index;
+
+  //!
+  //! parsing failure
+  //!
+  parse_error m_error;
+
+  //!
+  //! request currently being built
+  //!
+  http::request m_current_request;
 
   //!
   //! parsed requests, ready for dequeing
@@ -0,0 +1,143 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace netflex {
+
+namespace parsing {
+
+namespace scanner {
+
+//!
+//! set of characters to look for
+//! contains at most 16 characters (fits in one SSE register)
+//!
+class char_set {
+public:
+  //!
+  //! ctor
+  //!
+  //! \param chars characters of the set (at most 16, NUL characters are ignored)
+  //!
+  explicit char_set(const std::string& chars);
+
+  //! default dtor
+  ~char_set(void) = default;
+
+  //! copy ctor
+  char_set(const char_set&) = default;
+  //! assignment operator
+  char_set& operator=(const char_set&) = default;
+
+public:
+  //!
+  //! \param c char to check
+  //! \return whether c belongs to the set
+  //!
+  bool contains(char c) const;
+
+  //!
+  //! \return characters of the set (padded with the first character up to 16 bytes)
+  //!
+  const char* get_chars(void) const;
+
+  //!
+  //! \return number of characters in the set
+  //!
+  std::size_t get_size(void) const;
+
+private:
+  //!
+  //! characters of the set, padded with the first character so that the whole array can be loaded at once
+  //!
+  char m_chars[16];
+
+  //!
+  //! number of characters of the set
+  //!
+  std::size_t m_size;
+
+  //!
+  //! lookup table for scalar scans
+  //!
+  bool m_table[256];
+};
+
+//!
+//! scanning implementations
+//!
+enum class implementation {
+  scalar,
+  sse4_2,
+  avx2
+};
+
+//!
+//! find the first character of the input range belonging to the set
+//!
+//! \param data beginning of the range
+//! \param size size of the range
+//! \param set characters to look for
+//! \return position of the first matching character, size if none matches
+//!
+std::size_t find_first_of(const char* data, std::size_t size, const char_set& set);
+
+//!
+//! find the first character of the input range not belonging to the set
+//!
+//! \param data beginning of the range
+//! \param size size of the range
+//! \param set characters to skip
+//! \return position of the first non matching character, size if all characters match
+//!
+std::size_t find_first_not_of(const char* data, std::size_t size, const char_set& set);
+
+//!
+//! \return implementation currently used by find_first_of and find_first_not_of
+//! by default, the fastest implementation supported by the cpu is selected at runtime
+//!
+implementation get_implementation(void);
+
+//!
+//! force the implementation used by find_first_of and find_first_not_of
+//! meant for tests and benchmarks: not thread-safe, must not be called while requests are being parsed
+//!
+//! \param impl implementation to use
+//! \return whether the implementation is supported by the cpu (the current implementation is left unchanged otherwise)
+//!
+bool set_implementation(implementation impl);
+
+//!
+//! \param impl implementation to check
+//! \return whether the implementation is supported by the cpu (and has been compiled in)
+//!
+bool is_supported(implementation impl);
+
+} // namespace scanner
+
+} // namespace parsing
+
+} // namespace netflex
@@ -22,8 +22,8 @@
 
 #pragma once
 
+#include <cstddef>
 #include <functional>
-#include <list>
 
 #include <netflex/http/request.hpp>
 #include <netflex/http/response.hpp>
@@ -35,6 +35,9 @@ namespace routing {
 //! middleware_chain forward declaration
 class middleware_chain;
 
+//! middleware_pipeline forward declaration
+class middleware_pipeline;
+
 //!
 //! middleware
 //! take middleware middleware_chain as parameter and should call .proceed() to go to next step
@@ -50,11 +53,11 @@ public:
   //!
   //! ctor
   //!
-  //! \param middlewares middlewares to be managed by the middleware chain. middleware should be ordered from lowest level (first executed) to highest level (last to be executed)
+  //! \param pipeline middlewares to be managed by the middleware chain, not copied: must outlive the chain
   //! \param request request to be passed as parameter to each middleware
   //! \param response response to be passed as parameter to each middleware
   //!
-  middleware_chain(const std::list<middleware_t>& middlewares, http::request& request, http::response& response);
+  middleware_chain(const middleware_pipeline& pipeline, http::request& request, http::response& response);
 
   //! default dtor
   ~middleware_chain(void) = default;
@@ -74,7 +77,7 @@ private:
   //!
   //! middlewares
   //!
-  std::list<middleware_t> m_middlewares;
+  const middleware_pipeline& m_pipeline;
 
   //!
   //! request to propagate
@@ -87,9 +90,9 @@ private:
   http::response& m_response;
 
   //!
-  //! current middleware to execute
+  //! index of the next middleware to execute
   //!
-  std::list<middleware_t>::iterator m_current_middleware;
+  std::size_t m_current_middleware;
 };
 
 } // namespace routing
@@ -22,50 +22,59 @@
 
 #pragma once
 
-#include <netflex/parsing/parser_iface.hpp>
+#include <cstddef>
+#include <list>
+#include <vector>
+
+#include <netflex/routing/middleware_chain.hpp>
 
 namespace netflex {
 
-namespace parsing {
+namespace routing {
 
 //!
-//! parser for a chuncked body
+//! immutable, contiguous sequence of middlewares
+//! built once (when the server starts) and shared by reference by all the middleware chains, so that running a request does not copy the middlewares
 //!
-class message_body_chuncked_parser : public parser_iface {
+class middleware_pipeline {
 public:
+  //! default ctor (empty pipeline)
+  middleware_pipeline(void) = default;
+
   //!
-  //! default ctor
+  //! ctor
   //!
-  //! \param request request to be initialized
+  //! \param middlewares middlewares ordered from lowest level (first executed) to highest level (last to be executed)
   //!
-  explicit message_body_chuncked_parser(http::request& request);
+  explicit middleware_pipeline(const std::list<middleware_t>& middlewares);
 
   //! default dtor
-  ~message_body_chuncked_parser(void) = default;
+  ~middleware_pipeline(void) = default;
 
   //! copy ctor
-  message_body_chuncked_parser(const message_body_chuncked_parser&) = delete;
+  middleware_pipeline(const middleware_pipeline&) = default;
   //! assignment operator
-  message_body_chuncked_parser& operator=(const message_body_chuncked_parser&) = delete;
+  middleware_pipeline& operator=(const middleware_pipeline&) = default;
 
 public:
   //!
-  //! consume input data to parse it and init the request
-  //! if not enough data is passed in, this method would need to be called again later
-  //! input data is modified whenever a token is consumed by parsing, even if parsing is incomplete or invalid
-  //! invalid data would lead to a raised exception
+  //! \return number of middlewares in the pipeline
+  //!
+  std::size_t size(void) const;
+
   //!
-  //! \param data input data to be parsed
-  //! \return reference to the current object
+  //! \param index position of the middleware in the pipeline (must be lower than size())
+  //! \return middleware at the given position
   //!
-  parser_iface& operator<<(std::string& data);
+  const middleware_t& operator[](std::size_t index) const;
 
+private:
   //!
-  //! \return whether the parsing is done or not
+  //! middlewares
   //!
-  bool is_done(void) const;
+  std::vector<middleware_t> m_middlewares;
 };
 
-} // namespace parsing
+} // namespace routing
 
 } // namespace netflex
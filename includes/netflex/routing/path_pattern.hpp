@@ -0,0 +1,181 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <netflex/misc/string_view.hpp>
+
+namespace netflex {
+
+namespace routing {
+
+//!
+//! type of a path param, declared in the route path as :name<type>
+//!
+enum class param_type {
+  //! :name or :name<str>, matches [a-zA-Z0-9_-]+
+  str,
+  //! :name<u64>, matches an unsigned 64 bits integer
+  u64,
+  //! :name<i64>, matches a signed 64 bits integer
+  i64
+};
+
+//!
+//! convert param_type to string
+//!
+//! \param type type to convert
+//! \return type as written in route paths (u64, i64, str)
+//!
+const char* param_type_to_string(param_type type);
+
+//!
+//! value of a path param, parsed and validated during matching
+//!
+struct path_param {
+  //! type of the param
+  param_type type;
+
+  //! raw value, view over the request target
+  misc::string_view str;
+
+  //! parsed value (u64)
+  std::uint64_t u64;
+
+  //! parsed value (i64)
+  std::int64_t i64;
+};
+
+//!
+//! path params, in order of appearance in the path
+//!
+typedef std::vector<path_param> path_params_t;
+
+//!
+//! route path compiled into a sequence of literals and typed params (for example /users/:id<u64>/posts/:post<u64>)
+//! matching is a single pass over the requested path, without regex nor allocation (except for the params storage)
+//! as for route_matcher, query string, fragment and trailing slash of the requested path are ignored
+//!
+class path_pattern {
+public:
+  //!
+  //! ctor
+  //! throws netflex_error if the path declares an unknown param type
+  //!
+  //! \param path path of the route
+  //!
+  explicit path_pattern(const std::string& path);
+
+  //! default dtor
+  ~path_pattern(void) = default;
+
+  //! copy ctor
+  path_pattern(const path_pattern&) = default;
+  //! assignment operator
+  path_pattern& operator=(const path_pattern&) = default;
+
+public:
+  //!
+  //! match the given target with the pattern
+  //!
+  //! \param target requested target
+  //! \param params place where to store the params values (cleared first), views over target
+  //! \return whether the target matched or not
+  //!
+  bool match(const misc::string_view& target, path_params_t& params) const;
+
+public:
+  //!
+  //! \return path the pattern was compiled from
+  //!
+  const std::string& get_path(void) const;
+
+  //!
+  //! \return names of the params, in order of appearance
+  //!
+  const std::vector<std::string>& get_param_names(void) const;
+
+  //!
+  //! \return types of the params, in order of appearance
+  //!
+  const std::vector<param_type>& get_param_types(void) const;
+
+private:
+  //!
+  //! compile the path into elements
+  //!
+  void compile(void);
+
+  //!
+  //! match a param value at the beginning of value
+  //!
+  //! \param type expected type
+  //! \param value remaining part of the requested path
+  //! \param param param to fill
+  //! \return whether a valid value was found
+  //!
+  static bool match_param(param_type type, const misc::string_view& value, path_param& param);
+
+private:
+  //!
+  //! element of a compiled path: literal or param
+  //!
+  struct element {
+    //! whether the element is a param
+    bool is_param;
+
+    //! literal to match (literal element)
+    std::string literal;
+
+    //! type of the param (param element)
+    param_type type;
+  };
+
+  //!
+  //! path the pattern was compiled from
+  //!
+  std::string m_path;
+
+  //!
+  //! compiled path
+  //!
+  std::vector<element> m_elements;
+
+  //!
+  //! names of the params, in order of appearance
+  //!
+  std::vector<std::string> m_param_names;
+
+  //!
+  //! types of the params, in order of appearance
+  //!
+  std::vector<param_type> m_param_types;
+};
+
+} // namespace routing
+
+} // namespace netflex
@@ -0,0 +1,158 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <netflex/misc/string_view.hpp>
+
+namespace netflex {
+
+namespace routing {
+
+//!
+//! query string of a request target (for example a=1&b=2 in /path?a=1&b=2#anchor)
+//! parsing is lazy: nothing is done until a param is looked up, and lookups scan the raw query string without allocating
+//! keys and values are percent-decoded ('+' being a space) on demand
+//! a query is a view over the request target: it must not outlive the request it comes from
+//!
+class query {
+public:
+  //! default ctor (empty query)
+  query(void) = default;
+
+  //!
+  //! ctor
+  //!
+  //! \param raw raw query string, without the leading '?' and the trailing #fragment
+  //!
+  explicit query(const misc::string_view& raw);
+
+  //! default dtor
+  ~query(void) = default;
+
+  //! copy ctor
+  query(const query&) = default;
+  //! assignment operator
+  query& operator=(const query&) = default;
+
+public:
+  //!
+  //! build the query of a request target
+  //!
+  //! \param target request target
+  //! \return query of target, empty if target has no query string
+  //!
+  static query from_target(const misc::string_view& target);
+
+public:
+  //!
+  //! \return raw query string
+  //!
+  const misc::string_view& get_raw(void) const;
+
+  //!
+  //! \return whether the query string has no param
+  //!
+  bool empty(void) const;
+
+  //!
+  //! \return number of params, including repeated keys
+  //!
+  std::size_t size(void) const;
+
+public:
+  //!
+  //! \param key decoded key to look for
+  //! \return whether a param with this key exists
+  //!
+  bool has(const misc::string_view& key) const;
+
+  //!
+  //! \param key decoded key to look for
+  //! \return number of params with this key
+  //!
+  std::size_t count(const misc::string_view& key) const;
+
+  //!
+  //! \param key decoded key to look for
+  //! \return raw (still encoded) value of the first param with this key, empty if none
+  //!
+  misc::string_view get_raw_value(const misc::string_view& key) const;
+
+  //!
+  //! \param key decoded key to look for
+  //! \param default_value value to return if no param has this key
+  //! \return decoded value of the first param with this key
+  //!
+  std::string get(const misc::string_view& key, const std::string& default_value = "") const;
+
+  //!
+  //! \param key decoded key to look for
+  //! \return decoded values of all the params with this key, in order of appearance
+  //!
+  std::vector<std::string> get_all(const misc::string_view& key) const;
+
+public:
+  //!
+  //! percent-decode a query string component, '+' being decoded as a space
+  //! invalid escape sequences are kept as is
+  //!
+  //! \param component component to decode
+  //! \return decoded component
+  //!
+  static std::string decode(const misc::string_view& component);
+
+private:
+  //!
+  //! get the next param of the query string
+  //! empty params (&&) are skipped, params without '=' have an empty value
+  //!
+  //! \param pos position to start at, updated to the position of the following param
+  //! \param key raw key of the param
+  //! \param value raw value of the param
+  //! \return whether a param was found
+  //!
+  bool next_param(std::size_t& pos, misc::string_view& key, misc::string_view& value) const;
+
+  //!
+  //! compare a raw key with a decoded key, decoding on the fly
+  //!
+  //! \param raw_key key as found in the query string
+  //! \param key decoded key
+  //! \return whether raw_key decodes to key
+  //!
+  static bool key_equals(const misc::string_view& raw_key, const misc::string_view& key);
+
+private:
+  //!
+  //! raw query string
+  //!
+  misc::string_view m_raw;
+};
+
+} // namespace routing
+
+} // namespace netflex
@@ -23,11 +23,13 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 #include <string>
 
 #include <netflex/http/method.hpp>
 #include <netflex/http/request.hpp>
 #include <netflex/http/response.hpp>
+#include <netflex/routing/path_pattern.hpp>
 #include <netflex/routing/route_matcher.hpp>
 
 namespace netflex {
@@ -38,6 +40,7 @@ namespace routing {
 //! define a route for the server
 //! specify path, method and callback to be called
 //! path can be regex and contains params (like /articles/:id)
+//! routes built from a path_pattern match typed params (like /articles/:id<u64>) without regex, see typed_route.hpp
 //!
 class route {
 public:
@@ -57,6 +60,16 @@ public:
   //!
   route(http::method m, const std::string& path, const route_callback_t& callback);
 
+  //!
+  //! ctor for routes with typed params
+  //! matched params are stored in the request path params (http::request::get_path_params()), not in its params
+  //!
+  //! \param m HTTP verb of the route
+  //! \param pattern compiled path of the route
+  //! \param callback callback to be called on dispatch in case of match
+  //!
+  route(http::method m, const path_pattern& pattern, const route_callback_t& callback);
+
   //! default dtor
   ~route(void) = default;
 
@@ -73,6 +86,28 @@ public:
   //!
   bool match(http::request& request) const;
 
+public:
+  //!
+  //! \return http method of the route
+  //!
+  http::method get_method(void) const;
+
+  //!
+  //! \return path of the route
+  //!
+  const std::string& get_path(void) const;
+
+  //!
+  //! \return callback called on dispatch
+  //!
+  const route_callback_t& get_callback(void) const;
+
+  //!
+  //! \param path new path
+  //! \return copy of the route with another path, matched the same way (typed params or not)
+  //!
+  route with_path(const std::string& path) const;
+
 public:
   //!
   //! dispatch the request (and the response) to the pre-defined route callback
@@ -99,9 +134,15 @@ private:
   route_callback_t m_callback;
 
   //!
-  //! used to match a route with a requested path
+  //! used to match a route with a requested path (untyped routes)
+  //! shared between the copies of the route, as regex are costly to copy
+  //!
+  std::shared_ptr<const route_matcher> m_matcher;
+
+  //!
+  //! used to match a route with a requested path (typed routes)
   //!
-  route_matcher m_matcher;
+  std::shared_ptr<const path_pattern> m_pattern;
 };
 
 } // namespace routing
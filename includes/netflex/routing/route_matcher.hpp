@@ -56,10 +56,11 @@ public:
 public:
   //!
   //! match the given path with the underlying route
+  //! the query string and the fragment of the path are ignored (query string params are available through http::request::get_query())
   //!
   //! \param path path to match
   //! \param params place where to store params of the requested path (for example /articles/1?author=simon) will
-  //!        store {article:1, author: simon} for underlying route /articles/:id.
+  //!        store {id: 1} for underlying route /articles/:id.
   //!        store nothing if mismatch
   //! \return whether the path matched or not
   //!
@@ -74,15 +75,6 @@ protected:
   //!
   void build_match_regex(const std::string& path);
 
-  //!
-  //! match GET request params given a requested path
-  //!
-  //! \param path path to match
-  //! \param params place where to store params of the requested path (for example /articles/1?author=simon) will
-  //!        store {author: simon}.
-  //!
-  void match_get_params(const std::string& path, params_t& params) const;
-
 protected:
   //!
   //! matching regex (string object)
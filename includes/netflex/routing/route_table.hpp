@@ -0,0 +1,186 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <netflex/http/method.hpp>
+#include <netflex/http/static_response.hpp>
+#include <netflex/routing/middleware_pipeline.hpp>
+
+namespace netflex {
+
+namespace routing {
+
+//!
+//! frozen routing configuration of a server: one middleware pipeline per mount point
+//! each pipeline ends with the dispatch to the routes of its mount point
+//! a request is resolved to a single pipeline, by longest prefix match on its target
+//! virtual hosts have their own route table, selected by the Host header of the request before matching the target
+//! static responses are looked up first, by exact path, and bypass the pipelines
+//!
+class route_table {
+public:
+  //! default ctor (empty table)
+  route_table(void) = default;
+  //! default dtor
+  ~route_table(void) = default;
+
+  //! copy ctor
+  route_table(const route_table&) = default;
+  //! assignment operator
+  route_table& operator=(const route_table&) = default;
+
+  //! move ctor
+  route_table(route_table&&) = default;
+  //! move assignment operator
+  route_table& operator=(route_table&&) = default;
+
+public:
+  //!
+  //! add a mount point
+  //! trailing slashes of the prefix are ignored, an empty prefix (or "/") matches all the targets
+  //! mount points added first win over the ones with the same prefix added later
+  //!
+  //! \param prefix path prefix of the mount point
+  //! \param pipeline middlewares to run for the targets under prefix
+  //!
+  void add(const std::string& prefix, const middleware_pipeline& pipeline);
+
+  //!
+  //! find the mount point with the longest prefix matching the target
+  //! a prefix matches a target if it is followed in it by the end of the path ('/', '?', '#' or end of target)
+  //!
+  //! \param target request target
+  //! \return pipeline of the matching mount point, nullptr if none matches
+  //!
+  const middleware_pipeline* resolve(const std::string& target) const;
+
+  //!
+  //! \return number of mount points
+  //!
+  std::size_t size(void) const;
+
+public:
+  //!
+  //! add a static response
+  //! static responses added first win over the ones with the same method and path added later
+  //!
+  //! \param m method of the requests to answer, GET responses also answer HEAD requests
+  //! \param path exact path of the requests to answer, query string ignored
+  //! \param response preserialized response, shared by copies of the table
+  //!
+  void add_static_response(http::method m, const std::string& path, const std::shared_ptr<const http::static_response>& response);
+
+  //!
+  //! find the static response of a request
+  //!
+  //! \param m method of the request
+  //! \param target request target
+  //! \return static response, nullptr if none matches
+  //!
+  const http::static_response* resolve_static_response(http::method m, const std::string& target) const;
+
+public:
+  //!
+  //! add a virtual host
+  //! host is either exact (api.example.com) or a wildcard on subdomains (*.example.com, which does not match example.com itself)
+  //! virtual hosts added first win over the ones with the same host added later
+  //!
+  //! \param host host of the virtual host, case insensitive, port ignored
+  //! \param table route table of the virtual host
+  //!
+  void add_host(const std::string& host, const route_table& table);
+
+  //!
+  //! find the route table of the given host
+  //! exact hosts win over wildcards, and longest wildcards win over shorter ones
+  //! lookup is done with a hash lookup per label of the host, regardless of the number of virtual hosts and of their routes
+  //!
+  //! \param host value of the Host header
+  //! \return route table of the matching virtual host, current table if none matches
+  //!
+  const route_table& resolve_host(const std::string& host) const;
+
+  //!
+  //! \return number of virtual hosts
+  //!
+  std::size_t get_nb_hosts(void) const;
+
+  //!
+  //! normalize a host (lowercase, without port nor trailing dot)
+  //!
+  //! \param host host to normalize
+  //! \return normalized host
+  //!
+  static std::string normalize_host(const std::string& host);
+
+  //!
+  //! normalize a prefix (remove trailing slashes)
+  //!
+  //! \param prefix prefix to normalize
+  //! \return normalized prefix
+  //!
+  static std::string normalize_prefix(const std::string& prefix);
+
+private:
+  //!
+  //! mount point
+  //!
+  struct mount_point {
+    //! normalized prefix
+    std::string prefix;
+
+    //! middlewares, ending with the dispatch
+    middleware_pipeline pipeline;
+  };
+
+  //!
+  //! mount points, sorted by decreasing prefix length
+  //!
+  std::vector<mount_point> m_mount_points;
+
+  //!
+  //! static responses, by path
+  //!
+  std::unordered_map<std::string, std::vector<std::pair<http::method, std::shared_ptr<const http::static_response>>>> m_static_responses;
+
+  //!
+  //! exact virtual hosts, by normalized host
+  //! tables are immutable once added, so copies of the route table share them
+  //!
+  std::unordered_map<std::string, std::shared_ptr<const route_table>> m_hosts;
+
+  //!
+  //! wildcard virtual hosts, by normalized suffix (.example.com for *.example.com)
+  //!
+  std::unordered_map<std::string, std::shared_ptr<const route_table>> m_wildcard_hosts;
+};
+
+} // namespace routing
+
+} // namespace netflex
@@ -0,0 +1,188 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include <netflex/routing/route_table.hpp>
+
+namespace netflex {
+
+namespace routing {
+
+//!
+//! publish immutable route table snapshots, swapped atomically while requests are being dispatched (RCU)
+//!
+//! readers enter a read-side section (reader object) that pins the current snapshot: entering and leaving are wait-free (a few atomic operations, no lock)
+//! writers publish a new snapshot with a single atomic exchange, then reclaim the previous ones once all the readers that could still see them are gone
+//! readers are counted in one of two epoch counters: reclaiming steers new readers to one counter while waiting for the other one to drain, and does so for both counters
+//! snapshots retired from a read-side section (route handler updating the routes) are reclaimed without waiting once that section is left
+//!
+class route_table_publisher {
+public:
+  //!
+  //! read-side section
+  //! the snapshot read on construction remains valid until destruction, even if a new one is published meanwhile
+  //! reader objects must not be shared between threads
+  //!
+  class reader {
+  public:
+    //!
+    //! ctor: enter the read-side section
+    //!
+    //! \param publisher publisher to read the current snapshot from
+    //!
+    explicit reader(const route_table_publisher& publisher);
+
+    //! dtor: leave the read-side section
+    ~reader(void);
+
+    //! copy ctor
+    reader(const reader&) = delete;
+    //! assignment operator
+    reader& operator=(const reader&) = delete;
+
+  public:
+    //!
+    //! \return pinned snapshot
+    //!
+    const route_table& operator*(void) const;
+    const route_table* operator->(void) const;
+
+  private:
+    //!
+    //! publisher the snapshot comes from
+    //!
+    const route_table_publisher& m_publisher;
+
+    //!
+    //! epoch counter incremented on construction
+    //!
+    unsigned int m_epoch;
+
+    //!
+    //! pinned snapshot
+    //!
+    const route_table* m_table;
+  };
+
+public:
+  //! ctor (publish an empty table)
+  route_table_publisher(void);
+  //! dtor (no reader must remain)
+  ~route_table_publisher(void);
+
+  //! copy ctor
+  route_table_publisher(const route_table_publisher&) = delete;
+  //! assignment operator
+  route_table_publisher& operator=(const route_table_publisher&) = delete;
+
+public:
+  //!
+  //! publish a new snapshot, visible to the readers created from now on
+  //! never blocks: the previous snapshot is retired, to be deleted by reclaim()
+  //!
+  //! \param table new snapshot
+  //!
+  void publish(route_table table);
+
+  //!
+  //! delete the retired snapshots, waiting for the readers that could still use them
+  //! does nothing when called from a read-side section (for example from a route handler): the snapshots are reclaimed once the readers leave their outermost section
+  //!
+  void reclaim(void);
+
+  //!
+  //! \return number of retired snapshots not reclaimed yet
+  //!
+  std::size_t get_nb_retired(void) const;
+
+private:
+  //!
+  //! wait until all the readers that were in a read-side section when this function was called have left it
+  //!
+  void synchronize(void);
+
+  //!
+  //! delete the retired snapshots if all the readers that could still use them are known to be gone, without waiting
+  //! called by the readers leaving their outermost read-side section while snapshots are retired, the readers still present being checked again by the next ones
+  //!
+  void try_reclaim(void) const;
+
+private:
+  //!
+  //! reader counter, alone on its cache line so that both counters do not contend
+  //!
+  struct alignas(64) reader_counter {
+    std::atomic<std::size_t> value;
+  };
+
+  //!
+  //! current snapshot
+  //!
+  std::atomic<const route_table*> m_current;
+
+  //!
+  //! epoch counter new readers register into
+  //!
+  mutable std::atomic<unsigned int> m_epoch;
+
+  //!
+  //! number of readers in a read-side section, per epoch
+  //!
+  mutable reader_counter m_readers[2];
+
+  //!
+  //! snapshots replaced but possibly still used by readers
+  //!
+  mutable std::vector<const route_table*> m_retired;
+
+  //!
+  //! protect m_retired
+  //!
+  mutable std::mutex m_retired_mutex;
+
+  //!
+  //! snapshots taken from m_retired by try_reclaim, and the epoch counters observed drained since they were taken
+  //!
+  mutable std::vector<const route_table*> m_reclaiming;
+  mutable bool m_drained[2];
+
+  //!
+  //! protect m_reclaiming and m_drained, only one thread reclaiming at a time
+  //!
+  mutable std::mutex m_reclaim_mutex;
+
+  //!
+  //! number of retired snapshots not deleted yet, checked by the readers leaving their read-side section
+  //!
+  mutable std::atomic<std::size_t> m_nb_retired;
+};
+
+} // namespace routing
+
+} // namespace netflex
@@ -0,0 +1,112 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <list>
+#include <vector>
+
+#include <netflex/routing/middleware_chain.hpp>
+#include <netflex/routing/route.hpp>
+
+namespace netflex {
+
+namespace routing {
+
+//!
+//! group of routes sharing their own middlewares
+//! meant to be mounted on a server at a path prefix: its middlewares only run for the requests targeting that prefix
+//!
+class router {
+public:
+  //! default ctor
+  router(void) = default;
+  //! default dtor
+  ~router(void) = default;
+
+  //! copy ctor
+  router(const router&) = default;
+  //! assignment operator
+  router& operator=(const router&) = default;
+
+public:
+  //!
+  //! add route to the router
+  //! route path is relative to the prefix the router is mounted at
+  //!
+  //! \param route route to be added
+  //! \return reference to the current object
+  //!
+  router& add_route(const route& route);
+
+  //!
+  //! add multiple routes to the router
+  //!
+  //! \param routes routes to be added
+  //! \return reference to the current object
+  //!
+  router& add_routes(const std::vector<route>& routes);
+
+  //!
+  //! add middleware to the router
+  //! added middleware is added at the highest level (on top of all the previously added middleware)
+  //!
+  //! \param middleware middleware to be added
+  //! \return reference to the current object
+  //!
+  router& add_middleware(const middleware_t& middleware);
+
+  //!
+  //! add multiple middlewares to the router
+  //! middleares should be ranged from the lowest to the highest level
+  //!
+  //! \param middlewares middlewares to be added
+  //! \return reference to the current object
+  //!
+  router& add_middlewares(const std::list<middleware_t>& middlewares);
+
+public:
+  //!
+  //! \return routes of the router
+  //!
+  const std::vector<route>& get_routes(void) const;
+
+  //!
+  //! \return middlewares of the router, from the lowest to the highest level
+  //!
+  const std::list<middleware_t>& get_middlewares(void) const;
+
+private:
+  //!
+  //! routes
+  //!
+  std::vector<route> m_routes;
+
+  //!
+  //! middlewares
+  //!
+  std::list<middleware_t> m_middlewares;
+};
+
+} // namespace routing
+
+} // namespace netflex
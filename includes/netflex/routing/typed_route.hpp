@@ -0,0 +1,187 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <netflex/http/method.hpp>
+#include <netflex/http/request.hpp>
+#include <netflex/http/response.hpp>
+#include <netflex/misc/error.hpp>
+#include <netflex/misc/string_view.hpp>
+#include <netflex/routing/path_pattern.hpp>
+#include <netflex/routing/route.hpp>
+
+namespace netflex {
+
+namespace routing {
+
+//!
+//! mapping between handler argument types and path param types
+//! u64 params are passed as std::uint64_t, i64 params as std::int64_t, str params as misc::string_view or std::string
+//!
+template <typename T>
+struct path_param_traits;
+
+template <>
+struct path_param_traits<std::uint64_t> {
+  static param_type type(void) { return param_type::u64; }
+  static std::uint64_t get(const path_param& param) { return param.u64; }
+};
+
+template <>
+struct path_param_traits<std::int64_t> {
+  static param_type type(void) { return param_type::i64; }
+  static std::int64_t get(const path_param& param) { return param.i64; }
+};
+
+template <>
+struct path_param_traits<misc::string_view> {
+  static param_type type(void) { return param_type::str; }
+  static misc::string_view get(const path_param& param) { return param.str; }
+};
+
+template <>
+struct path_param_traits<std::string> {
+  static param_type type(void) { return param_type::str; }
+  static std::string get(const path_param& param) { return param.str.to_string(); }
+};
+
+//!
+//! compile-time sequence of indexes (C++11 replacement for std::index_sequence)
+//!
+template <std::size_t... Indexes>
+struct index_sequence {};
+
+template <std::size_t N, std::size_t... Indexes>
+struct make_index_sequence : make_index_sequence<N - 1, N - 1, Indexes...> {};
+
+template <std::size_t... Indexes>
+struct make_index_sequence<0, Indexes...> {
+  typedef index_sequence<Indexes...> type;
+};
+
+//!
+//! route callback wrapper passing typed path params to the handler as arguments
+//! params are read by index from the request path params: no lookup, no parsing (done during matching)
+//!
+template <typename... Args>
+class typed_route_callback {
+public:
+  //!
+  //! handler of a typed route
+  //!
+  typedef std::function<void(const http::request&, http::response&, Args...)> handler_t;
+
+public:
+  //!
+  //! ctor
+  //!
+  //! \param handler handler to call on dispatch
+  //!
+  explicit typed_route_callback(const handler_t& handler);
+
+public:
+  //!
+  //! call the handler with the typed params of the request
+  //!
+  //! \param request matched request
+  //! \param response response to be sent
+  //!
+  void operator()(const http::request& request, http::response& response) const;
+
+private:
+  //!
+  //! unpack the params as handler arguments
+  //!
+  template <std::size_t... Indexes>
+  void call(const http::request& request, http::response& response, index_sequence<Indexes...>) const;
+
+private:
+  //!
+  //! handler to call on dispatch
+  //!
+  handler_t m_handler;
+};
+
+//!
+//! build a route with typed params
+//! for example make_route<std::uint64_t, std::uint64_t>(GET, "/users/:id<u64>/posts/:post<u64>", handler) with handler(request, response, id, post)
+//! throws netflex_error if Args does not match the params declared in the path
+//!
+//! \param m HTTP verb of the route
+//! \param path path of the route, with typed params
+//! \param handler handler taking the request, the response and the path params
+//! \return route
+//!
+template <typename... Args, typename Handler>
+route make_route(http::method m, const std::string& path, const Handler& handler);
+
+
+//!
+//! typed_route_callback
+//!
+template <typename... Args>
+typed_route_callback<Args...>::typed_route_callback(const handler_t& handler)
+: m_handler(handler) {}
+
+template <typename... Args>
+void
+typed_route_callback<Args...>::operator()(const http::request& request, http::response& response) const {
+  call(request, response, typename make_index_sequence<sizeof...(Args)>::type());
+}
+
+template <typename... Args>
+template <std::size_t... Indexes>
+void
+typed_route_callback<Args...>::call(const http::request& request, http::response& response, index_sequence<Indexes...>) const {
+  const path_params_t& params = request.get_path_params();
+  (void) params;
+
+  m_handler(request, response, path_param_traits<Args>::get(params[Indexes])...);
+}
+
+
+//!
+//! make_route
+//!
+template <typename... Args, typename Handler>
+route
+make_route(http::method m, const std::string& path, const Handler& handler) {
+  path_pattern pattern(path);
+  std::vector<param_type> expected_types = {path_param_traits<Args>::type()...};
+
+  if (pattern.get_param_types() != expected_types)
+    __NETFLEX_THROW(error, "handler arguments do not match the params of route path " + path);
+
+  return route(m, pattern, typed_route_callback<Args...>(handler));
+}
+
+} // namespace routing
+
+} // namespace netflex
@@ -0,0 +1,162 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace netflex {
+
+namespace transport {
+
+//!
+//! result of an async read
+//!
+struct read_result {
+  //!
+  //! whether the read succeeded (false if the connection has been closed)
+  //!
+  bool success;
+
+  //!
+  //! bytes read, owned by the connection and only valid until the callback returns
+  //! backends can hand out their own buffers (kernel-filled buffers for io_uring) without copying them
+  //!
+  const char* data;
+
+  //!
+  //! number of bytes read
+  //!
+  std::size_t size;
+};
+
+//!
+//! result of an async write
+//!
+struct write_result {
+  //!
+  //! whether the write succeeded
+  //!
+  bool success;
+
+  //!
+  //! number of bytes written
+  //!
+  std::size_t size;
+};
+
+//!
+//! connection to a remote peer, as seen by the http layer
+//! implemented by each I/O backend (see transport::listener)
+//! completion callbacks are called from the I/O threads of the backend
+//!
+class connection {
+public:
+  //! default dtor
+  virtual ~connection(void) = default;
+
+public:
+  //!
+  //! called on async read completion
+  //!
+  typedef std::function<void(read_result&)> read_callback_t;
+
+  //!
+  //! called on async write completion
+  //!
+  typedef std::function<void(write_result&)> write_callback_t;
+
+  //!
+  //! called once the connection has been closed by the peer or because of an error
+  //!
+  typedef std::function<void(void)> disconnection_handler_t;
+
+public:
+  //!
+  //! \return host of the peer
+  //!
+  virtual const std::string& get_host(void) const = 0;
+
+  //!
+  //! \return port of the peer
+  //!
+  virtual std::uint32_t get_port(void) const = 0;
+
+  //!
+  //! \return whether the connection is still open
+  //!
+  virtual bool is_connected(void) const = 0;
+
+public:
+  //!
+  //! read at most size bytes, the callback being called once some bytes are available
+  //! only one read can be pending at a time
+  //! on failure, the callback is called with an unsuccessful result, then the disconnection handler
+  //!
+  //! \param size maximum number of bytes to read
+  //! \param callback callback called on completion
+  //!
+  virtual void async_read(std::size_t size, const read_callback_t& callback) = 0;
+
+  //!
+  //! write the whole buffer, after the previously requested writes
+  //! the buffer is given back to misc::buffer_pool once written
+  //!
+  //! \param buffer bytes to write
+  //! \param callback callback called on completion, can be nullptr
+  //!
+  virtual void async_write(std::vector<char>&& buffer, const write_callback_t& callback) = 0;
+
+  //!
+  //! write a head followed by a large body, after the previously requested writes
+  //! backends able to send the body without copying it (MSG_ZEROCOPY) keep a reference to it until the kernel is done with it
+  //! by default, the body is copied after the head and written by async_write
+  //!
+  //! \param head bytes to write first, given back to misc::buffer_pool once written
+  //! \param body bytes to write next, not modified until released
+  //! \param callback callback called on completion, can be nullptr (the size of the result includes both head and body)
+  //!
+  virtual void async_write_zerocopy(std::vector<char>&& head, const std::shared_ptr<const std::string>& body, const write_callback_t& callback);
+
+  //!
+  //! define the callback to be called once the connection has been closed by the peer or because of an error
+  //!
+  //! \param handler callback to be called
+  //!
+  virtual void set_disconnection_handler(const disconnection_handler_t& handler) = 0;
+
+  //!
+  //! close the connection
+  //! pending reads and writes are dropped, and the disconnection handler is not called
+  //!
+  virtual void disconnect(void) = 0;
+};
+
+} // namespace transport
+
+} // namespace netflex
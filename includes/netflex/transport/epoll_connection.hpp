@@ -0,0 +1,360 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#ifdef __linux__
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sys/types.h>
+
+#include <netflex/transport/connection.hpp>
+
+struct ssl_st;
+
+namespace netflex {
+
+namespace transport {
+
+class epoll_loop;
+class tls_context;
+
+//!
+//! connection of the epoll backend
+//! readiness is notified once per change (edge-triggered): the connection remembers whether its socket is readable and writable, until a read or write would block
+//! reads and writes are done by the loop thread, writes being first attempted in place
+//! callbacks are called by the loop thread, outside of the connection lock
+//! with a TLS context, the socket is read and written through OpenSSL once the handshake is done, and the kernel encrypts the records when kernel TLS is available
+//!
+class epoll_connection : public connection, public std::enable_shared_from_this<epoll_connection> {
+public:
+  //!
+  //! ctor
+  //!
+  //! \param fd connected non-blocking socket, closed by the connection
+  //! \param id id of the connection in its loop
+  //! \param loop loop monitoring the socket
+  //! \param host host of the peer
+  //! \param port port of the peer
+  //! \param tls TLS configuration, nullptr for a plaintext connection
+  //!
+  epoll_connection(int fd, std::uint64_t id, epoll_loop& loop, const std::string& host, std::uint32_t port, const std::shared_ptr<tls_context>& tls);
+
+  //! dtor
+  ~epoll_connection(void);
+
+  //! copy ctor
+  epoll_connection(const epoll_connection&) = delete;
+  //! assignment operator
+  epoll_connection& operator=(const epoll_connection&) = delete;
+
+public:
+  //!
+  //! connection interface (see transport::connection)
+  //!
+  const std::string& get_host(void) const override;
+  std::uint32_t get_port(void) const override;
+  bool is_connected(void) const override;
+
+  void async_read(std::size_t size, const read_callback_t& callback) override;
+  void async_write(std::vector<char>&& buffer, const write_callback_t& callback) override;
+  void async_write_zerocopy(std::vector<char>&& head, const std::shared_ptr<const std::string>& body, const write_callback_t& callback) override;
+  void set_disconnection_handler(const disconnection_handler_t& handler) override;
+  void disconnect(void) override;
+
+public:
+  //!
+  //! notify readiness changes, then process the connection
+  //! called by the loop thread
+  //!
+  //! \param events epoll events
+  //!
+  void on_events(std::uint32_t events);
+
+  //!
+  //! perform the pending reads and writes, then call the completion callbacks
+  //! called by the loop thread
+  //!
+  void process(void);
+
+  //!
+  //! close the socket of a connection closed with zero copy sends in flight, once the kernel is done with their bodies
+  //! past the linger timeout, or if forced, the connection is reset instead, discarding the unsent data
+  //! called by the loop thread
+  //!
+  //! \param force whether to reset the connection if the sends are still in flight
+  //! \return whether the socket is closed
+  //!
+  bool check_linger(bool force);
+
+private:
+  //!
+  //! write the pending buffers until the socket would block
+  //! must be called with m_mutex held
+  //!
+  void flush_writes(void);
+
+  //!
+  //! write the body of the front pending write, once its buffer has been written, without copy if zero copy is enabled
+  //! must be called with m_mutex held
+  //!
+  //! \return result of the send call
+  //!
+  ssize_t send_body(void);
+
+  //!
+  //! read the zero copy completion notifications from the socket error queue and release the bodies sent
+  //! must be called with m_mutex held
+  //!
+  void read_zerocopy_notifications(void);
+
+  //!
+  //! read the socket for the pending read
+  //! must be called with m_mutex held
+  //!
+  //! \param buffer buffer receiving the bytes read
+  //! \return whether bytes have been read
+  //!
+  bool read(std::vector<char>& buffer);
+
+  //!
+  //! write bytes on the socket, through OpenSSL for TLS connections
+  //!
+  //! \param data bytes to write
+  //! \param size number of bytes to write
+  //! \param flags send flags, ignored for TLS connections
+  //! \return number of bytes written, or -1 with errno set (EAGAIN if the socket would block)
+  //!
+  ssize_t send_bytes(const char* data, std::size_t size, int flags);
+
+  //!
+  //! read bytes from the socket, through OpenSSL for TLS connections
+  //!
+  //! \param data buffer receiving the bytes
+  //! \param size maximum number of bytes to read
+  //! \return number of bytes read, 0 on end of file (plaintext connections only), or -1 with errno set (EAGAIN if the socket would block)
+  //!
+  ssize_t recv_bytes(char* data, std::size_t size);
+
+  //!
+  //! perform the TLS handshake, if any, until done or until the socket would block
+  //! must be called with m_mutex held
+  //!
+  //! \return whether the connection is ready for reads and writes
+  //!
+  bool handshake(void);
+
+  //!
+  //! convert the result of an OpenSSL read or write into the result of the equivalent system call
+  //!
+  //! \param result result of SSL_read or SSL_write
+  //! \return result to be returned by send_bytes or recv_bytes
+  //!
+  ssize_t to_io_result(int result);
+
+  //!
+  //! have the connection processed by the loop
+  //! must be called with m_mutex held
+  //!
+  void schedule(void);
+
+  //!
+  //! close the socket and stop monitoring it
+  //!
+  //! \param notify whether to fail the pending operations and call the disconnection handler
+  //!
+  void close(bool notify);
+
+  //!
+  //! stop monitoring the socket and close it
+  //! must be called with m_mutex held
+  //!
+  //! \param reset whether to reset the connection, discarding the unsent data
+  //!
+  void release_socket(bool reset);
+
+private:
+  //!
+  //! buffer being written
+  //!
+  struct pending_write {
+    //!
+    //! bytes to write
+    //!
+    std::vector<char> buffer;
+
+    //!
+    //! number of bytes already written, buffer then body
+    //!
+    std::size_t offset;
+
+    //!
+    //! completion callback
+    //!
+    write_callback_t callback;
+
+    //!
+    //! body written after the buffer without being copied, nullptr if none
+    //!
+    std::shared_ptr<const std::string> body;
+
+    //!
+    //! whether part of the body has been sent without copy, the body being kept until the kernel notifies it is done
+    //!
+    bool zerocopy_sent;
+  };
+
+  //!
+  //! whether zero copy sends are used on the socket (SO_ZEROCOPY), enabled on the first zero copy write
+  //!
+  enum class zerocopy_state {
+    unknown,
+    enabled,
+    disabled
+  };
+
+  //!
+  //! socket
+  //!
+  int m_fd;
+
+  //!
+  //! id in the loop
+  //!
+  std::uint64_t m_id;
+
+  //!
+  //! loop monitoring the socket
+  //!
+  epoll_loop& m_loop;
+
+  //!
+  //! peer
+  //!
+  std::string m_host;
+  std::uint32_t m_port;
+
+  //!
+  //! TLS configuration, nullptr for a plaintext connection
+  //!
+  std::shared_ptr<tls_context> m_tls_context;
+
+  //!
+  //! OpenSSL connection, reading and writing the socket
+  //!
+  ssl_st* m_ssl;
+
+  //!
+  //! whether the TLS handshake is done
+  //!
+  bool m_tls_established;
+
+  //!
+  //! whether the connection is open
+  //!
+  std::atomic<bool> m_connected;
+
+  //!
+  //! whether reading or writing the socket may succeed (set by events, cleared when the socket would block)
+  //!
+  bool m_readable;
+  bool m_writable;
+
+  //!
+  //! whether the peer shut down the connection (the socket staying readable until end of file is read)
+  //!
+  bool m_peer_closed;
+
+  //!
+  //! whether an I/O error occurred, the connection being closed by the next processing
+  //!
+  bool m_error;
+
+  //!
+  //! whether the connection is scheduled to be processed by the loop
+  //!
+  bool m_scheduled;
+
+  //!
+  //! pending read
+  //!
+  bool m_read_pending;
+  std::size_t m_read_size;
+  read_callback_t m_read_callback;
+
+  //!
+  //! pending writes, in order
+  //!
+  std::deque<pending_write> m_writes;
+
+  //!
+  //! writes completed, whose callbacks are to be called
+  //!
+  std::vector<std::pair<write_callback_t, write_result>> m_completed_writes;
+
+  //!
+  //! zero copy sends state
+  //!
+  zerocopy_state m_zerocopy_state;
+
+  //!
+  //! sequence number given by the kernel to the next zero copy send
+  //!
+  std::uint32_t m_zerocopy_next_seq;
+
+  //!
+  //! bodies fully written but still in use by the kernel, with the sequence number of their last zero copy send, in order
+  //!
+  std::deque<std::pair<std::uint32_t, std::shared_ptr<const std::string>>> m_zerocopy_bodies;
+
+  //!
+  //! whether the connection is closed but its socket kept open until the zero copy sends in flight complete, and until when
+  //!
+  bool m_lingering;
+  std::chrono::steady_clock::time_point m_linger_deadline;
+
+  //!
+  //! called on disconnection by the peer or on error
+  //!
+  disconnection_handler_t m_disconnection_handler;
+
+  //!
+  //! protect the socket and the connection state
+  //!
+  std::mutex m_mutex;
+};
+
+} // namespace transport
+
+} // namespace netflex
+
+#endif /* __linux__ */
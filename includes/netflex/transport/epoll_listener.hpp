@@ -0,0 +1,139 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#ifdef __linux__
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <netflex/transport/epoll_loop.hpp>
+#include <netflex/transport/listener.hpp>
+
+namespace netflex {
+
+namespace transport {
+
+class tls_context;
+
+//!
+//! listener of the epoll backend (linux only)
+//! connections are spread over several event loops, each run by its own thread, and accepted by the loop woken up by the kernel
+//! unlike the tacopie backend, the cost of an event does not depend on the number of connections
+//!
+class epoll_listener : public listener {
+public:
+  //!
+  //! ctor
+  //!
+  //! \param nb_threads number of event loops, one per core if 0
+  //!
+  explicit epoll_listener(std::size_t nb_threads = 0);
+
+  //! dtor
+  ~epoll_listener(void);
+
+  //! copy ctor
+  epoll_listener(const epoll_listener&) = delete;
+  //! assignment operator
+  epoll_listener& operator=(const epoll_listener&) = delete;
+
+public:
+  //!
+  //! listener interface (see transport::listener)
+  //!
+  void start(const std::string& host, std::uint32_t port, const connection_handler_t& handler) override;
+  void stop(void) override;
+  bool is_running(void) const override;
+
+public:
+  //!
+  //! \return port the listener is bound to (useful when started on port 0)
+  //!
+  std::uint32_t get_port(void) const;
+
+  //!
+  //! \return number of event loops
+  //!
+  std::size_t get_nb_threads(void) const;
+
+  //!
+  //! \return number of open connections
+  //!
+  std::size_t get_nb_connections(void) const;
+
+#ifdef __NETFLEX_TLS_ENABLED
+public:
+  //!
+  //! serve the connections over TLS (see tls_context)
+  //! must be called before the listener is started
+  //!
+  //! \param context TLS configuration, nullptr for plaintext connections
+  //!
+  void set_tls_context(const std::shared_ptr<tls_context>& context);
+
+  //!
+  //! \return TLS configuration, nullptr for plaintext connections
+  //!
+  const std::shared_ptr<tls_context>& get_tls_context(void) const;
+#endif /* __NETFLEX_TLS_ENABLED */
+
+private:
+  //!
+  //! number of event loops
+  //!
+  std::size_t m_nb_threads;
+
+  //!
+  //! listening socket
+  //!
+  int m_fd;
+
+  //!
+  //! bound port
+  //!
+  std::uint32_t m_port;
+
+  //!
+  //! event loops
+  //!
+  std::vector<std::unique_ptr<epoll_loop>> m_loops;
+
+  //!
+  //! TLS configuration of the connections, nullptr for plaintext connections
+  //!
+  std::shared_ptr<tls_context> m_tls_context;
+
+  //!
+  //! whether the listener is running
+  //!
+  std::atomic<bool> m_running;
+};
+
+} // namespace transport
+
+} // namespace netflex
+
+#endif /* __linux__ */
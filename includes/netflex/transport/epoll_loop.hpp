@@ -0,0 +1,207 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#ifdef __linux__
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <netflex/transport/listener.hpp>
+
+namespace netflex {
+
+namespace transport {
+
+class epoll_connection;
+class tls_context;
+
+//!
+//! event loop of the epoll backend, run by its own thread
+//! connections are registered once, edge-triggered, and stay on the loop that accepted them: each event costs a hash lookup, regardless of the number of connections
+//! the listening socket is shared by all the loops with EPOLLEXCLUSIVE, so that a new connection wakes up a single loop
+//!
+class epoll_loop {
+public:
+  //!
+  //! ctor
+  //!
+  //! \param listen_fd listening socket, shared with the other loops
+  //! \param handler callback called on each connection accepted by the loop
+  //! \param tls TLS configuration of the accepted connections, nullptr for plaintext connections
+  //!
+  epoll_loop(int listen_fd, const listener::connection_handler_t& handler, const std::shared_ptr<tls_context>& tls);
+
+  //! dtor
+  ~epoll_loop(void);
+
+  //! copy ctor
+  epoll_loop(const epoll_loop&) = delete;
+  //! assignment operator
+  epoll_loop& operator=(const epoll_loop&) = delete;
+
+public:
+  //!
+  //! start the loop thread
+  //!
+  void start(void);
+
+  //!
+  //! stop the loop thread and close its connections
+  //! must not be called from the loop thread
+  //!
+  void stop(void);
+
+  //!
+  //! \return number of connections handled by the loop
+  //!
+  std::size_t get_nb_connections(void) const;
+
+public:
+  //!
+  //! process the connection from the loop thread, once the current events have been handled
+  //! used for the work that cannot be done in place: completion callbacks, data left in the socket by the previous read
+  //!
+  //! \param connection connection to be processed
+  //!
+  void schedule(const std::shared_ptr<epoll_connection>& connection);
+
+  //!
+  //! stop monitoring a connection, before its socket is closed
+  //!
+  //! \param id id of the connection
+  //! \param fd socket of the connection
+  //!
+  void remove(std::uint64_t id, int fd);
+
+  //!
+  //! keep monitoring a closed connection until its socket is closed (see epoll_connection::check_linger)
+  //!
+  //! \param id id of the connection
+  //!
+  void linger(std::uint64_t id);
+
+private:
+  //!
+  //! loop thread
+  //!
+  void run(void);
+
+  //!
+  //! accept the pending connections of the listening socket
+  //!
+  void accept_connections(void);
+
+  //!
+  //! process the connections scheduled so far
+  //!
+  void process_scheduled(void);
+
+  //!
+  //! close the sockets of the lingering connections whose zero copy sends completed or timed out
+  //!
+  void check_lingering(void);
+
+  //!
+  //! wake up the loop thread if called from another thread
+  //!
+  void wakeup(void);
+
+private:
+  //!
+  //! epoll instance
+  //!
+  int m_epoll_fd;
+
+  //!
+  //! eventfd waking up the loop thread
+  //!
+  int m_wakeup_fd;
+
+  //!
+  //! listening socket
+  //!
+  int m_listen_fd;
+
+  //!
+  //! callback called on accepted connections
+  //!
+  listener::connection_handler_t m_handler;
+
+  //!
+  //! TLS configuration of the accepted connections, nullptr for plaintext connections
+  //!
+  std::shared_ptr<tls_context> m_tls_context;
+
+  //!
+  //! loop thread
+  //!
+  std::thread m_thread;
+
+  //!
+  //! whether the loop is running
+  //!
+  std::atomic<bool> m_running;
+
+  //!
+  //! id of the next accepted connection, only used by the loop thread
+  //!
+  std::uint64_t m_next_id;
+
+  //!
+  //! connections, by id (event data)
+  //!
+  std::unordered_map<std::uint64_t, std::shared_ptr<epoll_connection>> m_connections;
+
+  //!
+  //! connections to be processed after the current events
+  //!
+  std::vector<std::shared_ptr<epoll_connection>> m_scheduled;
+
+  //!
+  //! connections being processed, swapped with m_scheduled to keep their capacity
+  //!
+  std::vector<std::shared_ptr<epoll_connection>> m_processing;
+
+  //!
+  //! ids of the closed connections whose socket is kept open until their zero copy sends complete
+  //!
+  std::vector<std::uint64_t> m_lingering;
+
+  //!
+  //! protect m_connections, m_scheduled and m_lingering
+  //!
+  mutable std::mutex m_mutex;
+};
+
+} // namespace transport
+
+} // namespace netflex
+
+#endif /* __linux__ */
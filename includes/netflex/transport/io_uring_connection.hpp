@@ -0,0 +1,248 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#ifdef __linux__
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <netflex/transport/connection.hpp>
+
+namespace netflex {
+
+namespace transport {
+
+class io_uring_loop;
+
+//!
+//! connection of the io_uring backend
+//! bytes are received by a multishot receive into the provided buffers of the loop, and handed to the read callbacks straight from these buffers
+//! writes are sent by the loop, the writes requested while handling a batch of completions being submitted together as a chain of linked sends
+//! all the requests are prepared and completed by the loop thread, callbacks being called by it, outside of the connection lock
+//!
+class io_uring_connection : public connection, public std::enable_shared_from_this<io_uring_connection> {
+public:
+  //!
+  //! ctor
+  //!
+  //! \param fd connected socket, closed by the connection
+  //! \param id id of the connection in its loop
+  //! \param loop loop driving the socket
+  //! \param host host of the peer
+  //! \param port port of the peer
+  //!
+  io_uring_connection(int fd, std::uint64_t id, io_uring_loop& loop, const std::string& host, std::uint32_t port);
+
+  //! dtor
+  ~io_uring_connection(void);
+
+  //! copy ctor
+  io_uring_connection(const io_uring_connection&) = delete;
+  //! assignment operator
+  io_uring_connection& operator=(const io_uring_connection&) = delete;
+
+public:
+  //!
+  //! connection interface (see transport::connection)
+  //!
+  const std::string& get_host(void) const override;
+  std::uint32_t get_port(void) const override;
+  bool is_connected(void) const override;
+
+  void async_read(std::size_t size, const read_callback_t& callback) override;
+  void async_write(std::vector<char>&& buffer, const write_callback_t& callback) override;
+  void set_disconnection_handler(const disconnection_handler_t& handler) override;
+  void disconnect(void) override;
+
+public:
+  //!
+  //! handle a completion of the multishot receive
+  //! called by the loop thread
+  //!
+  //! \param result number of bytes received, or negated errno
+  //! \param flags completion flags (buffer id, whether more completions will follow)
+  //!
+  void on_recv(std::int32_t result, std::uint32_t flags);
+
+  //!
+  //! handle the completion of a send
+  //! called by the loop thread
+  //!
+  //! \param result number of bytes sent, or negated errno
+  //!
+  void on_send(std::int32_t result);
+
+  //!
+  //! arm the receive again, after it ran out of provided buffers
+  //! called by the loop thread when a buffer is recycled
+  //!
+  //! \return whether the connection was waiting for a buffer
+  //!
+  bool on_buffer_available(void);
+
+  //!
+  //! prepare the pending sends and receive, deliver the received bytes, release the connection once closed
+  //! called by the loop thread
+  //!
+  void process(void);
+
+private:
+  //!
+  //! hand the received bytes to the pending reads
+  //!
+  void deliver(void);
+
+  //!
+  //! have the connection processed by the loop
+  //! must be called with m_mutex held
+  //!
+  void schedule(void);
+
+  //!
+  //! shut the socket down, its pending requests completing with an error
+  //! the socket is closed once they all completed
+  //!
+  //! \param notify whether to fail the pending operations and call the disconnection handler
+  //!
+  void close(bool notify);
+
+private:
+  //!
+  //! bytes received in a provided buffer and not read yet
+  //!
+  struct received_chunk {
+    //! provided buffer holding the bytes
+    std::uint16_t buffer_id;
+    //! number of bytes already read
+    std::uint32_t offset;
+    //! number of bytes received
+    std::uint32_t size;
+  };
+
+  //!
+  //! buffer to be written
+  //!
+  struct pending_write {
+    //! bytes to be written, released to the buffer pool once sent
+    std::vector<char> buffer;
+    //! called once the bytes are sent
+    write_callback_t callback;
+  };
+
+  //!
+  //! socket
+  //!
+  int m_fd;
+
+  //!
+  //! id in the loop
+  //!
+  std::uint64_t m_id;
+
+  //!
+  //! loop driving the socket
+  //!
+  io_uring_loop& m_loop;
+
+  //!
+  //! peer
+  //!
+  std::string m_host;
+  std::uint32_t m_port;
+
+  //!
+  //! whether the connection is open
+  //!
+  std::atomic<bool> m_connected;
+
+  //!
+  //! whether the connection is scheduled to be processed by the loop
+  //!
+  bool m_scheduled;
+
+  //!
+  //! whether received bytes are being delivered (reads requested meanwhile are served by the same delivery)
+  //!
+  bool m_delivering;
+
+  //!
+  //! pending read
+  //!
+  bool m_read_pending;
+  std::size_t m_read_size;
+  read_callback_t m_read_callback;
+
+  //!
+  //! whether the multishot receive is armed
+  //!
+  bool m_recv_armed;
+
+  //!
+  //! whether the receive ran out of provided buffers, and waits for one to be recycled before being armed again
+  //!
+  bool m_waiting_buffer;
+
+  //!
+  //! whether the peer closed the connection, which is closed once the bytes received before are read
+  //!
+  bool m_end_of_file;
+
+  //!
+  //! bytes received and not read yet, in order
+  //!
+  std::deque<received_chunk> m_received;
+
+  //!
+  //! pending writes, in order, the first m_nb_sent ones being submitted
+  //!
+  std::deque<pending_write> m_writes;
+  std::size_t m_nb_sent;
+
+  //!
+  //! number of submitted requests that did not complete yet
+  //!
+  std::size_t m_nb_in_flight;
+
+  //!
+  //! called on disconnection by the peer or on error
+  //!
+  disconnection_handler_t m_disconnection_handler;
+
+  //!
+  //! protect the connection state
+  //!
+  std::mutex m_mutex;
+};
+
+} // namespace transport
+
+} // namespace netflex
+
+#endif /* __linux__ */
@@ -0,0 +1,143 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#ifdef __linux__
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <netflex/transport/epoll_listener.hpp>
+#include <netflex/transport/io_uring_loop.hpp>
+#include <netflex/transport/listener.hpp>
+
+namespace netflex {
+
+namespace transport {
+
+//!
+//! listener of the io_uring backend (linux only)
+//! connections are spread over several rings, each run by its own thread, accepting on the same socket with a multishot accept
+//! falls back to the epoll backend when the kernel does not support the io_uring features in use (see io_uring_loop::is_supported)
+//!
+class io_uring_listener : public listener {
+public:
+  //!
+  //! ctor
+  //!
+  //! \param nb_threads number of rings, one per core if 0
+  //! \param nb_buffers number of provided buffers of each ring (up to 32768)
+  //! \param buffer_size size of the provided buffers, upper bound of the bytes received at once by a connection
+  //!
+  explicit io_uring_listener(std::size_t nb_threads = 0, std::uint32_t nb_buffers = 1024, std::uint32_t buffer_size = 4096);
+
+  //! dtor
+  ~io_uring_listener(void);
+
+  //! copy ctor
+  io_uring_listener(const io_uring_listener&) = delete;
+  //! assignment operator
+  io_uring_listener& operator=(const io_uring_listener&) = delete;
+
+public:
+  //!
+  //! listener interface (see transport::listener)
+  //!
+  void start(const std::string& host, std::uint32_t port, const connection_handler_t& handler) override;
+  void stop(void) override;
+  bool is_running(void) const override;
+
+public:
+  //!
+  //! \return port the listener is bound to (useful when started on port 0)
+  //!
+  std::uint32_t get_port(void) const;
+
+  //!
+  //! \return number of rings (or of event loops when falling back to epoll)
+  //!
+  std::size_t get_nb_threads(void) const;
+
+  //!
+  //! \return number of open connections
+  //!
+  std::size_t get_nb_connections(void) const;
+
+  //!
+  //! \return whether the running listener uses io_uring, false when it fell back to epoll
+  //!
+  bool is_using_io_uring(void) const;
+
+private:
+  //!
+  //! start the rings
+  //!
+  //! \return whether the rings could be created
+  //!
+  bool start_rings(const std::string& host, std::uint32_t port, const connection_handler_t& handler);
+
+private:
+  //!
+  //! number of rings
+  //!
+  std::size_t m_nb_threads;
+
+  //!
+  //! provided buffers of each ring
+  //!
+  std::uint32_t m_nb_buffers;
+  std::uint32_t m_buffer_size;
+
+  //!
+  //! listening socket
+  //!
+  int m_fd;
+
+  //!
+  //! bound port
+  //!
+  std::uint32_t m_port;
+
+  //!
+  //! rings
+  //!
+  std::vector<std::unique_ptr<io_uring_loop>> m_loops;
+
+  //!
+  //! listener used when io_uring is not available
+  //!
+  std::unique_ptr<epoll_listener> m_fallback;
+
+  //!
+  //! whether the listener is running
+  //!
+  std::atomic<bool> m_running;
+};
+
+} // namespace transport
+
+} // namespace netflex
+
+#endif /* __linux__ */
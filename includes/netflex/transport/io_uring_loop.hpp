@@ -0,0 +1,345 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#ifdef __linux__
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <netflex/transport/listener.hpp>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace netflex {
+
+namespace transport {
+
+class io_uring_connection;
+
+//!
+//! event loop of the io_uring backend, run by its own thread
+//! each loop owns a ring, and a group of provided buffers into which the kernel receives the bytes of its connections
+//! accepts and receives are multishot: armed once, they complete as many times as connections and bytes come in
+//! the requests prepared while handling completions are submitted, and the next completions waited for, with a single system call
+//!
+class io_uring_loop {
+public:
+  //!
+  //! ctor
+  //!
+  //! \param listen_fd listening socket, shared with the other loops
+  //! \param handler callback called on each connection accepted by the loop
+  //! \param nb_buffers number of provided buffers, up to 32768
+  //! \param buffer_size size of each provided buffer
+  //!
+  io_uring_loop(int listen_fd, const listener::connection_handler_t& handler, std::uint32_t nb_buffers, std::uint32_t buffer_size);
+
+  //! dtor
+  ~io_uring_loop(void);
+
+  //! copy ctor
+  io_uring_loop(const io_uring_loop&) = delete;
+  //! assignment operator
+  io_uring_loop& operator=(const io_uring_loop&) = delete;
+
+public:
+  //!
+  //! \return whether the kernel supports the features used by the loop (multishot accept and receive: linux 6.0)
+  //!
+  static bool is_supported(void);
+
+public:
+  //!
+  //! start the loop thread
+  //!
+  void start(void);
+
+  //!
+  //! stop the loop thread and close its connections
+  //! must not be called from the loop thread
+  //!
+  void stop(void);
+
+  //!
+  //! \return number of connections handled by the loop
+  //!
+  std::size_t get_nb_connections(void) const;
+
+public:
+  //!
+  //! process the connection from the loop thread, before the next submission
+  //! can be called from any thread
+  //!
+  //! \param connection connection to be processed
+  //!
+  void schedule(const std::shared_ptr<io_uring_connection>& connection);
+
+  //!
+  //! prepare a multishot receive into the provided buffers
+  //! loop thread only
+  //!
+  //! \param id id of the connection
+  //! \param fd socket of the connection
+  //!
+  void prepare_recv(std::uint64_t id, int fd);
+
+  //!
+  //! prepare a send
+  //! loop thread only
+  //!
+  //! \param id id of the connection
+  //! \param fd socket of the connection
+  //! \param data bytes to send, valid until completion
+  //! \param size number of bytes to send
+  //! \param linked whether the next prepared request must only start once this one completed
+  //!
+  void prepare_send(std::uint64_t id, int fd, const char* data, std::size_t size, bool linked);
+
+  //!
+  //! \param buffer_id id of a provided buffer
+  //! \return bytes of the provided buffer
+  //!
+  const char* get_buffer(std::uint16_t buffer_id) const;
+
+  //!
+  //! give a provided buffer back to the kernel, and have a connection waiting for a buffer arm its receive again
+  //! loop thread only
+  //!
+  //! \param buffer_id id of the provided buffer
+  //!
+  void recycle_buffer(std::uint16_t buffer_id);
+
+  //!
+  //! schedule the connection once a provided buffer is recycled
+  //! called by connections whose receive ran out of buffers, instead of arming it again right away
+  //! loop thread only
+  //!
+  //! \param id id of the connection
+  //! \return whether the connection has to wait, false if buffers have been recycled since the receive ran out of them
+  //!
+  bool wait_for_buffer(std::uint64_t id);
+
+  //!
+  //! forget a connection whose requests all completed
+  //!
+  //! \param id id of the connection
+  //!
+  void remove(std::uint64_t id);
+
+private:
+  //!
+  //! create and map the ring, and allocate the provided buffers
+  //!
+  void setup(void);
+
+  //!
+  //! unmap and close what setup created
+  //!
+  void teardown(void);
+
+  //!
+  //! \return free submission queue entry, submitting the prepared ones if the queue is full
+  //!
+  io_uring_sqe* get_sqe(void);
+
+  //!
+  //! submit the prepared requests and wait for completions
+  //!
+  //! \param nb_completions number of completions to wait for
+  //!
+  void submit(unsigned int nb_completions);
+
+  //!
+  //! handle the available completions
+  //!
+  void process_completions(void);
+
+  //!
+  //! handle the completion of a multishot accept
+  //!
+  //! \param result accepted socket, or negated errno
+  //!
+  void on_accept(std::int32_t result);
+
+  //!
+  //! prepare the requests of the loop itself
+  //!
+  void prepare_accept(void);
+  void prepare_wakeup(void);
+
+  //!
+  //! prepare the provision of buffers to the kernel
+  //!
+  //! \param first_id id of the first buffer
+  //! \param nb_buffers number of consecutive buffers
+  //!
+  void provide_buffers(std::uint16_t first_id, std::uint32_t nb_buffers);
+
+  //!
+  //! loop thread
+  //!
+  void run(void);
+
+  //!
+  //! close the connections and wait for their requests to complete, so that no buffer is in use once the loop is stopped
+  //!
+  void drain(void);
+
+  //!
+  //! process the connections scheduled so far
+  //!
+  void process_scheduled(void);
+
+  //!
+  //! wake up the loop thread if called from another thread
+  //!
+  void wakeup(void);
+
+private:
+  //!
+  //! ring
+  //!
+  int m_ring_fd;
+
+  //!
+  //! whether the ring has to be enabled by the loop thread (single issuer rings, enabled by their submitter)
+  //!
+  bool m_ring_disabled;
+
+  //!
+  //! shared memory of the submission and completion queues
+  //!
+  void* m_rings;
+  std::size_t m_rings_size;
+
+  //!
+  //! submission queue entries
+  //!
+  io_uring_sqe* m_sqes;
+  std::size_t m_sqes_size;
+
+  //!
+  //! submission queue, m_sq_tail being the tail of the prepared entries
+  //!
+  std::uint32_t* m_sq_head;
+  std::uint32_t* m_sq_shared_tail;
+  std::uint32_t m_sq_mask;
+  std::uint32_t m_sq_entries;
+  std::uint32_t m_sq_tail;
+
+  //!
+  //! completion queue
+  //!
+  std::uint32_t* m_cq_head;
+  std::uint32_t* m_cq_tail;
+  std::uint32_t m_cq_mask;
+  io_uring_cqe* m_cqes;
+
+  //!
+  //! provided buffers
+  //!
+  char* m_buffers;
+  std::uint32_t m_nb_buffers;
+  std::uint32_t m_buffer_size;
+
+  //!
+  //! number of buffers held by the kernel, including the ones whose provision is not submitted yet
+  //!
+  std::uint32_t m_nb_provided_buffers;
+
+  //!
+  //! connections waiting for a provided buffer, by id, only used by the loop thread
+  //!
+  std::deque<std::uint64_t> m_waiting_buffer;
+
+  //!
+  //! eventfd waking up the loop thread, and value read from it
+  //!
+  int m_wakeup_fd;
+  std::uint64_t m_wakeup_value;
+
+  //!
+  //! listening socket
+  //!
+  int m_listen_fd;
+
+  //!
+  //! callback called on accepted connections
+  //!
+  listener::connection_handler_t m_handler;
+
+  //!
+  //! loop thread
+  //!
+  std::thread m_thread;
+
+  //!
+  //! whether the loop is running
+  //!
+  std::atomic<bool> m_running;
+
+  //!
+  //! number of submitted requests that did not complete yet
+  //!
+  std::size_t m_nb_in_flight;
+
+  //!
+  //! id of the next accepted connection, only used by the loop thread
+  //!
+  std::uint64_t m_next_id;
+
+  //!
+  //! connections, by id (requests user data)
+  //!
+  std::unordered_map<std::uint64_t, std::shared_ptr<io_uring_connection>> m_connections;
+
+  //!
+  //! connections to be processed before the next submission
+  //!
+  std::vector<std::shared_ptr<io_uring_connection>> m_scheduled;
+
+  //!
+  //! connections being processed, swapped with m_scheduled to keep their capacity
+  //!
+  std::vector<std::shared_ptr<io_uring_connection>> m_processing;
+
+  //!
+  //! protect m_connections and m_scheduled
+  //!
+  mutable std::mutex m_mutex;
+};
+
+} // namespace transport
+
+} // namespace netflex
+
+#endif /* __linux__ */
@@ -20,54 +20,55 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+
 #pragma once
 
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
 
-#include <netflex/http/request.hpp>
+#include <netflex/transport/connection.hpp>
 
 namespace netflex {
 
-namespace parsing {
+namespace transport {
 
 //!
-//! parser interface that must be implemented by all parsers
+//! accept incoming connections and drive their I/O
+//! each backend provides its own listener and connection implementations
 //!
-class parser_iface {
+class listener {
+public:
+  //! default dtor
+  virtual ~listener(void) = default;
+
 public:
   //!
-  //! default ctor
-  //!
-  //! \param request request to be initialized
+  //! called whenever a new connection is accepted
   //!
-  explicit parser_iface(http::request& request);
-
-  //! default dtor
-  virtual ~parser_iface(void) = default;
+  typedef std::function<void(const std::shared_ptr<connection>&)> connection_handler_t;
 
   //!
-  //! consume input data to parse it and init the request
-  //! if not enough data is passed in, this method would need to be called again later
-  //! input data is modified whenever a token is consumed by parsing, even if parsing is incomplete or invalid
-  //! invalid data would lead to a raised exception
+  //! start listening on the given host and port
   //!
-  //! \param data input data to be parsed
-  //! \return reference to the current object
+  //! \param host host to bind
+  //! \param port port to bind
+  //! \param handler callback called on each accepted connection
   //!
-  virtual parser_iface& operator<<(std::string& data) = 0;
+  virtual void start(const std::string& host, std::uint32_t port, const connection_handler_t& handler) = 0;
 
   //!
-  //! \return whether the parsing is done or not
+  //! stop listening and close the connections
   //!
-  virtual bool is_done(void) const = 0;
+  virtual void stop(void) = 0;
 
-protected:
   //!
-  //! request
+  //! \return whether the listener is currently running or not
   //!
-  http::request& m_request;
+  virtual bool is_running(void) const = 0;
 };
 
-} // namespace parsing
+} // namespace transport
 
 } // namespace netflex
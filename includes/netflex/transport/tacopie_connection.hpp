@@ -0,0 +1,88 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <memory>
+
+#include <tacopie/tacopie>
+
+#include <netflex/transport/connection.hpp>
+
+namespace netflex {
+
+namespace transport {
+
+//!
+//! connection of the tacopie backend, wrapping a tacopie::tcp_client
+//!
+class tacopie_connection : public connection {
+public:
+  //!
+  //! ctor
+  //!
+  //! \param client underlying tcp connection
+  //!
+  explicit tacopie_connection(const std::shared_ptr<tacopie::tcp_client>& client);
+
+  //! default dtor
+  ~tacopie_connection(void) = default;
+
+  //! copy ctor
+  tacopie_connection(const tacopie_connection&) = delete;
+  //! assignment operator
+  tacopie_connection& operator=(const tacopie_connection&) = delete;
+
+public:
+  //!
+  //! connection interface (see transport::connection)
+  //!
+  const std::string& get_host(void) const override;
+  std::uint32_t get_port(void) const override;
+  bool is_connected(void) const override;
+
+  void async_read(std::size_t size, const read_callback_t& callback) override;
+  void async_write(std::vector<char>&& buffer, const write_callback_t& callback) override;
+  void set_disconnection_handler(const disconnection_handler_t& handler) override;
+  void disconnect(void) override;
+
+private:
+  //!
+  //! underlying tcp connection
+  //!
+  std::shared_ptr<tacopie::tcp_client> m_client;
+
+  //!
+  //! callback of the pending read
+  //!
+  read_callback_t m_read_callback;
+
+  //!
+  //! tacopie read callback forwarding to m_read_callback, built once and copied into each read request without allocating
+  //!
+  tacopie::tcp_client::async_read_callback_t m_tacopie_read_callback;
+};
+
+} // namespace transport
+
+} // namespace netflex
@@ -20,44 +20,48 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+
 #pragma once
 
-#include <netflex/http/request.hpp>
-#include <netflex/parsing/parser_iface.hpp>
+#include <tacopie/tacopie>
+
+#include <netflex/transport/listener.hpp>
 
 namespace netflex {
 
-namespace parsing {
+namespace transport {
 
 //!
-//! different http packet parsing stages
-//! high level breakdown
+//! listener of the tacopie backend, wrapping a tacopie::tcp_server
+//! portable default backend, its I/O being driven by the tacopie io_service
 //!
-enum class parsing_stage {
-  start_line,
-  header_fields,
-  message_body
-};
+class tacopie_listener : public listener {
+public:
+  //! default ctor
+  tacopie_listener(void) = default;
+  //! default dtor
+  ~tacopie_listener(void) = default;
 
-//!
-//! create the parser corresponding to the given stage
-//!
-//! \param stage current stage
-//! \param request request to be initialized
-//! \return appropriate parser
-//!
-std::unique_ptr<parser_iface> create_parser(parsing_stage stage, http::request& request);
+  //! copy ctor
+  tacopie_listener(const tacopie_listener&) = delete;
+  //! assignment operator
+  tacopie_listener& operator=(const tacopie_listener&) = delete;
 
-//!
-//! switch to the next parsing stage *or go back to initial one if last stage already reached
-//! and return the parser corresponding to that next stage
-//!
-//! \param stage current stage (will be set to the next one)
-//! \param request request to be initialized
-//! \return appropriate parser
-//!
-std::unique_ptr<parser_iface> switch_to_next_stage(parsing_stage& stage, http::request& request);
+public:
+  //!
+  //! listener interface (see transport::listener)
+  //!
+  void start(const std::string& host, std::uint32_t port, const connection_handler_t& handler) override;
+  void stop(void) override;
+  bool is_running(void) const override;
+
+private:
+  //!
+  //! underlying tcp server
+  //!
+  tacopie::tcp_server m_server;
+};
 
-} // namespace parsing
+} // namespace transport
 
 } // namespace netflex
@@ -0,0 +1,123 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#ifdef __NETFLEX_TLS_ENABLED
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct ssl_ctx_st;
+
+namespace netflex {
+
+namespace transport {
+
+//!
+//! TLS configuration shared by the connections of a listener (OpenSSL, built with TLS_ENABLED)
+//! sessions are cached by the context and session tickets are encrypted with its keys: a client reconnecting to any loop of the listener resumes its session without a full handshake
+//! kernel TLS is requested, so that records are encrypted by the kernel once the handshake is done, on kernels providing it
+//! must be configured before the listener is started
+//! SIGPIPE is ignored from the creation of the context, as OpenSSL cannot write the sockets with MSG_NOSIGNAL
+//!
+class tls_context {
+public:
+  //!
+  //! ctor
+  //!
+  //! \param certificate_file PEM file of the certificate, followed by its chain
+  //! \param private_key_file PEM file of the private key of the certificate
+  //!
+  tls_context(const std::string& certificate_file, const std::string& private_key_file);
+
+  //! dtor
+  ~tls_context(void);
+
+  //! copy ctor
+  tls_context(const tls_context&) = delete;
+  //! assignment operator
+  tls_context& operator=(const tls_context&) = delete;
+
+public:
+  //!
+  //! set the application protocols that can be negotiated (ALPN), by order of preference
+  //! handshakes of clients offering none of them fail, clients not using ALPN are accepted
+  //!
+  //! \param protocols protocols names, http/1.1 by default
+  //!
+  void set_alpn_protocols(const std::vector<std::string>& protocols);
+
+  //!
+  //! \return application protocols that can be negotiated
+  //!
+  const std::vector<std::string>& get_alpn_protocols(void) const;
+
+  //!
+  //! set the maximum number of sessions kept for resumption by session id (TLS 1.2 clients not using tickets)
+  //!
+  //! \param size maximum number of cached sessions
+  //!
+  void set_session_cache_size(std::size_t size);
+
+  //!
+  //! \return maximum number of cached sessions
+  //!
+  std::size_t get_session_cache_size(void) const;
+
+public:
+  //!
+  //! \return underlying OpenSSL context
+  //!
+  ssl_ctx_st* get_native_handle(void) const;
+
+  //!
+  //! select the protocol of a handshake among the ones offered by the client
+  //! called by OpenSSL
+  //!
+  //! \param out selected protocol
+  //! \param out_size size of the selected protocol
+  //! \param offered protocols offered by the client (ALPN wire format)
+  //! \param offered_size size of the offered protocols
+  //! \return whether a protocol has been selected
+  //!
+  bool select_alpn_protocol(const unsigned char** out, unsigned char* out_size, const unsigned char* offered, unsigned int offered_size) const;
+
+private:
+  //!
+  //! OpenSSL context
+  //!
+  ssl_ctx_st* m_ctx;
+
+  //!
+  //! application protocols, by order of preference, and their ALPN wire format (length-prefixed names)
+  //!
+  std::vector<std::string> m_alpn_protocols;
+  std::string m_alpn_wire;
+};
+
+} // namespace transport
+
+} // namespace netflex
+
+#endif /* __NETFLEX_TLS_ENABLED */
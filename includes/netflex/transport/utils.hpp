@@ -0,0 +1,77 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#ifdef __linux__
+
+#include <cstdint>
+#include <string>
+
+struct sockaddr_storage;
+
+namespace netflex {
+
+namespace transport {
+
+namespace utils {
+
+//!
+//! create a non-blocking listening socket, bound to the first usable address of the host
+//! throws a netflex_error on failure
+//!
+//! \param host host to bind
+//! \param port port to bind, 0 for any
+//! \return listening socket
+//!
+int create_listen_socket(const std::string& host, std::uint32_t port);
+
+//!
+//! \param fd bound socket
+//! \return port the socket is bound to, 0 on failure
+//!
+std::uint32_t get_bound_port(int fd);
+
+//!
+//! extract the host and port of an address
+//!
+//! \param address ipv4 or ipv6 address
+//! \param host host of the address
+//! \param port port of the address
+//!
+void get_address(const struct sockaddr_storage& address, std::string& host, std::uint32_t& port);
+
+//!
+//! prepare an accepted socket for request/response traffic (disables Nagle's algorithm)
+//!
+//! \param fd accepted socket
+//!
+void setup_accepted_socket(int fd);
+
+} // namespace utils
+
+} // namespace transport
+
+} // namespace netflex
+
+#endif /* __linux__ */
@@ -20,20 +20,38 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <algorithm>
+
 #include <netflex/http/client.hpp>
+#include <netflex/http/status.hpp>
+#include <netflex/misc/buffer_pool.hpp>
 #include <netflex/misc/error.hpp>
+#include <netflex/misc/http_date.hpp>
 #include <netflex/misc/logger.hpp>
 
 namespace netflex {
 
 namespace http {
 
+//!
+//! bounds of the read size
+//! reads start small, as most requests are, double while they fill the requested size, and come back to the minimum between requests
+//!
+static const std::size_t min_read_size = 4 * 1024;
+static const std::size_t max_read_size = 64 * 1024;
+
+
 //!
 //! ctor & dtor
 //!
-client::client(const std::shared_ptr<tacopie::tcp_client>& tcp_client)
-: m_tcp_client(tcp_client)
-, m_request_received_callback(nullptr) {}
+client::client(const std::shared_ptr<transport::connection>& connection)
+: m_connection(connection)
+, m_request_received_callback(nullptr)
+, m_response_sent_callback(nullptr)
+, m_disconnection_callback(nullptr)
+, m_read_size(min_read_size)
+, m_read_callback([this](transport::read_result& result) { on_async_read_result(result); })
+, m_zerocopy_threshold(0) {}
 
 
 //!
@@ -41,12 +59,12 @@ client::client(const std::shared_ptr<tacopie::tcp_client>& tcp_client)
 //!
 const std::string&
 client::get_host(void) const {
-  return m_tcp_client->get_host();
+  return m_connection->get_host();
 }
 
 std::uint32_t
 client::get_port(void) const {
-  return m_tcp_client->get_port();
+  return m_connection->get_port();
 }
 
 
@@ -55,6 +73,7 @@ client::get_port(void) const {
 //!  > notify on new http request received
 //!  > notify on invalid http request received (err while parsing)
 //!  > notify on client disconnection
+//!  > notify on response written
 //!
 void
 client::set_request_handler(const request_handler_t& recv_callback) {
@@ -64,7 +83,13 @@ client::set_request_handler(const request_handler_t& recv_callback) {
 
 void
 client::set_disconnection_handler(const disconnection_handler_t& disco_callback) {
-  m_tcp_client->set_on_disconnection_handler(disco_callback);
+  m_disconnection_callback = disco_callback;
+  m_connection->set_disconnection_handler(disco_callback);
+}
+
+void
+client::set_response_sent_handler(const response_sent_handler_t& sent_callback) {
+  m_response_sent_callback = sent_callback;
 }
 
 
@@ -72,10 +97,83 @@ client::set_disconnection_handler(const disconnection_handler_t& disco_callback)
 //! send http response
 //!
 void
-client::send_response(const response& response) {
-  std::string http_response = response.to_http_packet();
+client::send_response(const response& response, const misc::request_timing& timing) {
+  std::uint64_t serialize_start                  = misc::request_timing::now();
+  std::vector<char> buffer                       = misc::buffer_pool::acquire();
+  const std::shared_ptr<const std::string>& body = response.get_shared_body();
+
+  //! large shared body: only the head is serialized, the body being sent from the shared buffer itself
+  if (m_zerocopy_threshold && body && body->size() >= m_zerocopy_threshold && !response.get_raw_packet()) {
+    response.serialize_head(buffer);
+    write_response(std::move(buffer), body, serialize_start, timing);
+    return;
+  }
+
+  response.serialize(buffer);
+
+  write_response(std::move(buffer), nullptr, serialize_start, timing);
+}
+
+void
+client::send_static_response(const static_response& response, bool with_body, const misc::request_timing& timing) {
+  std::uint64_t serialize_start = misc::request_timing::now();
+  std::vector<char> buffer      = misc::buffer_pool::acquire();
+
+  response.serialize(buffer, *misc::http_date(), with_body);
+
+  write_response(std::move(buffer), nullptr, serialize_start, timing);
+}
+
+void
+client::write_response(std::vector<char>&& buffer, const std::shared_ptr<const std::string>& body, std::uint64_t serialize_start, const misc::request_timing& timing) {
+  std::uint64_t write_start                        = misc::request_timing::now();
+  transport::connection::write_callback_t callback = nullptr;
+
+  if (m_response_sent_callback) {
+    misc::request_timing response_timing = timing;
+    response_timing.add(misc::request_phase::serialize, write_start - serialize_start);
+
+    callback = [this, response_timing, write_start](transport::write_result&) mutable {
+      response_timing.add(misc::request_phase::write, misc::request_timing::now() - write_start);
+      m_response_sent_callback(response_timing);
+    };
+  }
+
+  //! the serialization buffer is recycled by the connection once written
+  if (body)
+    m_connection->async_write_zerocopy(std::move(buffer), body, callback);
+  else
+    m_connection->async_write(std::move(buffer), callback);
+}
+
+
+void
+client::send_error(unsigned int status) {
+  const std::string& packet = status_to_error_packet(status);
+  std::vector<char> buffer  = misc::buffer_pool::acquire(packet.size());
+  buffer.assign(packet.begin(), packet.end());
+
+  m_connection->async_write(std::move(buffer), [this](transport::write_result& result) {
+    //! on failure, the connection disconnects and notifies by itself
+    if (!result.success)
+      return;
+
+    //! explicit disconnections are not notified by the connection
+    m_connection->disconnect();
+
+    if (m_disconnection_callback)
+      m_disconnection_callback();
+  });
+}
 
-  m_tcp_client->async_write({{http_response.begin(), http_response.end()}, nullptr});
+const parsing::parse_error&
+client::get_parse_error(void) const {
+  return m_parser.get_error();
+}
+
+void
+client::set_request_limits(const parsing::request_limits& limits) {
+  m_parser.set_limits(limits);
 }
 
 
@@ -91,43 +189,44 @@ client::call_request_received_callback(bool success, request& request) {
 
 
 //!
-//! tcp_client callback
+//! connection callback
 //!
 void
-client::on_async_read_result(tacopie::tcp_client::read_result& result) {
-  __NETFLEX_LOG(debug, __NETFLEX_CLIENT_LOG_PREFIX(m_tcp_client->get_host(), m_tcp_client->get_port()) + "async_read result");
+client::on_async_read_result(transport::read_result& result) {
+  __NETFLEX_LOG(debug, __NETFLEX_CLIENT_LOG_PREFIX(m_connection->get_host(), m_connection->get_port()) + "async_read result");
 
   //! if request has failed, simply return
-  //! disconnection callback will be called by the tcp_client right after
+  //! disconnection callback will be called by the connection right after
   if (!result.success) {
-    __NETFLEX_LOG(debug, __NETFLEX_CLIENT_LOG_PREFIX(m_tcp_client->get_host(), m_tcp_client->get_port()) + "async_read failure");
+    __NETFLEX_LOG(debug, __NETFLEX_CLIENT_LOG_PREFIX(m_connection->get_host(), m_connection->get_port()) + "async_read failure");
     return;
   }
 
   //! try to parse request
-  //! in case of failure, notify that the request could not be parsed and stop reading bytes from socket
-  try {
-    __NETFLEX_LOG(debug, __NETFLEX_CLIENT_LOG_PREFIX(m_tcp_client->get_host(), m_tcp_client->get_port()) + "attempts to parse request");
-    m_parser << std::string(result.buffer.begin(), result.buffer.end());
-  }
-  catch (const netflex_error&) {
-    __NETFLEX_LOG(error, __NETFLEX_CLIENT_LOG_PREFIX(m_tcp_client->get_host(), m_tcp_client->get_port()) + "could not parse request (invalid format), disconnecting");
-
-    request partial_request = m_parser.get_currently_parsed_request();
-    call_request_received_callback(false, partial_request);
-
-    return;
-  }
+  __NETFLEX_LOG(debug, __NETFLEX_CLIENT_LOG_PREFIX(m_connection->get_host(), m_connection->get_port()) + "attempts to parse request");
+  m_parser.feed(result.data, result.size);
+  adapt_read_size(result.size);
 
   //! retrieve available requests and forward them
+  //! requests fully received before an invalid one are still served
   while (m_parser.request_available()) {
-    __NETFLEX_LOG(debug, __NETFLEX_CLIENT_LOG_PREFIX(m_tcp_client->get_host(), m_tcp_client->get_port()) + "request fully parsed");
+    __NETFLEX_LOG(debug, __NETFLEX_CLIENT_LOG_PREFIX(m_connection->get_host(), m_connection->get_port()) + "request fully parsed");
 
     request fully_parsed_request = m_parser.get_front();
     call_request_received_callback(true, fully_parsed_request);
     m_parser.pop_front();
   }
 
+  //! in case of failure, notify that the request could not be parsed and stop reading bytes from socket
+  if (m_parser.has_error()) {
+    __NETFLEX_LOG(error, __NETFLEX_CLIENT_LOG_PREFIX(m_connection->get_host(), m_connection->get_port()) + "could not parse request (invalid format)");
+
+    request partial_request = m_parser.get_currently_parsed_request();
+    call_request_received_callback(false, partial_request);
+
+    return;
+  }
+
   //! Keep reading
   async_read();
 } // namespace http
@@ -139,13 +238,42 @@ client::on_async_read_result(tacopie::tcp_client::read_result& result) {
 void
 client::async_read(void) {
   try {
-    m_tcp_client->async_read({1024, std::bind(&client::on_async_read_result, this, std::placeholders::_1)});
+    m_connection->async_read(m_read_size, m_read_callback);
   }
   catch (const std::exception&) {
     //! Client disconnected in the meantime
   }
 }
 
+void
+client::adapt_read_size(std::size_t nb_bytes) {
+  //! socket had more data than requested: sustained transfer, fewer and larger reads
+  if (nb_bytes >= m_read_size)
+    m_read_size = std::min(m_read_size * 2, max_read_size);
+  //! between requests: next read is likely a small request, not worth a large buffer
+  else if (!m_parser.is_parsing_request())
+    m_read_size = min_read_size;
+}
+
+std::size_t
+client::get_read_size(void) const {
+  return m_read_size;
+}
+
+
+//!
+//! zero copy writes
+//!
+void
+client::set_zerocopy_threshold(std::size_t threshold) {
+  m_zerocopy_threshold = threshold;
+}
+
+std::size_t
+client::get_zerocopy_threshold(void) const {
+  return m_zerocopy_threshold;
+}
+
 } // namespace http
 
 } // namespace netflex
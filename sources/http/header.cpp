@@ -20,6 +20,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <cctype>
+
 #include <netflex/http/header.hpp>
 
 namespace netflex {
@@ -46,6 +48,64 @@ header::to_s(void) const {
   return field_name + "=" + field_value;
 }
 
+
+//!
+//! lookup
+//!
+const std::string*
+find_header(const header_list_t& headers, const std::string& name) {
+  //! exact match first, which is the common case
+  auto header = headers.find(name);
+  if (header != headers.end())
+    return &header->second;
+
+  for (const auto& candidate : headers) {
+    const std::string& candidate_name = candidate.first;
+
+    if (candidate_name.size() != name.size())
+      continue;
+
+    std::size_t i = 0;
+    while (i < name.size() && std::tolower(static_cast<unsigned char>(candidate_name[i])) == std::tolower(static_cast<unsigned char>(name[i])))
+      ++i;
+
+    if (i == name.size())
+      return &candidate.second;
+  }
+
+  return nullptr;
+}
+
+bool
+has_header_token(const header_list_t& headers, const std::string& name, const std::string& token) {
+  const std::string* value = find_header(headers, name);
+  if (!value)
+    return false;
+
+  std::size_t pos = 0;
+  while (pos <= value->size()) {
+    std::size_t end = value->find(',', pos);
+    if (end == std::string::npos)
+      end = value->size();
+
+    std::size_t begin = pos;
+    while (begin < end && std::isspace(static_cast<unsigned char>((*value)[begin])))
+      ++begin;
+
+    std::size_t i = 0;
+    while (i < token.size() && begin + i < end && std::tolower(static_cast<unsigned char>((*value)[begin + i])) == std::tolower(static_cast<unsigned char>(token[i])))
+      ++i;
+
+    std::size_t after = begin + i;
+    if (i == token.size() && (after == end || (*value)[after] == '=' || std::isspace(static_cast<unsigned char>((*value)[after]))))
+      return true;
+
+    pos = end + 1;
+  }
+
+  return false;
+}
+
 } // namespace http
 
 } // namespace netflex
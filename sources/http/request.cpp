@@ -20,6 +20,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <functional>
+
 #include <netflex/http/request.hpp>
 #include <netflex/misc/error.hpp>
 #include <netflex/misc/output.hpp>
@@ -28,6 +30,75 @@ namespace netflex {
 
 namespace http {
 
+//!
+//! copy & move
+//!
+request::request(const request& other)
+: request() {
+  *this = other;
+}
+
+request&
+request::operator=(const request& other) {
+  m_method       = other.m_method;
+  m_raw_method   = other.m_raw_method;
+  m_target       = other.m_target;
+  m_http_version = other.m_http_version;
+  m_headers      = other.m_headers;
+  m_path         = other.m_path;
+  m_params       = other.m_params;
+  m_path_params  = other.m_path_params;
+  m_body         = other.m_body;
+  m_timing       = other.m_timing;
+
+  rebind_path_params(other.m_target.data(), other.m_target.size());
+
+  return *this;
+}
+
+request::request(request&& other)
+: request() {
+  *this = std::move(other);
+}
+
+request&
+request::operator=(request&& other) {
+  if (this == &other)
+    return *this;
+
+  //! taken before the move: a large target keeps its buffer, but a small one is copied
+  const char* source_target = other.m_target.data();
+  std::size_t source_size   = other.m_target.size();
+
+  m_method       = other.m_method;
+  m_raw_method   = std::move(other.m_raw_method);
+  m_target       = std::move(other.m_target);
+  m_http_version = std::move(other.m_http_version);
+  m_headers      = std::move(other.m_headers);
+  m_path         = std::move(other.m_path);
+  m_params       = std::move(other.m_params);
+  m_path_params  = std::move(other.m_path_params);
+  m_body         = std::move(other.m_body);
+  m_timing       = std::move(other.m_timing);
+
+  rebind_path_params(source_target, source_size);
+
+  return *this;
+}
+
+void
+request::rebind_path_params(const char* source_target, std::size_t source_size) {
+  for (auto& param : m_path_params) {
+    //! pointers compared through std::less: the views may be over another buffer
+    std::less<const char*> before;
+    if (before(param.str.data(), source_target) || before(source_target + source_size, param.str.data() + param.str.size()))
+      continue;
+
+    param.str = misc::string_view(m_target.data() + (param.str.data() - source_target), param.str.size());
+  }
+}
+
+
 //!
 //! start line information
 //!
@@ -127,6 +198,16 @@ request::get_params(void) const {
   return m_params;
 }
 
+routing::query
+request::get_query(void) const {
+  return routing::query::from_target(m_target);
+}
+
+const routing::path_params_t&
+request::get_path_params(void) const {
+  return m_path_params;
+}
+
 void
 request::set_path(const std::string& path) {
   m_path = path;
@@ -137,6 +218,11 @@ request::set_params(const routing::params_t& params) {
   m_params = params;
 }
 
+void
+request::set_path_params(const routing::path_params_t& params) {
+  m_path_params = params;
+}
+
 
 //!
 //! body
@@ -152,6 +238,20 @@ request::set_body(const std::string& body) {
 }
 
 
+//!
+//! timing
+//!
+misc::request_timing&
+request::get_timing(void) {
+  return m_timing;
+}
+
+const misc::request_timing&
+request::get_timing(void) const {
+  return m_timing;
+}
+
+
 //!
 //! misc
 //!
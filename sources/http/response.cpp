@@ -41,7 +41,58 @@ response::response(void)
 //!
 std::string
 response::to_http_packet(void) const {
-  return misc::status_line_to_http_packet(m_http_version, m_status, m_reason) + misc::header_list_to_http_packet(m_headers) + m_body;
+  if (m_raw_packet)
+    return *m_raw_packet;
+
+  std::string head        = serialize_head();
+  const std::string& body = get_body();
+
+  std::string packet;
+  packet.reserve(head.size() + body.size());
+  packet.append(head);
+  packet.append(body);
+
+  return packet;
+}
+
+void
+response::serialize(std::vector<char>& buffer) const {
+  if (m_raw_packet) {
+    buffer.assign(m_raw_packet->begin(), m_raw_packet->end());
+    return;
+  }
+
+  std::string head        = serialize_head();
+  const std::string& body = get_body();
+
+  //! body copied once, straight into the write buffer
+  buffer.clear();
+  buffer.reserve(head.size() + body.size());
+  buffer.insert(buffer.end(), head.begin(), head.end());
+  buffer.insert(buffer.end(), body.begin(), body.end());
+}
+
+void
+response::serialize_head(std::vector<char>& buffer) const {
+  std::string head = serialize_head();
+
+  buffer.assign(head.begin(), head.end());
+}
+
+std::string
+response::serialize_head(void) const {
+  //! single allocation: status line, headers and their separators
+  std::size_t size = m_http_version.size() + m_reason.size() + 9;
+  for (const auto& header : m_headers)
+    size += header.first.size() + header.second.size() + 4;
+
+  std::string head;
+  head.reserve(size);
+
+  misc::append_status_line(head, m_http_version, m_status, m_reason);
+  misc::append_header_list(head, m_headers);
+
+  return head;
 }
 
 
@@ -103,12 +154,54 @@ response::set_headers(const header_list_t& headers) {
 //!
 const std::string&
 response::get_body(void) const {
-  return m_body;
+  return m_shared_body ? *m_shared_body : m_body;
 }
 
 void
 response::set_body(const std::string& body) {
   m_body = body;
+  m_shared_body.reset();
+}
+
+void
+response::set_body(std::string&& body) {
+  m_body = std::move(body);
+  m_shared_body.reset();
+}
+
+void
+response::set_body(const std::shared_ptr<const std::string>& body) {
+  m_body.clear();
+  m_shared_body = body;
+}
+
+const std::shared_ptr<const std::string>&
+response::get_shared_body(void) const {
+  return m_shared_body;
+}
+
+const std::shared_ptr<const std::string>&
+response::share_body(void) {
+  if (!m_shared_body) {
+    m_shared_body = std::make_shared<const std::string>(std::move(m_body));
+    m_body.clear();
+  }
+
+  return m_shared_body;
+}
+
+
+//!
+//! raw packet
+//!
+void
+response::set_raw_packet(const std::shared_ptr<const std::string>& packet) {
+  m_raw_packet = packet;
+}
+
+const std::shared_ptr<const std::string>&
+response::get_raw_packet(void) const {
+  return m_raw_packet;
 }
 
 } // namespace http
@@ -20,19 +20,56 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <memory>
+
 #include <netflex/http/server.hpp>
+#include <netflex/http/status.hpp>
+#include <netflex/misc/error.hpp>
+#include <netflex/misc/http_date.hpp>
 #include <netflex/misc/logger.hpp>
+#include <netflex/transport/tacopie_listener.hpp>
 
 namespace netflex {
 
 namespace http {
 
+//!
+//! Host header of the request, empty if none
+//!
+static const std::string&
+get_host_header(const request& request) {
+  static const std::string no_host;
+
+  const std::string* host = find_header(request.get_headers(), "Host");
+
+  return host ? *host : no_host;
+}
+
+//!
+//! serialized answer of the requests rejected by the server limits
+//!
+static std::string
+build_rejection_packet(unsigned int status, unsigned int retry_after, bool close) {
+  return "HTTP/1.1 " + std::to_string(status) + " " + status_to_reason_phrase(status) + "\r\n"
+         + "Content-Length: 0\r\n"
+         + "Retry-After: " + std::to_string(retry_after) + "\r\n"
+         + (close ? "Connection: close\r\n" : "")
+         + "\r\n";
+}
+
+
 //!
 //! ctor & dtor
 //!
 server::server(void)
-//! insert first middleware (dispatch)
-: m_middlewares({1, std::bind(&server::dispatch, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3)}) {}
+: server(std::make_shared<transport::tacopie_listener>()) {}
+
+server::server(const std::shared_ptr<transport::listener>& listener)
+: m_listener(listener)
+, m_routing_live(false)
+, m_zerocopy_threshold(0)
+, m_max_connections(0)
+, m_nb_connections(0) {}
 
 
 //!
@@ -40,19 +77,29 @@ server::server(void)
 //!
 server&
 server::add_route(const routing::route& route) {
-  m_routes.push_back(route);
+  update_routing([&] { m_routes.push_back(route); });
   return *this;
 }
 
 server&
 server::add_routes(const std::vector<routing::route>& routes) {
-  m_routes.insert(m_routes.end(), routes.begin(), routes.end());
+  update_routing([&] { m_routes.insert(m_routes.end(), routes.begin(), routes.end()); });
   return *this;
 }
 
 server&
 server::set_route(const std::vector<routing::route>& routes) {
-  m_routes = routes;
+  update_routing([&] { m_routes = routes; });
+  return *this;
+}
+
+
+server&
+server::add_static_route(http::method m, const std::string& path, const http::response& response) {
+  auto serialized = std::make_shared<const static_response>(response);
+
+  update_routing([&] { m_static_routes.emplace_back(m, path, serialized); });
+
   return *this;
 }
 
@@ -62,31 +109,218 @@ server::set_route(const std::vector<routing::route>& routes) {
 //!
 server&
 server::add_middleware(const routing::middleware_t& middleware) {
-  //! insert all middlewares after the user defined middlewares, but always before the dispatch middleware
-  m_middlewares.insert(std::prev(m_middlewares.end()), middleware);
+  //! dispatch middleware is only appended when the route table is built
+  update_routing([&] { m_middlewares.push_back(middleware); });
 
   return *this;
 }
 
 server&
 server::add_middlewares(const std::list<routing::middleware_t>& middlewares) {
-  //! insert all middlewares after the user defined middlewares, but always before the dispatch middleware
-  m_middlewares.insert(std::prev(m_middlewares.end()), middlewares.begin(), middlewares.end());
+  update_routing([&] { m_middlewares.insert(m_middlewares.end(), middlewares.begin(), middlewares.end()); });
 
   return *this;
 }
 
 server&
 server::set_middlewares(const std::list<routing::middleware_t>& middlewares) {
-  //! erase all middlewares except the dispatch one
-  m_middlewares.erase(m_middlewares.begin(), std::prev(m_middlewares.end()));
+  update_routing([&] { m_middlewares = middlewares; });
+
+  return *this;
+}
+
+
+//!
+//! mount routers
+//!
+server&
+server::mount(const std::string& prefix, const routing::router& router) {
+  update_routing([&] { m_mounts.emplace_back(routing::route_table::normalize_prefix(prefix), router); });
+
+  return *this;
+}
+
+
+//!
+//! virtual hosts
+//!
+server&
+server::add_virtual_host(const std::string& host, const routing::router& router) {
+  update_routing([&] { m_virtual_hosts.emplace_back(host, router); });
+
+  return *this;
+}
+
+
+//!
+//! route table
+//!
+routing::route_table
+server::build_route_table(void) {
+  routing::route_table table;
+
+  for (const auto& route : m_static_routes)
+    table.add_static_response(std::get<0>(route), std::get<1>(route), std::get<2>(route));
+
+  //! pipeline: server middlewares, then specific middlewares, then dispatch to the given routes
+  auto build_pipeline = [this](const std::list<routing::middleware_t>& middlewares, const std::shared_ptr<const std::vector<routing::route>>& routes) {
+    std::list<routing::middleware_t> pipeline = m_middlewares;
+    pipeline.insert(pipeline.end(), middlewares.begin(), middlewares.end());
+    pipeline.push_back([this, routes](routing::middleware_chain&, http::request& request, http::response& response) {
+      dispatch(*routes, request, response);
+    });
+
+    return routing::middleware_pipeline(pipeline);
+  };
+
+  for (const auto& mount : m_mounts) {
+    const std::string& prefix = mount.first;
+    auto routes               = std::make_shared<std::vector<routing::route>>();
+
+    //! routes paths are relative to the mount point, / being the mount point itself
+    for (const auto& route : mount.second.get_routes())
+      routes->push_back(route.with_path(route.get_path() == "/" ? (prefix.empty() ? "/" : prefix) : prefix + route.get_path()));
+
+    table.add(prefix, build_pipeline(mount.second.get_middlewares(), routes));
+  }
+
+  //! server routes, for the targets that do not belong to any mount point
+  //! added last so that a router mounted at / wins over them
+  table.add("", build_pipeline({}, std::make_shared<std::vector<routing::route>>(m_routes)));
+
+  //! virtual hosts, each with its own table, so that lookups only scan the routes of the requested host
+  for (const auto& virtual_host : m_virtual_hosts) {
+    routing::route_table host_table;
+    host_table.add("", build_pipeline(virtual_host.second.get_middlewares(), std::make_shared<std::vector<routing::route>>(virtual_host.second.get_routes())));
+
+    table.add_host(virtual_host.first, host_table);
+  }
+
+  return table;
+}
+
+void
+server::update_routing(const std::function<void(void)>& update) {
+  {
+    std::lock_guard<std::mutex> lock(m_routing_mutex);
+    update();
+
+    //! publish under the lock, so that snapshots are published in the order of the changes
+    if (m_routing_live)
+      m_route_table.publish(build_route_table());
+  }
+
+  //! wait for the readers of the previous snapshots out of the lock, as they may be waiting for it
+  m_route_table.reclaim();
+}
+
+
+//!
+//! request limits
+//!
+server&
+server::set_request_limits(const parsing::request_limits& limits) {
+  if (is_running())
+    __NETFLEX_THROW(error, "request limits must be set before starting the server");
+
+  m_request_limits = limits;
+
+  return *this;
+}
+
+const parsing::request_limits&
+server::get_request_limits(void) const {
+  return m_request_limits;
+}
+
+
+//!
+//! zero copy writes
+//!
+server&
+server::set_zerocopy_threshold(std::size_t threshold) {
+  if (is_running())
+    __NETFLEX_THROW(error, "zero copy threshold must be set before starting the server");
+
+  m_zerocopy_threshold = threshold;
+
+  return *this;
+}
+
+std::size_t
+server::get_zerocopy_threshold(void) const {
+  return m_zerocopy_threshold;
+}
+
+
+//!
+//! rate limiting
+//!
+server&
+server::set_rate_limit(double requests_per_second, std::uint32_t burst, const std::string& key_header, std::size_t max_clients) {
+  m_rate_limiter.reset(new misc::rate_limiter(requests_per_second, burst, max_clients));
+  m_rate_limit_key_header = key_header;
 
-  //! insert all middlewares after the user defined middlewares, but always before the dispatch middleware
-  m_middlewares.insert(std::prev(m_middlewares.end()), middlewares.begin(), middlewares.end());
+  //! serialized once: rejections only copy it to the write buffer
+  //! connection is kept alive, so that well-behaved clients going over their limit do not have to reconnect
+  m_rate_limited_response.set_status_code(429);
+  m_rate_limited_response.set_reason_phrase(status_to_reason_phrase(429));
+  m_rate_limited_response.set_raw_packet(std::make_shared<const std::string>(build_rejection_packet(429, m_rate_limiter->get_retry_after(), false)));
 
   return *this;
 }
 
+const misc::rate_limiter*
+server::get_rate_limiter(void) const {
+  return m_rate_limiter.get();
+}
+
+bool
+server::is_request_allowed(const request& request, const client& client) {
+  if (!m_rate_limit_key_header.empty()) {
+    const std::string* key = find_header(request.get_headers(), m_rate_limit_key_header);
+
+    //! the header is chosen by the client: its address is charged as well, a fresh key getting a full bucket
+    if (key)
+      return m_rate_limiter->try_acquire(*key, client.get_host()) && m_rate_limiter->try_acquire(client.get_host());
+  }
+
+  return m_rate_limiter->try_acquire(client.get_host());
+}
+
+
+//!
+//! load shedding
+//!
+server&
+server::set_adaptive_concurrency_limit(std::uint32_t initial_limit, std::uint32_t min_limit, std::uint32_t max_limit) {
+  m_concurrency_limiter.reset(new misc::concurrency_limiter(initial_limit, min_limit, max_limit));
+
+  //! overload is expected to be short lived, and the connection kept alive
+  m_overloaded_response.set_status_code(503);
+  m_overloaded_response.set_reason_phrase(status_to_reason_phrase(503));
+  m_overloaded_response.set_raw_packet(std::make_shared<const std::string>(build_rejection_packet(503, 1, false)));
+
+  return *this;
+}
+
+const misc::concurrency_limiter*
+server::get_concurrency_limiter(void) const {
+  return m_concurrency_limiter.get();
+}
+
+server&
+server::set_max_connections(std::size_t max_connections) {
+  m_max_connections = max_connections;
+
+  return *this;
+}
+
+std::size_t
+server::get_nb_connections(void) const {
+  return m_nb_connections;
+}
+
 
 //!
 //! start & stop the server
@@ -96,7 +330,10 @@ server::start(const std::string& host, unsigned int port) {
   __NETFLEX_LOG(info, "starting server on " + __NETFLEX_HOST_PORT_LOG(host, port));
   //! TODO: debug log of loaded routes.
 
-  m_tcp_server.start(host, port, std::bind(&server::on_connection_received, this, std::placeholders::_1));
+  //! publish routing, so that requests share it instead of copying it, and publish its subsequent changes
+  update_routing([&] { m_routing_live = true; });
+
+  m_listener->start(host, port, std::bind(&server::on_connection_received, this, std::placeholders::_1));
 
   __NETFLEX_LOG(info, "server running on " + __NETFLEX_HOST_PORT_LOG(host, port));
 }
@@ -104,30 +341,59 @@ server::start(const std::string& host, unsigned int port) {
 void
 server::stop(void) {
   __NETFLEX_LOG(info, "stopping server");
-  m_tcp_server.stop();
+  m_listener->stop();
+
+  //! routing changes are published on the next start
+  {
+    std::lock_guard<std::mutex> lock(m_routing_mutex);
+    m_routing_live = false;
+  }
+
   __NETFLEX_LOG(info, "server stopped");
 }
 
 
 //!
-//! tacopie::tcp_server callback
+//! listener callback
 //!
-bool
-server::on_connection_received(const std::shared_ptr<tacopie::tcp_client>& client) {
-  __NETFLEX_LOG(debug, __NETFLEX_CLIENT_LOG_PREFIX(client->get_host(), client->get_port()) + "receiving connection");
+void
+server::on_connection_received(const std::shared_ptr<transport::connection>& connection) {
+  __NETFLEX_LOG(debug, __NETFLEX_CLIENT_LOG_PREFIX(connection->get_host(), connection->get_port()) + "receiving connection");
+
+  //! counted before checked: concurrent loops cannot both take the last connection
+  std::size_t nb_connections = m_nb_connections.fetch_add(1);
+
+  if (m_max_connections && nb_connections >= m_max_connections) {
+    --m_nb_connections;
+
+    __NETFLEX_LOG(warn, __NETFLEX_CLIENT_LOG_PREFIX(connection->get_host(), connection->get_port()) + "too many connections, connection rejected");
+
+    //! answered without reading the request, the connection being kept alive by the write callback until it is closed
+    static const std::string packet = build_rejection_packet(503, 1, true);
+
+    connection->async_write(std::vector<char>(packet.begin(), packet.end()), [connection](transport::write_result&) {
+      connection->disconnect();
+    });
+
+    return;
+  }
 
   //! store client
-  m_clients.emplace_back(client);
+  client_iterator_t http_client;
+  {
+    std::lock_guard<std::mutex> lock(m_clients_mutex);
+    m_clients.emplace_back(connection);
+    http_client = std::prev(m_clients.end());
+  }
 
   //! start listening for incoming requests
-  client_iterator_t http_client = std::prev(m_clients.end());
+  http_client->set_request_limits(m_request_limits);
+  http_client->set_zerocopy_threshold(m_zerocopy_threshold);
   http_client->set_disconnection_handler(std::bind(&server::on_client_disconnected, this, http_client));
+  http_client->set_response_sent_handler(std::bind(&server::on_http_response_sent, this, std::placeholders::_1));
   http_client->set_request_handler(std::bind(&server::on_http_request_received, this, std::placeholders::_1, std::placeholders::_2, http_client));
 
-  __NETFLEX_LOG(info, __NETFLEX_CLIENT_LOG_PREFIX(client->get_host(), client->get_port()) + "connection accepted");
-
-  //! mark connection as handled by ourselves
-  return true;
+  __NETFLEX_LOG(info, __NETFLEX_CLIENT_LOG_PREFIX(connection->get_host(), connection->get_port()) + "connection accepted");
 }
 
 
@@ -137,9 +403,38 @@ server::on_connection_received(const std::shared_ptr<tacopie::tcp_client>& clien
 void
 server::on_http_request_received(bool success, request& request, client_iterator_t client) {
   if (!success) {
-    __NETFLEX_LOG(warn, __NETFLEX_CLIENT_LOG_PREFIX(client->get_host(), client->get_port()) + "invalid request");
+    const parsing::parse_error& error = client->get_parse_error();
+    __NETFLEX_LOG(warn, __NETFLEX_CLIENT_LOG_PREFIX(client->get_host(), client->get_port()) + "invalid request (" + parsing::parsing_stage_to_string(error.stage) + " at offset " + std::to_string(error.offset) + ": " + error.reason + "), answering " + std::to_string(error.status));
 
-    m_clients.erase(client);
+    //! answer with the matching error, client is removed once disconnected
+    client->send_error(error.status);
+    return;
+  }
+
+  //! rejected before any routing or middleware, with the preserialized answer
+  if (m_rate_limiter && !is_request_allowed(request, *client)) {
+    __NETFLEX_LOG(debug, __NETFLEX_CLIENT_LOG_PREFIX(client->get_host(), client->get_port()) + "rate limited");
+
+    client->send_response(m_rate_limited_response, request.get_timing());
+    return;
+  }
+
+  //! pin the current routing snapshot until the request is processed
+  routing::route_table_publisher::reader route_table(m_route_table);
+
+  //! constant responses: no middleware, no serialization
+  const static_response* constant_response = route_table->resolve_static_response(request.get_method(), request.get_target());
+  if (constant_response) {
+    client->send_static_response(*constant_response, request.get_method() != method::HEAD, request.get_timing());
+    return;
+  }
+
+  //! shed load before queueing behind slow requests, the permit being released even if the chain throws
+  misc::concurrency_limiter::permit permit;
+  if (m_concurrency_limiter && !permit.acquire(*m_concurrency_limiter)) {
+    __NETFLEX_LOG(debug, __NETFLEX_CLIENT_LOG_PREFIX(client->get_host(), client->get_port()) + "server overloaded");
+
+    client->send_response(m_overloaded_response, request.get_timing());
     return;
   }
 
@@ -152,19 +447,51 @@ server::on_http_request_received(bool success, request& request, client_iterator
   response.set_reason_phrase("OK");
   //! header with body information
   response.add_header({"Content-Type", "text/html"});
+  //! date, formatted once per second
+  response.add_header({"Date", *misc::http_date()});
 
   //! middleware chain, including dispatch
-  routing::middleware_chain chain(m_middlewares, request, response);
+  misc::request_timing& timing = request.get_timing();
+  std::uint64_t chain_start    = misc::request_timing::now();
+
+  const routing::route_table& host_table = route_table->resolve_host(get_host_header(request));
+
+  routing::middleware_chain chain(*host_table.resolve(request.get_target()), request, response);
   chain.proceed();
 
-  client->send_response(response);
+  std::uint64_t chain_end = misc::request_timing::now();
+
+  permit.release(chain_end - chain_start);
+
+  //! handler time is measured by dispatch, exclude it from the middleware phase
+  timing.add(misc::request_phase::middleware, chain_end - chain_start - timing.get(misc::request_phase::handler));
+
+  //! the request is not kept until written: described now, but only if already slow, to keep the dump off the common path
+  if (m_metrics.is_slow_request(timing))
+    timing.set_description(request.to_string());
+
+  //! large bodies written without copy must outlive the response
+  if (m_zerocopy_threshold && response.get_body().size() >= m_zerocopy_threshold)
+    response.share_body();
+
+  client->send_response(response, timing);
+}
+
+void
+server::on_http_response_sent(const misc::request_timing& timing) {
+  m_metrics.record(timing);
 }
 
 void
 server::on_client_disconnected(client_iterator_t client) {
   __NETFLEX_LOG(info, __NETFLEX_CLIENT_LOG_PREFIX(client->get_host(), client->get_port()) + "client disconnected");
 
-  m_clients.erase(client);
+  {
+    std::lock_guard<std::mutex> lock(m_clients_mutex);
+    m_clients.erase(client);
+  }
+
+  --m_nb_connections;
 }
 
 
@@ -172,11 +499,14 @@ server::on_client_disconnected(client_iterator_t client) {
 //! dispatch
 //!
 void
-server::dispatch(routing::middleware_chain&, http::request& request, http::response& response) {
+server::dispatch(const std::vector<routing::route>& routes, http::request& request, http::response& response) {
   //! find route matching
-  for (const auto& route : m_routes) {
+  for (const auto& route : routes) {
     if (route.match(request)) {
+      std::uint64_t handler_start = misc::request_timing::now();
       route.dispatch(request, response);
+      request.get_timing().add(misc::request_phase::handler, misc::request_timing::now() - handler_start);
+
       return;
     }
   }
@@ -196,7 +526,21 @@ server::dispatch(routing::middleware_chain&, http::request& request, http::respo
 //!
 bool
 server::is_running(void) const {
-  return m_tcp_server.is_running();
+  return m_listener->is_running();
+}
+
+
+//!
+//! metrics
+//!
+misc::request_metrics&
+server::get_metrics(void) {
+  return m_metrics;
+}
+
+const misc::request_metrics&
+server::get_metrics(void) const {
+  return m_metrics;
 }
 
 } // namespace http
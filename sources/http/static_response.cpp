@@ -0,0 +1,86 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <algorithm>
+#include <cctype>
+
+#include <netflex/http/static_response.hpp>
+#include <netflex/misc/output.hpp>
+
+namespace netflex {
+
+namespace http {
+
+//!
+//! ctor
+//!
+static_response::static_response(const response& response)
+: m_body(response.get_body())
+, m_status(response.get_status_code()) {
+  header_list_t headers;
+
+  for (const auto& header : response.get_headers()) {
+    std::string name = header.first;
+    std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    if (name != "date")
+      headers.insert(header);
+  }
+
+  if (!find_header(headers, "Content-Length"))
+    headers["Content-Length"] = std::to_string(m_body.size());
+
+  misc::append_status_line(m_status_line, response.get_http_version(), m_status, response.get_reason_phase());
+  misc::append_header_list(m_headers, headers);
+}
+
+
+//!
+//! serialization
+//!
+void
+static_response::serialize(std::vector<char>& buffer, const std::string& date, bool with_body) const {
+  static const std::string date_name = "Date: ";
+
+  buffer.clear();
+  buffer.reserve(m_status_line.size() + date_name.size() + date.size() + 2 + m_headers.size() + (with_body ? m_body.size() : 0));
+
+  buffer.insert(buffer.end(), m_status_line.begin(), m_status_line.end());
+  buffer.insert(buffer.end(), date_name.begin(), date_name.end());
+  buffer.insert(buffer.end(), date.begin(), date.end());
+  buffer.push_back('\r');
+  buffer.push_back('\n');
+  buffer.insert(buffer.end(), m_headers.begin(), m_headers.end());
+
+  if (with_body)
+    buffer.insert(buffer.end(), m_body.begin(), m_body.end());
+}
+
+unsigned int
+static_response::get_status_code(void) const {
+  return m_status;
+}
+
+} // namespace http
+
+} // namespace netflex
@@ -0,0 +1,154 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include <netflex/http/status.hpp>
+
+namespace netflex {
+
+namespace http {
+
+//!
+//! reason phrases
+//!
+const char*
+status_to_reason_phrase(unsigned int status) {
+  switch (status) {
+  case 100: return "Continue";
+  case 101: return "Switching Protocols";
+  case 200: return "OK";
+  case 201: return "Created";
+  case 202: return "Accepted";
+  case 203: return "Non-Authoritative Information";
+  case 204: return "No Content";
+  case 205: return "Reset Content";
+  case 206: return "Partial Content";
+  case 300: return "Multiple Choices";
+  case 301: return "Moved Permanently";
+  case 302: return "Found";
+  case 303: return "See Other";
+  case 304: return "Not Modified";
+  case 305: return "Use Proxy";
+  case 307: return "Temporary Redirect";
+  case 308: return "Permanent Redirect";
+  case 400: return "Bad Request";
+  case 401: return "Unauthorized";
+  case 402: return "Payment Required";
+  case 403: return "Forbidden";
+  case 404: return "Not Found";
+  case 405: return "Method Not Allowed";
+  case 406: return "Not Acceptable";
+  case 407: return "Proxy Authentication Required";
+  case 408: return "Request Timeout";
+  case 409: return "Conflict";
+  case 410: return "Gone";
+  case 411: return "Length Required";
+  case 412: return "Precondition Failed";
+  case 413: return "Payload Too Large";
+  case 414: return "URI Too Long";
+  case 415: return "Unsupported Media Type";
+  case 416: return "Range Not Satisfiable";
+  case 417: return "Expectation Failed";
+  case 426: return "Upgrade Required";
+  case 428: return "Precondition Required";
+  case 429: return "Too Many Requests";
+  case 431: return "Request Header Fields Too Large";
+  case 500: return "Internal Server Error";
+  case 501: return "Not Implemented";
+  case 502: return "Bad Gateway";
+  case 503: return "Service Unavailable";
+  case 504: return "Gateway Timeout";
+  case 505: return "HTTP Version Not Supported";
+  default: return "Unknown";
+  }
+}
+
+
+//!
+//! status lines
+//!
+const std::string*
+status_to_status_line(unsigned int status) {
+  //! indexed by status code, empty for non-standard ones
+  static const std::vector<std::string> lines = [] {
+    std::vector<std::string> lines(600);
+
+    for (unsigned int status = 100; status < lines.size(); ++status) {
+      const char* reason = status_to_reason_phrase(status);
+
+      if (std::strcmp(reason, "Unknown"))
+        lines[status] = "HTTP/1.1 " + std::to_string(status) + " " + reason + "\r\n";
+    }
+
+    return lines;
+  }();
+
+  if (status >= lines.size() || lines[status].empty())
+    return nullptr;
+
+  return &lines[status];
+}
+
+
+//!
+//! error packets
+//!
+static std::string
+build_error_packet(unsigned int status) {
+  std::string body = std::to_string(status) + " " + status_to_reason_phrase(status) + "\n";
+
+  return "HTTP/1.1 " + std::to_string(status) + " " + status_to_reason_phrase(status) + "\r\n"
+         + "Content-Type: text/plain\r\n"
+         + "Content-Length: " + std::to_string(body.size()) + "\r\n"
+         + "Connection: close\r\n"
+         + "\r\n"
+         + body;
+}
+
+const std::string&
+status_to_error_packet(unsigned int status) {
+  //! packets for the errors reported by the server itself
+  static const std::unordered_map<unsigned int, std::string> packets = {
+    {400, build_error_packet(400)},
+    {404, build_error_packet(404)},
+    {408, build_error_packet(408)},
+    {413, build_error_packet(413)},
+    {414, build_error_packet(414)},
+    {429, build_error_packet(429)},
+    {431, build_error_packet(431)},
+    {500, build_error_packet(500)},
+    {501, build_error_packet(501)},
+    {503, build_error_packet(503)},
+    {505, build_error_packet(505)}};
+
+  auto packet = packets.find(status);
+
+  //! other statuses fall back to a generic error
+  return packet != packets.end() ? packet->second : packets.at(status >= 500 ? 500 : 400);
+}
+
+} // namespace http
+
+} // namespace netflex
@@ -0,0 +1,220 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <cctype>
+#include <cstdio>
+#include <functional>
+
+#include <netflex/middlewares/etag.hpp>
+#include <netflex/misc/hash.hpp>
+
+namespace netflex {
+
+namespace middlewares {
+
+//!
+//! case insensitive header name comparison
+//!
+static bool
+is_header(const std::string& name, const char* expected) {
+  std::size_t i = 0;
+
+  for (; i < name.size() && expected[i]; ++i)
+    if (std::tolower(static_cast<unsigned char>(name[i])) != std::tolower(static_cast<unsigned char>(expected[i])))
+      return false;
+
+  return i == name.size() && !expected[i];
+}
+
+
+//!
+//! ctor & dtor
+//!
+etag::etag(std::chrono::milliseconds cache_ttl, std::size_t max_cached_etags)
+: m_cache_ttl(cache_ttl)
+, m_max_cached_etags(max_cached_etags)
+, m_nb_not_modified(0)
+, m_nb_cache_hits(0) {}
+
+
+//!
+//! middleware
+//!
+routing::middleware_t
+etag::get_middleware(void) {
+  return std::bind(&etag::process, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
+}
+
+void
+etag::process(routing::middleware_chain& chain, http::request& request, http::response& response) {
+  if (request.get_method() != http::method::GET && request.get_method() != http::method::HEAD) {
+    chain.proceed();
+    return;
+  }
+
+  const std::string* if_none_match = http::find_header(request.get_headers(), "If-None-Match");
+  std::string key                  = m_cache_ttl.count() > 0 ? request.get_raw_method() + ' ' + request.get_target() : "";
+  std::string value;
+
+  //! unchanged resource according to the cached ETag: skip the route
+  if (if_none_match && !key.empty() && get_cached_etag(key, value) && matches(*if_none_match, value)) {
+    set_not_modified(response, value);
+
+    ++m_nb_cache_hits;
+    ++m_nb_not_modified;
+    return;
+  }
+
+  chain.proceed();
+
+  //! raw packets cannot get a header: the response cache and the single flight serve structured responses for that reason
+  if (response.get_status_code() != 200 || response.get_raw_packet())
+    return;
+
+  const std::string* existing = http::find_header(response.get_headers(), "ETag");
+  value                       = existing ? *existing : compute(response.get_body());
+
+  if (!existing)
+    response.add_header({"ETag", value});
+
+  if (!key.empty())
+    cache_etag(key, value);
+
+  if (if_none_match && matches(*if_none_match, value)) {
+    set_not_modified(response, value);
+    ++m_nb_not_modified;
+  }
+}
+
+
+//!
+//! ETags
+//!
+std::string
+etag::compute(const std::string& body) {
+  char etag[19];
+  std::snprintf(etag, sizeof(etag), "\"%016llx\"", static_cast<unsigned long long>(misc::xxhash64(body.data(), body.size())));
+
+  return etag;
+}
+
+bool
+etag::matches(const std::string& if_none_match, const std::string& etag) {
+  //! weak comparison: W/ prefixes are ignored
+  std::string opaque_etag = etag.compare(0, 2, "W/") == 0 ? etag.substr(2) : etag;
+  std::size_t pos         = 0;
+
+  while (pos < if_none_match.size()) {
+    std::size_t end = if_none_match.find(',', pos);
+    if (end == std::string::npos)
+      end = if_none_match.size();
+
+    std::size_t begin = pos;
+    while (begin < end && std::isspace(static_cast<unsigned char>(if_none_match[begin])))
+      ++begin;
+    std::size_t last = end;
+    while (last > begin && std::isspace(static_cast<unsigned char>(if_none_match[last - 1])))
+      --last;
+
+    std::string candidate = if_none_match.substr(begin, last - begin);
+    if (candidate.compare(0, 2, "W/") == 0)
+      candidate = candidate.substr(2);
+
+    if (candidate == "*" || candidate == opaque_etag)
+      return true;
+
+    pos = end + 1;
+  }
+
+  return false;
+}
+
+void
+etag::set_not_modified(http::response& response, const std::string& etag) {
+  http::header_list_t headers;
+
+  //! a 304 has no body: drop the headers describing it
+  for (const auto& header : response.get_headers())
+    if (!is_header(header.first, "Content-Length") && !is_header(header.first, "Content-Type") && !is_header(header.first, "Transfer-Encoding") && !is_header(header.first, "ETag"))
+      headers.insert(header);
+
+  headers["ETag"] = etag;
+
+  response.set_status_code(304);
+  response.set_reason_phrase("Not Modified");
+  response.set_headers(headers);
+  response.set_body("");
+  response.set_raw_packet(nullptr);
+}
+
+
+//!
+//! ETags cache
+//!
+bool
+etag::get_cached_etag(const std::string& key, std::string& value) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto cached = m_cached_etags.find(key);
+  if (cached == m_cached_etags.end())
+    return false;
+
+  if (cached->second.expires_at <= std::chrono::steady_clock::now()) {
+    m_cached_etags.erase(cached);
+    return false;
+  }
+
+  value = cached->second.value;
+
+  return true;
+}
+
+void
+etag::cache_etag(const std::string& key, const std::string& value) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  //! bounded: drop an arbitrary entry, its target only loses the shortcut until its next request
+  if (m_cached_etags.size() >= m_max_cached_etags && !m_cached_etags.count(key) && !m_cached_etags.empty())
+    m_cached_etags.erase(m_cached_etags.begin());
+
+  if (m_max_cached_etags)
+    m_cached_etags[key] = {value, std::chrono::steady_clock::now() + m_cache_ttl};
+}
+
+
+//!
+//! counters
+//!
+std::uint64_t
+etag::get_nb_not_modified(void) const {
+  return m_nb_not_modified;
+}
+
+std::uint64_t
+etag::get_nb_cache_hits(void) const {
+  return m_nb_cache_hits;
+}
+
+} // namespace middlewares
+
+} // namespace netflex
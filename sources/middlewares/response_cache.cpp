@@ -0,0 +1,393 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <algorithm>
+#include <cctype>
+#include <functional>
+
+#include <netflex/middlewares/response_cache.hpp>
+#include <netflex/misc/http_date.hpp>
+
+namespace netflex {
+
+namespace middlewares {
+
+//!
+//! Cache-Control directives relevant to a shared cache
+//!
+struct cache_control {
+  bool no_store   = false;
+  bool no_cache   = false;
+  bool is_private = false;
+  long max_age    = -1;
+  long s_maxage   = -1;
+};
+
+static std::string
+trim_lower(const std::string& str, std::size_t begin, std::size_t end) {
+  while (begin < end && std::isspace(static_cast<unsigned char>(str[begin])))
+    ++begin;
+  while (end > begin && std::isspace(static_cast<unsigned char>(str[end - 1])))
+    --end;
+
+  std::string trimmed = str.substr(begin, end - begin);
+  std::transform(trimmed.begin(), trimmed.end(), trimmed.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+  return trimmed;
+}
+
+//!
+//! split a comma separated header value into lowercase trimmed elements
+//!
+static std::vector<std::string>
+split_list(const std::string* value) {
+  std::vector<std::string> elements;
+
+  if (!value)
+    return elements;
+
+  std::size_t begin = 0;
+  while (begin <= value->size()) {
+    std::size_t end = value->find(',', begin);
+    if (end == std::string::npos)
+      end = value->size();
+
+    std::string element = trim_lower(*value, begin, end);
+    if (!element.empty())
+      elements.push_back(element);
+
+    begin = end + 1;
+  }
+
+  return elements;
+}
+
+static long
+parse_seconds(const std::string& directive, std::size_t value_pos) {
+  long seconds = 0;
+
+  for (std::size_t i = value_pos; i < directive.size(); ++i) {
+    if (directive[i] == '"')
+      continue;
+    if (!std::isdigit(static_cast<unsigned char>(directive[i])))
+      return -1;
+
+    seconds = std::min(seconds * 10 + (directive[i] - '0'), 0x7fffffffL);
+  }
+
+  return seconds;
+}
+
+static cache_control
+parse_cache_control(const std::string* value) {
+  cache_control directives;
+
+  for (const auto& directive : split_list(value)) {
+    if (directive == "no-store")
+      directives.no_store = true;
+    else if (directive.compare(0, 8, "no-cache") == 0)
+      directives.no_cache = true;
+    else if (directive.compare(0, 7, "private") == 0)
+      directives.is_private = true;
+    else if (directive.compare(0, 8, "max-age=") == 0)
+      directives.max_age = parse_seconds(directive, 8);
+    else if (directive.compare(0, 9, "s-maxage=") == 0)
+      directives.s_maxage = parse_seconds(directive, 9);
+  }
+
+  return directives;
+}
+
+//!
+//! statuses cacheable by default (RFC 7231, section 6.1)
+//!
+static bool
+is_cacheable_status(unsigned int status) {
+  switch (status) {
+  case 200:
+  case 203:
+  case 204:
+  case 300:
+  case 301:
+  case 404:
+  case 405:
+  case 410:
+  case 414:
+  case 501:
+    return true;
+  default:
+    return false;
+  }
+}
+
+//!
+//! full key: base key, then the values of the vary headers
+//!
+static std::string
+build_key(const http::request& request, const std::string& base_key, const std::vector<std::string>& vary) {
+  std::string key = base_key;
+
+  for (const auto& name : vary) {
+    const std::string* value = http::find_header(request.get_headers(), name);
+
+    key += '\n';
+    key += name;
+    key += ':';
+    if (value)
+      key += *value;
+  }
+
+  return key;
+}
+
+//!
+//! headers rewritten on each hit
+//!
+static bool
+is_hit_header(const std::string& name) {
+  std::string lower = trim_lower(name, 0, name.size());
+
+  return lower == "date" || lower == "age";
+}
+
+//!
+//! approximated bookkeeping cost of an entry, on top of its keys, headers and body
+//!
+static const std::size_t entry_overhead = 128;
+
+
+//!
+//! ctor & dtor
+//!
+response_cache::response_cache(std::size_t max_memory, std::chrono::seconds default_ttl, std::size_t nb_shards)
+: m_max_shard_memory(max_memory / std::max<std::size_t>(nb_shards, 1))
+, m_default_ttl(default_ttl)
+, m_nb_hits(0)
+, m_nb_misses(0) {
+  for (std::size_t i = 0; i < std::max<std::size_t>(nb_shards, 1); ++i) {
+    m_shards.emplace_back(new shard);
+    m_shards.back()->memory = 0;
+  }
+}
+
+
+//!
+//! middleware
+//!
+routing::middleware_t
+response_cache::get_middleware(void) {
+  return std::bind(&response_cache::process, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
+}
+
+void
+response_cache::process(routing::middleware_chain& chain, http::request& request, http::response& response) {
+  bool is_cacheable_method = request.get_method() == http::method::GET || request.get_method() == http::method::HEAD;
+
+  cache_control request_directives = parse_cache_control(http::find_header(request.get_headers(), "Cache-Control"));
+
+  if (!is_cacheable_method || request_directives.no_store || http::find_header(request.get_headers(), "Authorization")) {
+    chain.proceed();
+    return;
+  }
+
+  //! virtual hosts share the server middlewares: the host is part of the key (lowercase, port kept)
+  const std::string* host = http::find_header(request.get_headers(), "Host");
+  std::string base_key    = request.get_raw_method() + ' ' + (host ? trim_lower(*host, 0, host->size()) : "") + ' ' + request.get_target();
+
+  if (!request_directives.no_cache && lookup(request, base_key, response)) {
+    ++m_nb_hits;
+    return;
+  }
+
+  ++m_nb_misses;
+  chain.proceed();
+  store(request, base_key, response);
+}
+
+
+//!
+//! lookup & store
+//!
+response_cache::shard&
+response_cache::get_shard(const std::string& base_key) {
+  return *m_shards[std::hash<std::string>()(base_key) % m_shards.size()];
+}
+
+bool
+response_cache::lookup(const http::request& request, const std::string& base_key, http::response& response) {
+  shard& shard = get_shard(base_key);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+
+  auto vary = shard.vary.find(base_key);
+  if (vary == shard.vary.end())
+    return false;
+
+  const std::vector<std::string>& vary_names = vary->second.names;
+
+  auto it = shard.entries.find(vary_names.empty() ? base_key : build_key(request, base_key, vary_names));
+  if (it == shard.entries.end())
+    return false;
+
+  if (it->second->expires_at <= std::chrono::steady_clock::now()) {
+    remove(shard, it->second);
+    return false;
+  }
+
+  //! most recently used first
+  shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+
+  //! stored without Date: the response is dated now, its Age telling how long ago it was generated
+  http::header_list_t headers = it->second->headers;
+  headers["Date"]             = *misc::http_date();
+  headers["Age"]              = std::to_string(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - it->second->stored_at).count());
+
+  response.set_status_code(it->second->status);
+  response.set_reason_phrase(it->second->reason);
+  response.set_headers(headers);
+  response.set_body(it->second->body);
+  response.set_raw_packet(nullptr);
+
+  return true;
+}
+
+void
+response_cache::store(const http::request& request, const std::string& base_key, http::response& response) {
+  if (!is_cacheable_status(response.get_status_code()) || response.get_raw_packet())
+    return;
+
+  const http::header_list_t& headers = response.get_headers();
+  cache_control directives           = parse_cache_control(http::find_header(headers, "Cache-Control"));
+
+  if (directives.no_store || directives.no_cache || directives.is_private || http::find_header(headers, "Set-Cookie"))
+    return;
+
+  //! shared cache: s-maxage wins over max-age
+  long ttl = directives.s_maxage >= 0 ? directives.s_maxage : directives.max_age >= 0 ? directives.max_age : static_cast<long>(m_default_ttl.count());
+  if (ttl <= 0)
+    return;
+
+  std::vector<std::string> vary = split_list(http::find_header(headers, "Vary"));
+  if (std::find(vary.begin(), vary.end(), "*") != vary.end())
+    return;
+
+  std::string key    = vary.empty() ? base_key : build_key(request, base_key, vary);
+  std::size_t memory = base_key.size() + key.size() + response.get_body().size() + entry_overhead;
+
+  http::header_list_t stored_headers;
+  for (const auto& header : headers) {
+    if (!is_hit_header(header.first)) {
+      stored_headers.insert(header);
+      memory += header.first.size() + header.second.size();
+    }
+  }
+
+  if (memory > m_max_shard_memory)
+    return;
+
+  shard& shard = get_shard(base_key);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+
+  auto existing = shard.entries.find(key);
+  if (existing != shard.entries.end())
+    remove(shard, existing->second);
+
+  //! make room, least recently used first
+  while (shard.memory + memory > m_max_shard_memory && !shard.lru.empty())
+    remove(shard, std::prev(shard.lru.end()));
+
+  //! the latest response defines the vary headers of the target
+  vary_headers& target_vary = shard.vary[base_key];
+  target_vary.names         = vary;
+  ++target_vary.nb_entries;
+
+  //! the body is shared with the response being sent, not copied
+  auto now = std::chrono::steady_clock::now();
+  shard.lru.push_front({base_key, key, response.get_status_code(), response.get_reason_phase(), stored_headers, response.share_body(), now, now + std::chrono::seconds(ttl), memory});
+  shard.entries[key] = shard.lru.begin();
+  shard.memory += memory;
+}
+
+void
+response_cache::remove(shard& shard, std::list<entry>::iterator it) {
+  auto vary = shard.vary.find(it->base_key);
+  if (vary != shard.vary.end() && --vary->second.nb_entries == 0)
+    shard.vary.erase(vary);
+
+  shard.memory -= it->memory;
+  shard.entries.erase(it->key);
+  shard.lru.erase(it);
+}
+
+
+//!
+//! state
+//!
+void
+response_cache::clear(void) {
+  for (auto& shard : m_shards) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+
+    shard->lru.clear();
+    shard->entries.clear();
+    shard->vary.clear();
+    shard->memory = 0;
+  }
+}
+
+std::size_t
+response_cache::size(void) const {
+  std::size_t size = 0;
+
+  for (const auto& shard : m_shards) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    size += shard->lru.size();
+  }
+
+  return size;
+}
+
+std::size_t
+response_cache::get_memory_usage(void) const {
+  std::size_t memory = 0;
+
+  for (const auto& shard : m_shards) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    memory += shard->memory;
+  }
+
+  return memory;
+}
+
+std::uint64_t
+response_cache::get_nb_hits(void) const {
+  return m_nb_hits;
+}
+
+std::uint64_t
+response_cache::get_nb_misses(void) const {
+  return m_nb_misses;
+}
+
+} // namespace middlewares
+
+} // namespace netflex
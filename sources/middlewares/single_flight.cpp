@@ -0,0 +1,255 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <cctype>
+#include <functional>
+
+#include <netflex/middlewares/single_flight.hpp>
+
+namespace netflex {
+
+namespace middlewares {
+
+//!
+//! case insensitive header name comparison
+//!
+static bool
+is_same_header(const std::string& lhs, const std::string& rhs) {
+  if (lhs.size() != rhs.size())
+    return false;
+
+  for (std::size_t i = 0; i < lhs.size(); ++i)
+    if (std::tolower(static_cast<unsigned char>(lhs[i])) != std::tolower(static_cast<unsigned char>(rhs[i])))
+      return false;
+
+  return true;
+}
+
+
+//!
+//! ctor & dtor
+//!
+single_flight::single_flight(const std::vector<std::string>& key_headers, std::chrono::milliseconds max_wait)
+: m_key_headers(key_headers)
+, m_max_wait(max_wait)
+, m_nb_coalesced(0) {}
+
+
+//!
+//! middleware
+//!
+routing::middleware_t
+single_flight::get_middleware(void) {
+  return std::bind(&single_flight::process, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
+}
+
+void
+single_flight::process(routing::middleware_chain& chain, http::request& request, http::response& response) {
+  bool is_idempotent = request.get_method() == http::method::GET || request.get_method() == http::method::HEAD;
+
+  if (!is_idempotent || carries_credentials(request)) {
+    chain.proceed();
+    return;
+  }
+
+  std::string key = build_key(request);
+  std::shared_ptr<flight> current;
+  bool is_leader = false;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::shared_ptr<flight>& existing = m_flights[key];
+    if (!existing) {
+      existing         = std::make_shared<flight>();
+      existing->done   = false;
+      existing->shared = false;
+      is_leader        = true;
+    }
+
+    current = existing;
+  }
+
+  if (is_leader)
+    lead(chain, response, key, current);
+  else
+    follow(chain, response, current);
+}
+
+
+//!
+//! leader & followers
+//!
+void
+single_flight::lead(routing::middleware_chain& chain, http::response& response, const std::string& key, const std::shared_ptr<flight>& current) {
+  //! release the followers, and let the next identical request lead a new flight
+  auto complete = [&](bool shared) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    current->done   = true;
+    current->shared = shared;
+    if (shared)
+      current->response = response;
+
+    m_flights.erase(key);
+    current->completed.notify_all();
+  };
+
+  try {
+    chain.proceed();
+  }
+  catch (...) {
+    //! followers compute the response themselves
+    complete(false);
+    throw;
+  }
+
+  //! private responses, or negotiated on headers outside of the key, are for the leader only: followers compute their own
+  const http::header_list_t& headers = response.get_headers();
+  bool is_shareable                  = !http::find_header(headers, "Set-Cookie") && !http::has_header_token(headers, "Cache-Control", "private") && !http::has_header_token(headers, "Cache-Control", "no-store") && is_keyed_vary(headers);
+
+  //! the body is shared with the followers, not copied
+  if (is_shareable)
+    response.share_body();
+
+  complete(is_shareable);
+}
+
+void
+single_flight::follow(routing::middleware_chain& chain, http::response& response, const std::shared_ptr<flight>& current) {
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (current->completed.wait_for(lock, m_max_wait, [&] { return current->done; }) && current->shared) {
+      response = current->response;
+
+      ++m_nb_coalesced;
+      return;
+    }
+  }
+
+  //! leader too slow, failed or private response: compute the response ourselves
+  chain.proceed();
+}
+
+
+//!
+//! key
+//!
+std::string
+single_flight::build_key(const http::request& request) const {
+  //! virtual hosts share the server middlewares: the host is always part of the key (lowercase, port kept)
+  const std::string* host = http::find_header(request.get_headers(), "Host");
+  std::string key         = request.get_raw_method() + ' ';
+
+  if (host)
+    for (char c : *host)
+      key += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+
+  key += ' ' + request.get_target();
+
+  for (const auto& name : m_key_headers) {
+    const std::string* value = http::find_header(request.get_headers(), name);
+
+    key += '\n';
+    if (value)
+      key += *value;
+  }
+
+  return key;
+}
+
+bool
+single_flight::is_keyed(const std::string& name) const {
+  if (is_same_header(name, "Host"))
+    return true;
+
+  for (const auto& key_header : m_key_headers)
+    if (is_same_header(key_header, name))
+      return true;
+
+  return false;
+}
+
+bool
+single_flight::is_keyed_vary(const http::header_list_t& headers) const {
+  const std::string* vary = http::find_header(headers, "Vary");
+  if (!vary)
+    return true;
+
+  std::size_t pos = 0;
+  while (pos <= vary->size()) {
+    std::size_t end = vary->find(',', pos);
+    if (end == std::string::npos)
+      end = vary->size();
+
+    std::size_t begin = pos;
+    while (begin < end && std::isspace(static_cast<unsigned char>((*vary)[begin])))
+      ++begin;
+    std::size_t last = end;
+    while (last > begin && std::isspace(static_cast<unsigned char>((*vary)[last - 1])))
+      --last;
+
+    //! Vary: * included
+    if (last > begin && !is_keyed(vary->substr(begin, last - begin)))
+      return false;
+
+    pos = end + 1;
+  }
+
+  return true;
+}
+
+bool
+single_flight::carries_credentials(const http::request& request) const {
+  for (const char* name : {"Authorization", "Cookie"}) {
+    if (!http::find_header(request.get_headers(), name))
+      continue;
+
+    //! responses to credentials are only shared if the credentials are part of the key
+    if (!is_keyed(name))
+      return true;
+  }
+
+  return false;
+}
+
+
+//!
+//! stats
+//!
+std::size_t
+single_flight::get_nb_in_flight(void) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  return m_flights.size();
+}
+
+std::uint64_t
+single_flight::get_nb_coalesced(void) const {
+  return m_nb_coalesced;
+}
+
+} // namespace middlewares
+
+} // namespace netflex
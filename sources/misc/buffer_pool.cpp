@@ -0,0 +1,93 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <netflex/misc/buffer_pool.hpp>
+
+namespace netflex {
+
+namespace misc {
+
+//!
+//! limits
+//!
+const std::size_t buffer_pool::max_buffers_per_thread;
+const std::size_t buffer_pool::max_buffer_capacity;
+
+
+//!
+//! buffers kept by the current thread
+//!
+static std::vector<std::vector<char>>&
+thread_buffers(void) {
+  static thread_local std::vector<std::vector<char>> buffers;
+
+  return buffers;
+}
+
+
+//!
+//! acquire & release
+//!
+std::vector<char>
+buffer_pool::acquire(std::size_t capacity) {
+  std::vector<std::vector<char>>& buffers = thread_buffers();
+  std::vector<char> buffer;
+
+  if (!buffers.empty()) {
+    buffer = std::move(buffers.back());
+    buffers.pop_back();
+  }
+
+  buffer.reserve(capacity);
+
+  return buffer;
+}
+
+void
+buffer_pool::release(std::vector<char>&& buffer) {
+  std::vector<std::vector<char>>& buffers = thread_buffers();
+
+  if (!buffer.capacity() || buffer.capacity() > max_buffer_capacity || buffers.size() >= max_buffers_per_thread)
+    return;
+
+  buffer.clear();
+  buffers.push_back(std::move(buffer));
+}
+
+
+//!
+//! pool state
+//!
+std::size_t
+buffer_pool::size(void) {
+  return thread_buffers().size();
+}
+
+void
+buffer_pool::clear(void) {
+  thread_buffers().clear();
+}
+
+} // namespace misc
+
+} // namespace netflex
@@ -0,0 +1,170 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <algorithm>
+#include <cmath>
+
+#include <netflex/misc/concurrency_limiter.hpp>
+
+namespace netflex {
+
+namespace misc {
+
+//!
+//! weights of the new samples in the short and long term latency averages
+//!
+static const double short_latency_weight = 0.1;
+static const double long_latency_weight  = 1.0 / 600;
+
+//!
+//! short term latency tolerated over the long term one before shrinking the limit
+//!
+static const double latency_tolerance = 1.5;
+
+//!
+//! weight of the new estimation in the limit
+//!
+static const double limit_smoothing = 0.2;
+
+
+//!
+//! ctor
+//!
+concurrency_limiter::concurrency_limiter(std::uint32_t initial_limit, std::uint32_t min_limit, std::uint32_t max_limit)
+: m_min_limit(std::max(min_limit, 1U))
+, m_max_limit(std::max(max_limit, m_min_limit))
+, m_short_latency(0)
+, m_long_latency(0)
+, m_in_flight(0)
+, m_nb_rejected(0) {
+  m_estimated_limit = std::min(std::max(initial_limit, m_min_limit), m_max_limit);
+  m_limit           = static_cast<std::uint32_t>(m_estimated_limit);
+}
+
+
+//!
+//! admission
+//!
+bool
+concurrency_limiter::try_acquire(void) {
+  if (m_in_flight.fetch_add(1) < m_limit.load(std::memory_order_relaxed))
+    return true;
+
+  --m_in_flight;
+  ++m_nb_rejected;
+
+  return false;
+}
+
+void
+concurrency_limiter::release(std::uint64_t latency) {
+  std::uint32_t in_flight = m_in_flight.fetch_sub(1);
+
+  //! a sample less does not matter: completing requests never wait for each other
+  std::unique_lock<std::mutex> lock(m_update_mutex, std::try_to_lock);
+  if (lock.owns_lock())
+    update(static_cast<double>(latency), in_flight);
+}
+
+void
+concurrency_limiter::update(double latency, std::uint32_t in_flight) {
+  if (m_long_latency == 0) {
+    m_short_latency = latency;
+    m_long_latency  = latency;
+  }
+  else {
+    m_short_latency += (latency - m_short_latency) * short_latency_weight;
+    m_long_latency += (latency - m_long_latency) * long_latency_weight;
+  }
+
+  //! long term latency caught up by a lasting load: let it come back once the load is gone
+  if (m_long_latency > 2 * m_short_latency)
+    m_long_latency *= 0.95;
+
+  //! limit not reached: latency says nothing about it, do not grow it forever
+  if (in_flight < m_estimated_limit / 2)
+    return;
+
+  double gradient  = std::max(0.5, std::min(1.0, latency_tolerance * m_long_latency / m_short_latency));
+  double new_limit = m_estimated_limit * gradient + std::sqrt(m_estimated_limit);
+
+  m_estimated_limit = m_estimated_limit * (1 - limit_smoothing) + new_limit * limit_smoothing;
+  m_estimated_limit = std::min(std::max(m_estimated_limit, static_cast<double>(m_min_limit)), static_cast<double>(m_max_limit));
+
+  m_limit.store(static_cast<std::uint32_t>(m_estimated_limit), std::memory_order_relaxed);
+}
+
+
+//!
+//! permit
+//!
+concurrency_limiter::permit::permit(void)
+: m_limiter(nullptr) {}
+
+concurrency_limiter::permit::~permit(void) {
+  if (m_limiter)
+    release(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_acquired_at).count()));
+}
+
+bool
+concurrency_limiter::permit::acquire(concurrency_limiter& limiter) {
+  if (!limiter.try_acquire())
+    return false;
+
+  m_limiter     = &limiter;
+  m_acquired_at = std::chrono::steady_clock::now();
+
+  return true;
+}
+
+void
+concurrency_limiter::permit::release(std::uint64_t latency) {
+  if (!m_limiter)
+    return;
+
+  m_limiter->release(latency);
+  m_limiter = nullptr;
+}
+
+
+//!
+//! stats
+//!
+std::uint32_t
+concurrency_limiter::get_limit(void) const {
+  return m_limit;
+}
+
+std::uint32_t
+concurrency_limiter::get_nb_in_flight(void) const {
+  return m_in_flight;
+}
+
+std::uint64_t
+concurrency_limiter::get_nb_rejected(void) const {
+  return m_nb_rejected;
+}
+
+} // namespace misc
+
+} // namespace netflex
@@ -0,0 +1,134 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <netflex/misc/hash.hpp>
+
+namespace netflex {
+
+namespace misc {
+
+//!
+//! XXH64 primes
+//!
+static const std::uint64_t prime_1 = 0x9E3779B185EBCA87ULL;
+static const std::uint64_t prime_2 = 0xC2B2AE3D27D4EB4FULL;
+static const std::uint64_t prime_3 = 0x165667B19E3779F9ULL;
+static const std::uint64_t prime_4 = 0x85EBCA77C2B2AE63ULL;
+static const std::uint64_t prime_5 = 0x27D4EB2F165667C5ULL;
+
+static std::uint64_t
+rotl(std::uint64_t value, unsigned int bits) {
+  return (value << bits) | (value >> (64 - bits));
+}
+
+//!
+//! little endian reads, byte by byte so that alignment and endianness do not matter (compilers turn them into single loads)
+//!
+static std::uint64_t
+read_64(const unsigned char* p) {
+  return static_cast<std::uint64_t>(p[0]) | static_cast<std::uint64_t>(p[1]) << 8 | static_cast<std::uint64_t>(p[2]) << 16 | static_cast<std::uint64_t>(p[3]) << 24 | static_cast<std::uint64_t>(p[4]) << 32 | static_cast<std::uint64_t>(p[5]) << 40 | static_cast<std::uint64_t>(p[6]) << 48 | static_cast<std::uint64_t>(p[7]) << 56;
+}
+
+static std::uint64_t
+read_32(const unsigned char* p) {
+  return static_cast<std::uint64_t>(p[0]) | static_cast<std::uint64_t>(p[1]) << 8 | static_cast<std::uint64_t>(p[2]) << 16 | static_cast<std::uint64_t>(p[3]) << 24;
+}
+
+static std::uint64_t
+accumulate(std::uint64_t accumulator, std::uint64_t input) {
+  accumulator += input * prime_2;
+  accumulator = rotl(accumulator, 31);
+
+  return accumulator * prime_1;
+}
+
+static std::uint64_t
+merge_round(std::uint64_t accumulator, std::uint64_t value) {
+  accumulator ^= accumulate(0, value);
+
+  return accumulator * prime_1 + prime_4;
+}
+
+
+//!
+//! hash
+//!
+std::uint64_t
+xxhash64(const void* data, std::size_t size, std::uint64_t seed) {
+  const unsigned char* p   = static_cast<const unsigned char*>(data);
+  const unsigned char* end = p + size;
+  std::uint64_t hash;
+
+  if (size >= 32) {
+    //! 4 independent lanes of 8 bytes, consumed by stripes of 32 bytes
+    std::uint64_t v1 = seed + prime_1 + prime_2;
+    std::uint64_t v2 = seed + prime_2;
+    std::uint64_t v3 = seed;
+    std::uint64_t v4 = seed - prime_1;
+
+    const unsigned char* limit = end - 32;
+    do {
+      v1 = accumulate(v1, read_64(p));
+      v2 = accumulate(v2, read_64(p + 8));
+      v3 = accumulate(v3, read_64(p + 16));
+      v4 = accumulate(v4, read_64(p + 24));
+      p += 32;
+    } while (p <= limit);
+
+    hash = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+    hash = merge_round(hash, v1);
+    hash = merge_round(hash, v2);
+    hash = merge_round(hash, v3);
+    hash = merge_round(hash, v4);
+  }
+  else {
+    hash = seed + prime_5;
+  }
+
+  hash += static_cast<std::uint64_t>(size);
+
+  //! remaining bytes
+  for (; p + 8 <= end; p += 8)
+    hash = rotl(hash ^ accumulate(0, read_64(p)), 27) * prime_1 + prime_4;
+
+  if (p + 4 <= end) {
+    hash = rotl(hash ^ (read_32(p) * prime_1), 23) * prime_2 + prime_3;
+    p += 4;
+  }
+
+  for (; p < end; ++p)
+    hash = rotl(hash ^ (*p * prime_5), 11) * prime_1;
+
+  //! avalanche
+  hash ^= hash >> 33;
+  hash *= prime_2;
+  hash ^= hash >> 29;
+  hash *= prime_3;
+  hash ^= hash >> 32;
+
+  return hash;
+}
+
+} // namespace misc
+
+} // namespace netflex
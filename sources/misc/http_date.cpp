@@ -0,0 +1,83 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+
+#include <netflex/misc/http_date.hpp>
+
+namespace netflex {
+
+namespace misc {
+
+//!
+//! formatting
+//!
+std::string
+format_http_date(std::time_t time) {
+  static const char* days[]   = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+  static const char* months[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+
+  std::tm tm;
+#ifdef _WIN32
+  gmtime_s(&tm, &time);
+#else
+  gmtime_r(&time, &tm);
+#endif /* _WIN32 */
+
+  char date[32];
+  std::snprintf(date, sizeof(date), "%s, %02d %s %04d %02d:%02d:%02d GMT", days[tm.tm_wday], tm.tm_mday, months[tm.tm_mon], tm.tm_year + 1900, tm.tm_hour, tm.tm_min, tm.tm_sec);
+
+  return date;
+}
+
+
+//!
+//! cached date
+//!
+std::shared_ptr<const std::string>
+http_date(void) {
+  //! date is read and replaced with the atomic shared_ptr functions
+  static std::atomic<std::time_t> date_time(std::time(nullptr));
+  static std::shared_ptr<const std::string> date = std::make_shared<const std::string>(format_http_date(date_time));
+  static std::mutex refresh_mutex;
+
+  std::time_t now = std::time(nullptr);
+
+  if (date_time.load(std::memory_order_acquire) != now) {
+    //! a single thread formats the new date, the others keep the previous one meanwhile
+    std::unique_lock<std::mutex> lock(refresh_mutex, std::try_to_lock);
+
+    if (lock.owns_lock() && date_time.load(std::memory_order_relaxed) != now) {
+      std::atomic_store(&date, std::make_shared<const std::string>(format_http_date(now)));
+      date_time.store(now, std::memory_order_release);
+    }
+  }
+
+  return std::atomic_load(&date);
+}
+
+} // namespace misc
+
+} // namespace netflex
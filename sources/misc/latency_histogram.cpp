@@ -0,0 +1,184 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <netflex/misc/latency_histogram.hpp>
+
+namespace netflex {
+
+namespace misc {
+
+//!
+//! ctor & dtor
+//!
+latency_histogram::latency_histogram(void) {
+  reset();
+}
+
+
+//!
+//! bucket computation
+//!
+unsigned int
+latency_histogram::bucket_index(std::uint64_t value) {
+  //! small values have a dedicated bucket each
+  if (value < 2 * sub_bucket_count)
+    return static_cast<unsigned int>(value);
+
+  //! position of the highest bit set
+  unsigned int exponent = 63;
+#if defined(__GNUC__) || defined(__clang__)
+  exponent -= __builtin_clzll(value);
+#else
+  while (!(value & (1ULL << exponent)))
+    --exponent;
+#endif /* __GNUC__ || __clang__ */
+
+  //! keep the sub_bucket_bits bits following the highest bit set
+  unsigned int sub_bucket = static_cast<unsigned int>(value >> (exponent - sub_bucket_bits)) - sub_bucket_count;
+
+  return (exponent - sub_bucket_bits + 1) * sub_bucket_count + sub_bucket;
+}
+
+std::uint64_t
+latency_histogram::bucket_upper_bound(unsigned int index) {
+  if (index < 2 * sub_bucket_count)
+    return index;
+
+  unsigned int exponent = index / sub_bucket_count + sub_bucket_bits - 1;
+  std::uint64_t mantissa = sub_bucket_count + index % sub_bucket_count;
+  unsigned int shift     = exponent - sub_bucket_bits;
+
+  //! last value whose top bits are the bucket mantissa
+  return (mantissa << shift) + ((1ULL << shift) - 1);
+}
+
+
+//!
+//! record & reset
+//!
+void
+latency_histogram::record(std::uint64_t value, std::uint64_t count) {
+  m_buckets[bucket_index(value)].fetch_add(count, std::memory_order_relaxed);
+  m_count.fetch_add(count, std::memory_order_relaxed);
+  m_sum.fetch_add(value * count, std::memory_order_relaxed);
+
+  std::uint64_t max = m_max.load(std::memory_order_relaxed);
+  while (value > max && !m_max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+    ;
+}
+
+void
+latency_histogram::record_corrected(std::uint64_t value, std::uint64_t expected_interval, std::uint64_t count) {
+  record(value, count);
+
+  if (!expected_interval)
+    return;
+
+  //! backfill the samples hidden by the stall
+  for (std::uint64_t missing = value; missing > expected_interval;) {
+    missing -= expected_interval;
+    record(missing, count);
+  }
+}
+
+void
+latency_histogram::add_corrected(const latency_histogram& other, std::uint64_t expected_interval) {
+  std::uint64_t other_max = other.get_max();
+
+  for (unsigned int i = 0; i < bucket_count; ++i) {
+    std::uint64_t count = other.m_buckets[i].load(std::memory_order_relaxed);
+
+    if (count) {
+      std::uint64_t value = bucket_upper_bound(i);
+      record_corrected(value < other_max ? value : other_max, expected_interval, count);
+    }
+  }
+}
+
+void
+latency_histogram::reset(void) {
+  for (auto& bucket : m_buckets)
+    bucket.store(0, std::memory_order_relaxed);
+
+  m_count.store(0, std::memory_order_relaxed);
+  m_sum.store(0, std::memory_order_relaxed);
+  m_max.store(0, std::memory_order_relaxed);
+}
+
+
+//!
+//! statistics
+//!
+std::uint64_t
+latency_histogram::get_count(void) const {
+  return m_count.load(std::memory_order_relaxed);
+}
+
+std::uint64_t
+latency_histogram::get_max(void) const {
+  return m_max.load(std::memory_order_relaxed);
+}
+
+double
+latency_histogram::get_mean(void) const {
+  std::uint64_t count = get_count();
+
+  if (!count)
+    return 0;
+
+  return static_cast<double>(m_sum.load(std::memory_order_relaxed)) / count;
+}
+
+std::uint64_t
+latency_histogram::get_percentile(double percentile) const {
+  std::uint64_t count = get_count();
+
+  if (!count)
+    return 0;
+
+  if (percentile > 100)
+    percentile = 100;
+
+  //! rank of the requested value, at least the first one
+  std::uint64_t rank = static_cast<std::uint64_t>(percentile / 100 * count + 0.5);
+  if (!rank)
+    rank = 1;
+
+  std::uint64_t seen = 0;
+  for (unsigned int i = 0; i < bucket_count; ++i) {
+    seen += m_buckets[i].load(std::memory_order_relaxed);
+
+    //! never report a value higher than the highest recorded one
+    if (seen >= rank) {
+      std::uint64_t upper_bound = bucket_upper_bound(i);
+      std::uint64_t max         = get_max();
+
+      return upper_bound < max ? upper_bound : max;
+    }
+  }
+
+  return get_max();
+}
+
+} // namespace misc
+
+} // namespace netflex
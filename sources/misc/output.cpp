@@ -20,6 +20,7 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <netflex/http/status.hpp>
 #include <netflex/misc/output.hpp>
 
 namespace netflex {
@@ -57,16 +58,48 @@ std::string
 header_list_to_http_packet(const http::header_list_t& headers) {
   std::string headers_str;
 
-  for (const auto& header : headers)
-    headers_str += header.first + ": " + header.second + "\r\n";
-  headers_str += "\r\n";
+  append_header_list(headers_str, headers);
 
   return headers_str;
 }
 
+void
+append_header_list(std::string& packet, const http::header_list_t& headers) {
+  for (const auto& header : headers) {
+    packet.append(header.first);
+    packet.append(": ", 2);
+    packet.append(header.second);
+    packet.append("\r\n", 2);
+  }
+
+  packet.append("\r\n", 2);
+}
+
 std::string
 status_line_to_http_packet(const std::string& http_version, unsigned int status_code, const std::string& reason_phrase) {
-  return http_version + " " + std::to_string(status_code) + " " + reason_phrase + "\r\n";
+  std::string status_line;
+
+  append_status_line(status_line, http_version, status_code, reason_phrase);
+
+  return status_line;
+}
+
+void
+append_status_line(std::string& packet, const std::string& http_version, unsigned int status_code, const std::string& reason_phrase) {
+  const std::string* status_line = http_version == "HTTP/1.1" ? http::status_to_status_line(status_code) : nullptr;
+
+  //! preserialized line holds the standard reason phrase only
+  if (status_line && !reason_phrase.compare(0, std::string::npos, *status_line, 13, status_line->size() - 15)) {
+    packet.append(*status_line);
+    return;
+  }
+
+  packet.append(http_version);
+  packet.push_back(' ');
+  packet.append(std::to_string(status_code));
+  packet.push_back(' ');
+  packet.append(reason_phrase);
+  packet.append("\r\n", 2);
 }
 
 } // namespace misc
@@ -0,0 +1,258 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <netflex/misc/error.hpp>
+#include <netflex/misc/hash.hpp>
+#include <netflex/misc/rate_limiter.hpp>
+
+namespace netflex {
+
+namespace misc {
+
+//!
+//! number of slots probed for a key before giving up
+//!
+static const std::size_t max_probes = 8;
+
+//!
+//! refill times ahead of the current time by less than this are seen as concurrent updates, not as wrapped times
+//!
+static const std::int32_t max_clock_skew = 1000;
+
+static std::uint64_t
+pack_state(std::uint32_t last_refill, std::uint32_t tokens) {
+  return (static_cast<std::uint64_t>(last_refill) << 32) | tokens;
+}
+
+
+//!
+//! ctor
+//!
+rate_limiter::rate_limiter(double requests_per_second, std::uint32_t burst, std::size_t max_clients, std::size_t nb_shards)
+: m_refill_rate(requests_per_second)
+, m_capacity(0)
+, m_idle_timeout(0)
+, m_retry_after(1)
+, m_start(std::chrono::steady_clock::now())
+, m_nb_rejected(0)
+, m_nb_untracked(0) {
+  if (!(requests_per_second > 0))
+    __NETFLEX_THROW(error, "rate limiter rate must be positive");
+  if (burst == 0 || burst > std::numeric_limits<std::uint32_t>::max() / 1000)
+    __NETFLEX_THROW(error, "invalid rate limiter burst: " + std::to_string(burst));
+
+  //! 1 token per second is 1 thousandth of token per millisecond
+  m_capacity     = burst * 1000;
+  m_idle_timeout = static_cast<std::uint32_t>(std::min(std::ceil(m_capacity / m_refill_rate), static_cast<double>(std::numeric_limits<std::int32_t>::max() / 2)));
+  m_retry_after  = static_cast<std::uint32_t>(std::max(std::ceil(1 / requests_per_second), 1.0));
+
+  if (nb_shards == 0)
+    nb_shards = 1;
+
+  std::size_t nb_slots = 1;
+  while (nb_slots * nb_shards < max_clients)
+    nb_slots <<= 1;
+
+  m_shards.resize(nb_shards);
+  for (auto& shard : m_shards) {
+    shard.slots.reset(new slot[nb_slots]);
+    shard.mask = nb_slots - 1;
+
+    //! unused slots hold a bucket full since the creation: the first request of a key finds it full
+    for (std::size_t i = 0; i < nb_slots; ++i) {
+      shard.slots[i].key.store(0, std::memory_order_relaxed);
+      shard.slots[i].state.store(pack_state(0, m_capacity), std::memory_order_relaxed);
+    }
+  }
+}
+
+
+//!
+//! consume tokens
+//!
+bool
+rate_limiter::try_acquire(const std::string& key) {
+  return try_acquire(key, now());
+}
+
+bool
+rate_limiter::try_acquire(const std::string& key, std::uint32_t now) {
+  slot* bucket = find_slot(key, now);
+
+  //! table full of active clients (or lost a race for the slot): let the request through
+  if (!bucket) {
+    ++m_nb_untracked;
+    return true;
+  }
+
+  return consume(*bucket, now);
+}
+
+bool
+rate_limiter::try_acquire(const std::string& key, const std::string& fallback_key) {
+  return try_acquire(key, fallback_key, now());
+}
+
+bool
+rate_limiter::try_acquire(const std::string& key, const std::string& fallback_key, std::uint32_t now) {
+  slot* bucket = find_slot(key, now);
+  if (!bucket)
+    bucket = find_slot(fallback_key, now);
+
+  //! the key is chosen by the client: failing open would let random keys saturate the table and escape the limit
+  if (!bucket) {
+    ++m_nb_rejected;
+    return false;
+  }
+
+  return consume(*bucket, now);
+}
+
+rate_limiter::slot*
+rate_limiter::find_slot(const std::string& key, std::uint32_t now) {
+  //! 0 marks unused slots
+  std::uint64_t hash = xxhash64(key.data(), key.size());
+  if (hash == 0)
+    hash = 1;
+
+  shard& shard          = m_shards[hash % m_shards.size()];
+  std::size_t position  = static_cast<std::size_t>(hash >> 32);
+  std::size_t nb_probes = std::min(max_probes, shard.mask + 1);
+  slot* reusable        = nullptr;
+
+  //! look for the bucket of the key in all the probed slots before reusing one:
+  //! taking an idle slot in front of the bucket of the key would give it a new full bucket
+  for (std::size_t probe = 0; probe < nb_probes; ++probe) {
+    slot& bucket        = shard.slots[(position + probe) & shard.mask];
+    std::uint64_t owner = bucket.key.load(std::memory_order_acquire);
+
+    if (owner == hash)
+      return &bucket;
+
+    if (!reusable && (owner == 0 || get_elapsed(bucket.state.load(std::memory_order_relaxed), now) >= m_idle_timeout))
+      reusable = &bucket;
+  }
+
+  //! idle buckets are full, so that the new key inherits a full bucket without resetting the state
+  if (reusable) {
+    std::uint64_t owner = reusable->key.load(std::memory_order_relaxed);
+
+    if (owner == hash || reusable->key.compare_exchange_strong(owner, hash, std::memory_order_acq_rel) || owner == hash)
+      return reusable;
+  }
+
+  return nullptr;
+}
+
+bool
+rate_limiter::consume(slot& bucket, std::uint32_t now) {
+  std::uint64_t state = bucket.state.load(std::memory_order_relaxed);
+
+  for (;;) {
+    std::uint32_t last_refill = static_cast<std::uint32_t>(state >> 32);
+    std::uint32_t tokens      = static_cast<std::uint32_t>(state);
+    double refill             = get_elapsed(state, now) * m_refill_rate;
+
+    if (refill >= m_capacity - tokens) {
+      tokens      = m_capacity;
+      last_refill = now;
+    }
+    else if (refill >= 1) {
+      tokens += static_cast<std::uint32_t>(refill);
+      last_refill = now;
+    }
+    //! less than a thousandth of token: keep the refill time, so that slow rates accumulate over frequent requests
+
+    //! rejections do not write the state: flooding clients only read their slot
+    if (tokens < 1000) {
+      ++m_nb_rejected;
+      return false;
+    }
+
+    if (bucket.state.compare_exchange_weak(state, pack_state(last_refill, tokens - 1000), std::memory_order_relaxed))
+      return true;
+  }
+}
+
+std::uint32_t
+rate_limiter::get_elapsed(std::uint64_t state, std::uint32_t now) const {
+  std::int32_t elapsed = static_cast<std::int32_t>(now - static_cast<std::uint32_t>(state >> 32));
+
+  if (elapsed >= 0)
+    return static_cast<std::uint32_t>(elapsed);
+
+  //! refilled by a concurrent request that read the clock after us
+  if (elapsed > -max_clock_skew)
+    return 0;
+
+  //! refill time older than the clock wrap period: bucket long idle
+  return m_idle_timeout;
+}
+
+std::uint32_t
+rate_limiter::now(void) const {
+  return static_cast<std::uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_start).count());
+}
+
+
+//!
+//! stats
+//!
+std::uint32_t
+rate_limiter::get_retry_after(void) const {
+  return m_retry_after;
+}
+
+std::uint64_t
+rate_limiter::get_nb_rejected(void) const {
+  return m_nb_rejected;
+}
+
+std::uint64_t
+rate_limiter::get_nb_untracked(void) const {
+  return m_nb_untracked;
+}
+
+std::size_t
+rate_limiter::get_nb_active(std::uint32_t now) const {
+  std::size_t nb_active = 0;
+
+  for (const auto& shard : m_shards) {
+    for (std::size_t i = 0; i <= shard.mask; ++i) {
+      const slot& bucket = shard.slots[i];
+
+      if (bucket.key.load(std::memory_order_relaxed) && get_elapsed(bucket.state.load(std::memory_order_relaxed), now) < m_idle_timeout)
+        ++nb_active;
+    }
+  }
+
+  return nb_active;
+}
+
+} // namespace misc
+
+} // namespace netflex
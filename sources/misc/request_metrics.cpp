@@ -0,0 +1,106 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <netflex/misc/request_metrics.hpp>
+
+namespace netflex {
+
+namespace misc {
+
+//!
+//! ctor & dtor
+//!
+request_metrics::request_metrics(void)
+: m_slow_request_threshold(0)
+, m_slow_request_handler(nullptr) {}
+
+
+//!
+//! slow requests tracing
+//!
+void
+request_metrics::set_slow_request_handler(std::uint64_t threshold, const slow_request_handler_t& handler) {
+  std::lock_guard<std::mutex> lock(m_slow_request_handler_mutex);
+
+  m_slow_request_handler = handler;
+  m_slow_request_threshold.store(handler ? threshold : 0);
+}
+
+bool
+request_metrics::is_slow_request_tracing_enabled(void) const {
+  return m_slow_request_threshold.load(std::memory_order_relaxed) != 0;
+}
+
+bool
+request_metrics::is_slow_request(const request_timing& timing) const {
+  std::uint64_t threshold = m_slow_request_threshold.load(std::memory_order_relaxed);
+
+  return threshold && timing.get_total() >= threshold;
+}
+
+
+//!
+//! record & reset
+//!
+void
+request_metrics::record(const request_timing& timing) {
+  for (std::size_t i = 0; i < nb_request_phases; ++i)
+    m_histograms[i].record(timing.get(static_cast<request_phase>(i)));
+
+  std::uint64_t total = timing.get_total();
+  m_total_histogram.record(total);
+
+  //! the lock is only taken for slow requests, keeping the common path lock-free
+  std::uint64_t threshold = m_slow_request_threshold.load(std::memory_order_relaxed);
+  if (threshold && total >= threshold) {
+    std::lock_guard<std::mutex> lock(m_slow_request_handler_mutex);
+
+    if (m_slow_request_handler)
+      m_slow_request_handler(timing);
+  }
+}
+
+void
+request_metrics::reset(void) {
+  for (auto& histogram : m_histograms)
+    histogram.reset();
+
+  m_total_histogram.reset();
+}
+
+
+//!
+//! histograms
+//!
+const latency_histogram&
+request_metrics::get_histogram(request_phase phase) const {
+  return m_histograms[static_cast<std::size_t>(phase)];
+}
+
+const latency_histogram&
+request_metrics::get_total_histogram(void) const {
+  return m_total_histogram;
+}
+
+} // namespace misc
+
+} // namespace netflex
@@ -0,0 +1,124 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <chrono>
+
+#include <netflex/misc/request_timing.hpp>
+
+namespace netflex {
+
+namespace misc {
+
+//!
+//! ctor & dtor
+//!
+request_timing::request_timing(void)
+: m_durations{0, 0, 0, 0, 0} {}
+
+
+//!
+//! monotonic clock
+//! steady_clock relies on clock_gettime(CLOCK_MONOTONIC) on posix systems, which is served by the vDSO
+//!
+std::uint64_t
+request_timing::now(void) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+//!
+//! durations
+//!
+void
+request_timing::add(request_phase phase, std::uint64_t duration) {
+  m_durations[static_cast<std::size_t>(phase)] += duration;
+}
+
+std::uint64_t
+request_timing::get(request_phase phase) const {
+  return m_durations[static_cast<std::size_t>(phase)];
+}
+
+std::uint64_t
+request_timing::get_total(void) const {
+  std::uint64_t total = 0;
+
+  for (auto duration : m_durations)
+    total += duration;
+
+  return total;
+}
+
+
+//!
+//! description
+//!
+const std::string&
+request_timing::get_description(void) const {
+  return m_description;
+}
+
+void
+request_timing::set_description(const std::string& description) {
+  m_description = description;
+}
+
+
+//!
+//! misc
+//!
+std::string
+request_timing::to_string(void) const {
+  std::string str = m_description.empty() ? "" : m_description + " ";
+
+  for (std::size_t i = 0; i < nb_request_phases; ++i)
+    str += std::string(request_phase_to_string(static_cast<request_phase>(i))) + "=" + std::to_string(m_durations[i]) + "ns ";
+
+  return str + "total=" + std::to_string(get_total()) + "ns";
+}
+
+const char*
+request_phase_to_string(request_phase phase) {
+  switch (phase) {
+  case request_phase::parse:
+    return "parse";
+
+  case request_phase::middleware:
+    return "middleware";
+
+  case request_phase::handler:
+    return "handler";
+
+  case request_phase::serialize:
+    return "serialize";
+
+  case request_phase::write:
+    return "write";
+
+  default:
+    return "";
+  }
+}
+
+} // namespace misc
+
+} // namespace netflex
@@ -0,0 +1,140 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <algorithm>
+#include <cstring>
+
+#include <netflex/misc/string_view.hpp>
+
+namespace netflex {
+
+namespace misc {
+
+const std::size_t string_view::npos;
+
+
+//!
+//! ctor & dtor
+//!
+string_view::string_view(void)
+: m_data("")
+, m_size(0) {}
+
+string_view::string_view(const char* data, std::size_t size)
+: m_data(data)
+, m_size(size) {}
+
+string_view::string_view(const char* str)
+: m_data(str)
+, m_size(std::strlen(str)) {}
+
+string_view::string_view(const std::string& str)
+: m_data(str.data())
+, m_size(str.size()) {}
+
+
+//!
+//! accessors
+//!
+const char*
+string_view::data(void) const {
+  return m_data;
+}
+
+std::size_t
+string_view::size(void) const {
+  return m_size;
+}
+
+bool
+string_view::empty(void) const {
+  return m_size == 0;
+}
+
+const char*
+string_view::begin(void) const {
+  return m_data;
+}
+
+const char*
+string_view::end(void) const {
+  return m_data + m_size;
+}
+
+char
+string_view::operator[](std::size_t index) const {
+  return m_data[index];
+}
+
+
+//!
+//! operations
+//!
+string_view
+string_view::substr(std::size_t pos, std::size_t count) const {
+  pos = std::min(pos, m_size);
+
+  return string_view(m_data + pos, std::min(count, m_size - pos));
+}
+
+std::size_t
+string_view::find(char c, std::size_t pos) const {
+  if (pos >= m_size)
+    return npos;
+
+  const void* found = std::memchr(m_data + pos, c, m_size - pos);
+
+  return found ? static_cast<const char*>(found) - m_data : npos;
+}
+
+std::string
+string_view::to_string(void) const {
+  return std::string(m_data, m_size);
+}
+
+
+//!
+//! comparison
+//!
+bool
+string_view::operator==(const string_view& rhs) const {
+  return m_size == rhs.m_size && (m_size == 0 || std::memcmp(m_data, rhs.m_data, m_size) == 0);
+}
+
+bool
+string_view::operator!=(const string_view& rhs) const {
+  return !operator==(rhs);
+}
+
+
+//!
+//! output
+//!
+std::ostream&
+operator<<(std::ostream& os, const string_view& view) {
+  return os.write(view.data(), static_cast<std::streamsize>(view.size()));
+}
+
+} // namespace misc
+
+} // namespace netflex
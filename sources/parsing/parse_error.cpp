@@ -0,0 +1,72 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <netflex/parsing/parse_error.hpp>
+
+namespace netflex {
+
+namespace parsing {
+
+//!
+//! parsing stage
+//!
+const char*
+parsing_stage_to_string(parsing_stage stage) {
+  switch (stage) {
+  case parsing_stage::start_line:
+    return "start-line";
+  case parsing_stage::header_fields:
+    return "header fields";
+  case parsing_stage::message_body:
+    return "message body";
+  default:
+    return "unknown";
+  }
+}
+
+
+//!
+//! ctor
+//!
+parse_error::parse_error(void)
+: stage(parsing_stage::start_line)
+, offset(0)
+, status(0)
+, reason("") {}
+
+parse_error::parse_error(parsing_stage stage, std::size_t offset, unsigned int status, const char* reason)
+: stage(stage)
+, offset(offset)
+, status(status)
+, reason(reason) {}
+
+
+//!
+//! error check
+//!
+parse_error::operator bool(void) const {
+  return status != 0;
+}
+
+} // namespace parsing
+
+} // namespace netflex
@@ -20,7 +20,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
-#include <netflex/parsing/message_body_gzip_parser.hpp>
+
+#include <netflex/parsing/request_limits.hpp>
 
 namespace netflex {
 
@@ -29,22 +30,12 @@ namespace parsing {
 //!
 //! ctor
 //!
-message_body_gzip_parser::message_body_gzip_parser(http::request& request)
-: parser_iface(request) {}
-
-
-//!
-//! parser_iface impl
-//!
-parser_iface&
-message_body_gzip_parser::operator<<(std::string&) {
-  return *this;
-}
-
-bool
-message_body_gzip_parser::is_done(void) const {
-  return true;
-}
+request_limits::request_limits(void)
+: max_request_line_size(8 * 1024)
+, max_header_field_size(8 * 1024)
+, max_nb_header_fields(100)
+, max_header_section_size(64 * 1024)
+, max_body_size(8 * 1024 * 1024) {}
 
 } // namespace parsing
 
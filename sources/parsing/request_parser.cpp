@@ -20,19 +20,211 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <vector>
+
 #include <netflex/misc/error.hpp>
+#include <netflex/misc/logger.hpp>
 #include <netflex/parsing/request_parser.hpp>
+#include <netflex/parsing/scanner.hpp>
+#include <netflex/parsing/utils.hpp>
 
 namespace netflex {
 
 namespace parsing {
 
+//!
+//! parsing states
+//! states up to trailer_end_lf are driven by the transition table
+//! content_length_body and chunk_data consume the input in bulk
+//! headers_end, chunk_size_end and request_end are transient states, only used to trigger the corresponding actions
+//!
+enum class request_parser::state : unsigned char {
+  //! request-line
+  start,
+  start_lf,
+  method,
+  target_ows,
+  target,
+  version_ows,
+  version,
+  line_ows,
+  line_lf,
+  //! header fields
+  header_start,
+  field_name,
+  value_ows,
+  value,
+  value_lf,
+  headers_end_lf,
+  //! chunked message body
+  chunk_size,
+  chunk_ext,
+  chunk_size_lf,
+  chunk_data_cr,
+  chunk_data_lf,
+  trailer_start,
+  trailer,
+  trailer_lf,
+  trailer_end_lf,
+  //! bulk states
+  content_length_body,
+  chunk_data,
+  //! transient states
+  headers_end,
+  chunk_size_end,
+  request_end,
+  //! invalid input
+  error
+};
+
+
+//!
+//! character classes
+//!
+enum char_class : unsigned char {
+  //! control characters
+  ctl,
+  //! SP, HTAB
+  sp,
+  //! CR
+  cr,
+  //! LF
+  lf,
+  //! ':'
+  colon,
+  //! ';'
+  semicolon,
+  //! hexadecimal digits (also token characters)
+  hex,
+  //! other token characters
+  tchar,
+  //! other visible characters (separators and obs-text)
+  vchar,
+  nb_char_classes
+};
+
+static const struct char_classes_table {
+  char_classes_table(void) {
+    for (unsigned int c = 0; c < 256; ++c) {
+      if (c < 0x20 || c == 0x7f)
+        classes[c] = ctl;
+      else if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'))
+        classes[c] = hex;
+      else if ((c >= 'g' && c <= 'z') || (c >= 'G' && c <= 'Z') || (c < 0x80 && std::string("!#$%&'*+-.^_`|~").find(static_cast<char>(c)) != std::string::npos))
+        classes[c] = tchar;
+      else
+        classes[c] = vchar;
+    }
+
+    classes[static_cast<unsigned char>(utils::SP)]   = sp;
+    classes[static_cast<unsigned char>(utils::HTAB)] = sp;
+    classes[static_cast<unsigned char>(utils::CR)]   = cr;
+    classes[static_cast<unsigned char>(utils::LF)]   = lf;
+    classes[static_cast<unsigned char>(':')]         = colon;
+    classes[static_cast<unsigned char>(';')]         = semicolon;
+  }
+
+  char_class classes[256];
+} char_classes;
+
+
+//!
+//! transition table: next state for each (state, character class)
+//! control characters are tolerated inside targets, field values and trailers, as they always were
+//! obs-fold (header line starting with whitespace) and whitespace between field name and colon are rejected (RFC 7230 3.2.4)
+//!
+typedef request_parser::state state_t;
+
+#define E state_t::error
+#define S(name) state_t::name
+
+static const state_t transitions[][nb_char_classes] = {
+  //! columns: ctl, sp, cr, lf, colon, semicolon, hex, tchar, vchar
+  /* start */ {E, E, S(start_lf), E, E, E, S(method), S(method), E},
+  /* start_lf */ {E, E, E, S(start), E, E, E, E, E},
+  /* method */ {E, S(target_ows), E, E, E, E, S(method), S(method), E},
+  /* target_ows */ {E, S(target_ows), E, E, S(target), S(target), S(target), S(target), S(target)},
+  /* target */ {S(target), S(version_ows), E, E, S(target), S(target), S(target), S(target), S(target)},
+  /* version_ows */ {E, S(version_ows), E, E, E, E, S(version), S(version), S(version)},
+  /* version */ {E, S(line_ows), S(line_lf), E, E, E, S(version), S(version), S(version)},
+  /* line_ows */ {E, S(line_ows), S(line_lf), E, E, E, E, E, E},
+  /* line_lf */ {E, E, E, S(header_start), E, E, E, E, E},
+  /* header_start */ {E, E, S(headers_end_lf), E, E, E, S(field_name), S(field_name), E},
+  /* field_name */ {E, E, E, E, S(value_ows), E, S(field_name), S(field_name), E},
+  /* value_ows */ {S(value), S(value_ows), S(value_lf), E, S(value), S(value), S(value), S(value), S(value)},
+  /* value */ {S(value), S(value), S(value_lf), E, S(value), S(value), S(value), S(value), S(value)},
+  /* value_lf */ {E, E, E, S(header_start), E, E, E, E, E},
+  /* headers_end_lf */ {E, E, E, S(headers_end), E, E, E, E, E},
+  /* chunk_size */ {E, S(chunk_ext), S(chunk_size_lf), E, E, S(chunk_ext), S(chunk_size), E, E},
+  /* chunk_ext */ {E, S(chunk_ext), S(chunk_size_lf), E, S(chunk_ext), S(chunk_ext), S(chunk_ext), S(chunk_ext), S(chunk_ext)},
+  /* chunk_size_lf */ {E, E, E, S(chunk_size_end), E, E, E, E, E},
+  /* chunk_data_cr */ {E, E, S(chunk_data_lf), E, E, E, E, E, E},
+  /* chunk_data_lf */ {E, E, E, S(chunk_size), E, E, E, E, E},
+  /* trailer_start */ {E, E, S(trailer_end_lf), E, E, E, S(trailer), S(trailer), E},
+  /* trailer */ {S(trailer), S(trailer), S(trailer_lf), E, S(trailer), S(trailer), S(trailer), S(trailer), S(trailer)},
+  /* trailer_lf */ {E, E, E, S(trailer_start), E, E, E, E, E},
+  /* trailer_end_lf */ {E, E, E, S(request_end), E, E, E, E, E}};
+
+#undef S
+#undef E
+
+static_assert(sizeof(transitions) / sizeof(transitions[0]) == static_cast<std::size_t>(state_t::content_length_body), "transition table must cover all the table-driven states");
+
+
+//!
+//! sets ending the spans that are consumed in bulk
+//!
+static const scanner::char_set target_endings({utils::SP, utils::HTAB, utils::CR, utils::LF});
+static const scanner::char_set line_endings({utils::CR, utils::LF});
+
+
+//!
+//! helpers
+//!
+static bool
+iequals(const std::string& str, const char* lower_str) {
+  std::size_t i = 0;
+
+  for (; i < str.size() && lower_str[i]; ++i)
+    if (std::tolower(static_cast<unsigned char>(str[i])) != lower_str[i])
+      return false;
+
+  return i == str.size() && !lower_str[i];
+}
+
+static bool
+exceeds(std::uint64_t size, std::uint64_t limit) {
+  return limit && size > limit;
+}
+
+static void
+rtrim_ows(std::string& str) {
+  std::size_t end = str.size();
+
+  while (end && utils::is_space_delimiter(str[end - 1]))
+    --end;
+
+  str.resize(end);
+}
+
+
 //!
 //! ctor & dtor
 //!
 request_parser::request_parser(void)
-: m_current_stage(parsing_stage::start_line)
-, m_current_parser(create_parser(m_current_stage, m_current_request)) {}
+: m_state(state::start)
+, m_nb_header_fields(0)
+, m_header_section_size(0)
+, m_has_content_length(false)
+, m_content_length(0)
+, m_remaining(0)
+, m_chunk_size_digits(0)
+, m_parse_start(0)
+, m_buffer_offset(0)
+, m_index(0) {}
 
 
 //!
@@ -40,39 +232,329 @@ request_parser::request_parser(void)
 //!
 request_parser&
 request_parser::operator<<(const std::string& data) {
-  m_buffer += data;
+  return feed(data.data(), data.size());
+}
+
+request_parser&
+request_parser::feed(const char* data, std::size_t size) {
+  //! nothing can be parsed after invalid data
+  if (m_state == state::error)
+    return *this;
+
+  m_parse_start = misc::request_timing::now();
 
-  while (build_request())
-    ;
+  parse(data, size);
+
+  //! account the time spent on the request that is still being parsed
+  m_current_request.get_timing().add(misc::request_phase::parse, misc::request_timing::now() - m_parse_start);
 
   return *this;
 }
 
 
 //!
-//! build request
+//! state machine
 //!
-bool
-request_parser::build_request(void) {
-  //! feed current parser
-  *m_current_parser << m_buffer;
-
-  if (m_current_parser->is_done()) {
-    //! request fully built
-    if (m_current_stage == parsing_stage::message_body) {
-      //! store request as available
-      m_available_requests.push_back(m_current_request);
-      //! reset current request
-      m_current_request = {};
+void
+request_parser::parse(const char* data, std::size_t size) {
+  std::size_t& i = m_index;
+
+  for (i = 0; i < size && m_state != state::error;) {
+    //! bulk states: consume as many bytes as available
+    if (m_state == state::content_length_body || m_state == state::chunk_data) {
+      std::size_t nb_bytes = static_cast<std::size_t>(std::min<std::uint64_t>(m_remaining, size - i));
+
+      m_body.append(data + i, nb_bytes);
+      m_remaining -= nb_bytes;
+      i += nb_bytes;
+
+      if (!m_remaining) {
+        if (m_state == state::chunk_data)
+          m_state = state::chunk_data_cr;
+        else
+          on_request_end();
+      }
+
+      continue;
+    }
+
+    char c     = data[i];
+    state prev = m_state;
+    m_state    = transitions[static_cast<unsigned char>(prev)][char_classes.classes[static_cast<unsigned char>(c)]];
+    ++i;
+
+    switch (m_state) {
+    case state::method:
+      m_method += c;
+      check_request_line_size();
+      break;
+
+    case state::target:
+    case state::value:
+    case state::chunk_ext:
+    case state::trailer: {
+      //! long spans: find their end at once
+      const scanner::char_set& endings = m_state == state::target ? target_endings : line_endings;
+      std::size_t span                 = scanner::find_first_of(data + i, size - i, endings);
+
+      if (m_state == state::target)
+        m_target.append(data + i - 1, span + 1);
+      else if (m_state == state::value)
+        m_field_value.append(data + i - 1, span + 1);
+
+      i += span;
+
+      if (m_state == state::target)
+        check_request_line_size();
+      else if (m_state == state::value)
+        check_header_field_size();
+      break;
     }
 
-    //! switch to next stage
-    m_current_parser = switch_to_next_stage(m_current_stage, m_current_request);
+    case state::version:
+      m_http_version += c;
+      check_request_line_size();
+      break;
 
-    return true;
+    case state::header_start:
+      if (prev == state::line_lf)
+        on_request_line();
+      else
+        on_header_field();
+      break;
+
+    case state::field_name:
+      m_field_name += c;
+      check_header_field_size();
+      break;
+
+    case state::headers_end:
+      m_state = on_header_fields_end();
+      break;
+
+    case state::chunk_size: {
+      if (prev == state::chunk_data_lf) {
+        m_remaining         = 0;
+        m_chunk_size_digits = 0;
+        break;
+      }
+
+      unsigned int digit = c <= '9' ? c - '0' : (c | 0x20) - 'a' + 10;
+      if (m_remaining > (std::numeric_limits<std::uint64_t>::max() >> 4)) {
+        fail(parsing_stage::message_body, 400, "chunk-size overflow");
+        break;
+      }
+
+      m_remaining = (m_remaining << 4) | digit;
+      ++m_chunk_size_digits;
+      break;
+    }
+
+    case state::chunk_size_end:
+      if (!m_chunk_size_digits) {
+        fail(parsing_stage::message_body, 400, "invalid chunk-size");
+        break;
+      }
+
+      //! chunk-size checked on its own first, so that the sum cannot overflow
+      if (exceeds(m_remaining, m_limits.max_body_size) || exceeds(m_body.size() + m_remaining, m_limits.max_body_size)) {
+        fail(parsing_stage::message_body, 413, "message body too large");
+        break;
+      }
+
+      //! last chunk is followed by the trailer section
+      m_state = m_remaining ? state::chunk_data : state::trailer_start;
+      break;
+
+    case state::request_end:
+      on_request_end();
+      break;
+
+    case state::error:
+      if (prev < state::header_start)
+        fail(parsing_stage::start_line, 400, "invalid start-line");
+      else if (prev < state::chunk_size)
+        fail(parsing_stage::header_fields, 400, "invalid header field");
+      else
+        fail(parsing_stage::message_body, 400, "invalid chunked message body");
+      break;
+
+    default:
+      break;
+    }
   }
 
-  return false;
+  //! next buffer starts right after this one
+  m_buffer_offset += size;
+}
+
+
+//!
+//! actions
+//!
+void
+request_parser::on_request_line(void) {
+  //! HTTP-version = "HTTP/" DIGIT "." DIGIT
+  if (m_http_version.size() != 8 || m_http_version.compare(0, 5, "HTTP/") || !std::isdigit(static_cast<unsigned char>(m_http_version[5])) || m_http_version[6] != '.' || !std::isdigit(static_cast<unsigned char>(m_http_version[7])))
+    return fail(parsing_stage::start_line, 400, "invalid http version");
+
+  //! only HTTP/1.x messages can be parsed
+  if (m_http_version[5] != '1')
+    return fail(parsing_stage::start_line, 505, "unsupported http version");
+
+  m_current_request.set_raw_method(m_method);
+  m_current_request.set_target(m_target);
+  m_current_request.set_http_version(m_http_version);
+}
+
+void
+request_parser::on_header_field(void) {
+  rtrim_ows(m_field_value);
+
+  if (exceeds(++m_nb_header_fields, m_limits.max_nb_header_fields))
+    return fail(parsing_stage::header_fields, 431, "too many header fields");
+
+  m_header_section_size += m_field_name.size() + m_field_value.size();
+
+  if (iequals(m_field_name, "content-length")) {
+    //! Content-Length = 1*DIGIT, repeated values must be identical
+    if (m_field_value.empty() || !std::all_of(m_field_value.begin(), m_field_value.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)); }))
+      return fail(parsing_stage::header_fields, 400, "invalid Content-Length");
+
+    //! valid but not representable: larger than any body limit, like an overflowing chunk size
+    std::size_t first_digit = std::min(m_field_value.find_first_not_of('0'), m_field_value.size() - 1);
+    if (m_field_value.size() - first_digit > 18)
+      return fail(parsing_stage::message_body, 413, "message body too large");
+
+    std::uint64_t content_length = std::stoull(m_field_value.substr(first_digit));
+    if (m_has_content_length && content_length != m_content_length)
+      return fail(parsing_stage::header_fields, 400, "conflicting Content-Length");
+
+    m_has_content_length = true;
+    m_content_length     = content_length;
+  }
+  else if (iequals(m_field_name, "transfer-encoding")) {
+    //! multiple Transfer-Encoding fields are equivalent to a single comma-separated one
+    if (!m_transfer_encoding.empty())
+      m_transfer_encoding += ',';
+
+    m_transfer_encoding += m_field_value;
+  }
+
+  m_current_request.add_header({m_field_name, m_field_value});
+
+  m_field_name.clear();
+  m_field_value.clear();
+}
+
+request_parser::state
+request_parser::on_header_fields_end(void) {
+  if (!m_transfer_encoding.empty()) {
+    std::vector<std::string> encodings = utils::split(m_transfer_encoding, ',');
+
+    for (std::size_t i = 0; i < encodings.size(); ++i) {
+      std::string& encoding = encodings[i];
+
+      utils::trim(encoding);
+      utils::to_lower(encoding);
+
+      //! chunked must be applied last, exactly once
+      if (encoding == "chunked" && i + 1 == encodings.size())
+        continue;
+
+      //! other codings are left applied to the body
+      if (encoding == "chunked" || encoding.empty()) {
+        fail(parsing_stage::header_fields, 400, "chunked must be the final transfer encoding");
+        return state::error;
+      }
+
+      if (encoding != "compress" && encoding != "x-compress" && encoding != "deflate" && encoding != "gzip" && encoding != "x-gzip") {
+        fail(parsing_stage::header_fields, 501, "unsupported transfer encoding");
+        return state::error;
+      }
+    }
+
+    if (encodings.empty() || encodings.back() != "chunked") {
+      fail(parsing_stage::header_fields, 400, "chunked must be the final transfer encoding");
+      return state::error;
+    }
+
+    //! if both content length and encoding are provided, content length should be discarded
+    m_current_request.remove_header("Content-Length");
+
+    m_remaining         = 0;
+    m_chunk_size_digits = 0;
+    return state::chunk_size;
+  }
+
+  //! rejected before receiving the body
+  if (m_has_content_length && exceeds(m_content_length, m_limits.max_body_size)) {
+    fail(parsing_stage::message_body, 413, "message body too large");
+    return state::error;
+  }
+
+  if (m_has_content_length && m_content_length) {
+    m_remaining = m_content_length;
+    return state::content_length_body;
+  }
+
+  on_request_end();
+  return state::start;
+}
+
+void
+request_parser::on_request_end(void) {
+  //! account the parsing time of the request, next request starts being parsed right now
+  std::uint64_t parse_end = misc::request_timing::now();
+  m_current_request.get_timing().add(misc::request_phase::parse, parse_end - m_parse_start);
+  m_parse_start = parse_end;
+
+  m_current_request.set_body(m_body);
+
+  //! store request as available
+  m_available_requests.push_back(std::move(m_current_request));
+
+  //! reset state for the next request, keeping the tokens storage around
+  m_current_request = {};
+  m_method.clear();
+  m_target.clear();
+  m_http_version.clear();
+  m_body.clear();
+  m_has_content_length = false;
+  m_content_length     = 0;
+  m_transfer_encoding.clear();
+  m_nb_header_fields    = 0;
+  m_header_section_size = 0;
+
+  m_state = state::start;
+
+  //! next request begins right after this one
+  m_buffer_offset = -static_cast<std::int64_t>(m_index);
+}
+
+void
+request_parser::check_request_line_size(void) {
+  if (exceeds(m_method.size() + m_target.size() + m_http_version.size(), m_limits.max_request_line_size))
+    fail(parsing_stage::start_line, 414, "request-line too long");
+}
+
+void
+request_parser::check_header_field_size(void) {
+  std::size_t field_size = m_field_name.size() + m_field_value.size();
+
+  if (exceeds(field_size, m_limits.max_header_field_size))
+    fail(parsing_stage::header_fields, 431, "header field too large");
+  else if (exceeds(m_header_section_size + field_size, m_limits.max_header_section_size))
+    fail(parsing_stage::header_fields, 431, "header section too large");
+}
+
+void
+request_parser::fail(parsing_stage stage, unsigned int status, const char* reason) {
+  //! offset of the last consumed byte
+  m_error = {stage, static_cast<std::size_t>(m_buffer_offset + static_cast<std::int64_t>(m_index)) - 1, status, reason};
+  m_state = state::error;
+
+  __NETFLEX_LOG(debug, std::string("request parsing failed (") + parsing_stage_to_string(stage) + ", offset " + std::to_string(m_error.offset) + "): " + reason);
 }
 
 
@@ -118,6 +600,40 @@ request_parser::request_available(void) const {
   return !m_available_requests.empty();
 }
 
+
+bool
+request_parser::is_parsing_request(void) const {
+  return m_state != state::start && m_state != state::error;
+}
+
+
+//!
+//! parsing failure
+//!
+bool
+request_parser::has_error(void) const {
+  return m_state == state::error;
+}
+
+const parse_error&
+request_parser::get_error(void) const {
+  return m_error;
+}
+
+
+//!
+//! size limits
+//!
+void
+request_parser::set_limits(const request_limits& limits) {
+  m_limits = limits;
+}
+
+const request_limits&
+request_parser::get_limits(void) const {
+  return m_limits;
+}
+
 } // namespace parsing
 
 } // namespace netflex
@@ -0,0 +1,275 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cstring>
+
+#include <netflex/parsing/scanner.hpp>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define __NETFLEX_SCANNER_X86 1
+#include <immintrin.h>
+#endif /* (__GNUC__ || __clang__) && (__x86_64__ || __i386__) */
+
+namespace netflex {
+
+namespace parsing {
+
+namespace scanner {
+
+//!
+//! char_set
+//!
+char_set::char_set(const std::string& chars)
+: m_size(0) {
+  std::memset(m_table, 0, sizeof(m_table));
+
+  for (char c : chars) {
+    if (!c || m_table[static_cast<unsigned char>(c)] || m_size == sizeof(m_chars))
+      continue;
+
+    m_table[static_cast<unsigned char>(c)] = true;
+    m_chars[m_size++]                      = c;
+  }
+
+  //! pad with the first character: duplicates do not change the result of the comparisons
+  std::fill(m_chars + m_size, m_chars + sizeof(m_chars), m_size ? m_chars[0] : 0);
+}
+
+bool
+char_set::contains(char c) const {
+  return m_table[static_cast<unsigned char>(c)];
+}
+
+const char*
+char_set::get_chars(void) const {
+  return m_chars;
+}
+
+std::size_t
+char_set::get_size(void) const {
+  return m_size;
+}
+
+
+//!
+//! scalar implementation
+//! also used for the tails of the vectorized implementations
+//!
+static std::size_t
+scalar_find(const char* data, std::size_t size, const char_set& set, bool expected) {
+  std::size_t i = 0;
+
+  while (i < size && set.contains(data[i]) != expected)
+    ++i;
+
+  return i;
+}
+
+static std::size_t
+scalar_find_first_of(const char* data, std::size_t size, const char_set& set) {
+  return scalar_find(data, size, set, true);
+}
+
+static std::size_t
+scalar_find_first_not_of(const char* data, std::size_t size, const char_set& set) {
+  return scalar_find(data, size, set, false);
+}
+
+
+#ifdef __NETFLEX_SCANNER_X86
+
+//!
+//! SSE4.2 implementation: pcmpestri compares 16 bytes against the whole set (up to 16 chars) in one instruction
+//! explicit-length variant is used so that NUL bytes in the input do not stop the scan
+//!
+__attribute__((target("sse4.2"))) static std::size_t
+sse4_2_find_first_of(const char* data, std::size_t size, const char_set& set) {
+  const __m128i chars  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.get_chars()));
+  const int chars_size = static_cast<int>(set.get_size());
+  std::size_t i        = 0;
+
+  for (; i + 16 <= size; i += 16) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    int index     = _mm_cmpestri(chars, chars_size, block, 16, _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_LEAST_SIGNIFICANT);
+
+    if (index != 16)
+      return i + index;
+  }
+
+  return i + scalar_find(data + i, size - i, set, true);
+}
+
+__attribute__((target("sse4.2"))) static std::size_t
+sse4_2_find_first_not_of(const char* data, std::size_t size, const char_set& set) {
+  const __m128i chars  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.get_chars()));
+  const int chars_size = static_cast<int>(set.get_size());
+  std::size_t i        = 0;
+
+  for (; i + 16 <= size; i += 16) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    int index     = _mm_cmpestri(chars, chars_size, block, 16, _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_NEGATIVE_POLARITY | _SIDD_LEAST_SIGNIFICANT);
+
+    if (index != 16)
+      return i + index;
+  }
+
+  return i + scalar_find(data + i, size - i, set, false);
+}
+
+//!
+//! AVX2 implementation (cpus supporting AVX2 all support SSE4.2): compares 32 bytes against each char of the set, then extracts the first match from the movemask
+//!
+__attribute__((target("avx2"))) static unsigned int
+avx2_match_mask(const char* block_data, const char_set& set) {
+  const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block_data));
+  const char* chars   = set.get_chars();
+  __m256i matches     = _mm256_setzero_si256();
+
+  for (std::size_t i = 0; i < set.get_size(); ++i)
+    matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(block, _mm256_set1_epi8(chars[i])));
+
+  return static_cast<unsigned int>(_mm256_movemask_epi8(matches));
+}
+
+__attribute__((target("avx2"))) static std::size_t
+avx2_find_first_of(const char* data, std::size_t size, const char_set& set) {
+  std::size_t i = 0;
+
+  for (; i + 32 <= size; i += 32) {
+    unsigned int mask = avx2_match_mask(data + i, set);
+
+    if (mask)
+      return i + __builtin_ctz(mask);
+  }
+
+  //! remaining 16 bytes block, if any
+  return i + sse4_2_find_first_of(data + i, size - i, set);
+}
+
+__attribute__((target("avx2"))) static std::size_t
+avx2_find_first_not_of(const char* data, std::size_t size, const char_set& set) {
+  std::size_t i = 0;
+
+  for (; i + 32 <= size; i += 32) {
+    unsigned int mask = ~avx2_match_mask(data + i, set);
+
+    if (mask)
+      return i + __builtin_ctz(mask);
+  }
+
+  //! remaining 16 bytes block, if any
+  return i + sse4_2_find_first_not_of(data + i, size - i, set);
+}
+
+#endif /* __NETFLEX_SCANNER_X86 */
+
+
+//!
+//! runtime dispatch
+//!
+struct dispatch_table {
+  implementation impl;
+  std::size_t (*find_first_of)(const char*, std::size_t, const char_set&);
+  std::size_t (*find_first_not_of)(const char*, std::size_t, const char_set&);
+};
+
+static dispatch_table
+make_dispatch_table(implementation impl) {
+  switch (impl) {
+#ifdef __NETFLEX_SCANNER_X86
+  case implementation::avx2:
+    return {impl, avx2_find_first_of, avx2_find_first_not_of};
+  case implementation::sse4_2:
+    return {impl, sse4_2_find_first_of, sse4_2_find_first_not_of};
+#endif /* __NETFLEX_SCANNER_X86 */
+  default:
+    return {implementation::scalar, scalar_find_first_of, scalar_find_first_not_of};
+  }
+}
+
+static dispatch_table&
+get_dispatch_table(void) {
+  //! fastest supported implementation, selected on first use
+  static dispatch_table table = make_dispatch_table(is_supported(implementation::avx2) ? implementation::avx2 : is_supported(implementation::sse4_2) ? implementation::sse4_2 : implementation::scalar);
+
+  return table;
+}
+
+bool
+is_supported(implementation impl) {
+  switch (impl) {
+  case implementation::scalar:
+    return true;
+#ifdef __NETFLEX_SCANNER_X86
+  case implementation::sse4_2:
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.2");
+  case implementation::avx2:
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif /* __NETFLEX_SCANNER_X86 */
+  default:
+    return false;
+  }
+}
+
+implementation
+get_implementation(void) {
+  return get_dispatch_table().impl;
+}
+
+bool
+set_implementation(implementation impl) {
+  if (!is_supported(impl))
+    return false;
+
+  get_dispatch_table() = make_dispatch_table(impl);
+  return true;
+}
+
+
+//!
+//! scanners
+//!
+std::size_t
+find_first_of(const char* data, std::size_t size, const char_set& set) {
+  //! most tokens (methods, versions, whitespaces runs) are shorter than a vector: no need to dispatch
+  if (size < 16)
+    return scalar_find(data, size, set, true);
+
+  return get_dispatch_table().find_first_of(data, size, set);
+}
+
+std::size_t
+find_first_not_of(const char* data, std::size_t size, const char_set& set) {
+  if (size < 16)
+    return scalar_find(data, size, set, false);
+
+  return get_dispatch_table().find_first_not_of(data, size, set);
+}
+
+} // namespace scanner
+
+} // namespace parsing
+
+} // namespace netflex
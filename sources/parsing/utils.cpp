@@ -24,6 +24,7 @@
 #include <regex>
 
 #include <netflex/misc/error.hpp>
+#include <netflex/parsing/scanner.hpp>
 #include <netflex/parsing/utils.hpp>
 
 namespace netflex {
@@ -42,6 +43,12 @@ const char FF   = 0x0c;
 const char CR   = 0x0d;
 const char LF   = '\n';
 
+//!
+//! scanner sets
+//!
+static const scanner::char_set whitespaces({SP, HTAB, VT, FF, CR});
+static const scanner::char_set words_endings({VT, FF, CR});
+
 
 //!
 //! parsing helper
@@ -76,14 +83,10 @@ is_crlf(const std::string& buffer) {
 //!
 char
 consume_whitespaces(std::string& buffer) {
-  size_t i = 0;
-
   if (buffer.empty())
     return 0;
 
-  while (i < buffer.size() && utils::is_whitespace_delimiter(buffer[i])) {
-    ++i;
-  }
+  size_t i = scanner::find_first_not_of(buffer.data(), buffer.size(), whitespaces);
 
   char last_consumed_whitespace = buffer[i];
   buffer.erase(0, i);
@@ -93,11 +96,16 @@ consume_whitespaces(std::string& buffer) {
 
 std::string
 consume_word(std::string& buffer, char ending) {
-  size_t i = 0;
+  //! ':' is the only ending used while parsing requests, keep its set around
+  static const scanner::char_set whitespaces_and_colon({SP, HTAB, VT, FF, CR, ':'});
 
-  while (i < buffer.size() && !utils::is_whitespace_delimiter(buffer[i]) && buffer[i] != ending) {
-    ++i;
-  }
+  size_t i;
+  if (!ending)
+    i = scanner::find_first_of(buffer.data(), buffer.size(), whitespaces);
+  else if (ending == ':')
+    i = scanner::find_first_of(buffer.data(), buffer.size(), whitespaces_and_colon);
+  else
+    i = scanner::find_first_of(buffer.data(), buffer.size(), scanner::char_set({SP, HTAB, VT, FF, CR, ending}));
 
   if (i == buffer.size()) {
     return std::move(buffer);
@@ -112,11 +120,8 @@ consume_word(std::string& buffer, char ending) {
 
 std::string
 consume_words(std::string& buffer) {
-  size_t i = 0;
-
-  while (i < buffer.size() && !(utils::is_whitespace_delimiter(buffer[i]) && !utils::is_space_delimiter(buffer[i]))) {
-    ++i;
-  }
+  //! words are only delimited by non-space whitespaces
+  size_t i = scanner::find_first_of(buffer.data(), buffer.size(), words_endings);
 
   if (i == buffer.size()) {
     return std::move(buffer);
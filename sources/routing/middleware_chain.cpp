@@ -22,6 +22,7 @@
 
 #include <netflex/http/response.hpp>
 #include <netflex/routing/middleware_chain.hpp>
+#include <netflex/routing/middleware_pipeline.hpp>
 
 namespace netflex {
 
@@ -30,11 +31,11 @@ namespace routing {
 //!
 //! ctor & dtor
 //!
-middleware_chain::middleware_chain(const std::list<middleware_t>& middlewares, http::request& request, http::response& response)
-: m_middlewares(middlewares)
+middleware_chain::middleware_chain(const middleware_pipeline& pipeline, http::request& request, http::response& response)
+: m_pipeline(pipeline)
 , m_request(request)
 , m_response(response)
-, m_current_middleware(m_middlewares.begin()) {}
+, m_current_middleware(0) {}
 
 
 //!
@@ -43,7 +44,7 @@ middleware_chain::middleware_chain(const std::list<middleware_t>& middlewares, h
 void
 middleware_chain::proceed(void) {
   //! nothing anymore to proceed
-  if (m_current_middleware == m_middlewares.end())
+  if (m_current_middleware == m_pipeline.size())
     return;
 
   //! we increment the index right now because the next middleware will call .proceed before returning
@@ -51,7 +52,7 @@ middleware_chain::proceed(void) {
   ++m_current_middleware;
 
   //! execute middleware
-  (*std::prev(m_current_middleware))(*this, m_request, m_response);
+  m_pipeline[m_current_middleware - 1](*this, m_request, m_response);
 }
 
 } // namespace routing
@@ -20,32 +20,32 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
-#include <netflex/parsing/message_body_chuncked_parser.hpp>
+#include <netflex/routing/middleware_pipeline.hpp>
 
 namespace netflex {
 
-namespace parsing {
+namespace routing {
 
 //!
-//! ctor
+//! ctor & dtor
 //!
-message_body_chuncked_parser::message_body_chuncked_parser(http::request& request)
-: parser_iface(request) {}
+middleware_pipeline::middleware_pipeline(const std::list<middleware_t>& middlewares)
+: m_middlewares(middlewares.begin(), middlewares.end()) {}
 
 
 //!
-//! parser_iface impl
+//! middlewares access
 //!
-parser_iface&
-message_body_chuncked_parser::operator<<(std::string&) {
-  return *this;
+std::size_t
+middleware_pipeline::size(void) const {
+  return m_middlewares.size();
 }
 
-bool
-message_body_chuncked_parser::is_done(void) const {
-  return true;
+const middleware_t&
+middleware_pipeline::operator[](std::size_t index) const {
+  return m_middlewares[index];
 }
 
-} // namespace parsing
+} // namespace routing
 
 } // namespace netflex
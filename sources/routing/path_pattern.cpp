@@ -0,0 +1,237 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <netflex/misc/error.hpp>
+#include <netflex/routing/path_pattern.hpp>
+
+namespace netflex {
+
+namespace routing {
+
+//!
+//! chars allowed in params names and str params values (same as route_matcher)
+//!
+static bool
+is_param_char(char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '-';
+}
+
+
+//!
+//! conversion
+//!
+const char*
+param_type_to_string(param_type type) {
+  switch (type) {
+  case param_type::str: return "str";
+  case param_type::u64: return "u64";
+  case param_type::i64: return "i64";
+  default: return "unknown";
+  }
+}
+
+
+//!
+//! ctor & dtor
+//!
+path_pattern::path_pattern(const std::string& path)
+: m_path(path) {
+  compile();
+}
+
+
+//!
+//! compilation
+//!
+void
+path_pattern::compile(void) {
+  std::string literal;
+  std::size_t pos = 0;
+
+  while (pos < m_path.size()) {
+    //! params are /:name or /:name<type>
+    if (m_path[pos] != ':' || pos == 0 || m_path[pos - 1] != '/' || pos + 1 == m_path.size() || !is_param_char(m_path[pos + 1])) {
+      literal.push_back(m_path[pos++]);
+      continue;
+    }
+
+    std::size_t name_begin = ++pos;
+    while (pos < m_path.size() && is_param_char(m_path[pos]))
+      ++pos;
+
+    param_type type = param_type::str;
+    std::size_t name_end = pos;
+
+    if (pos < m_path.size() && m_path[pos] == '<') {
+      std::size_t type_end = m_path.find('>', pos);
+      if (type_end == std::string::npos)
+        __NETFLEX_THROW(error, "unterminated param type in route path " + m_path);
+
+      std::string type_str = m_path.substr(pos + 1, type_end - pos - 1);
+      if (type_str == "u64")
+        type = param_type::u64;
+      else if (type_str == "i64")
+        type = param_type::i64;
+      else if (type_str != "str")
+        __NETFLEX_THROW(error, "invalid param type <" + type_str + "> in route path " + m_path);
+
+      pos = type_end + 1;
+    }
+
+    if (!literal.empty()) {
+      m_elements.push_back({false, literal, param_type::str});
+      literal.clear();
+    }
+
+    m_elements.push_back({true, "", type});
+    m_param_names.push_back(m_path.substr(name_begin, name_end - name_begin));
+    m_param_types.push_back(type);
+  }
+
+  if (!literal.empty())
+    m_elements.push_back({false, literal, param_type::str});
+}
+
+
+//!
+//! matching
+//!
+bool
+path_pattern::match(const misc::string_view& target, path_params_t& params) const {
+  //! only match the path: query string and fragment are ignored
+  std::size_t path_end = target.find('?');
+  std::size_t hash     = target.find('#');
+  if (hash < path_end)
+    path_end = hash;
+
+  misc::string_view path = target.substr(0, path_end);
+  std::size_t pos        = 0;
+
+  params.clear();
+
+  for (const auto& element : m_elements) {
+    misc::string_view remaining = path.substr(pos);
+
+    if (!element.is_param) {
+      if (remaining.substr(0, element.literal.size()) != element.literal)
+        return false;
+
+      pos += element.literal.size();
+      continue;
+    }
+
+    path_param param;
+    if (!match_param(element.type, remaining, param))
+      return false;
+
+    pos += param.str.size();
+    params.push_back(param);
+  }
+
+  //! optional trailing slash
+  return pos == path.size() || (pos + 1 == path.size() && path[pos] == '/');
+}
+
+bool
+path_pattern::match_param(param_type type, const misc::string_view& value, path_param& param) {
+  std::size_t size = 0;
+
+  param.type = type;
+  param.u64  = 0;
+  param.i64  = 0;
+
+  switch (type) {
+  case param_type::str:
+    while (size < value.size() && is_param_char(value[size]))
+      ++size;
+
+    param.str = value.substr(0, size);
+    return size > 0;
+
+  case param_type::u64:
+    while (size < value.size() && value[size] >= '0' && value[size] <= '9') {
+      std::uint64_t digit = static_cast<std::uint64_t>(value[size] - '0');
+
+      //! overflow
+      if (param.u64 > (UINT64_MAX - digit) / 10)
+        return false;
+
+      param.u64 = param.u64 * 10 + digit;
+      ++size;
+    }
+
+    param.str = value.substr(0, size);
+    return size > 0;
+
+  case param_type::i64: {
+    bool negative = size < value.size() && value[size] == '-';
+    if (negative)
+      ++size;
+
+    std::size_t digits_begin = size;
+    std::uint64_t magnitude  = 0;
+    std::uint64_t limit      = negative ? static_cast<std::uint64_t>(INT64_MAX) + 1 : static_cast<std::uint64_t>(INT64_MAX);
+
+    while (size < value.size() && value[size] >= '0' && value[size] <= '9') {
+      std::uint64_t digit = static_cast<std::uint64_t>(value[size] - '0');
+
+      //! overflow
+      if (magnitude > (limit - digit) / 10)
+        return false;
+
+      magnitude = magnitude * 10 + digit;
+      ++size;
+    }
+
+    param.i64 = negative ? static_cast<std::int64_t>(0 - magnitude) : static_cast<std::int64_t>(magnitude);
+    param.str = value.substr(0, size);
+    return size > digits_begin;
+  }
+
+  default:
+    return false;
+  }
+}
+
+
+//!
+//! getters
+//!
+const std::string&
+path_pattern::get_path(void) const {
+  return m_path;
+}
+
+const std::vector<std::string>&
+path_pattern::get_param_names(void) const {
+  return m_param_names;
+}
+
+const std::vector<param_type>&
+path_pattern::get_param_types(void) const {
+  return m_param_types;
+}
+
+} // namespace routing
+
+} // namespace netflex
@@ -0,0 +1,260 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <netflex/routing/query.hpp>
+
+namespace netflex {
+
+namespace routing {
+
+//!
+//! decoding helpers
+//!
+static int
+hex_value(char c) {
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  if (c >= 'a' && c <= 'f')
+    return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F')
+    return c - 'A' + 10;
+
+  return -1;
+}
+
+//!
+//! decode the char at pos of component
+//!
+//! \param component component being decoded
+//! \param pos position of the char to decode, updated to the position of the next one
+//! \return decoded char
+//!
+static char
+decode_char(const misc::string_view& component, std::size_t& pos) {
+  char c = component[pos++];
+
+  if (c == '+')
+    return ' ';
+
+  if (c == '%' && pos + 1 < component.size()) {
+    int high = hex_value(component[pos]);
+    int low  = hex_value(component[pos + 1]);
+
+    if (high >= 0 && low >= 0) {
+      pos += 2;
+      return static_cast<char>((high << 4) | low);
+    }
+  }
+
+  return c;
+}
+
+
+//!
+//! ctor & dtor
+//!
+query::query(const misc::string_view& raw)
+: m_raw(raw) {}
+
+
+//!
+//! build from target
+//!
+query
+query::from_target(const misc::string_view& target) {
+  //! a '?' in the fragment does not start a query string
+  misc::string_view path = target.substr(0, target.find('#'));
+  std::size_t begin      = path.find('?');
+
+  if (begin == misc::string_view::npos)
+    return query();
+
+  return query(path.substr(begin + 1));
+}
+
+
+//!
+//! getters
+//!
+const misc::string_view&
+query::get_raw(void) const {
+  return m_raw;
+}
+
+bool
+query::empty(void) const {
+  std::size_t pos = 0;
+  misc::string_view key;
+  misc::string_view value;
+
+  return !next_param(pos, key, value);
+}
+
+std::size_t
+query::size(void) const {
+  std::size_t pos  = 0;
+  std::size_t size = 0;
+  misc::string_view key;
+  misc::string_view value;
+
+  while (next_param(pos, key, value))
+    ++size;
+
+  return size;
+}
+
+
+//!
+//! lookups
+//!
+bool
+query::has(const misc::string_view& key) const {
+  std::size_t pos = 0;
+  misc::string_view raw_key;
+  misc::string_view raw_value;
+
+  while (next_param(pos, raw_key, raw_value))
+    if (key_equals(raw_key, key))
+      return true;
+
+  return false;
+}
+
+std::size_t
+query::count(const misc::string_view& key) const {
+  std::size_t pos   = 0;
+  std::size_t count = 0;
+  misc::string_view raw_key;
+  misc::string_view raw_value;
+
+  while (next_param(pos, raw_key, raw_value))
+    if (key_equals(raw_key, key))
+      ++count;
+
+  return count;
+}
+
+misc::string_view
+query::get_raw_value(const misc::string_view& key) const {
+  std::size_t pos = 0;
+  misc::string_view raw_key;
+  misc::string_view raw_value;
+
+  while (next_param(pos, raw_key, raw_value))
+    if (key_equals(raw_key, key))
+      return raw_value;
+
+  return misc::string_view();
+}
+
+std::string
+query::get(const misc::string_view& key, const std::string& default_value) const {
+  std::size_t pos = 0;
+  misc::string_view raw_key;
+  misc::string_view raw_value;
+
+  while (next_param(pos, raw_key, raw_value))
+    if (key_equals(raw_key, key))
+      return decode(raw_value);
+
+  return default_value;
+}
+
+std::vector<std::string>
+query::get_all(const misc::string_view& key) const {
+  std::vector<std::string> values;
+  std::size_t pos = 0;
+  misc::string_view raw_key;
+  misc::string_view raw_value;
+
+  while (next_param(pos, raw_key, raw_value))
+    if (key_equals(raw_key, key))
+      values.push_back(decode(raw_value));
+
+  return values;
+}
+
+
+//!
+//! decoding
+//!
+std::string
+query::decode(const misc::string_view& component) {
+  std::string decoded;
+  decoded.reserve(component.size());
+
+  std::size_t pos = 0;
+  while (pos < component.size())
+    decoded.push_back(decode_char(component, pos));
+
+  return decoded;
+}
+
+
+//!
+//! parsing
+//!
+bool
+query::next_param(std::size_t& pos, misc::string_view& key, misc::string_view& value) const {
+  while (pos < m_raw.size()) {
+    std::size_t end = m_raw.find('&', pos);
+    if (end == misc::string_view::npos)
+      end = m_raw.size();
+
+    misc::string_view param = m_raw.substr(pos, end - pos);
+    pos                     = end + 1;
+
+    //! skip empty params
+    if (param.empty())
+      continue;
+
+    std::size_t equal = param.find('=');
+    key               = param.substr(0, equal);
+    value             = equal == misc::string_view::npos ? misc::string_view() : param.substr(equal + 1);
+
+    return true;
+  }
+
+  return false;
+}
+
+bool
+query::key_equals(const misc::string_view& raw_key, const misc::string_view& key) {
+  //! a decoded key is never longer than its raw form
+  if (raw_key.size() < key.size())
+    return false;
+
+  std::size_t raw_pos = 0;
+  std::size_t pos     = 0;
+
+  while (raw_pos < raw_key.size()) {
+    if (pos == key.size() || decode_char(raw_key, raw_pos) != key[pos++])
+      return false;
+  }
+
+  return pos == key.size();
+}
+
+} // namespace routing
+
+} // namespace netflex
@@ -33,7 +33,13 @@ route::route(http::method m, const std::string& path, const route_callback_t& ca
 : m_method(m)
 , m_path(path)
 , m_callback(callback)
-, m_matcher(path) {}
+, m_matcher(std::make_shared<route_matcher>(path)) {}
+
+route::route(http::method m, const path_pattern& pattern, const route_callback_t& callback)
+: m_method(m)
+, m_path(pattern.get_path())
+, m_callback(callback)
+, m_pattern(std::make_shared<path_pattern>(pattern)) {}
 
 
 //!
@@ -45,9 +51,21 @@ route::match(http::request& request) const {
   if (request.get_method() != m_method)
     return false;
 
+  //! typed route: params are parsed and validated while matching
+  if (m_pattern) {
+    path_params_t path_params;
+    if (!m_pattern->match(request.get_target(), path_params))
+      return false;
+
+    request.set_path(m_path);
+    request.set_path_params(path_params);
+
+    return true;
+  }
+
   //! no path matching, return
   params_t params;
-  if (!m_matcher.match(request.get_target(), params))
+  if (!m_matcher->match(request.get_target(), params))
     return false;
 
   request.set_path(m_path);
@@ -57,6 +75,33 @@ route::match(http::request& request) const {
 }
 
 
+//!
+//! getters
+//!
+http::method
+route::get_method(void) const {
+  return m_method;
+}
+
+const std::string&
+route::get_path(void) const {
+  return m_path;
+}
+
+const route::route_callback_t&
+route::get_callback(void) const {
+  return m_callback;
+}
+
+route
+route::with_path(const std::string& path) const {
+  if (m_pattern)
+    return route(m_method, path_pattern(path), m_callback);
+
+  return route(m_method, path, m_callback);
+}
+
+
 //!
 //! dispatch
 //!
@@ -20,6 +20,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <algorithm>
+
 #include <netflex/routing/route_matcher.hpp>
 
 namespace netflex {
@@ -59,16 +61,12 @@ route_matcher::build_match_regex(const std::string& path) {
   }
 
   //! transform /abc/:var1/def into /abc/([a-zA-Z0-9]*)/def to match url params values
-  //! also match trailing slash, get params and #comments
+  //! also match trailing slash
+  //! get params and #comments are stripped before matching, so that the regex only deals with the path
   //!
   //! regex_replace(path, reg, "/([a-zA-Z0-9]+)") ==> transform /abc/:var1/def into /abc/([a-zA-Z0-9]*)/def
-  //! "/?((\\?([^=]+)=([^&\\#]*))(&([^=]+)=([^&\\#]*))*)?(\\#.*)?" ==> match trailing slash, get params and #comments
-  //!  > /? ==> match trailing slash
-  //!  > ((\\?([^=]+)=([^&\\#]*))(&([^=]+)=([^&\\#]*))*)? ==> match get params
-  //!    > (\\?([^=]+)=([^&\\#]*)) ==> match first ?var=val
-  //!    > (&([^=]+)=([^&\\#]*))*)?(\\#.*)? ==> match subsequent &var=val
-  //!  > (\\#.*)? ==> match #comments
-  m_match_regex_str = std::regex_replace(path, find_url_params_regex, std::string("/([a-zA-Z0-9_\\-]+)")) + "/?((\\?([^=]+)=([^&\\#]*))(&([^=]+)=([^&\\#]*))*)?(\\#.*)*";
+  //! "/?" ==> match trailing slash
+  m_match_regex_str = std::regex_replace(path, find_url_params_regex, std::string("/([a-zA-Z0-9_\\-]+)")) + "/?";
   m_match_regex     = std::regex(m_match_regex_str);
 }
 
@@ -80,40 +78,19 @@ bool
 route_matcher::match(const std::string& path, params_t& params) const {
   std::smatch sm;
 
-  if (!std::regex_match(path, sm, m_match_regex))
+  //! only match the path: get params are parsed lazily by http::request::get_query()
+  auto path_end = path.cbegin() + std::min(path.find_first_of("?#"), path.size());
+
+  if (!std::regex_match(path.cbegin(), path_end, sm, m_match_regex))
     return false;
 
   //! expected url params are in sm[1..m_url_params.size()]
   for (size_t i = 1; i <= m_url_params.size(); ++i)
     params[m_url_params[i - 1]] = sm[i];
 
-  //! sm[m_url_params.size() + 1] contains get_params
-  match_get_params(sm[m_url_params.size() + 1], params);
-
   return true;
 }
 
-void
-route_matcher::match_get_params(const std::string& path, params_t& params) const {
-  std::regex params_regex("[\\?&]([^=]+)=([^&]*)");
-  std::smatch sm;
-
-  auto params_it  = std::sregex_iterator(path.cbegin(), path.cend(), params_regex);
-  auto params_end = std::sregex_iterator();
-
-  while (params_it != params_end) {
-    auto param = params_it->str();
-
-    if (!std::regex_match(param, sm, params_regex))
-      continue;
-
-    //! sm is [?key1=val1, key1, val1]
-    params[sm[1]] = sm[2];
-
-    ++params_it;
-  }
-}
-
 } // namespace routing
 
 } // namespace netflex
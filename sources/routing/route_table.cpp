@@ -0,0 +1,180 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cctype>
+
+#include <netflex/routing/route_table.hpp>
+
+namespace netflex {
+
+namespace routing {
+
+//!
+//! mount points
+//!
+void
+route_table::add(const std::string& prefix, const middleware_pipeline& pipeline) {
+  mount_point mount = {normalize_prefix(prefix), pipeline};
+
+  //! keep longest prefixes first, after the mount points of the same length already added
+  auto position = std::find_if(m_mount_points.begin(), m_mount_points.end(), [&](const mount_point& other) {
+    return other.prefix.size() < mount.prefix.size();
+  });
+
+  m_mount_points.insert(position, std::move(mount));
+}
+
+const middleware_pipeline*
+route_table::resolve(const std::string& target) const {
+  for (const auto& mount : m_mount_points) {
+    const std::string& prefix = mount.prefix;
+
+    if (target.compare(0, prefix.size(), prefix))
+      continue;
+
+    //! /api matches /api, /api/users and /api?x=1, but not /apis
+    if (prefix.empty() || target.size() == prefix.size() || target[prefix.size()] == '/' || target[prefix.size()] == '?' || target[prefix.size()] == '#')
+      return &mount.pipeline;
+  }
+
+  return nullptr;
+}
+
+std::size_t
+route_table::size(void) const {
+  return m_mount_points.size();
+}
+
+
+//!
+//! static responses
+//!
+void
+route_table::add_static_response(http::method m, const std::string& path, const std::shared_ptr<const http::static_response>& response) {
+  m_static_responses[path].emplace_back(m, response);
+}
+
+const http::static_response*
+route_table::resolve_static_response(http::method m, const std::string& target) const {
+  if (m_static_responses.empty())
+    return nullptr;
+
+  //! targets without query string are looked up without copying them
+  std::size_t path_end = target.find_first_of("?#");
+  auto responses       = path_end == std::string::npos ? m_static_responses.find(target) : m_static_responses.find(target.substr(0, path_end));
+
+  if (responses == m_static_responses.end())
+    return nullptr;
+
+  for (const auto& response : responses->second)
+    if (response.first == m || (m == http::method::HEAD && response.first == http::method::GET))
+      return response.second.get();
+
+  return nullptr;
+}
+
+
+//!
+//! virtual hosts
+//!
+void
+route_table::add_host(const std::string& host, const route_table& table) {
+  std::string normalized = normalize_host(host);
+  auto shared_table      = std::make_shared<const route_table>(table);
+
+  //! *.example.com is stored as .example.com
+  if (normalized.compare(0, 2, "*.") == 0)
+    m_wildcard_hosts.emplace(normalized.substr(1), shared_table);
+  else
+    m_hosts.emplace(normalized, shared_table);
+}
+
+const route_table&
+route_table::resolve_host(const std::string& host) const {
+  if (m_hosts.empty() && m_wildcard_hosts.empty())
+    return *this;
+
+  std::string normalized = normalize_host(host);
+
+  auto exact = m_hosts.find(normalized);
+  if (exact != m_hosts.end())
+    return *exact->second;
+
+  if (m_wildcard_hosts.empty())
+    return *this;
+
+  //! try .b.example.com, then .example.com, then .com for a.b.example.com
+  for (std::size_t dot = normalized.find('.'); dot != std::string::npos; dot = normalized.find('.', dot + 1)) {
+    auto wildcard = m_wildcard_hosts.find(normalized.substr(dot));
+
+    if (wildcard != m_wildcard_hosts.end())
+      return *wildcard->second;
+  }
+
+  return *this;
+}
+
+std::size_t
+route_table::get_nb_hosts(void) const {
+  return m_hosts.size() + m_wildcard_hosts.size();
+}
+
+
+//!
+//! host normalization
+//!
+std::string
+route_table::normalize_host(const std::string& host) {
+  std::size_t end = host.size();
+
+  //! strip port, except in ipv6 literals ([::1]:8080)
+  std::size_t colon = host.rfind(':');
+  if (colon != std::string::npos && host.find(']', colon) == std::string::npos)
+    end = colon;
+
+  while (end && host[end - 1] == '.')
+    --end;
+
+  std::string normalized(host, 0, end);
+  std::transform(normalized.begin(), normalized.end(), normalized.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+  return normalized;
+}
+
+
+//!
+//! prefix normalization
+//!
+std::string
+route_table::normalize_prefix(const std::string& prefix) {
+  std::size_t end = prefix.size();
+
+  while (end && prefix[end - 1] == '/')
+    --end;
+
+  return prefix.substr(0, end);
+}
+
+} // namespace routing
+
+} // namespace netflex
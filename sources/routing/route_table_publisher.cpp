@@ -0,0 +1,202 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <thread>
+
+#include <netflex/routing/route_table_publisher.hpp>
+
+namespace netflex {
+
+namespace routing {
+
+//!
+//! number of read-side sections the current thread is in
+//! used to avoid waiting for ourselves when reclaiming from a route handler
+//!
+static thread_local unsigned int read_depth = 0;
+
+
+//!
+//! reader
+//!
+route_table_publisher::reader::reader(const route_table_publisher& publisher)
+: m_publisher(publisher)
+, m_epoch(publisher.m_epoch.load()) {
+  ++read_depth;
+
+  //! register before loading the snapshot: a reclaimer observing the counter at 0 knows we will load a newer snapshot
+  m_publisher.m_readers[m_epoch].value.fetch_add(1);
+  m_table = m_publisher.m_current.load();
+}
+
+route_table_publisher::reader::~reader(void) {
+  m_publisher.m_readers[m_epoch].value.fetch_sub(1);
+
+  //! snapshots retired meanwhile, possibly by this very section: reclaimed as soon as no reader can use them anymore
+  if (--read_depth == 0 && m_publisher.m_nb_retired.load(std::memory_order_relaxed))
+    m_publisher.try_reclaim();
+}
+
+const route_table&
+route_table_publisher::reader::operator*(void) const {
+  return *m_table;
+}
+
+const route_table*
+route_table_publisher::reader::operator->(void) const {
+  return m_table;
+}
+
+
+//!
+//! ctor & dtor
+//!
+route_table_publisher::route_table_publisher(void)
+: m_current(new route_table)
+, m_epoch(0)
+, m_nb_retired(0) {
+  m_readers[0].value = 0;
+  m_readers[1].value = 0;
+  m_drained[0]       = false;
+  m_drained[1]       = false;
+}
+
+route_table_publisher::~route_table_publisher(void) {
+  for (const route_table* table : m_retired)
+    delete table;
+
+  for (const route_table* table : m_reclaiming)
+    delete table;
+
+  delete m_current.load();
+}
+
+
+//!
+//! publication
+//!
+void
+route_table_publisher::publish(route_table table) {
+  const route_table* previous = m_current.exchange(new route_table(std::move(table)));
+
+  std::lock_guard<std::mutex> lock(m_retired_mutex);
+  m_retired.push_back(previous);
+  ++m_nb_retired;
+}
+
+void
+route_table_publisher::reclaim(void) {
+  //! waiting from a read-side section would wait for ourselves
+  if (read_depth > 0)
+    return;
+
+  std::lock_guard<std::mutex> reclaim_lock(m_reclaim_mutex);
+
+  //! take the snapshots retired so far, along with the ones being reclaimed: they are not reachable by the readers created from now on
+  std::vector<const route_table*> retired;
+  retired.swap(m_reclaiming);
+  {
+    std::lock_guard<std::mutex> lock(m_retired_mutex);
+    retired.insert(retired.end(), m_retired.begin(), m_retired.end());
+    m_retired.clear();
+  }
+
+  if (retired.empty())
+    return;
+
+  synchronize();
+
+  for (const route_table* table : retired)
+    delete table;
+
+  m_nb_retired -= retired.size();
+}
+
+void
+route_table_publisher::try_reclaim(void) const {
+  std::unique_lock<std::mutex> reclaim_lock(m_reclaim_mutex, std::try_to_lock);
+
+  //! another thread is reclaiming
+  if (!reclaim_lock.owns_lock())
+    return;
+
+  //! new batch: the readers registered so far must be observed gone from both counters
+  if (m_reclaiming.empty()) {
+    std::lock_guard<std::mutex> lock(m_retired_mutex);
+    m_reclaiming.swap(m_retired);
+    m_drained[0] = false;
+    m_drained[1] = false;
+  }
+
+  if (m_reclaiming.empty())
+    return;
+
+  //! same steps as synchronize, each counter being observed at 0 once, but checked instead of waited for
+  bool steered = false;
+  for (unsigned int epoch = 0; epoch < 2; ++epoch) {
+    if (m_drained[epoch])
+      continue;
+
+    if (m_readers[epoch].value.load() == 0) {
+      m_drained[epoch] = true;
+    }
+    else if (!steered) {
+      unsigned int expected = epoch;
+      m_epoch.compare_exchange_strong(expected, epoch ^ 1);
+      steered = true;
+    }
+  }
+
+  if (!m_drained[0] || !m_drained[1])
+    return;
+
+  for (const route_table* table : m_reclaiming)
+    delete table;
+
+  m_nb_retired -= m_reclaiming.size();
+  m_reclaiming.clear();
+}
+
+std::size_t
+route_table_publisher::get_nb_retired(void) const {
+  return m_nb_retired;
+}
+
+void
+route_table_publisher::synchronize(void) {
+  //! a reader started before this call is registered in one of the counters until it ends
+  //! so both counters being observed at 0 once means all of them ended
+  //! new readers are steered to the other counter, so that the waited counter drains
+  for (unsigned int epoch = 0; epoch < 2; ++epoch) {
+    while (m_readers[epoch].value.load() != 0) {
+      unsigned int expected = epoch;
+      m_epoch.compare_exchange_strong(expected, epoch ^ 1);
+
+      std::this_thread::yield();
+    }
+  }
+}
+
+} // namespace routing
+
+} // namespace netflex
@@ -0,0 +1,76 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <netflex/routing/router.hpp>
+
+namespace netflex {
+
+namespace routing {
+
+//!
+//! add routes to the router
+//!
+router&
+router::add_route(const route& route) {
+  m_routes.push_back(route);
+  return *this;
+}
+
+router&
+router::add_routes(const std::vector<route>& routes) {
+  m_routes.insert(m_routes.end(), routes.begin(), routes.end());
+  return *this;
+}
+
+
+//!
+//! add middlewares
+//!
+router&
+router::add_middleware(const middleware_t& middleware) {
+  m_middlewares.push_back(middleware);
+  return *this;
+}
+
+router&
+router::add_middlewares(const std::list<middleware_t>& middlewares) {
+  m_middlewares.insert(m_middlewares.end(), middlewares.begin(), middlewares.end());
+  return *this;
+}
+
+
+//!
+//! getters
+//!
+const std::vector<route>&
+router::get_routes(void) const {
+  return m_routes;
+}
+
+const std::list<middleware_t>&
+router::get_middlewares(void) const {
+  return m_middlewares;
+}
+
+} // namespace routing
+
+} // namespace netflex
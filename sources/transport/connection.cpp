@@ -20,32 +20,22 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
-#include <netflex/parsing/message_body_deflate_parser.hpp>
+#include <netflex/transport/connection.hpp>
 
 namespace netflex {
 
-namespace parsing {
+namespace transport {
 
 //!
-//! ctor
+//! async operations
 //!
-message_body_deflate_parser::message_body_deflate_parser(http::request& request)
-: parser_iface(request) {}
+void
+connection::async_write_zerocopy(std::vector<char>&& head, const std::shared_ptr<const std::string>& body, const write_callback_t& callback) {
+  head.insert(head.end(), body->begin(), body->end());
 
-
-//!
-//! parser_iface impl
-//!
-parser_iface&
-message_body_deflate_parser::operator<<(std::string&) {
-  return *this;
-}
-
-bool
-message_body_deflate_parser::is_done(void) const {
-  return true;
+  async_write(std::move(head), callback);
 }
 
-} // namespace parsing
+} // namespace transport
 
 } // namespace netflex
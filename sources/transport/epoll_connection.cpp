@@ -0,0 +1,676 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifdef __linux__
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <ctime>
+
+#include <linux/errqueue.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifdef __NETFLEX_TLS_ENABLED
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+#endif /* __NETFLEX_TLS_ENABLED */
+
+#include <netflex/misc/buffer_pool.hpp>
+#include <netflex/misc/logger.hpp>
+#include <netflex/transport/epoll_connection.hpp>
+#include <netflex/transport/epoll_loop.hpp>
+#include <netflex/transport/tls_context.hpp>
+
+namespace netflex {
+
+namespace transport {
+
+//!
+//! how long a connection closed with zero copy sends in flight waits for their completion before being reset
+//!
+static const std::chrono::seconds zerocopy_linger(5);
+
+
+//!
+//! ctor & dtor
+//!
+epoll_connection::epoll_connection(int fd, std::uint64_t id, epoll_loop& loop, const std::string& host, std::uint32_t port, const std::shared_ptr<tls_context>& tls)
+: m_fd(fd)
+, m_id(id)
+, m_loop(loop)
+, m_host(host)
+, m_port(port)
+, m_tls_context(tls)
+, m_ssl(nullptr)
+, m_tls_established(false)
+, m_connected(true)
+, m_readable(false)
+, m_writable(true)
+, m_peer_closed(false)
+, m_error(false)
+, m_scheduled(false)
+, m_read_pending(false)
+, m_read_size(0)
+, m_read_callback(nullptr)
+, m_zerocopy_state(zerocopy_state::unknown)
+, m_zerocopy_next_seq(0)
+, m_lingering(false)
+, m_disconnection_handler(nullptr) {
+#ifdef __NETFLEX_TLS_ENABLED
+  if (m_tls_context) {
+    m_ssl = SSL_new(m_tls_context->get_native_handle());
+
+    //! records are encrypted, by OpenSSL or by the kernel which does not support MSG_ZEROCOPY: bodies are always copied
+    m_zerocopy_state = zerocopy_state::disabled;
+
+    //! without OpenSSL connection, the handshake fails and the connection is closed by its first processing
+    if (m_ssl && SSL_set_fd(m_ssl, m_fd) == 1) {
+      SSL_set_accept_state(m_ssl);
+    }
+    else {
+      SSL_free(m_ssl);
+      m_ssl = nullptr;
+      ERR_clear_error();
+    }
+  }
+#endif /* __NETFLEX_TLS_ENABLED */
+}
+
+epoll_connection::~epoll_connection(void) {
+#ifdef __NETFLEX_TLS_ENABLED
+  SSL_free(m_ssl);
+#endif /* __NETFLEX_TLS_ENABLED */
+
+  if (m_fd >= 0)
+    ::close(m_fd);
+}
+
+
+//!
+//! peer
+//!
+const std::string&
+epoll_connection::get_host(void) const {
+  return m_host;
+}
+
+std::uint32_t
+epoll_connection::get_port(void) const {
+  return m_port;
+}
+
+bool
+epoll_connection::is_connected(void) const {
+  return m_connected;
+}
+
+
+//!
+//! async operations
+//!
+void
+epoll_connection::async_read(std::size_t size, const read_callback_t& callback) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (!m_connected)
+    return;
+
+  m_read_pending  = true;
+  m_read_size     = size;
+  m_read_callback = callback;
+
+  //! no event will come for the data already received: read it on the next loop iteration
+  if (m_readable)
+    schedule();
+}
+
+void
+epoll_connection::async_write(std::vector<char>&& buffer, const write_callback_t& callback) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (!m_connected) {
+    misc::buffer_pool::release(std::move(buffer));
+    return;
+  }
+
+  m_writes.push_back({std::move(buffer), 0, callback, nullptr, false});
+
+  //! most responses fit in the socket buffer: written right away, without waiting for the loop
+  flush_writes();
+
+  //! callbacks are called by the loop, as the caller may not expect them to be called in place
+  if (!m_completed_writes.empty() || m_error)
+    schedule();
+}
+
+void
+epoll_connection::async_write_zerocopy(std::vector<char>&& head, const std::shared_ptr<const std::string>& body, const write_callback_t& callback) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (!m_connected) {
+    misc::buffer_pool::release(std::move(head));
+    return;
+  }
+
+  //! kernels without zero copy support reject the option: bodies are then sent with a regular copy
+  if (m_zerocopy_state == zerocopy_state::unknown) {
+    int enable       = 1;
+    m_zerocopy_state = ::setsockopt(m_fd, SOL_SOCKET, SO_ZEROCOPY, &enable, sizeof(enable)) == 0 ? zerocopy_state::enabled : zerocopy_state::disabled;
+  }
+
+  m_writes.push_back({std::move(head), 0, callback, body, false});
+
+  flush_writes();
+
+  if (!m_completed_writes.empty() || m_error)
+    schedule();
+}
+
+void
+epoll_connection::set_disconnection_handler(const disconnection_handler_t& handler) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  m_disconnection_handler = handler;
+}
+
+void
+epoll_connection::disconnect(void) {
+  close(false);
+}
+
+
+//!
+//! loop notifications
+//!
+void
+epoll_connection::on_events(std::uint32_t events) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    //! closed with zero copy sends in flight: only waiting for the kernel to be done with the bodies
+    if (m_lingering) {
+      if (events & EPOLLERR)
+        read_zerocopy_notifications();
+
+      if (m_zerocopy_bodies.empty())
+        release_socket(false);
+
+      return;
+    }
+
+    //! zero copy completions are queued on the socket error queue, which is notified as an error
+    //! only a pending socket error is an actual failure of the connection
+    if ((events & EPOLLERR) && m_zerocopy_state != zerocopy_state::unknown && m_fd >= 0) {
+      read_zerocopy_notifications();
+
+      int error         = 0;
+      socklen_t size    = sizeof(error);
+      bool socket_error = ::getsockopt(m_fd, SOL_SOCKET, SO_ERROR, &error, &size) != 0 || error != 0;
+
+      //! the socket error is consumed by getsockopt, later I/O would not report it
+      if (socket_error)
+        m_error = true;
+      else
+        events &= ~EPOLLERR;
+    }
+
+    if (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))
+      m_readable = true;
+
+    if (events & (EPOLLRDHUP | EPOLLHUP | EPOLLERR))
+      m_peer_closed = true;
+
+    if (events & (EPOLLOUT | EPOLLHUP | EPOLLERR))
+      m_writable = true;
+
+    //! TLS reads may wait for the socket to be writable (handshake) and TLS writes for it to be readable: any event retries both
+    if (m_tls_context) {
+      m_readable = true;
+      m_writable = true;
+    }
+  }
+
+  process();
+}
+
+void
+epoll_connection::process(void) {
+  read_callback_t read_callback = nullptr;
+  std::vector<char> buffer;
+  bool has_read  = false;
+  bool has_error = false;
+  std::vector<std::pair<write_callback_t, write_result>> completed_writes;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_scheduled = false;
+
+    if (!m_connected)
+      return;
+
+    //! nothing is read or written before the end of the TLS handshake
+    bool is_ready = handshake();
+
+    if (is_ready)
+      flush_writes();
+
+    if (is_ready && !m_error && m_read_pending && m_readable) {
+      has_read = read(buffer);
+
+      if (has_read) {
+        m_read_pending  = false;
+        read_callback   = std::move(m_read_callback);
+        m_read_callback = nullptr;
+      }
+    }
+
+    completed_writes.swap(m_completed_writes);
+    has_error = m_error;
+  }
+
+  for (auto& completed_write : completed_writes) {
+    if (completed_write.first)
+      completed_write.first(completed_write.second);
+  }
+
+  //! a write callback may have closed the connection
+  if (has_read && m_connected) {
+    read_result result = {true, buffer.data(), buffer.size()};
+    read_callback(result);
+  }
+
+  //! read buffers are not kept by the callback
+  misc::buffer_pool::release(std::move(buffer));
+
+  if (has_error)
+    close(true);
+}
+
+
+//!
+//! socket I/O
+//!
+void
+epoll_connection::flush_writes(void) {
+  //! written by the processing completing the TLS handshake
+  if (m_tls_context && !m_tls_established)
+    return;
+
+  while (!m_writes.empty() && m_writable) {
+    pending_write& write = m_writes.front();
+    ssize_t nb_bytes;
+
+    //! the head is sent as more data to come, to be coalesced with the body
+    if (!write.body || write.offset < write.buffer.size())
+      nb_bytes = send_bytes(write.buffer.data() + write.offset, write.buffer.size() - write.offset, MSG_NOSIGNAL | (write.body ? MSG_MORE : 0));
+    else
+      nb_bytes = send_body();
+
+    if (nb_bytes < 0) {
+      if (errno == EINTR)
+        continue;
+
+      //! EPOLLOUT is notified once the socket buffer has room again
+      if (errno == EAGAIN || errno == EWOULDBLOCK)
+        m_writable = false;
+      else
+        m_error = true;
+
+      return;
+    }
+
+    write.offset += nb_bytes;
+
+    std::size_t size = write.buffer.size() + (write.body ? write.body->size() : 0);
+
+    if (write.offset == size) {
+      m_completed_writes.emplace_back(std::move(write.callback), write_result{true, size});
+      misc::buffer_pool::release(std::move(write.buffer));
+
+      //! the last zero copy send of the body is the last one issued so far
+      if (write.zerocopy_sent)
+        m_zerocopy_bodies.emplace_back(m_zerocopy_next_seq - 1, std::move(write.body));
+
+      m_writes.pop_front();
+    }
+  }
+}
+
+ssize_t
+epoll_connection::send_body(void) {
+  pending_write& write = m_writes.front();
+  std::size_t offset   = write.offset - write.buffer.size();
+  const char* data     = write.body->data() + offset;
+  std::size_t size     = write.body->size() - offset;
+
+  if (m_zerocopy_state == zerocopy_state::enabled) {
+    ssize_t nb_bytes = ::send(m_fd, data, size, MSG_NOSIGNAL | MSG_ZEROCOPY);
+
+    //! each successful zero copy send is given the next sequence number, notified once the kernel is done with the pages
+    if (nb_bytes >= 0) {
+      ++m_zerocopy_next_seq;
+      write.zerocopy_sent = true;
+      return nb_bytes;
+    }
+
+    //! ENOBUFS: too many pages pinned by the socket (optmem limit), this part is copied instead
+    if (errno != ENOBUFS)
+      return nb_bytes;
+  }
+
+  return send_bytes(data, size, MSG_NOSIGNAL);
+}
+
+void
+epoll_connection::read_zerocopy_notifications(void) {
+  for (;;) {
+    char control[128];
+    struct msghdr message = {};
+    message.msg_control    = control;
+    message.msg_controllen = sizeof(control);
+
+    if (::recvmsg(m_fd, &message, MSG_ERRQUEUE) < 0) {
+      if (errno == EINTR)
+        continue;
+
+      //! EAGAIN: error queue drained
+      return;
+    }
+
+    for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&message); cmsg; cmsg = CMSG_NXTHDR(&message, cmsg)) {
+      bool is_ipv4_error = cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR;
+      bool is_ipv6_error = cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR;
+
+      if (!is_ipv4_error && !is_ipv6_error)
+        continue;
+
+      const struct sock_extended_err* error = reinterpret_cast<const struct sock_extended_err*>(CMSG_DATA(cmsg));
+
+      if (error->ee_errno != 0 || error->ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+        continue;
+
+      //! pages copied anyway (loopback, device without scatter-gather): zero copy only adds the cost of the notifications
+      if (error->ee_code & SO_EE_CODE_ZEROCOPY_COPIED)
+        m_zerocopy_state = zerocopy_state::disabled;
+
+      //! sends [ee_info, ee_data] are done, notified in order on TCP sockets
+      std::uint32_t last_seq = error->ee_data;
+
+      while (!m_zerocopy_bodies.empty() && static_cast<std::int32_t>(last_seq - m_zerocopy_bodies.front().first) >= 0)
+        m_zerocopy_bodies.pop_front();
+    }
+  }
+}
+
+bool
+epoll_connection::read(std::vector<char>& buffer) {
+  buffer = misc::buffer_pool::acquire(m_read_size);
+  buffer.resize(m_read_size);
+
+  for (;;) {
+    ssize_t nb_bytes = recv_bytes(buffer.data(), m_read_size);
+
+    if (nb_bytes > 0) {
+      buffer.resize(nb_bytes);
+
+      //! socket drained: data received from now on is notified by a new event
+      //! after a shutdown of the peer, keep reading until end of file, which is not notified again
+      //! TLS reads return a record at most, the next ones possibly being already read from the socket by OpenSSL
+      if (static_cast<std::size_t>(nb_bytes) < m_read_size && !m_peer_closed && !m_ssl)
+        m_readable = false;
+
+      return true;
+    }
+
+    if (nb_bytes < 0 && errno == EINTR)
+      continue;
+
+    //! 0: connection closed by the peer
+    if (nb_bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+      m_readable = false;
+    else
+      m_error = true;
+
+    buffer.clear();
+    return false;
+  }
+}
+
+ssize_t
+epoll_connection::send_bytes(const char* data, std::size_t size, int flags) {
+#ifdef __NETFLEX_TLS_ENABLED
+  if (m_ssl)
+    return size ? to_io_result(SSL_write(m_ssl, data, static_cast<int>(std::min<std::size_t>(size, INT_MAX)))) : 0;
+#endif /* __NETFLEX_TLS_ENABLED */
+
+  return ::send(m_fd, data, size, flags);
+}
+
+ssize_t
+epoll_connection::recv_bytes(char* data, std::size_t size) {
+#ifdef __NETFLEX_TLS_ENABLED
+  if (m_ssl)
+    return to_io_result(SSL_read(m_ssl, data, static_cast<int>(std::min<std::size_t>(size, INT_MAX))));
+#endif /* __NETFLEX_TLS_ENABLED */
+
+  return ::recv(m_fd, data, size, 0);
+}
+
+void
+epoll_connection::schedule(void) {
+  if (m_scheduled)
+    return;
+
+  m_scheduled = true;
+  m_loop.schedule(shared_from_this());
+}
+
+
+//!
+//! TLS
+//!
+bool
+epoll_connection::handshake(void) {
+  if (!m_tls_context || m_tls_established)
+    return true;
+
+#ifdef __NETFLEX_TLS_ENABLED
+  int result = m_ssl ? SSL_do_handshake(m_ssl) : -1;
+
+  if (result == 1) {
+    m_tls_established = true;
+
+#ifndef OPENSSL_NO_KTLS
+    if (BIO_get_ktls_send(SSL_get_wbio(m_ssl))) {
+      __NETFLEX_LOG(debug, __NETFLEX_CLIENT_LOG_PREFIX(m_host, m_port) + "TLS records encrypted by the kernel");
+    }
+#endif /* OPENSSL_NO_KTLS */
+
+    return true;
+  }
+
+  switch (m_ssl ? SSL_get_error(m_ssl, result) : SSL_ERROR_SSL) {
+  case SSL_ERROR_WANT_READ:
+    m_readable = false;
+    break;
+  case SSL_ERROR_WANT_WRITE:
+    m_writable = false;
+    break;
+  default:
+    __NETFLEX_LOG(debug, __NETFLEX_CLIENT_LOG_PREFIX(m_host, m_port) + "TLS handshake failure");
+    ERR_clear_error();
+    m_error = true;
+  }
+#endif /* __NETFLEX_TLS_ENABLED */
+
+  return false;
+}
+
+ssize_t
+epoll_connection::to_io_result(int result) {
+#ifdef __NETFLEX_TLS_ENABLED
+  if (result > 0)
+    return result;
+
+  switch (SSL_get_error(m_ssl, result)) {
+  //! the socket would block, in either direction: retried on the next event
+  case SSL_ERROR_WANT_READ:
+  case SSL_ERROR_WANT_WRITE:
+    errno = EAGAIN;
+    return -1;
+  //! close_notify alert, end of file, I/O or protocol error: the connection is closed in any case
+  default:
+    ERR_clear_error();
+    errno = ECONNRESET;
+    return -1;
+  }
+#else
+  return result;
+#endif /* __NETFLEX_TLS_ENABLED */
+}
+
+
+//!
+//! disconnection
+//!
+void
+epoll_connection::close(bool notify) {
+  //! the loop and the owner of the connection may drop their reference while it is being closed
+  std::shared_ptr<epoll_connection> self = shared_from_this();
+
+  read_callback_t read_callback = nullptr;
+  std::deque<pending_write> writes;
+  disconnection_handler_t disconnection_handler = nullptr;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_connected)
+      return;
+
+    m_connected = false;
+
+#ifdef __NETFLEX_TLS_ENABLED
+    //! close_notify alert on explicit disconnections, best effort
+    //! sessions are removed from the cache of connections freed without shutdown: they stay resumable when the peer closes, fatal TLS errors invalidating them already
+    if (m_tls_established) {
+      if (notify)
+        SSL_set_shutdown(m_ssl, SSL_SENT_SHUTDOWN | SSL_RECEIVED_SHUTDOWN);
+      else
+        SSL_shutdown(m_ssl);
+    }
+#endif /* __NETFLEX_TLS_ENABLED */
+
+    //! the kernel may still be sending the body being written
+    if (!m_writes.empty() && m_writes.front().zerocopy_sent)
+      m_zerocopy_bodies.emplace_back(m_zerocopy_next_seq - 1, m_writes.front().body);
+
+    if (!m_zerocopy_bodies.empty())
+      read_zerocopy_notifications();
+
+    //! data queued by zero copy sends is still read from the bodies after close: the socket is kept, output shut down, until their completion is notified (see check_linger)
+    if (m_zerocopy_bodies.empty()) {
+      release_socket(false);
+    }
+    else {
+      ::shutdown(m_fd, SHUT_WR);
+
+      m_lingering       = true;
+      m_linger_deadline = std::chrono::steady_clock::now() + zerocopy_linger;
+      m_loop.linger(m_id);
+    }
+
+    //! callbacks are cleared in any case, as they may hold a reference to the connection
+    if (notify) {
+      if (m_read_pending)
+        read_callback = std::move(m_read_callback);
+
+      writes.swap(m_writes);
+      disconnection_handler = std::move(m_disconnection_handler);
+    }
+
+    m_read_pending          = false;
+    m_read_callback         = nullptr;
+    m_disconnection_handler = nullptr;
+    m_writes.clear();
+    m_completed_writes.clear();
+  }
+
+  if (read_callback) {
+    read_result result = {false, nullptr, 0};
+    read_callback(result);
+  }
+
+  for (auto& write : writes) {
+    if (write.callback) {
+      write_result result = {false, write.offset};
+      write.callback(result);
+    }
+  }
+
+  if (disconnection_handler)
+    disconnection_handler();
+}
+
+bool
+epoll_connection::check_linger(bool force) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (!m_lingering)
+    return true;
+
+  read_zerocopy_notifications();
+
+  //! past the deadline, the peer is not reading anymore: the unsent data is discarded (reset), so that the kernel stops reading the bodies
+  if (m_zerocopy_bodies.empty())
+    release_socket(false);
+  else if (force || std::chrono::steady_clock::now() >= m_linger_deadline)
+    release_socket(true);
+
+  return !m_lingering;
+}
+
+void
+epoll_connection::release_socket(bool reset) {
+  if (reset) {
+    struct linger linger = {1, 0};
+    ::setsockopt(m_fd, SOL_SOCKET, SO_LINGER, &linger, sizeof(linger));
+  }
+
+  m_loop.remove(m_id, m_fd);
+  ::close(m_fd);
+
+  m_fd        = -1;
+  m_lingering = false;
+  m_zerocopy_bodies.clear();
+}
+
+} // namespace transport
+
+} // namespace netflex
+
+#endif /* __linux__ */
@@ -0,0 +1,147 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifdef __linux__
+
+#include <algorithm>
+#include <thread>
+
+#include <unistd.h>
+
+#include <netflex/misc/error.hpp>
+#include <netflex/transport/epoll_listener.hpp>
+#include <netflex/transport/utils.hpp>
+
+namespace netflex {
+
+namespace transport {
+
+//!
+//! ctor & dtor
+//!
+epoll_listener::epoll_listener(std::size_t nb_threads)
+: m_nb_threads(nb_threads ? nb_threads : std::max(1U, std::thread::hardware_concurrency()))
+, m_fd(-1)
+, m_port(0)
+, m_running(false) {}
+
+epoll_listener::~epoll_listener(void) {
+  stop();
+}
+
+
+//!
+//! start & stop
+//!
+void
+epoll_listener::start(const std::string& host, std::uint32_t port, const connection_handler_t& handler) {
+  if (m_running)
+    __NETFLEX_THROW(error, "epoll_listener is already running");
+
+  m_fd   = utils::create_listen_socket(host, port);
+  m_port = utils::get_bound_port(m_fd);
+
+  try {
+    for (std::size_t i = 0; i < m_nb_threads; ++i) {
+      m_loops.emplace_back(new epoll_loop(m_fd, handler, m_tls_context));
+      m_loops.back()->start();
+    }
+  }
+  catch (const std::exception&) {
+    m_loops.clear();
+    ::close(m_fd);
+    m_fd = -1;
+
+    throw;
+  }
+
+  m_running = true;
+}
+
+void
+epoll_listener::stop(void) {
+  if (!m_running.exchange(false))
+    return;
+
+  //! loops are stopped before closing the socket they accept on
+  for (const auto& loop : m_loops)
+    loop->stop();
+
+  m_loops.clear();
+  ::close(m_fd);
+  m_fd = -1;
+}
+
+bool
+epoll_listener::is_running(void) const {
+  return m_running;
+}
+
+
+//!
+//! getters
+//!
+std::uint32_t
+epoll_listener::get_port(void) const {
+  return m_port;
+}
+
+std::size_t
+epoll_listener::get_nb_threads(void) const {
+  return m_nb_threads;
+}
+
+std::size_t
+epoll_listener::get_nb_connections(void) const {
+  std::size_t nb_connections = 0;
+
+  for (const auto& loop : m_loops)
+    nb_connections += loop->get_nb_connections();
+
+  return nb_connections;
+}
+
+
+#ifdef __NETFLEX_TLS_ENABLED
+//!
+//! TLS
+//!
+void
+epoll_listener::set_tls_context(const std::shared_ptr<tls_context>& context) {
+  if (m_running)
+    __NETFLEX_THROW(error, "epoll_listener TLS context must be set before starting the listener");
+
+  m_tls_context = context;
+}
+
+const std::shared_ptr<tls_context>&
+epoll_listener::get_tls_context(void) const {
+  return m_tls_context;
+}
+#endif /* __NETFLEX_TLS_ENABLED */
+
+} // namespace transport
+
+} // namespace netflex
+
+#endif /* __linux__ */
@@ -0,0 +1,353 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifdef __linux__
+
+#include <cerrno>
+#include <cstring>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <netflex/misc/error.hpp>
+#include <netflex/misc/logger.hpp>
+#include <netflex/transport/epoll_connection.hpp>
+#include <netflex/transport/epoll_loop.hpp>
+#include <netflex/transport/utils.hpp>
+
+#ifndef EPOLLEXCLUSIVE
+#define EPOLLEXCLUSIVE (1u << 28)
+#endif /* EPOLLEXCLUSIVE */
+
+namespace netflex {
+
+namespace transport {
+
+//!
+//! event data of the sockets that are not connections, connections ids starting after them
+//!
+static const std::uint64_t wakeup_id   = 0;
+static const std::uint64_t listener_id = 1;
+
+//!
+//! maximum number of events handled per wait
+//!
+static const int max_events = 256;
+
+//!
+//! interval of the lingering connections checks, in milliseconds
+//!
+static const int linger_check_interval = 100;
+
+
+//!
+//! ctor & dtor
+//!
+epoll_loop::epoll_loop(int listen_fd, const listener::connection_handler_t& handler, const std::shared_ptr<tls_context>& tls)
+: m_epoll_fd(::epoll_create1(EPOLL_CLOEXEC))
+, m_wakeup_fd(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+, m_listen_fd(listen_fd)
+, m_handler(handler)
+, m_tls_context(tls)
+, m_running(false)
+, m_next_id(listener_id + 1) {
+  struct epoll_event wakeup_event;
+  wakeup_event.events   = EPOLLIN;
+  wakeup_event.data.u64 = wakeup_id;
+
+  //! accept is level-triggered: connections left by a loop are accepted on its next wait
+  struct epoll_event listen_event;
+  listen_event.events   = EPOLLIN | EPOLLEXCLUSIVE;
+  listen_event.data.u64 = listener_id;
+
+  if (m_epoll_fd < 0 || m_wakeup_fd < 0
+      || ::epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, m_wakeup_fd, &wakeup_event) < 0
+      || ::epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, m_listen_fd, &listen_event) < 0) {
+    std::string reason = std::strerror(errno);
+
+    if (m_epoll_fd >= 0)
+      ::close(m_epoll_fd);
+    if (m_wakeup_fd >= 0)
+      ::close(m_wakeup_fd);
+
+    __NETFLEX_THROW(error, "epoll_loop creation failure: " + reason);
+  }
+}
+
+epoll_loop::~epoll_loop(void) {
+  stop();
+
+  ::close(m_epoll_fd);
+  ::close(m_wakeup_fd);
+}
+
+
+//!
+//! start & stop
+//!
+void
+epoll_loop::start(void) {
+  m_running = true;
+
+  //! read by the loop thread (see wakeup) once it locked the mutex
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_thread = std::thread(&epoll_loop::run, this);
+}
+
+void
+epoll_loop::stop(void) {
+  if (!m_running.exchange(false))
+    return;
+
+  wakeup();
+
+  if (m_thread.joinable())
+    m_thread.join();
+
+  std::unordered_map<std::uint64_t, std::shared_ptr<epoll_connection>> connections;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    connections.swap(m_connections);
+    m_scheduled.clear();
+  }
+
+  //! nothing is monitored anymore: zero copy sends still in flight are reset
+  for (const auto& connection : connections) {
+    connection.second->disconnect();
+    connection.second->check_linger(true);
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_lingering.clear();
+}
+
+std::size_t
+epoll_loop::get_nb_connections(void) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  return m_connections.size();
+}
+
+
+//!
+//! connections management
+//!
+void
+epoll_loop::schedule(const std::shared_ptr<epoll_connection>& connection) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_scheduled.push_back(connection);
+  }
+
+  wakeup();
+}
+
+void
+epoll_loop::remove(std::uint64_t id, int fd) {
+  ::epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_connections.erase(id);
+}
+
+void
+epoll_loop::linger(std::uint64_t id) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_lingering.push_back(id);
+  }
+
+  //! checked periodically from now on
+  wakeup();
+}
+
+void
+epoll_loop::wakeup(void) {
+  //! the loop thread checks the scheduled connections before waiting
+  if (std::this_thread::get_id() == m_thread.get_id())
+    return;
+
+  std::uint64_t value = 1;
+  if (::write(m_wakeup_fd, &value, sizeof(value)) < 0) {
+    //! counter already non-zero: loop already woken up
+  }
+}
+
+
+//!
+//! loop thread
+//!
+void
+epoll_loop::run(void) {
+  struct epoll_event events[max_events];
+
+  while (m_running) {
+    bool has_scheduled;
+    bool has_lingering;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      has_scheduled = !m_scheduled.empty();
+      has_lingering = !m_lingering.empty();
+    }
+
+    int nb_events = ::epoll_wait(m_epoll_fd, events, max_events, has_scheduled ? 0 : has_lingering ? linger_check_interval : -1);
+
+    if (nb_events < 0) {
+      if (errno == EINTR)
+        continue;
+
+      __NETFLEX_LOG(error, std::string("epoll_wait failure: ") + std::strerror(errno));
+      break;
+    }
+
+    for (int i = 0; i < nb_events; ++i) {
+      std::uint64_t id = events[i].data.u64;
+
+      if (id == wakeup_id) {
+        std::uint64_t value;
+        if (::read(m_wakeup_fd, &value, sizeof(value)) < 0) {
+          //! spurious wakeup
+        }
+      }
+      else if (id == listener_id) {
+        accept_connections();
+      }
+      else {
+        std::shared_ptr<epoll_connection> connection;
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          auto it = m_connections.find(id);
+
+          //! closed by a previous event of the batch
+          if (it == m_connections.end())
+            continue;
+
+          connection = it->second;
+        }
+
+        connection->on_events(events[i].events);
+      }
+    }
+
+    process_scheduled();
+
+    if (has_lingering)
+      check_lingering();
+  }
+}
+
+void
+epoll_loop::accept_connections(void) {
+  for (;;) {
+    struct sockaddr_storage address;
+    socklen_t address_size = sizeof(address);
+
+    int fd = ::accept4(m_listen_fd, reinterpret_cast<struct sockaddr*>(&address), &address_size, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+    if (fd < 0) {
+      if (errno == EINTR || errno == ECONNABORTED)
+        continue;
+
+      //! EAGAIN: no more pending connection, or accepted by another loop
+      if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        __NETFLEX_LOG(warn, std::string("accept failure: ") + std::strerror(errno));
+      }
+
+      return;
+    }
+
+    utils::setup_accepted_socket(fd);
+
+    std::string host;
+    std::uint32_t port = 0;
+    utils::get_address(address, host, port);
+
+    std::uint64_t id = m_next_id++;
+    auto connection  = std::make_shared<epoll_connection>(fd, id, *this, host, port, m_tls_context);
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_connections[id] = connection;
+    }
+
+    //! registered once for both directions: readiness changes are notified, no re-arming needed
+    struct epoll_event event;
+    event.events   = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    event.data.u64 = id;
+
+    if (::epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0) {
+      __NETFLEX_LOG(warn, __NETFLEX_CLIENT_LOG_PREFIX(host, port) + "epoll registration failure: " + std::strerror(errno));
+      connection->disconnect();
+      continue;
+    }
+
+    m_handler(connection);
+  }
+}
+
+void
+epoll_loop::process_scheduled(void) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_processing.swap(m_scheduled);
+  }
+
+  for (const auto& connection : m_processing)
+    connection->process();
+
+  m_processing.clear();
+}
+
+void
+epoll_loop::check_lingering(void) {
+  std::vector<std::pair<std::uint64_t, std::shared_ptr<epoll_connection>>> lingering;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    //! connections missing from m_connections already closed their socket
+    for (std::uint64_t id : m_lingering) {
+      auto it = m_connections.find(id);
+      if (it != m_connections.end())
+        lingering.emplace_back(id, it->second);
+    }
+
+    m_lingering.clear();
+  }
+
+  std::vector<std::uint64_t> still_lingering;
+  for (const auto& connection : lingering) {
+    if (!connection.second->check_linger(false))
+      still_lingering.push_back(connection.first);
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_lingering.insert(m_lingering.end(), still_lingering.begin(), still_lingering.end());
+}
+
+} // namespace transport
+
+} // namespace netflex
+
+#endif /* __linux__ */
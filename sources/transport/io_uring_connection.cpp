@@ -0,0 +1,408 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifdef __linux__
+
+#include <algorithm>
+#include <cerrno>
+
+#include <linux/io_uring.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <netflex/misc/buffer_pool.hpp>
+#include <netflex/transport/io_uring_connection.hpp>
+#include <netflex/transport/io_uring_loop.hpp>
+
+namespace netflex {
+
+namespace transport {
+
+//!
+//! ctor & dtor
+//!
+io_uring_connection::io_uring_connection(int fd, std::uint64_t id, io_uring_loop& loop, const std::string& host, std::uint32_t port)
+: m_fd(fd)
+, m_id(id)
+, m_loop(loop)
+, m_host(host)
+, m_port(port)
+, m_connected(true)
+, m_scheduled(false)
+, m_delivering(false)
+, m_read_pending(false)
+, m_read_size(0)
+, m_read_callback(nullptr)
+, m_recv_armed(false)
+, m_waiting_buffer(false)
+, m_end_of_file(false)
+, m_nb_sent(0)
+, m_nb_in_flight(0)
+, m_disconnection_handler(nullptr) {}
+
+io_uring_connection::~io_uring_connection(void) {
+  if (m_fd >= 0)
+    ::close(m_fd);
+}
+
+
+//!
+//! peer
+//!
+const std::string&
+io_uring_connection::get_host(void) const {
+  return m_host;
+}
+
+std::uint32_t
+io_uring_connection::get_port(void) const {
+  return m_port;
+}
+
+bool
+io_uring_connection::is_connected(void) const {
+  return m_connected;
+}
+
+
+//!
+//! async operations
+//!
+void
+io_uring_connection::async_read(std::size_t size, const read_callback_t& callback) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (!m_connected)
+    return;
+
+  m_read_pending  = true;
+  m_read_size     = size;
+  m_read_callback = callback;
+
+  //! bytes already received, or receive to be armed: done by the loop (or by the delivery in progress)
+  if (!m_delivering && (!m_received.empty() || !m_recv_armed))
+    schedule();
+}
+
+void
+io_uring_connection::async_write(std::vector<char>&& buffer, const write_callback_t& callback) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (!m_connected) {
+    misc::buffer_pool::release(std::move(buffer));
+    return;
+  }
+
+  m_writes.push_back({std::move(buffer), callback});
+
+  //! sent by the loop along with the other writes requested meanwhile, or once the sends in progress complete
+  if (!m_nb_sent)
+    schedule();
+}
+
+void
+io_uring_connection::set_disconnection_handler(const disconnection_handler_t& handler) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  m_disconnection_handler = handler;
+}
+
+void
+io_uring_connection::disconnect(void) {
+  close(false);
+}
+
+
+//!
+//! completions
+//!
+void
+io_uring_connection::on_recv(std::int32_t result, std::uint32_t flags) {
+  bool has_buffer      = flags & IORING_CQE_F_BUFFER;
+  std::uint16_t buffer = static_cast<std::uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT);
+  bool has_error       = false;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!(flags & IORING_CQE_F_MORE)) {
+      m_recv_armed = false;
+      --m_nb_in_flight;
+    }
+
+    if (result > 0 && has_buffer && m_connected) {
+      m_received.push_back({buffer, 0, static_cast<std::uint32_t>(result)});
+      has_buffer = false;
+    }
+    else if (result == 0) {
+      m_end_of_file = true;
+    }
+    //! provided buffers exhausted: receive armed again once a buffer is recycled
+    else if (result == -ENOBUFS) {
+      m_waiting_buffer = m_loop.wait_for_buffer(m_id);
+    }
+    else if (result < 0) {
+      has_error = m_connected;
+    }
+  }
+
+  if (has_buffer)
+    m_loop.recycle_buffer(buffer);
+
+  if (has_error)
+    close(true);
+
+  process();
+}
+
+void
+io_uring_connection::on_send(std::int32_t result) {
+  pending_write write;
+  write_result write_res = {false, 0};
+  bool has_error         = false;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    --m_nb_in_flight;
+
+    //! sends complete in the order of the writes
+    write = std::move(m_writes.front());
+    m_writes.pop_front();
+    --m_nb_sent;
+
+    if (result >= 0 && static_cast<std::size_t>(result) == write.buffer.size())
+      write_res = {true, write.buffer.size()};
+    else
+      has_error = m_connected;
+  }
+
+  if (write_res.success && write.callback)
+    write.callback(write_res);
+
+  misc::buffer_pool::release(std::move(write.buffer));
+
+  if (has_error)
+    close(true);
+
+  process();
+}
+
+bool
+io_uring_connection::on_buffer_available(void) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (!m_connected || !m_waiting_buffer)
+    return false;
+
+  m_waiting_buffer = false;
+  schedule();
+
+  return true;
+}
+
+
+//!
+//! processing
+//!
+void
+io_uring_connection::process(void) {
+  std::deque<received_chunk> unread;
+  bool connected;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_scheduled = false;
+    connected   = m_connected;
+
+    if (!connected) {
+      unread.swap(m_received);
+
+      //! socket closed once the kernel is done with it, so that its descriptor is not reused by a new connection meanwhile
+      if (!m_nb_in_flight && m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+        m_loop.remove(m_id);
+      }
+    }
+    //! writes requested since the previous chain completed, sent in order as a chain of linked sends
+    else if (!m_nb_sent && !m_writes.empty()) {
+      for (const auto& write : m_writes) {
+        ++m_nb_sent;
+        m_loop.prepare_send(m_id, m_fd, write.buffer.data(), write.buffer.size(), m_nb_sent < m_writes.size());
+      }
+
+      m_nb_in_flight += m_nb_sent;
+    }
+  }
+
+  //! recycled outside of the lock, as recycling may resume a connection waiting for a buffer
+  if (!connected) {
+    for (const auto& chunk : unread)
+      m_loop.recycle_buffer(chunk.buffer_id);
+
+    return;
+  }
+
+  deliver();
+
+  bool end_of_file = false;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_connected)
+      return;
+
+    //! armed once the received bytes are read, so that connections that are not read do not hold the buffers shared by the loop
+    if (m_read_pending && m_received.empty() && !m_recv_armed && !m_waiting_buffer && !m_end_of_file) {
+      m_loop.prepare_recv(m_id, m_fd);
+      m_recv_armed = true;
+      ++m_nb_in_flight;
+    }
+
+    end_of_file = m_read_pending && m_received.empty() && m_end_of_file;
+  }
+
+  //! bytes received before the end of file have been read: pending read fails, as on the other backends
+  if (end_of_file)
+    close(true);
+}
+
+void
+io_uring_connection::deliver(void) {
+  for (;;) {
+    read_callback_t callback = nullptr;
+    read_result result       = {true, nullptr, 0};
+    bool is_chunk_read       = false;
+    std::uint16_t buffer     = 0;
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      if (!m_connected || !m_read_pending || m_received.empty()) {
+        m_delivering = false;
+        return;
+      }
+
+      m_delivering = true;
+
+      //! read straight from the provided buffer
+      received_chunk& chunk = m_received.front();
+      result.data           = m_loop.get_buffer(chunk.buffer_id) + chunk.offset;
+      result.size           = std::min<std::size_t>(chunk.size - chunk.offset, m_read_size);
+      chunk.offset += static_cast<std::uint32_t>(result.size);
+
+      if (chunk.offset == chunk.size) {
+        is_chunk_read = true;
+        buffer        = chunk.buffer_id;
+        m_received.pop_front();
+      }
+
+      m_read_pending  = false;
+      callback        = std::move(m_read_callback);
+      m_read_callback = nullptr;
+    }
+
+    callback(result);
+
+    //! bytes consumed by the callback: buffer given back to the kernel
+    if (is_chunk_read)
+      m_loop.recycle_buffer(buffer);
+  }
+}
+
+void
+io_uring_connection::schedule(void) {
+  if (m_scheduled)
+    return;
+
+  m_scheduled = true;
+  m_loop.schedule(shared_from_this());
+}
+
+
+//!
+//! disconnection
+//!
+void
+io_uring_connection::close(bool notify) {
+  //! the owner of the connection may drop its reference while it is being closed
+  std::shared_ptr<io_uring_connection> self = shared_from_this();
+
+  read_callback_t read_callback = nullptr;
+  std::vector<write_callback_t> write_callbacks;
+  disconnection_handler_t disconnection_handler = nullptr;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_connected)
+      return;
+
+    m_connected = false;
+
+    //! pending receive and sends complete with an error, the socket being closed and the connection released once they did (see process)
+    ::shutdown(m_fd, SHUT_RDWR);
+
+    if (notify) {
+      if (m_read_pending)
+        read_callback = std::move(m_read_callback);
+
+      for (auto& write : m_writes) {
+        if (write.callback)
+          write_callbacks.push_back(std::move(write.callback));
+      }
+
+      disconnection_handler = std::move(m_disconnection_handler);
+    }
+
+    //! callbacks are cleared in any case, as they may hold a reference to the connection
+    m_read_pending          = false;
+    m_read_callback         = nullptr;
+    m_disconnection_handler = nullptr;
+
+    //! submitted writes keep their buffer until they complete
+    for (auto& write : m_writes)
+      write.callback = nullptr;
+    m_writes.erase(m_writes.begin() + m_nb_sent, m_writes.end());
+
+    schedule();
+  }
+
+  if (read_callback) {
+    read_result result = {false, nullptr, 0};
+    read_callback(result);
+  }
+
+  for (const auto& write_callback : write_callbacks) {
+    write_result result = {false, 0};
+    write_callback(result);
+  }
+
+  if (disconnection_handler)
+    disconnection_handler();
+}
+
+} // namespace transport
+
+} // namespace netflex
+
+#endif /* __linux__ */
@@ -0,0 +1,165 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifdef __linux__
+
+#include <algorithm>
+#include <thread>
+
+#include <unistd.h>
+
+#include <netflex/misc/error.hpp>
+#include <netflex/misc/logger.hpp>
+#include <netflex/transport/io_uring_listener.hpp>
+#include <netflex/transport/utils.hpp>
+
+namespace netflex {
+
+namespace transport {
+
+//!
+//! ctor & dtor
+//!
+io_uring_listener::io_uring_listener(std::size_t nb_threads, std::uint32_t nb_buffers, std::uint32_t buffer_size)
+: m_nb_threads(nb_threads ? nb_threads : std::max(1U, std::thread::hardware_concurrency()))
+, m_nb_buffers(nb_buffers)
+, m_buffer_size(buffer_size)
+, m_fd(-1)
+, m_port(0)
+, m_running(false) {}
+
+io_uring_listener::~io_uring_listener(void) {
+  stop();
+}
+
+
+//!
+//! start & stop
+//!
+void
+io_uring_listener::start(const std::string& host, std::uint32_t port, const connection_handler_t& handler) {
+  if (m_running)
+    __NETFLEX_THROW(error, "io_uring_listener is already running");
+
+  if (!start_rings(host, port, handler)) {
+    __NETFLEX_LOG(warn, "io_uring not available, falling back to epoll");
+
+    m_fallback = std::unique_ptr<epoll_listener>(new epoll_listener(m_nb_threads));
+    m_fallback->start(host, port, handler);
+    m_port = m_fallback->get_port();
+  }
+
+  m_running = true;
+}
+
+bool
+io_uring_listener::start_rings(const std::string& host, std::uint32_t port, const connection_handler_t& handler) {
+  if (!io_uring_loop::is_supported())
+    return false;
+
+  //! socket errors are not related to io_uring: no fallback
+  m_fd   = utils::create_listen_socket(host, port);
+  m_port = utils::get_bound_port(m_fd);
+
+  try {
+    for (std::size_t i = 0; i < m_nb_threads; ++i) {
+      m_loops.emplace_back(new io_uring_loop(m_fd, handler, m_nb_buffers, m_buffer_size));
+      m_loops.back()->start();
+    }
+  }
+  //! rings may be denied (seccomp, locked memory limit, ...) even though the kernel supports them
+  catch (const netflex_error& e) {
+    __NETFLEX_LOG(warn, std::string("io_uring ring creation failure: ") + e.what());
+
+    m_loops.clear();
+    ::close(m_fd);
+    m_fd = -1;
+
+    return false;
+  }
+
+  return true;
+}
+
+void
+io_uring_listener::stop(void) {
+  if (!m_running.exchange(false))
+    return;
+
+  if (m_fallback) {
+    m_fallback->stop();
+    m_fallback = nullptr;
+    return;
+  }
+
+  //! rings are stopped before closing the socket they accept on
+  for (const auto& loop : m_loops)
+    loop->stop();
+
+  m_loops.clear();
+  ::close(m_fd);
+  m_fd = -1;
+}
+
+bool
+io_uring_listener::is_running(void) const {
+  return m_running;
+}
+
+
+//!
+//! getters
+//!
+std::uint32_t
+io_uring_listener::get_port(void) const {
+  return m_port;
+}
+
+std::size_t
+io_uring_listener::get_nb_threads(void) const {
+  return m_nb_threads;
+}
+
+std::size_t
+io_uring_listener::get_nb_connections(void) const {
+  if (m_fallback)
+    return m_fallback->get_nb_connections();
+
+  std::size_t nb_connections = 0;
+
+  for (const auto& loop : m_loops)
+    nb_connections += loop->get_nb_connections();
+
+  return nb_connections;
+}
+
+bool
+io_uring_listener::is_using_io_uring(void) const {
+  return m_running && !m_fallback;
+}
+
+} // namespace transport
+
+} // namespace netflex
+
+#endif /* __linux__ */
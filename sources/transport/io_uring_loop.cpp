@@ -0,0 +1,676 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifdef __linux__
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <netflex/misc/error.hpp>
+#include <netflex/misc/logger.hpp>
+#include <netflex/transport/io_uring_connection.hpp>
+#include <netflex/transport/io_uring_loop.hpp>
+#include <netflex/transport/utils.hpp>
+
+namespace netflex {
+
+namespace transport {
+
+//!
+//! number of submission queue entries
+//! the completion queue is larger, as multishot requests complete many times per submission
+//!
+static const unsigned int nb_sq_entries = 1024;
+static const unsigned int nb_cq_entries = 4 * nb_sq_entries;
+
+//!
+//! group of the provided buffers
+//!
+static const std::uint16_t buffer_group = 0;
+
+//!
+//! operation of a request, stored in the upper byte of its user data, the lower bytes holding the id of its connection
+//!
+enum class operation : std::uint64_t {
+  wakeup,
+  accept,
+  recv,
+  send,
+  cancel,
+  provide
+};
+
+static const unsigned int operation_shift = 56;
+static const std::uint64_t id_mask        = (static_cast<std::uint64_t>(1) << operation_shift) - 1;
+
+static std::uint64_t
+make_user_data(operation op, std::uint64_t id) {
+  return (static_cast<std::uint64_t>(op) << operation_shift) | id;
+}
+
+
+//!
+//! io_uring system calls, not wrapped by the libc
+//!
+static int
+io_uring_setup(unsigned int entries, struct io_uring_params* params) {
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int
+io_uring_enter(int fd, unsigned int to_submit, unsigned int min_complete, unsigned int flags) {
+  return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+static int
+io_uring_register(int fd, unsigned int opcode, void* arg, unsigned int nb_args) {
+  return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, nb_args));
+}
+
+
+//!
+//! queues indexes, shared with the kernel
+//!
+static std::uint32_t
+load_acquire(const std::uint32_t* index) {
+  return __atomic_load_n(index, __ATOMIC_ACQUIRE);
+}
+
+static void
+store_release(std::uint32_t* index, std::uint32_t value) {
+  __atomic_store_n(index, value, __ATOMIC_RELEASE);
+}
+
+
+//!
+//! ctor & dtor
+//!
+io_uring_loop::io_uring_loop(int listen_fd, const listener::connection_handler_t& handler, std::uint32_t nb_buffers, std::uint32_t buffer_size)
+: m_ring_fd(-1)
+, m_ring_disabled(false)
+, m_rings(nullptr)
+, m_rings_size(0)
+, m_sqes(nullptr)
+, m_sqes_size(0)
+, m_sq_head(nullptr)
+, m_sq_shared_tail(nullptr)
+, m_sq_mask(0)
+, m_sq_entries(0)
+, m_sq_tail(0)
+, m_cq_head(nullptr)
+, m_cq_tail(nullptr)
+, m_cq_mask(0)
+, m_cqes(nullptr)
+, m_buffers(nullptr)
+, m_nb_buffers(nb_buffers)
+, m_buffer_size(buffer_size)
+, m_nb_provided_buffers(0)
+, m_wakeup_fd(-1)
+, m_wakeup_value(0)
+, m_listen_fd(listen_fd)
+, m_handler(handler)
+, m_running(false)
+, m_nb_in_flight(0)
+, m_next_id(1) {
+  try {
+    setup();
+  }
+  catch (const netflex_error&) {
+    teardown();
+    throw;
+  }
+}
+
+io_uring_loop::~io_uring_loop(void) {
+  stop();
+  teardown();
+}
+
+
+//!
+//! ring setup
+//!
+bool
+io_uring_loop::is_supported(void) {
+  static const bool supported = [] {
+    struct io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+
+    //! ENOSYS, or io_uring disabled by sysctl or seccomp
+    int fd = io_uring_setup(4, &params);
+    if (fd < 0)
+      return false;
+
+    //! flags of multishot requests cannot be probed: probe an operation introduced by the same kernel release (linux 6.0)
+    std::vector<char> probe_buffer(sizeof(struct io_uring_probe) + 256 * sizeof(struct io_uring_probe_op), 0);
+    struct io_uring_probe* probe = reinterpret_cast<struct io_uring_probe*>(probe_buffer.data());
+
+    bool result = (params.features & IORING_FEAT_SINGLE_MMAP) && (params.features & IORING_FEAT_NODROP)
+                  && io_uring_register(fd, IORING_REGISTER_PROBE, probe, 256) == 0
+                  && probe->last_op >= IORING_OP_SEND_ZC
+                  && (probe->ops[IORING_OP_SEND_ZC].flags & IO_URING_OP_SUPPORTED);
+
+    ::close(fd);
+
+    return result;
+  }();
+
+  return supported;
+}
+
+void
+io_uring_loop::setup(void) {
+  if (m_nb_buffers == 0 || m_nb_buffers > 32768)
+    __NETFLEX_THROW(error, "io_uring_loop: number of buffers must be between 1 and 32768");
+
+  m_wakeup_fd = ::eventfd(0, EFD_CLOEXEC);
+  if (m_wakeup_fd < 0)
+    __NETFLEX_THROW(error, std::string("eventfd failure: ") + std::strerror(errno));
+
+  //! single issuer ring, enabled by the loop thread: completion work is run when the loop waits, instead of interrupting it
+  struct io_uring_params params;
+  std::memset(&params, 0, sizeof(params));
+  params.flags      = IORING_SETUP_CQSIZE | IORING_SETUP_SUBMIT_ALL | IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN | IORING_SETUP_R_DISABLED;
+  params.cq_entries = nb_cq_entries;
+
+  m_ring_fd       = io_uring_setup(nb_sq_entries, &params);
+  m_ring_disabled = true;
+
+  //! linux 6.0
+  if (m_ring_fd < 0 && errno == EINVAL) {
+    std::memset(&params, 0, sizeof(params));
+    params.flags      = IORING_SETUP_CQSIZE | IORING_SETUP_SUBMIT_ALL | IORING_SETUP_COOP_TASKRUN;
+    params.cq_entries = nb_cq_entries;
+
+    m_ring_fd       = io_uring_setup(nb_sq_entries, &params);
+    m_ring_disabled = false;
+  }
+
+  if (m_ring_fd < 0)
+    __NETFLEX_THROW(error, std::string("io_uring_setup failure: ") + std::strerror(errno));
+
+  //! queues, mapped at once (IORING_FEAT_SINGLE_MMAP, checked by is_supported)
+  std::size_t sq_size = params.sq_off.array + params.sq_entries * sizeof(std::uint32_t);
+  std::size_t cq_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  m_rings_size        = std::max(sq_size, cq_size);
+
+  void* rings = ::mmap(nullptr, m_rings_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring_fd, IORING_OFF_SQ_RING);
+  if (rings == MAP_FAILED)
+    __NETFLEX_THROW(error, std::string("io_uring queues mmap failure: ") + std::strerror(errno));
+  m_rings = rings;
+
+  m_sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+  void* sqes  = ::mmap(nullptr, m_sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring_fd, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED)
+    __NETFLEX_THROW(error, std::string("io_uring entries mmap failure: ") + std::strerror(errno));
+  m_sqes = static_cast<struct io_uring_sqe*>(sqes);
+
+  char* base       = static_cast<char*>(m_rings);
+  m_sq_head        = reinterpret_cast<std::uint32_t*>(base + params.sq_off.head);
+  m_sq_shared_tail = reinterpret_cast<std::uint32_t*>(base + params.sq_off.tail);
+  m_sq_mask        = *reinterpret_cast<std::uint32_t*>(base + params.sq_off.ring_mask);
+  m_sq_entries     = *reinterpret_cast<std::uint32_t*>(base + params.sq_off.ring_entries);
+  m_sq_tail        = *m_sq_shared_tail;
+  m_cq_head        = reinterpret_cast<std::uint32_t*>(base + params.cq_off.head);
+  m_cq_tail        = reinterpret_cast<std::uint32_t*>(base + params.cq_off.tail);
+  m_cq_mask        = *reinterpret_cast<std::uint32_t*>(base + params.cq_off.ring_mask);
+  m_cqes           = reinterpret_cast<struct io_uring_cqe*>(base + params.cq_off.cqes);
+
+  //! entries are used in the order of the queue
+  std::uint32_t* sq_array = reinterpret_cast<std::uint32_t*>(base + params.sq_off.array);
+  for (std::uint32_t i = 0; i < m_sq_entries; ++i)
+    sq_array[i] = i;
+
+  //! provided buffers: the kernel picks one for each receive completion (provided by the loop thread, see run)
+  void* buffers = ::mmap(nullptr, static_cast<std::size_t>(m_nb_buffers) * m_buffer_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (buffers == MAP_FAILED)
+    __NETFLEX_THROW(error, std::string("io_uring buffers mmap failure: ") + std::strerror(errno));
+  m_buffers = static_cast<char*>(buffers);
+}
+
+void
+io_uring_loop::teardown(void) {
+  //! closing the ring releases the provided buffers it holds
+  if (m_ring_fd >= 0)
+    ::close(m_ring_fd);
+  if (m_sqes)
+    ::munmap(m_sqes, m_sqes_size);
+  if (m_rings)
+    ::munmap(m_rings, m_rings_size);
+  if (m_buffers)
+    ::munmap(m_buffers, static_cast<std::size_t>(m_nb_buffers) * m_buffer_size);
+  if (m_wakeup_fd >= 0)
+    ::close(m_wakeup_fd);
+
+  m_ring_fd   = -1;
+  m_sqes      = nullptr;
+  m_rings     = nullptr;
+  m_buffers   = nullptr;
+  m_wakeup_fd = -1;
+}
+
+
+//!
+//! start & stop
+//!
+void
+io_uring_loop::start(void) {
+  m_running = true;
+
+  //! read by the loop thread (see wakeup) once it locked the mutex
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_thread = std::thread(&io_uring_loop::run, this);
+}
+
+void
+io_uring_loop::stop(void) {
+  if (!m_running.exchange(false))
+    return;
+
+  wakeup();
+
+  if (m_thread.joinable())
+    m_thread.join();
+
+  //! connections have been closed and released by the loop thread before exiting
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_connections.clear();
+  m_scheduled.clear();
+}
+
+std::size_t
+io_uring_loop::get_nb_connections(void) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  return m_connections.size();
+}
+
+
+//!
+//! connections management
+//!
+void
+io_uring_loop::schedule(const std::shared_ptr<io_uring_connection>& connection) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_scheduled.push_back(connection);
+  }
+
+  wakeup();
+}
+
+void
+io_uring_loop::remove(std::uint64_t id) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_connections.erase(id);
+}
+
+void
+io_uring_loop::wakeup(void) {
+  //! the loop thread processes the scheduled connections before waiting
+  if (std::this_thread::get_id() == m_thread.get_id())
+    return;
+
+  std::uint64_t value = 1;
+  if (::write(m_wakeup_fd, &value, sizeof(value)) < 0) {
+    //! counter already non-zero: loop already woken up
+  }
+}
+
+
+//!
+//! provided buffers
+//!
+const char*
+io_uring_loop::get_buffer(std::uint16_t buffer_id) const {
+  return m_buffers + static_cast<std::size_t>(buffer_id) * m_buffer_size;
+}
+
+void
+io_uring_loop::recycle_buffer(std::uint16_t buffer_id) {
+  provide_buffers(buffer_id, 1);
+
+  while (!m_waiting_buffer.empty()) {
+    std::uint64_t id = m_waiting_buffer.front();
+    m_waiting_buffer.pop_front();
+
+    std::shared_ptr<io_uring_connection> connection;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto it = m_connections.find(id);
+
+      if (it != m_connections.end())
+        connection = it->second;
+    }
+
+    //! closed connections are skipped
+    if (connection && connection->on_buffer_available())
+      return;
+  }
+}
+
+bool
+io_uring_loop::wait_for_buffer(std::uint64_t id) {
+  //! provisions are submitted before the receive armed again
+  if (m_nb_provided_buffers)
+    return false;
+
+  m_waiting_buffer.push_back(id);
+
+  return true;
+}
+
+void
+io_uring_loop::provide_buffers(std::uint16_t first_id, std::uint32_t nb_buffers) {
+  struct io_uring_sqe* sqe = get_sqe();
+  sqe->opcode              = IORING_OP_PROVIDE_BUFFERS;
+  sqe->fd                  = static_cast<std::int32_t>(nb_buffers);
+  sqe->addr                = reinterpret_cast<std::uint64_t>(get_buffer(first_id));
+  sqe->len                 = m_buffer_size;
+  sqe->off                 = first_id;
+  sqe->buf_group           = buffer_group;
+  sqe->user_data           = make_user_data(operation::provide, nb_buffers);
+
+  ++m_nb_in_flight;
+  m_nb_provided_buffers += nb_buffers;
+}
+
+//!
+//! requests
+//!
+struct io_uring_sqe*
+io_uring_loop::get_sqe(void) {
+  if (m_sq_tail - load_acquire(m_sq_head) >= m_sq_entries)
+    submit(0);
+
+  struct io_uring_sqe* sqe = &m_sqes[m_sq_tail & m_sq_mask];
+  ++m_sq_tail;
+
+  std::memset(sqe, 0, sizeof(*sqe));
+
+  return sqe;
+}
+
+void
+io_uring_loop::prepare_accept(void) {
+  struct io_uring_sqe* sqe = get_sqe();
+  sqe->opcode              = IORING_OP_ACCEPT;
+  sqe->fd                  = m_listen_fd;
+  sqe->ioprio              = IORING_ACCEPT_MULTISHOT;
+  sqe->accept_flags        = SOCK_CLOEXEC;
+  sqe->user_data           = make_user_data(operation::accept, 0);
+
+  ++m_nb_in_flight;
+}
+
+void
+io_uring_loop::prepare_wakeup(void) {
+  struct io_uring_sqe* sqe = get_sqe();
+  sqe->opcode              = IORING_OP_READ;
+  sqe->fd                  = m_wakeup_fd;
+  sqe->off                 = static_cast<std::uint64_t>(-1);
+  sqe->addr                = reinterpret_cast<std::uint64_t>(&m_wakeup_value);
+  sqe->len                 = sizeof(m_wakeup_value);
+  sqe->user_data           = make_user_data(operation::wakeup, 0);
+
+  ++m_nb_in_flight;
+}
+
+void
+io_uring_loop::prepare_recv(std::uint64_t id, int fd) {
+  struct io_uring_sqe* sqe = get_sqe();
+  sqe->opcode              = IORING_OP_RECV;
+  sqe->fd                  = fd;
+  sqe->ioprio              = IORING_RECV_MULTISHOT;
+  sqe->flags               = IOSQE_BUFFER_SELECT;
+  sqe->buf_group           = buffer_group;
+  sqe->user_data           = make_user_data(operation::recv, id);
+
+  ++m_nb_in_flight;
+}
+
+void
+io_uring_loop::prepare_send(std::uint64_t id, int fd, const char* data, std::size_t size, bool linked) {
+  struct io_uring_sqe* sqe = get_sqe();
+  sqe->opcode              = IORING_OP_SEND;
+  sqe->fd                  = fd;
+  sqe->addr                = reinterpret_cast<std::uint64_t>(data);
+  sqe->len                 = static_cast<std::uint32_t>(size);
+  //! short sends are retried by the kernel: a send completes with its size, or fails and cancels the sends linked to it
+  sqe->msg_flags = MSG_NOSIGNAL | MSG_WAITALL;
+  sqe->flags     = linked ? IOSQE_IO_LINK : 0;
+  sqe->user_data = make_user_data(operation::send, id);
+
+  ++m_nb_in_flight;
+}
+
+void
+io_uring_loop::submit(unsigned int nb_completions) {
+  store_release(m_sq_shared_tail, m_sq_tail);
+
+  unsigned int nb_prepared = m_sq_tail - load_acquire(m_sq_head);
+
+  //! EINTR, EBUSY (completions to be handled first): done by the next iteration
+  if (io_uring_enter(m_ring_fd, nb_prepared, nb_completions, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR && errno != EBUSY && errno != EAGAIN) {
+    __NETFLEX_LOG(error, std::string("io_uring_enter failure: ") + std::strerror(errno));
+  }
+}
+
+
+//!
+//! loop thread
+//!
+void
+io_uring_loop::run(void) {
+  //! the ring is bound to the thread enabling it
+  if (m_ring_disabled && io_uring_register(m_ring_fd, IORING_REGISTER_ENABLE_RINGS, nullptr, 0) < 0) {
+    __NETFLEX_LOG(error, std::string("io_uring ring activation failure: ") + std::strerror(errno));
+    return;
+  }
+
+  //! buffers are only provided by the loop thread
+  provide_buffers(0, m_nb_buffers);
+
+  prepare_wakeup();
+  prepare_accept();
+
+  while (m_running) {
+    process_scheduled();
+
+    bool has_scheduled;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      has_scheduled = !m_scheduled.empty();
+    }
+
+    submit(has_scheduled ? 0 : 1);
+    process_completions();
+  }
+
+  drain();
+}
+
+void
+io_uring_loop::drain(void) {
+  std::vector<std::shared_ptr<io_uring_connection>> connections;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (const auto& connection : m_connections)
+      connections.push_back(connection.second);
+  }
+
+  //! sockets shut down: their receives and sends complete
+  for (const auto& connection : connections)
+    connection->disconnect();
+
+  //! accept and wakeup requests
+  struct io_uring_sqe* sqe = get_sqe();
+  sqe->opcode              = IORING_OP_ASYNC_CANCEL;
+  sqe->fd                  = -1;
+  sqe->cancel_flags        = IORING_ASYNC_CANCEL_ALL | IORING_ASYNC_CANCEL_ANY;
+  sqe->user_data           = make_user_data(operation::cancel, 0);
+  ++m_nb_in_flight;
+
+  //! buffers and connections can only be released once the kernel is done with them
+  while (m_nb_in_flight) {
+    process_scheduled();
+    submit(1);
+    process_completions();
+  }
+
+  process_scheduled();
+}
+
+void
+io_uring_loop::process_completions(void) {
+  for (;;) {
+    std::uint32_t head = *m_cq_head;
+    if (head == load_acquire(m_cq_tail))
+      return;
+
+    const struct io_uring_cqe& cqe = m_cqes[head & m_cq_mask];
+    std::uint64_t user_data        = cqe.user_data;
+    std::int32_t result            = cqe.res;
+    std::uint32_t flags            = cqe.flags;
+
+    //! entry released before handling it, as handlers may wait for new completions
+    store_release(m_cq_head, head + 1);
+
+    //! the last completion of multishot requests does not have IORING_CQE_F_MORE
+    if (!(flags & IORING_CQE_F_MORE))
+      --m_nb_in_flight;
+
+    operation op     = static_cast<operation>(user_data >> operation_shift);
+    std::uint64_t id = user_data & id_mask;
+
+    if (flags & IORING_CQE_F_BUFFER)
+      --m_nb_provided_buffers;
+
+    if (op == operation::wakeup) {
+      if (m_running)
+        prepare_wakeup();
+    }
+    else if (op == operation::provide) {
+      //! user data holding the number of buffers instead of a connection id
+      if (result < 0) {
+        __NETFLEX_LOG(error, std::string("io_uring buffers provision failure: ") + std::strerror(-result));
+        m_nb_provided_buffers -= static_cast<std::uint32_t>(id);
+      }
+    }
+    else if (op == operation::accept) {
+      on_accept(result);
+
+      if (!(flags & IORING_CQE_F_MORE) && m_running)
+        prepare_accept();
+    }
+    else if (op == operation::recv || op == operation::send) {
+      std::shared_ptr<io_uring_connection> connection;
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_connections.find(id);
+
+        if (it != m_connections.end())
+          connection = it->second;
+      }
+
+      if (!connection) {
+        //! connections are kept until their requests complete
+        if (flags & IORING_CQE_F_BUFFER)
+          recycle_buffer(static_cast<std::uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT));
+      }
+      else if (op == operation::recv) {
+        connection->on_recv(result, flags);
+      }
+      else {
+        connection->on_send(result);
+      }
+    }
+  }
+}
+
+void
+io_uring_loop::on_accept(std::int32_t result) {
+  if (result < 0) {
+    if (result != -ECANCELED) {
+      __NETFLEX_LOG(warn, std::string("accept failure: ") + std::strerror(-result));
+    }
+
+    return;
+  }
+
+  int fd = result;
+
+  if (!m_running) {
+    ::close(fd);
+    return;
+  }
+
+  utils::setup_accepted_socket(fd);
+
+  std::string host;
+  std::uint32_t port = 0;
+  struct sockaddr_storage address;
+  socklen_t address_size = sizeof(address);
+
+  if (::getpeername(fd, reinterpret_cast<struct sockaddr*>(&address), &address_size) == 0)
+    utils::get_address(address, host, port);
+
+  std::uint64_t id = m_next_id++;
+  auto connection  = std::make_shared<io_uring_connection>(fd, id, *this, host, port);
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_connections[id] = connection;
+  }
+
+  m_handler(connection);
+}
+
+void
+io_uring_loop::process_scheduled(void) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_processing.swap(m_scheduled);
+  }
+
+  for (const auto& connection : m_processing)
+    connection->process();
+
+  m_processing.clear();
+}
+
+} // namespace transport
+
+} // namespace netflex
+
+#endif /* __linux__ */
@@ -0,0 +1,100 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <netflex/misc/buffer_pool.hpp>
+#include <netflex/transport/tacopie_connection.hpp>
+
+namespace netflex {
+
+namespace transport {
+
+//!
+//! ctor
+//!
+tacopie_connection::tacopie_connection(const std::shared_ptr<tacopie::tcp_client>& client)
+: m_client(client)
+, m_read_callback(nullptr)
+, m_tacopie_read_callback([this](tacopie::tcp_client::read_result& result) {
+  read_result res = {result.success, result.buffer.data(), result.buffer.size()};
+  m_read_callback(res);
+}) {}
+
+
+//!
+//! peer
+//!
+const std::string&
+tacopie_connection::get_host(void) const {
+  return m_client->get_host();
+}
+
+std::uint32_t
+tacopie_connection::get_port(void) const {
+  return m_client->get_port();
+}
+
+bool
+tacopie_connection::is_connected(void) const {
+  return m_client->is_connected();
+}
+
+
+//!
+//! I/O
+//!
+void
+tacopie_connection::async_read(std::size_t size, const read_callback_t& callback) {
+  m_read_callback = callback;
+  m_client->async_read({size, m_tacopie_read_callback});
+}
+
+void
+tacopie_connection::async_write(std::vector<char>&& buffer, const write_callback_t& callback) {
+  tacopie::tcp_client::write_request request = {std::move(buffer), nullptr};
+
+  if (callback) {
+    request.async_write_callback = [callback](tacopie::tcp_client::write_result& result) {
+      write_result res = {result.success, result.size};
+      callback(res);
+    };
+  }
+
+  m_client->async_write(request);
+
+  //! the tcp_client keeps its own copy of the request: recycle the buffer
+  misc::buffer_pool::release(std::move(request.buffer));
+}
+
+void
+tacopie_connection::set_disconnection_handler(const disconnection_handler_t& handler) {
+  m_client->set_on_disconnection_handler(handler);
+}
+
+void
+tacopie_connection::disconnect(void) {
+  m_client->disconnect();
+}
+
+} // namespace transport
+
+} // namespace netflex
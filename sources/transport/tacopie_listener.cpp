@@ -0,0 +1,58 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <memory>
+
+#include <netflex/transport/tacopie_connection.hpp>
+#include <netflex/transport/tacopie_listener.hpp>
+
+namespace netflex {
+
+namespace transport {
+
+//!
+//! start & stop
+//!
+void
+tacopie_listener::start(const std::string& host, std::uint32_t port, const connection_handler_t& handler) {
+  m_server.start(host, port, [handler](const std::shared_ptr<tacopie::tcp_client>& client) {
+    handler(std::make_shared<tacopie_connection>(client));
+
+    //! mark connection as handled by ourselves
+    return true;
+  });
+}
+
+void
+tacopie_listener::stop(void) {
+  m_server.stop();
+}
+
+bool
+tacopie_listener::is_running(void) const {
+  return m_server.is_running();
+}
+
+} // namespace transport
+
+} // namespace netflex
@@ -0,0 +1,176 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifdef __NETFLEX_TLS_ENABLED
+
+#include <csignal>
+
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+
+#include <netflex/misc/error.hpp>
+#include <netflex/transport/tls_context.hpp>
+
+namespace netflex {
+
+namespace transport {
+
+//!
+//! identify the sessions issued by netflex, required to resume them
+//!
+static const unsigned char session_id_context[] = "netflex";
+
+//!
+//! a single ticket per handshake: clients open one connection at a time per session
+//!
+static const std::size_t nb_session_tickets = 1;
+
+//!
+//! description of the last OpenSSL error, error queue cleared
+//!
+static std::string
+get_openssl_error(void) {
+  char description[256];
+  ERR_error_string_n(ERR_get_error(), description, sizeof(description));
+  ERR_clear_error();
+
+  return description;
+}
+
+static int
+on_alpn_select(SSL*, const unsigned char** out, unsigned char* out_size, const unsigned char* offered, unsigned int offered_size, void* context) {
+  if (static_cast<const tls_context*>(context)->select_alpn_protocol(out, out_size, offered, offered_size))
+    return SSL_TLSEXT_ERR_OK;
+
+  //! no protocol in common: no_application_protocol alert
+  return SSL_TLSEXT_ERR_ALERT_FATAL;
+}
+
+
+//!
+//! ctor & dtor
+//!
+tls_context::tls_context(const std::string& certificate_file, const std::string& private_key_file)
+: m_ctx(SSL_CTX_new(TLS_server_method())) {
+  if (!m_ctx)
+    __NETFLEX_THROW(error, "tls_context creation failure: " + get_openssl_error());
+
+  if (SSL_CTX_use_certificate_chain_file(m_ctx, certificate_file.c_str()) != 1
+      || SSL_CTX_use_PrivateKey_file(m_ctx, private_key_file.c_str(), SSL_FILETYPE_PEM) != 1
+      || SSL_CTX_check_private_key(m_ctx) != 1) {
+    std::string reason = get_openssl_error();
+    SSL_CTX_free(m_ctx);
+
+    __NETFLEX_THROW(error, "tls_context could not load " + certificate_file + " and " + private_key_file + ": " + reason);
+  }
+
+  SSL_CTX_set_min_proto_version(m_ctx, TLS1_2_VERSION);
+  SSL_CTX_set_options(m_ctx, SSL_OP_NO_RENEGOTIATION | SSL_OP_CIPHER_SERVER_PREFERENCE);
+
+  //! the kernel takes over the record layer once the handshake is done, when the kernel and the negotiated cipher support it
+#ifdef SSL_OP_ENABLE_KTLS
+  SSL_CTX_set_options(m_ctx, SSL_OP_ENABLE_KTLS);
+#endif /* SSL_OP_ENABLE_KTLS */
+
+  //! writes are retried with the buffer moved forward by the write queue, idle keep-alive connections do not keep their record buffers
+  SSL_CTX_set_mode(m_ctx, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER | SSL_MODE_RELEASE_BUFFERS);
+
+  //! resumption: server side session cache (session ids) and stateless tickets, both shared by all the connections of the context
+  SSL_CTX_set_session_cache_mode(m_ctx, SSL_SESS_CACHE_SERVER);
+  SSL_CTX_set_session_id_context(m_ctx, session_id_context, sizeof(session_id_context) - 1);
+  SSL_CTX_set_num_tickets(m_ctx, nb_session_tickets);
+
+  SSL_CTX_set_alpn_select_cb(m_ctx, on_alpn_select, this);
+  set_alpn_protocols({"http/1.1"});
+
+  //! OpenSSL writes the sockets without MSG_NOSIGNAL: a peer resetting its connection must not kill the process
+  std::signal(SIGPIPE, SIG_IGN);
+}
+
+tls_context::~tls_context(void) {
+  SSL_CTX_free(m_ctx);
+}
+
+
+//!
+//! application protocols
+//!
+void
+tls_context::set_alpn_protocols(const std::vector<std::string>& protocols) {
+  m_alpn_protocols = protocols;
+  m_alpn_wire.clear();
+
+  for (const auto& protocol : protocols) {
+    if (protocol.empty() || protocol.size() > 255)
+      __NETFLEX_THROW(error, "tls_context invalid ALPN protocol: " + protocol);
+
+    m_alpn_wire += static_cast<char>(protocol.size());
+    m_alpn_wire += protocol;
+  }
+}
+
+const std::vector<std::string>&
+tls_context::get_alpn_protocols(void) const {
+  return m_alpn_protocols;
+}
+
+bool
+tls_context::select_alpn_protocol(const unsigned char** out, unsigned char* out_size, const unsigned char* offered, unsigned int offered_size) const {
+  unsigned char* selected        = nullptr;
+  const unsigned char* protocols = reinterpret_cast<const unsigned char*>(m_alpn_wire.data());
+
+  //! server preference: first configured protocol offered by the client
+  if (SSL_select_next_proto(&selected, out_size, protocols, m_alpn_wire.size(), offered, offered_size) != OPENSSL_NPN_NEGOTIATED)
+    return false;
+
+  *out = selected;
+  return true;
+}
+
+
+//!
+//! session cache
+//!
+void
+tls_context::set_session_cache_size(std::size_t size) {
+  SSL_CTX_sess_set_cache_size(m_ctx, size);
+}
+
+std::size_t
+tls_context::get_session_cache_size(void) const {
+  return SSL_CTX_sess_get_cache_size(m_ctx);
+}
+
+
+//!
+//! native handle
+//!
+ssl_ctx_st*
+tls_context::get_native_handle(void) const {
+  return m_ctx;
+}
+
+} // namespace transport
+
+} // namespace netflex
+
+#endif /* __NETFLEX_TLS_ENABLED */
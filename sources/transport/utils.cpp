@@ -0,0 +1,136 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifdef __linux__
+
+#include <cerrno>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <netflex/misc/error.hpp>
+#include <netflex/misc/logger.hpp>
+#include <netflex/transport/utils.hpp>
+
+namespace netflex {
+
+namespace transport {
+
+namespace utils {
+
+int
+create_listen_socket(const std::string& host, std::uint32_t port) {
+  struct addrinfo hints;
+  std::memset(&hints, 0, sizeof(hints));
+  hints.ai_family   = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_flags    = AI_PASSIVE;
+
+  struct addrinfo* addresses = nullptr;
+  int result                 = ::getaddrinfo(host.empty() ? nullptr : host.c_str(), std::to_string(port).c_str(), &hints, &addresses);
+
+  if (result != 0)
+    __NETFLEX_THROW(error, "getaddrinfo failure for " + __NETFLEX_HOST_PORT_LOG(host, port) + ": " + ::gai_strerror(result));
+
+  int fd             = -1;
+  std::string reason = "no address";
+
+  for (struct addrinfo* address = addresses; address; address = address->ai_next) {
+    fd = ::socket(address->ai_family, address->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, address->ai_protocol);
+
+    if (fd < 0) {
+      reason = std::strerror(errno);
+      continue;
+    }
+
+    int reuse = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    if (::bind(fd, address->ai_addr, address->ai_addrlen) == 0 && ::listen(fd, SOMAXCONN) == 0)
+      break;
+
+    reason = std::strerror(errno);
+    ::close(fd);
+    fd = -1;
+  }
+
+  ::freeaddrinfo(addresses);
+
+  if (fd < 0)
+    __NETFLEX_THROW(error, "could not listen on " + __NETFLEX_HOST_PORT_LOG(host, port) + ": " + reason);
+
+  return fd;
+}
+
+std::uint32_t
+get_bound_port(int fd) {
+  struct sockaddr_storage address;
+  socklen_t address_size = sizeof(address);
+
+  if (::getsockname(fd, reinterpret_cast<struct sockaddr*>(&address), &address_size) < 0)
+    return 0;
+
+  std::string host;
+  std::uint32_t port = 0;
+  get_address(address, host, port);
+
+  return port;
+}
+
+void
+get_address(const struct sockaddr_storage& address, std::string& host, std::uint32_t& port) {
+  char buffer[INET6_ADDRSTRLEN] = {0};
+
+  if (address.ss_family == AF_INET6) {
+    const struct sockaddr_in6* address6 = reinterpret_cast<const struct sockaddr_in6*>(&address);
+    ::inet_ntop(AF_INET6, &address6->sin6_addr, buffer, sizeof(buffer));
+    port = ntohs(address6->sin6_port);
+  }
+  else {
+    const struct sockaddr_in* address4 = reinterpret_cast<const struct sockaddr_in*>(&address);
+    ::inet_ntop(AF_INET, &address4->sin_addr, buffer, sizeof(buffer));
+    port = ntohs(address4->sin_port);
+  }
+
+  host = buffer;
+}
+
+void
+setup_accepted_socket(int fd) {
+  //! responses are written in one go, do not delay them
+  int nodelay = 1;
+  ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+}
+
+} // namespace utils
+
+} // namespace transport
+
+} // namespace netflex
+
+#endif /* __linux__ */
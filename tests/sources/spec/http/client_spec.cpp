@@ -19,3 +19,149 @@
 // LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <netflex/netflex>
+
+//!
+//! connection recording the operations of the client
+//!
+class fake_connection : public netflex::transport::connection {
+public:
+  const std::string& get_host(void) const override { return host; }
+  std::uint32_t get_port(void) const override { return 0; }
+  bool is_connected(void) const override { return connected; }
+
+  void async_read(std::size_t, const read_callback_t&) override { ++nb_reads; }
+  void async_write(std::vector<char>&& buffer, const write_callback_t& callback) override {
+    writes.emplace_back(buffer.begin(), buffer.end());
+    write_callbacks.push_back(callback);
+  }
+  void async_write_zerocopy(std::vector<char>&& head, const std::shared_ptr<const std::string>& body, const write_callback_t& callback) override {
+    zerocopy_bodies.push_back(body);
+    async_write(std::move(head), callback);
+  }
+  void set_disconnection_handler(const disconnection_handler_t&) override {}
+  void disconnect(void) override { connected = false; }
+
+  std::string host;
+  bool connected       = true;
+  std::size_t nb_reads = 0;
+  std::vector<std::string> writes;
+  std::vector<write_callback_t> write_callbacks;
+  std::vector<std::shared_ptr<const std::string>> zerocopy_bodies;
+};
+
+static void
+receive(netflex::http::client& client, const std::string& data) {
+  netflex::transport::read_result result = {true, data.data(), data.size()};
+  client.on_async_read_result(result);
+}
+
+TEST(client, adaptive_read_size) {
+  netflex::http::client client(std::make_shared<fake_connection>());
+  std::size_t initial_size = client.get_read_size();
+  std::size_t remaining    = 1000000;
+
+  auto receive_body = [&](std::size_t size) {
+    receive(client, std::string(size, 'x'));
+    remaining -= size;
+  };
+
+  //! large body: reads filling the requested size make the next ones larger
+  receive(client, "POST / HTTP/1.1\r\nContent-Length: 1000000\r\n\r\n");
+  EXPECT_EQ(client.get_read_size(), initial_size);
+  receive_body(initial_size);
+  EXPECT_EQ(client.get_read_size(), 2 * initial_size);
+  receive_body(client.get_read_size());
+  EXPECT_EQ(client.get_read_size(), 4 * initial_size);
+
+  //! partial reads in the middle of the request keep the size
+  receive_body(1);
+  EXPECT_EQ(client.get_read_size(), 4 * initial_size);
+
+  //! bounded
+  for (int i = 0; i < 10; ++i)
+    receive_body(client.get_read_size());
+  EXPECT_EQ(client.get_read_size(), 64UL * 1024);
+
+  //! back to the initial size once the request is complete
+  while (remaining)
+    receive_body(std::min(remaining, client.get_read_size() - 1));
+  EXPECT_EQ(client.get_read_size(), initial_size);
+}
+
+TEST(client, send_response) {
+  auto connection = std::make_shared<fake_connection>();
+  netflex::http::client client(connection);
+  bool sent = false;
+  client.set_response_sent_handler([&](const netflex::misc::request_timing&) { sent = true; });
+
+  netflex::http::response response;
+  response.set_body("hello");
+  client.send_response(response);
+
+  ASSERT_EQ(connection->writes.size(), 1UL);
+  EXPECT_EQ(connection->writes[0], response.to_http_packet());
+
+  //! response sent handler called on write completion
+  EXPECT_FALSE(sent);
+  netflex::transport::write_result result = {true, connection->writes[0].size()};
+  connection->write_callbacks[0](result);
+  EXPECT_TRUE(sent);
+}
+
+TEST(client, zerocopy_threshold) {
+  auto connection = std::make_shared<fake_connection>();
+  netflex::http::client client(connection);
+  EXPECT_EQ(client.get_zerocopy_threshold(), 0UL);
+
+  netflex::http::response response;
+  response.set_body(std::make_shared<const std::string>(std::string(100, 'x')));
+
+  //! disabled by default
+  client.send_response(response);
+  EXPECT_TRUE(connection->zerocopy_bodies.empty());
+
+  //! shared body below the threshold: copied
+  client.set_zerocopy_threshold(101);
+  client.send_response(response);
+  EXPECT_TRUE(connection->zerocopy_bodies.empty());
+
+  //! shared body reaching the threshold: only the head is serialized
+  client.set_zerocopy_threshold(100);
+  client.send_response(response);
+  ASSERT_EQ(connection->zerocopy_bodies.size(), 1UL);
+  EXPECT_EQ(connection->zerocopy_bodies[0], response.get_shared_body());
+  ASSERT_EQ(connection->writes.size(), 3UL);
+  EXPECT_EQ(connection->writes[2] + *connection->zerocopy_bodies[0], response.to_http_packet());
+  EXPECT_EQ(connection->writes[1], response.to_http_packet());
+
+  //! owned bodies are always copied
+  response.set_body(std::string(100, 'x'));
+  client.send_response(response);
+  EXPECT_EQ(connection->zerocopy_bodies.size(), 1UL);
+}
+
+TEST(client, send_error) {
+  auto connection = std::make_shared<fake_connection>();
+  netflex::http::client client(connection);
+  bool disconnected = false;
+  client.set_disconnection_handler([&] { disconnected = true; });
+
+  client.send_error(431);
+
+  ASSERT_EQ(connection->writes.size(), 1UL);
+  EXPECT_EQ(connection->writes[0].find("HTTP/1.1 431 "), 0UL);
+
+  //! connection closed once the error is written, and disconnection notified
+  netflex::transport::write_result result = {true, connection->writes[0].size()};
+  connection->write_callbacks[0](result);
+  EXPECT_FALSE(connection->connected);
+  EXPECT_TRUE(disconnected);
+}
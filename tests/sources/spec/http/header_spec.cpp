@@ -19,3 +19,30 @@
 // LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <netflex/netflex>
+
+TEST(header, find_header) {
+  netflex::http::header_list_t headers = {{"Content-Type", "text/html"}, {"x-custom", "value"}};
+
+  ASSERT_NE(netflex::http::find_header(headers, "Content-Type"), nullptr);
+  EXPECT_EQ(*netflex::http::find_header(headers, "Content-Type"), "text/html");
+  EXPECT_EQ(*netflex::http::find_header(headers, "content-type"), "text/html");
+  EXPECT_EQ(*netflex::http::find_header(headers, "X-Custom"), "value");
+  EXPECT_EQ(netflex::http::find_header(headers, "Content-Length"), nullptr);
+  EXPECT_EQ(netflex::http::find_header(headers, "x-custo"), nullptr);
+}
+
+TEST(header, has_header_token) {
+  netflex::http::header_list_t headers = {{"cache-control", "public, Max-Age=60,private=\"Set-Cookie\" , no-store"}};
+
+  EXPECT_TRUE(netflex::http::has_header_token(headers, "Cache-Control", "public"));
+  EXPECT_TRUE(netflex::http::has_header_token(headers, "Cache-Control", "max-age"));
+  EXPECT_TRUE(netflex::http::has_header_token(headers, "Cache-Control", "private"));
+  EXPECT_TRUE(netflex::http::has_header_token(headers, "Cache-Control", "no-store"));
+  EXPECT_FALSE(netflex::http::has_header_token(headers, "Cache-Control", "no-cache"));
+  EXPECT_FALSE(netflex::http::has_header_token(headers, "Cache-Control", "pub"));
+  EXPECT_FALSE(netflex::http::has_header_token(headers, "Pragma", "no-cache"));
+}
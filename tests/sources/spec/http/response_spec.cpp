@@ -19,3 +19,74 @@
 // LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <netflex/netflex>
+
+TEST(response, to_http_packet) {
+  netflex::http::response response;
+  response.add_header({"Content-Length", "2"});
+  response.set_body("ok");
+
+  EXPECT_EQ(response.to_http_packet(), "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok");
+
+  response.set_status_code(299);
+  response.set_reason_phrase("Custom");
+  EXPECT_EQ(response.to_http_packet(), "HTTP/1.1 299 Custom\r\nContent-Length: 2\r\n\r\nok");
+}
+
+TEST(response, shared_body) {
+  auto body = std::make_shared<const std::string>("shared");
+
+  netflex::http::response first;
+  netflex::http::response second;
+  first.set_body(body);
+  second.set_body(body);
+
+  //! body is not copied into the responses
+  EXPECT_EQ(&first.get_body(), body.get());
+  EXPECT_EQ(&second.get_body(), body.get());
+  EXPECT_EQ(first.get_shared_body(), body);
+  EXPECT_EQ(first.to_http_packet(), "HTTP/1.1 200 OK\r\n\r\nshared");
+
+  //! owned body replaces the shared one
+  first.set_body("owned");
+  EXPECT_EQ(first.get_body(), "owned");
+  EXPECT_EQ(first.get_shared_body(), nullptr);
+  EXPECT_EQ(body.use_count(), 2);
+}
+
+TEST(response, share_body) {
+  netflex::http::response response;
+  response.set_body("owned");
+  std::string packet = response.to_http_packet();
+
+  //! owned body moved into a shared one
+  std::shared_ptr<const std::string> body = response.share_body();
+  ASSERT_NE(body, nullptr);
+  EXPECT_EQ(*body, "owned");
+  EXPECT_EQ(response.get_shared_body(), body);
+  EXPECT_EQ(&response.get_body(), body.get());
+  EXPECT_EQ(response.to_http_packet(), packet);
+
+  //! already shared: kept as is
+  EXPECT_EQ(response.share_body(), body);
+}
+
+TEST(response, serialize) {
+  netflex::http::response response;
+  response.set_body(std::make_shared<const std::string>("body"));
+
+  std::vector<char> buffer = {'x'};
+  response.serialize(buffer);
+  EXPECT_EQ(std::string(buffer.begin(), buffer.end()), response.to_http_packet());
+
+  response.set_raw_packet(std::make_shared<const std::string>("raw"));
+  response.serialize(buffer);
+  EXPECT_EQ(std::string(buffer.begin(), buffer.end()), "raw");
+}
@@ -0,0 +1,58 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <netflex/netflex>
+
+static std::string
+serialize(const netflex::http::static_response& response, bool with_body) {
+  std::vector<char> buffer;
+  response.serialize(buffer, "Sun, 06 Nov 1994 08:49:37 GMT", with_body);
+
+  return std::string(buffer.begin(), buffer.end());
+}
+
+TEST(static_response, serialize) {
+  netflex::http::response response;
+  response.set_body("ok");
+
+  netflex::http::static_response static_response(response);
+
+  EXPECT_EQ(static_response.get_status_code(), 200U);
+  EXPECT_EQ(serialize(static_response, true), "HTTP/1.1 200 OK\r\nDate: Sun, 06 Nov 1994 08:49:37 GMT\r\nContent-Length: 2\r\n\r\nok");
+  EXPECT_EQ(serialize(static_response, false), "HTTP/1.1 200 OK\r\nDate: Sun, 06 Nov 1994 08:49:37 GMT\r\nContent-Length: 2\r\n\r\n");
+}
+
+TEST(static_response, keeps_headers_but_date) {
+  netflex::http::response response;
+  response.set_status_code(404);
+  response.set_reason_phrase("Nothing Here");
+  response.add_header({"content-length", "0"});
+  response.add_header({"date", "yesterday"});
+
+  EXPECT_EQ(serialize(netflex::http::static_response(response), true), "HTTP/1.1 404 Nothing Here\r\nDate: Sun, 06 Nov 1994 08:49:37 GMT\r\ncontent-length: 0\r\n\r\n");
+}
@@ -0,0 +1,56 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <netflex/netflex>
+
+TEST(status, reason_phrase) {
+  EXPECT_STREQ(netflex::http::status_to_reason_phrase(200), "OK");
+  EXPECT_STREQ(netflex::http::status_to_reason_phrase(431), "Request Header Fields Too Large");
+  EXPECT_STREQ(netflex::http::status_to_reason_phrase(599), "Unknown");
+}
+
+TEST(status, error_packet) {
+  const std::string& packet = netflex::http::status_to_error_packet(400);
+
+  EXPECT_EQ(packet, "HTTP/1.1 400 Bad Request\r\nContent-Type: text/plain\r\nContent-Length: 16\r\nConnection: close\r\n\r\n400 Bad Request\n");
+
+  //! packets are built once
+  EXPECT_EQ(&packet, &netflex::http::status_to_error_packet(400));
+}
+
+TEST(status, error_packet_fallback) {
+  EXPECT_EQ(netflex::http::status_to_error_packet(418), netflex::http::status_to_error_packet(400));
+  EXPECT_EQ(netflex::http::status_to_error_packet(599), netflex::http::status_to_error_packet(500));
+}
+
+TEST(status, status_line) {
+  const std::string* line = netflex::http::status_to_status_line(404);
+
+  ASSERT_NE(line, nullptr);
+  EXPECT_EQ(*line, "HTTP/1.1 404 Not Found\r\n");
+  EXPECT_EQ(line, netflex::http::status_to_status_line(404));
+
+  EXPECT_EQ(netflex::http::status_to_status_line(599), nullptr);
+  EXPECT_EQ(netflex::http::status_to_status_line(1000), nullptr);
+}
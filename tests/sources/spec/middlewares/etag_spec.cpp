@@ -0,0 +1,241 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <netflex/netflex>
+
+#include "middleware_runner.hpp"
+
+//!
+//! route returning the configured status and body, to be run behind an etag middleware
+//!
+class etag_test : public ::testing::Test {
+protected:
+  etag_test(void)
+  : m_body("hello world") {}
+
+  middleware_runner::route_t
+  route(void) {
+    return [this](netflex::http::request&, netflex::http::response& response, int) {
+      response.set_status_code(m_status);
+      response.set_body(m_body);
+      response.add_header({"Content-Length", m_body.size()});
+      response.add_header({"Cache-Control", "no-cache"});
+    };
+  }
+
+  std::string m_body;
+  unsigned int m_status = 200;
+};
+
+//!
+//! helpers
+//!
+TEST(etag, compute) {
+  std::string etag = netflex::middlewares::etag::compute("hello world");
+
+  EXPECT_EQ(etag.size(), 18UL);
+  EXPECT_EQ(etag.front(), '"');
+  EXPECT_EQ(etag.back(), '"');
+  EXPECT_EQ(etag, netflex::middlewares::etag::compute("hello world"));
+  EXPECT_NE(etag, netflex::middlewares::etag::compute("hello world!"));
+}
+
+TEST(etag, matches) {
+  EXPECT_TRUE(netflex::middlewares::etag::matches("\"abc\"", "\"abc\""));
+  EXPECT_TRUE(netflex::middlewares::etag::matches("\"xyz\", \"abc\"", "\"abc\""));
+  EXPECT_TRUE(netflex::middlewares::etag::matches("W/\"abc\"", "\"abc\""));
+  EXPECT_TRUE(netflex::middlewares::etag::matches("\"abc\"", "W/\"abc\""));
+  EXPECT_TRUE(netflex::middlewares::etag::matches("*", "\"abc\""));
+  EXPECT_FALSE(netflex::middlewares::etag::matches("\"abd\"", "\"abc\""));
+  EXPECT_FALSE(netflex::middlewares::etag::matches("", "\"abc\""));
+  EXPECT_FALSE(netflex::middlewares::etag::matches("abc", "\"abc\""));
+}
+
+TEST(etag, set_not_modified) {
+  netflex::http::response response;
+  response.set_body("body");
+  response.set_headers({{"content-length", "4"}, {"Content-Type", "text/html"}, {"Cache-Control", "no-cache"}});
+
+  netflex::middlewares::etag::set_not_modified(response, "\"abc\"");
+
+  EXPECT_EQ(response.get_status_code(), 304U);
+  EXPECT_EQ(response.get_reason_phase(), "Not Modified");
+  EXPECT_EQ(response.get_body(), "");
+  EXPECT_EQ(response.get_headers(), netflex::http::header_list_t({{"Cache-Control", "no-cache"}, {"ETag", "\"abc\""}}));
+}
+
+//!
+//! middleware
+//!
+TEST_F(etag_test, adds_etag) {
+  netflex::middlewares::etag etag;
+  middleware_runner runner({etag.get_middleware()}, route());
+
+  netflex::http::response response = runner.run("/poll");
+
+  EXPECT_EQ(response.get_status_code(), 200U);
+  EXPECT_EQ(response.get_body(), m_body);
+  EXPECT_EQ(response.get_headers().at("ETag"), netflex::middlewares::etag::compute(m_body));
+}
+
+TEST_F(etag_test, not_modified) {
+  netflex::middlewares::etag etag;
+  middleware_runner runner({etag.get_middleware()}, route());
+
+  std::string value                = runner.run("/poll").get_headers().at("ETag");
+  netflex::http::response response = runner.run("/poll", {{"If-None-Match", value}});
+
+  EXPECT_EQ(response.get_status_code(), 304U);
+  EXPECT_EQ(response.get_body(), "");
+  EXPECT_EQ(response.get_headers().count("Content-Length"), 0UL);
+  EXPECT_EQ(response.get_headers().at("ETag"), value);
+  EXPECT_EQ(runner.get_nb_route_calls(), 2);
+  EXPECT_EQ(etag.get_nb_not_modified(), 1UL);
+  EXPECT_EQ(etag.get_nb_cache_hits(), 0UL);
+}
+
+TEST_F(etag_test, modified) {
+  netflex::middlewares::etag etag;
+  middleware_runner runner({etag.get_middleware()}, route());
+
+  std::string value = runner.run("/poll").get_headers().at("ETag");
+  m_body            = "changed";
+
+  netflex::http::response response = runner.run("/poll", {{"if-none-match", value}});
+
+  EXPECT_EQ(response.get_status_code(), 200U);
+  EXPECT_EQ(response.get_body(), "changed");
+  EXPECT_NE(response.get_headers().at("ETag"), value);
+}
+
+TEST_F(etag_test, keeps_existing_etag) {
+  netflex::middlewares::etag etag;
+  middleware_runner runner({etag.get_middleware()}, [](netflex::http::request&, netflex::http::response& response, int) {
+    response.add_header({"ETag", "\"v42\""});
+    response.set_body("body");
+  });
+
+  netflex::http::response response = runner.run("/poll", {{"If-None-Match", "\"v42\""}});
+
+  EXPECT_EQ(response.get_status_code(), 304U);
+  EXPECT_EQ(response.get_headers().at("ETag"), "\"v42\"");
+}
+
+TEST_F(etag_test, ignored_responses) {
+  netflex::middlewares::etag etag;
+  middleware_runner runner({etag.get_middleware()}, route());
+
+  EXPECT_EQ(runner.run("/poll", {}, netflex::http::method::POST).get_headers().count("ETag"), 0UL);
+
+  m_status = 404;
+  EXPECT_EQ(runner.run("/poll").get_headers().count("ETag"), 0UL);
+}
+
+TEST_F(etag_test, cached_etag) {
+  netflex::middlewares::etag etag(std::chrono::milliseconds(60000));
+  middleware_runner runner({etag.get_middleware()}, route());
+
+  std::string value = runner.run("/poll").get_headers().at("ETag");
+
+  //! route is skipped while the cached ETag is trusted
+  netflex::http::response response = runner.run("/poll", {{"If-None-Match", value}});
+  EXPECT_EQ(response.get_status_code(), 304U);
+  EXPECT_EQ(response.get_headers().at("ETag"), value);
+  EXPECT_EQ(runner.get_nb_route_calls(), 1);
+  EXPECT_EQ(etag.get_nb_cache_hits(), 1UL);
+
+  //! other validators still call the route
+  runner.run("/poll", {{"If-None-Match", "\"other\""}});
+  EXPECT_EQ(runner.get_nb_route_calls(), 2);
+}
+
+TEST_F(etag_test, cached_etag_expiration) {
+  netflex::middlewares::etag etag(std::chrono::milliseconds(10));
+  middleware_runner runner({etag.get_middleware()}, route());
+
+  std::string value = runner.run("/poll").get_headers().at("ETag");
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+  netflex::http::response response = runner.run("/poll", {{"If-None-Match", value}});
+  EXPECT_EQ(response.get_status_code(), 304U);
+  EXPECT_EQ(runner.get_nb_route_calls(), 2);
+  EXPECT_EQ(etag.get_nb_cache_hits(), 0UL);
+}
+
+//!
+//! chained middlewares
+//!
+TEST(etag, before_response_cache) {
+  netflex::middlewares::etag etag;
+  netflex::middlewares::response_cache cache;
+  middleware_runner runner({etag.get_middleware(), cache.get_middleware()}, [](netflex::http::request&, netflex::http::response& response, int) {
+    response.add_header({"Cache-Control", "max-age=60"});
+    response.set_body("articles");
+  });
+
+  std::string value = runner.run("/articles").get_headers().at("ETag");
+
+  //! cache hits are validated as well
+  netflex::http::response cached = runner.run("/articles");
+  EXPECT_EQ(cached.get_status_code(), 200U);
+  EXPECT_EQ(cached.get_headers().at("ETag"), value);
+
+  netflex::http::response not_modified = runner.run("/articles", {{"If-None-Match", value}});
+  EXPECT_EQ(not_modified.get_status_code(), 304U);
+  EXPECT_EQ(not_modified.get_body(), "");
+  EXPECT_EQ(not_modified.get_headers().count("Age"), 1UL);
+
+  EXPECT_EQ(runner.get_nb_route_calls(), 1);
+  EXPECT_EQ(cache.get_nb_hits(), 2UL);
+  EXPECT_EQ(etag.get_nb_not_modified(), 1UL);
+}
+
+TEST(etag, before_single_flight) {
+  netflex::middlewares::etag etag;
+  netflex::middlewares::response_cache cache;
+  netflex::middlewares::single_flight single_flight({}, std::chrono::milliseconds(2000));
+  middleware_runner runner({etag.get_middleware(), cache.get_middleware(), single_flight.get_middleware()}, [](netflex::http::request&, netflex::http::response& response, int) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    response.add_header({"Cache-Control", "max-age=60"});
+    response.set_body("articles");
+  });
+
+  std::string value = netflex::middlewares::etag::compute("articles");
+
+  //! one route call, each request being validated against its own If-None-Match
+  auto responses = middleware_runner::run_concurrently(4, [&](std::size_t i) {
+    return i % 2 ? runner.run("/articles", {{"If-None-Match", value}}) : runner.run("/articles");
+  });
+
+  EXPECT_EQ(runner.get_nb_route_calls(), 1);
+  EXPECT_EQ(single_flight.get_nb_coalesced(), 3UL);
+
+  for (std::size_t i = 0; i < responses.size(); ++i) {
+    EXPECT_EQ(responses[i].get_status_code(), i % 2 ? 304U : 200U);
+    EXPECT_EQ(responses[i].get_headers().at("ETag"), value);
+  }
+}
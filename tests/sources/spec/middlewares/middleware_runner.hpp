@@ -0,0 +1,99 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <list>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <netflex/netflex>
+
+//!
+//! pipeline made of the middlewares under test followed by a route counting its calls
+//! shared by the middlewares specs, to test them alone or chained
+//!
+class middleware_runner {
+public:
+  //! route called at the end of the pipeline, with its call number (starting at 1)
+  typedef std::function<void(netflex::http::request&, netflex::http::response&, int)> route_t;
+
+  middleware_runner(std::list<netflex::routing::middleware_t> middlewares, const route_t& route)
+  : m_nb_route_calls(0) {
+    middlewares.push_back([this, route](netflex::routing::middleware_chain&, netflex::http::request& request, netflex::http::response& response) {
+      route(request, response, ++m_nb_route_calls);
+    });
+
+    m_pipeline = netflex::routing::middleware_pipeline(middlewares);
+  }
+
+  middleware_runner(const middleware_runner&) = delete;
+  middleware_runner& operator=(const middleware_runner&) = delete;
+
+  netflex::http::response
+  run(const std::string& target, const netflex::http::header_list_t& headers = {}, netflex::http::method method = netflex::http::method::GET) const {
+    netflex::http::request request;
+    netflex::http::response response;
+
+    request.set_method(method);
+    request.set_raw_method(netflex::http::method_to_string(method));
+    request.set_target(target);
+    request.set_headers(headers);
+
+    netflex::routing::middleware_chain chain(m_pipeline, request, response);
+    chain.proceed();
+
+    return response;
+  }
+
+  //! run requests concurrently, the first one being started slightly ahead of the others (to lead a single flight)
+  static std::vector<netflex::http::response>
+  run_concurrently(std::size_t nb_requests, const std::function<netflex::http::response(std::size_t)>& request) {
+    std::vector<netflex::http::response> responses(nb_requests);
+    std::vector<std::thread> threads;
+
+    for (std::size_t i = 0; i < nb_requests; ++i) {
+      threads.emplace_back([&, i] { responses[i] = request(i); });
+
+      if (i == 0)
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    for (auto& thread : threads)
+      thread.join();
+
+    return responses;
+  }
+
+  int
+  get_nb_route_calls(void) const {
+    return m_nb_route_calls;
+  }
+
+private:
+  netflex::routing::middleware_pipeline m_pipeline;
+  std::atomic<int> m_nb_route_calls;
+};
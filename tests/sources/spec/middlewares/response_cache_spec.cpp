@@ -0,0 +1,229 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <netflex/netflex>
+
+#include "middleware_runner.hpp"
+
+//!
+//! run requests through the cache, followed by a route returning the configured headers
+//!
+class response_cache_test : public ::testing::Test {
+protected:
+  response_cache_test(void)
+  : m_cache(1024 * 1024, std::chrono::seconds(0), 4)
+  , m_runner({m_cache.get_middleware()}, [this](netflex::http::request& request, netflex::http::response& response, int call) {
+    response.set_headers(m_response_headers);
+    response.set_body("body of " + request.get_target() + " #" + std::to_string(call));
+  }) {}
+
+  netflex::middlewares::response_cache m_cache;
+  netflex::http::header_list_t m_response_headers;
+  middleware_runner m_runner;
+};
+
+TEST_F(response_cache_test, hit) {
+  m_response_headers = {{"Cache-Control", "public, max-age=60"}, {"Content-Type", "text/plain"}};
+
+  netflex::http::response first  = m_runner.run("/articles");
+  netflex::http::response second = m_runner.run("/articles");
+
+  EXPECT_EQ(m_runner.get_nb_route_calls(), 1);
+  EXPECT_EQ(second.get_status_code(), 200U);
+  EXPECT_EQ(second.get_body(), first.get_body());
+  EXPECT_EQ(second.get_headers().at("Content-Type"), "text/plain");
+  EXPECT_EQ(second.get_raw_packet(), nullptr);
+  EXPECT_EQ(m_cache.get_nb_hits(), 1UL);
+  EXPECT_EQ(m_cache.get_nb_misses(), 1UL);
+  EXPECT_EQ(m_cache.size(), 1UL);
+  EXPECT_GT(m_cache.get_memory_usage(), first.get_body().size());
+
+  //! the body is shared by the stored entry and the responses, never copied
+  ASSERT_NE(second.get_shared_body(), nullptr);
+  EXPECT_EQ(second.get_shared_body(), first.get_shared_body());
+}
+
+TEST_F(response_cache_test, date_and_age) {
+  m_response_headers = {{"Cache-Control", "max-age=60"}, {"Date", "Thu, 01 Jan 1970 00:00:00 GMT"}, {"Age", "42"}};
+
+  m_runner.run("/articles");
+  netflex::http::response fresh = m_runner.run("/articles");
+  std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+  netflex::http::response aged = m_runner.run("/articles");
+
+  EXPECT_EQ(m_runner.get_nb_route_calls(), 1);
+  EXPECT_EQ(fresh.get_headers().at("Age"), "0");
+  EXPECT_GE(std::stoi(aged.get_headers().at("Age")), 1);
+  EXPECT_NE(aged.get_headers().at("Date"), "Thu, 01 Jan 1970 00:00:00 GMT");
+  EXPECT_EQ(aged.get_headers().size(), 3UL);
+}
+
+TEST_F(response_cache_test, keyed_by_method_and_target) {
+  m_response_headers = {{"Cache-Control", "max-age=60"}};
+
+  m_runner.run("/articles");
+  m_runner.run("/articles?page=2");
+  m_runner.run("/articles", {}, netflex::http::method::HEAD);
+  m_runner.run("/articles?page=2");
+
+  EXPECT_EQ(m_runner.get_nb_route_calls(), 3);
+  EXPECT_EQ(m_cache.size(), 3UL);
+}
+
+TEST_F(response_cache_test, keyed_by_host) {
+  m_response_headers = {{"Cache-Control", "max-age=60"}};
+
+  netflex::http::response first  = m_runner.run("/", {{"Host", "a.example"}});
+  netflex::http::response second = m_runner.run("/", {{"Host", "b.example"}});
+  netflex::http::response cached = m_runner.run("/", {{"host", "A.example"}});
+
+  EXPECT_EQ(m_runner.get_nb_route_calls(), 2);
+  EXPECT_NE(second.get_body(), first.get_body());
+  EXPECT_EQ(cached.get_body(), first.get_body());
+
+  //! the port is kept
+  m_runner.run("/", {{"Host", "a.example:8080"}});
+  EXPECT_EQ(m_runner.get_nb_route_calls(), 3);
+}
+
+TEST_F(response_cache_test, no_explicit_freshness) {
+  m_runner.run("/articles");
+  m_runner.run("/articles");
+
+  EXPECT_EQ(m_runner.get_nb_route_calls(), 2);
+  EXPECT_EQ(m_cache.size(), 0UL);
+}
+
+TEST_F(response_cache_test, default_ttl) {
+  netflex::middlewares::response_cache cache(1024 * 1024, std::chrono::seconds(60));
+
+  middleware_runner runner({cache.get_middleware()}, [](netflex::http::request&, netflex::http::response&, int) {});
+
+  runner.run("/");
+  runner.run("/");
+
+  EXPECT_EQ(runner.get_nb_route_calls(), 1);
+}
+
+TEST_F(response_cache_test, s_maxage_wins) {
+  m_response_headers = {{"Cache-Control", "max-age=60, s-maxage=0"}};
+
+  m_runner.run("/articles");
+  m_runner.run("/articles");
+
+  EXPECT_EQ(m_runner.get_nb_route_calls(), 2);
+}
+
+TEST_F(response_cache_test, expiration) {
+  m_response_headers = {{"cache-control", "max-age=1"}};
+
+  m_runner.run("/articles");
+  std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+  m_runner.run("/articles");
+
+  EXPECT_EQ(m_runner.get_nb_route_calls(), 2);
+  EXPECT_EQ(m_cache.size(), 1UL);
+}
+
+TEST_F(response_cache_test, uncacheable_responses) {
+  std::vector<netflex::http::header_list_t> headers = {
+    {{"Cache-Control", "no-store, max-age=60"}},
+    {{"Cache-Control", "no-cache, max-age=60"}},
+    {{"Cache-Control", "private, max-age=60"}},
+    {{"Cache-Control", "max-age=60"}, {"Set-Cookie", "session=1"}},
+    {{"Cache-Control", "max-age=60"}, {"Vary", "*"}}};
+
+  for (const auto& response_headers : headers) {
+    m_response_headers = response_headers;
+    m_runner.run("/articles");
+  }
+
+  EXPECT_EQ(m_cache.size(), 0UL);
+}
+
+TEST_F(response_cache_test, uncacheable_requests) {
+  m_response_headers = {{"Cache-Control", "max-age=60"}};
+
+  m_runner.run("/articles", {}, netflex::http::method::POST);
+  m_runner.run("/articles", {{"Authorization", "Bearer token"}});
+  m_runner.run("/articles", {{"Cache-Control", "no-store"}});
+
+  EXPECT_EQ(m_runner.get_nb_route_calls(), 3);
+  EXPECT_EQ(m_cache.size(), 0UL);
+  EXPECT_EQ(m_cache.get_nb_misses(), 0UL);
+}
+
+TEST_F(response_cache_test, request_no_cache_refreshes) {
+  m_response_headers = {{"Cache-Control", "max-age=60"}};
+
+  m_runner.run("/articles");
+  netflex::http::response refreshed = m_runner.run("/articles", {{"Cache-Control", "no-cache"}});
+  netflex::http::response cached    = m_runner.run("/articles");
+
+  EXPECT_EQ(m_runner.get_nb_route_calls(), 2);
+  EXPECT_EQ(cached.get_body(), refreshed.get_body());
+}
+
+TEST_F(response_cache_test, vary) {
+  m_response_headers = {{"Cache-Control", "max-age=60"}, {"Vary", "Accept-Encoding"}};
+
+  m_runner.run("/articles", {{"Accept-Encoding", "gzip"}});
+  m_runner.run("/articles", {{"accept-encoding", "gzip"}});
+  m_runner.run("/articles", {{"Accept-Encoding", "br"}});
+  m_runner.run("/articles");
+  m_runner.run("/articles", {{"Accept-Encoding", "br"}});
+
+  EXPECT_EQ(m_runner.get_nb_route_calls(), 3);
+  EXPECT_EQ(m_cache.size(), 3UL);
+}
+
+TEST_F(response_cache_test, memory_cap) {
+  //! 1 shard of 1KB
+  netflex::middlewares::response_cache cache(1024, std::chrono::seconds(60), 1);
+
+  middleware_runner runner({cache.get_middleware()}, [](netflex::http::request&, netflex::http::response& response, int) { response.set_body(std::string(200, 'x')); });
+
+  for (int i = 0; i < 20; ++i)
+    runner.run("/" + std::to_string(i));
+
+  EXPECT_LE(cache.get_memory_usage(), 1024UL);
+  EXPECT_GT(cache.size(), 0UL);
+  EXPECT_LT(cache.size(), 20UL);
+}
+
+TEST_F(response_cache_test, clear) {
+  m_response_headers = {{"Cache-Control", "max-age=60"}};
+
+  m_runner.run("/articles");
+  m_cache.clear();
+
+  EXPECT_EQ(m_cache.size(), 0UL);
+  EXPECT_EQ(m_cache.get_memory_usage(), 0UL);
+
+  m_runner.run("/articles");
+  EXPECT_EQ(m_runner.get_nb_route_calls(), 2);
+}
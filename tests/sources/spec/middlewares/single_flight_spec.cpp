@@ -0,0 +1,205 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <atomic>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <netflex/netflex>
+
+#include "middleware_runner.hpp"
+
+//!
+//! run requests through the single flight, followed by a slow route
+//!
+class single_flight_test : public ::testing::Test {
+protected:
+  single_flight_test(void)
+  : m_single_flight({"Accept-Encoding"}, std::chrono::milliseconds(2000))
+  , m_route_delay(std::chrono::milliseconds(100))
+  , m_route_throws(false)
+  , m_runner({m_single_flight.get_middleware()}, [this](netflex::http::request& request, netflex::http::response& response, int call) {
+    std::this_thread::sleep_for(m_route_delay);
+
+    if (m_route_throws)
+      throw std::runtime_error("route failure");
+
+    response.set_status_code(201);
+    response.set_reason_phrase("Created");
+    response.set_headers(m_response_headers);
+    response.set_body(request.get_target() + " #" + std::to_string(call));
+  }) {}
+
+  netflex::middlewares::single_flight m_single_flight;
+  std::chrono::milliseconds m_route_delay;
+  std::atomic<bool> m_route_throws;
+  netflex::http::header_list_t m_response_headers;
+  middleware_runner m_runner;
+};
+
+TEST_F(single_flight_test, sequential_requests) {
+  m_runner.run("/articles");
+  m_runner.run("/articles");
+
+  EXPECT_EQ(m_runner.get_nb_route_calls(), 2);
+  EXPECT_EQ(m_single_flight.get_nb_coalesced(), 0UL);
+  EXPECT_EQ(m_single_flight.get_nb_in_flight(), 0UL);
+}
+
+TEST_F(single_flight_test, coalesce_identical_requests) {
+  auto responses = middleware_runner::run_concurrently(8, [&](std::size_t) { return m_runner.run("/articles"); });
+
+  EXPECT_EQ(m_runner.get_nb_route_calls(), 1);
+  EXPECT_EQ(m_single_flight.get_nb_coalesced(), 7UL);
+  EXPECT_EQ(m_single_flight.get_nb_in_flight(), 0UL);
+
+  for (const auto& response : responses) {
+    EXPECT_EQ(response.get_status_code(), 201U);
+    EXPECT_EQ(response.get_reason_phase(), "Created");
+    EXPECT_EQ(response.get_body(), "/articles #1");
+    ASSERT_NE(response.get_shared_body(), nullptr);
+    EXPECT_EQ(response.get_shared_body(), responses[0].get_shared_body());
+  }
+}
+
+TEST_F(single_flight_test, different_keys) {
+  middleware_runner::run_concurrently(4, [&](std::size_t i) {
+    switch (i) {
+    case 0: return m_runner.run("/articles");
+    case 1: return m_runner.run("/articles?page=2");
+    case 2: return m_runner.run("/articles", {{"Accept-Encoding", "gzip"}});
+    default: return m_runner.run("/articles", {}, netflex::http::method::HEAD);
+    }
+  });
+
+  EXPECT_EQ(m_runner.get_nb_route_calls(), 4);
+  EXPECT_EQ(m_single_flight.get_nb_coalesced(), 0UL);
+}
+
+TEST_F(single_flight_test, keyed_by_host) {
+  auto responses = middleware_runner::run_concurrently(3, [&](std::size_t i) {
+    switch (i) {
+    case 0: return m_runner.run("/", {{"Host", "a.example"}});
+    case 1: return m_runner.run("/", {{"Host", "b.example"}});
+    default: return m_runner.run("/", {{"host", "A.example"}});
+    }
+  });
+
+  EXPECT_EQ(m_runner.get_nb_route_calls(), 2);
+  EXPECT_EQ(m_single_flight.get_nb_coalesced(), 1UL);
+  EXPECT_NE(responses[1].get_body(), responses[0].get_body());
+  EXPECT_EQ(responses[2].get_body(), responses[0].get_body());
+}
+
+TEST_F(single_flight_test, vary) {
+  //! Accept-Encoding is part of the key
+  m_response_headers = {{"Vary", "accept-encoding"}};
+  middleware_runner::run_concurrently(3, [&](std::size_t) { return m_runner.run("/articles"); });
+
+  EXPECT_EQ(m_runner.get_nb_route_calls(), 1);
+  EXPECT_EQ(m_single_flight.get_nb_coalesced(), 2UL);
+
+  //! followers may have another Accept-Language than the leader
+  for (const auto& vary : {"Accept-Encoding, Accept-Language", "*"}) {
+    m_response_headers = {{"Vary", vary}};
+    middleware_runner::run_concurrently(3, [&](std::size_t) { return m_runner.run("/articles"); });
+  }
+
+  EXPECT_EQ(m_runner.get_nb_route_calls(), 7);
+  EXPECT_EQ(m_single_flight.get_nb_coalesced(), 2UL);
+}
+
+TEST_F(single_flight_test, non_idempotent_methods) {
+  middleware_runner::run_concurrently(3, [&](std::size_t) { return m_runner.run("/articles", {}, netflex::http::method::POST); });
+
+  EXPECT_EQ(m_runner.get_nb_route_calls(), 3);
+}
+
+TEST_F(single_flight_test, credentials) {
+  middleware_runner::run_concurrently(3, [&](std::size_t) { return m_runner.run("/articles", {{"Authorization", "Bearer token"}}); });
+  middleware_runner::run_concurrently(3, [&](std::size_t) { return m_runner.run("/articles", {{"cookie", "session=1"}}); });
+
+  EXPECT_EQ(m_runner.get_nb_route_calls(), 6);
+  EXPECT_EQ(m_single_flight.get_nb_coalesced(), 0UL);
+}
+
+TEST(single_flight, keyed_credentials) {
+  netflex::middlewares::single_flight single_flight({"authorization"}, std::chrono::milliseconds(2000));
+  middleware_runner runner({single_flight.get_middleware()}, [](netflex::http::request&, netflex::http::response&, int) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+  });
+
+  middleware_runner::run_concurrently(3, [&](std::size_t) { return runner.run("/me", {{"Authorization", "Bearer token"}}); });
+
+  EXPECT_EQ(runner.get_nb_route_calls(), 1);
+  EXPECT_EQ(single_flight.get_nb_coalesced(), 2UL);
+}
+
+TEST_F(single_flight_test, private_responses) {
+  std::vector<netflex::http::header_list_t> headers = {
+    {{"Set-Cookie", "session=1"}},
+    {{"Cache-Control", "private, max-age=60"}},
+    {{"cache-control", "No-Store"}}};
+
+  for (const auto& response_headers : headers) {
+    m_response_headers = response_headers;
+    middleware_runner::run_concurrently(3, [&](std::size_t) { return m_runner.run("/articles"); });
+  }
+
+  //! followers wait for the leader, then compute their own response
+  EXPECT_EQ(m_runner.get_nb_route_calls(), 9);
+  EXPECT_EQ(m_single_flight.get_nb_coalesced(), 0UL);
+}
+
+TEST_F(single_flight_test, leader_failure) {
+  m_route_throws = true;
+
+  std::atomic<int> nb_failures(0);
+  middleware_runner::run_concurrently(3, [&](std::size_t) {
+    try {
+      return m_runner.run("/articles");
+    }
+    catch (const std::runtime_error&) {
+      ++nb_failures;
+      return netflex::http::response();
+    }
+  });
+
+  //! followers do not share a failure: they run the route themselves
+  EXPECT_EQ(m_runner.get_nb_route_calls(), 3);
+  EXPECT_EQ(nb_failures, 3);
+  EXPECT_EQ(m_single_flight.get_nb_in_flight(), 0UL);
+}
+
+TEST(single_flight, max_wait) {
+  netflex::middlewares::single_flight single_flight({}, std::chrono::milliseconds(10));
+  middleware_runner runner({single_flight.get_middleware()}, [](netflex::http::request&, netflex::http::response&, int) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  });
+
+  middleware_runner::run_concurrently(2, [&](std::size_t) { return runner.run("/slow"); });
+
+  EXPECT_EQ(runner.get_nb_route_calls(), 2);
+  EXPECT_EQ(single_flight.get_nb_coalesced(), 0UL);
+}
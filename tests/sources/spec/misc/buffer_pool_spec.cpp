@@ -0,0 +1,61 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+
+#include <netflex/netflex>
+
+TEST(buffer_pool, recycles_buffers) {
+  netflex::misc::buffer_pool::clear();
+
+  std::vector<char> buffer = netflex::misc::buffer_pool::acquire(1024);
+  buffer.assign(100, 'x');
+  const char* data = buffer.data();
+
+  netflex::misc::buffer_pool::release(std::move(buffer));
+  EXPECT_EQ(netflex::misc::buffer_pool::size(), 1UL);
+
+  //! same storage, emptied
+  std::vector<char> recycled = netflex::misc::buffer_pool::acquire(512);
+  EXPECT_TRUE(recycled.empty());
+  EXPECT_GE(recycled.capacity(), 1024UL);
+  EXPECT_EQ(recycled.data(), data);
+  EXPECT_EQ(netflex::misc::buffer_pool::size(), 0UL);
+}
+
+TEST(buffer_pool, bounded) {
+  netflex::misc::buffer_pool::clear();
+
+  //! empty and oversized buffers are not kept
+  netflex::misc::buffer_pool::release(std::vector<char>());
+  netflex::misc::buffer_pool::release(std::vector<char>(netflex::misc::buffer_pool::max_buffer_capacity + 1));
+  EXPECT_EQ(netflex::misc::buffer_pool::size(), 0UL);
+
+  for (std::size_t i = 0; i < 2 * netflex::misc::buffer_pool::max_buffers_per_thread; ++i)
+    netflex::misc::buffer_pool::release(std::vector<char>(16));
+
+  EXPECT_EQ(netflex::misc::buffer_pool::size(), netflex::misc::buffer_pool::max_buffers_per_thread);
+
+  netflex::misc::buffer_pool::clear();
+  EXPECT_EQ(netflex::misc::buffer_pool::size(), 0UL);
+}
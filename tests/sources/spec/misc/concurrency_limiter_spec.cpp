@@ -0,0 +1,124 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+
+#include <netflex/netflex>
+
+TEST(concurrency_limiter, rejects_over_limit) {
+  netflex::misc::concurrency_limiter limiter(2);
+
+  EXPECT_TRUE(limiter.try_acquire());
+  EXPECT_TRUE(limiter.try_acquire());
+  EXPECT_FALSE(limiter.try_acquire());
+  EXPECT_EQ(limiter.get_nb_in_flight(), 2U);
+  EXPECT_EQ(limiter.get_nb_rejected(), 1U);
+
+  limiter.release(1000);
+  EXPECT_TRUE(limiter.try_acquire());
+}
+
+TEST(concurrency_limiter, permit) {
+  netflex::misc::concurrency_limiter limiter(1);
+
+  {
+    netflex::misc::concurrency_limiter::permit permit;
+    EXPECT_TRUE(permit.acquire(limiter));
+
+    netflex::misc::concurrency_limiter::permit rejected;
+    EXPECT_FALSE(rejected.acquire(limiter));
+
+    permit.release(1000);
+    EXPECT_EQ(limiter.get_nb_in_flight(), 0U);
+  }
+
+  //! released once
+  EXPECT_EQ(limiter.get_nb_in_flight(), 0U);
+}
+
+TEST(concurrency_limiter, permit_released_on_exception) {
+  netflex::misc::concurrency_limiter limiter(1);
+
+  try {
+    netflex::misc::concurrency_limiter::permit permit;
+    ASSERT_TRUE(permit.acquire(limiter));
+
+    throw std::runtime_error("handler failure");
+  }
+  catch (const std::runtime_error&) {
+  }
+
+  EXPECT_EQ(limiter.get_nb_in_flight(), 0U);
+  EXPECT_TRUE(limiter.try_acquire());
+}
+
+TEST(concurrency_limiter, initial_limit_bounds) {
+  EXPECT_EQ(netflex::misc::concurrency_limiter(0, 1, 10).get_limit(), 1U);
+  EXPECT_EQ(netflex::misc::concurrency_limiter(100, 1, 10).get_limit(), 10U);
+}
+
+TEST(concurrency_limiter, grows_with_stable_latency) {
+  netflex::misc::concurrency_limiter limiter(10, 1, 100);
+
+  //! saturated server, constant latency
+  for (int i = 0; i < 100; ++i) {
+    while (limiter.try_acquire())
+      ;
+    limiter.release(1000000);
+  }
+
+  EXPECT_EQ(limiter.get_limit(), 100U);
+}
+
+TEST(concurrency_limiter, shrinks_when_latency_rises) {
+  netflex::misc::concurrency_limiter limiter(50, 1, 100);
+
+  for (int i = 0; i < 100; ++i) {
+    while (limiter.try_acquire())
+      ;
+    limiter.release(1000000);
+  }
+
+  std::uint32_t limit = limiter.get_limit();
+
+  //! backend slowing down
+  for (int i = 0; i < 50; ++i) {
+    while (limiter.try_acquire())
+      ;
+    limiter.release(10000000);
+  }
+
+  EXPECT_LT(limiter.get_limit(), limit / 2);
+}
+
+TEST(concurrency_limiter, idle_does_not_grow) {
+  netflex::misc::concurrency_limiter limiter(10, 1, 100);
+
+  //! a single request at a time
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(limiter.try_acquire());
+    limiter.release(1000000);
+  }
+
+  EXPECT_EQ(limiter.get_limit(), 10U);
+}
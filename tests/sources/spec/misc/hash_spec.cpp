@@ -0,0 +1,58 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <netflex/netflex>
+
+static std::uint64_t
+hash(const std::string& str, std::uint64_t seed = 0) {
+  return netflex::misc::xxhash64(str.data(), str.size(), seed);
+}
+
+//!
+//! reference XXH64 values
+//!
+TEST(hash, xxhash64_reference) {
+  EXPECT_EQ(hash(""), 0xEF46DB3751D8E999ULL);
+  EXPECT_EQ(hash("a"), 0xD24EC4F1A98C6E5BULL);
+  EXPECT_EQ(hash("abc"), 0x44BC2CF5AD770999ULL);
+  EXPECT_EQ(hash("Nobody inspects the spammish repetition"), 0xFBCEA83C8A378BF1ULL);
+}
+
+TEST(hash, xxhash64_seed) {
+  EXPECT_NE(hash("abc", 0), hash("abc", 1));
+  EXPECT_EQ(hash("abc", 42), hash("abc", 42));
+}
+
+TEST(hash, xxhash64_all_sizes) {
+  std::string data(100, 'x');
+
+  //! every tail length and stripe count, on unaligned data
+  for (std::size_t size = 0; size < 64; ++size) {
+    EXPECT_EQ(netflex::misc::xxhash64(data.data() + 1, size), netflex::misc::xxhash64(std::string(data.data() + 1, size).data(), size));
+    EXPECT_NE(netflex::misc::xxhash64(data.data(), size), netflex::misc::xxhash64(data.data(), size + 1));
+  }
+}
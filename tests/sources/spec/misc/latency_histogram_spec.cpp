@@ -0,0 +1,121 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <netflex/netflex>
+
+TEST(latency_histogram, empty) {
+  netflex::misc::latency_histogram histogram;
+
+  EXPECT_EQ(histogram.get_count(), 0UL);
+  EXPECT_EQ(histogram.get_max(), 0UL);
+  EXPECT_EQ(histogram.get_mean(), 0);
+  EXPECT_EQ(histogram.get_percentile(50), 0UL);
+}
+
+TEST(latency_histogram, small_values_are_exact) {
+  netflex::misc::latency_histogram histogram;
+
+  for (std::uint64_t i = 1; i <= 20; ++i)
+    histogram.record(i);
+
+  EXPECT_EQ(histogram.get_count(), 20UL);
+  EXPECT_EQ(histogram.get_max(), 20UL);
+  EXPECT_EQ(histogram.get_mean(), 10.5);
+  EXPECT_EQ(histogram.get_percentile(50), 10UL);
+  EXPECT_EQ(histogram.get_percentile(100), 20UL);
+}
+
+TEST(latency_histogram, large_values_precision) {
+  netflex::misc::latency_histogram histogram;
+
+  for (std::uint64_t i = 1; i <= 1000; ++i)
+    histogram.record(i * 1000000);
+
+  //! values are reported with a relative precision of 1/16
+  std::uint64_t p50 = histogram.get_percentile(50);
+  std::uint64_t p99 = histogram.get_percentile(99);
+
+  EXPECT_GE(p50, 500000000UL);
+  EXPECT_LE(p50, 500000000UL + 500000000UL / 16);
+  EXPECT_GE(p99, 990000000UL);
+  EXPECT_LE(p99, 990000000UL + 990000000UL / 16);
+  EXPECT_EQ(histogram.get_percentile(100), 1000000000UL);
+}
+
+TEST(latency_histogram, huge_values) {
+  netflex::misc::latency_histogram histogram;
+
+  histogram.record(UINT64_MAX);
+
+  EXPECT_EQ(histogram.get_count(), 1UL);
+  EXPECT_EQ(histogram.get_percentile(99), UINT64_MAX);
+}
+
+TEST(latency_histogram, reset) {
+  netflex::misc::latency_histogram histogram;
+
+  histogram.record(42);
+  histogram.reset();
+
+  EXPECT_EQ(histogram.get_count(), 0UL);
+  EXPECT_EQ(histogram.get_max(), 0UL);
+  EXPECT_EQ(histogram.get_percentile(50), 0UL);
+}
+
+TEST(latency_histogram, record_count) {
+  netflex::misc::latency_histogram histogram;
+
+  histogram.record(10, 3);
+
+  EXPECT_EQ(histogram.get_count(), 3UL);
+  EXPECT_EQ(histogram.get_mean(), 10);
+}
+
+TEST(latency_histogram, record_corrected) {
+  netflex::misc::latency_histogram histogram;
+
+  //! a 10 units stall with an expected interval of 2 hides 4 samples (8, 6, 4, 2)
+  histogram.record_corrected(10, 2);
+
+  EXPECT_EQ(histogram.get_count(), 5UL);
+  EXPECT_EQ(histogram.get_max(), 10UL);
+  EXPECT_EQ(histogram.get_percentile(50), 6UL);
+
+  //! no correction for values below the expected interval
+  histogram.reset();
+  histogram.record_corrected(1, 2);
+  EXPECT_EQ(histogram.get_count(), 1UL);
+}
+
+TEST(latency_histogram, add_corrected) {
+  netflex::misc::latency_histogram raw;
+  netflex::misc::latency_histogram corrected;
+
+  raw.record(1, 9);
+  raw.record(10);
+  corrected.add_corrected(raw, 2);
+
+  EXPECT_EQ(corrected.get_count(), 14UL);
+  EXPECT_EQ(corrected.get_max(), 10UL);
+}
@@ -0,0 +1,164 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <netflex/netflex>
+
+TEST(rate_limiter, burst_then_reject) {
+  netflex::misc::rate_limiter limiter(1, 3);
+
+  EXPECT_TRUE(limiter.try_acquire("1.2.3.4", 100));
+  EXPECT_TRUE(limiter.try_acquire("1.2.3.4", 100));
+  EXPECT_TRUE(limiter.try_acquire("1.2.3.4", 100));
+  EXPECT_FALSE(limiter.try_acquire("1.2.3.4", 100));
+  EXPECT_EQ(limiter.get_nb_rejected(), 1U);
+}
+
+TEST(rate_limiter, keys_are_independent) {
+  netflex::misc::rate_limiter limiter(1, 1);
+
+  EXPECT_TRUE(limiter.try_acquire("a", 0));
+  EXPECT_FALSE(limiter.try_acquire("a", 0));
+  EXPECT_TRUE(limiter.try_acquire("b", 0));
+  EXPECT_EQ(limiter.get_nb_active(0), 2U);
+}
+
+TEST(rate_limiter, refill) {
+  netflex::misc::rate_limiter limiter(10, 2);
+
+  EXPECT_TRUE(limiter.try_acquire("a", 0));
+  EXPECT_TRUE(limiter.try_acquire("a", 0));
+  EXPECT_FALSE(limiter.try_acquire("a", 50));
+
+  //! 10 requests per second: a token every 100ms
+  EXPECT_TRUE(limiter.try_acquire("a", 100));
+  EXPECT_FALSE(limiter.try_acquire("a", 100));
+
+  //! refill is capped by the burst
+  EXPECT_TRUE(limiter.try_acquire("a", 10000));
+  EXPECT_TRUE(limiter.try_acquire("a", 10000));
+  EXPECT_FALSE(limiter.try_acquire("a", 10000));
+}
+
+TEST(rate_limiter, slow_rate_accumulates) {
+  netflex::misc::rate_limiter limiter(0.5, 1);
+
+  EXPECT_TRUE(limiter.try_acquire("a", 0));
+
+  //! frequent rejected requests do not reset the refill
+  for (std::uint32_t now = 1; now < 2000; now += 1)
+    EXPECT_FALSE(limiter.try_acquire("a", now));
+
+  EXPECT_TRUE(limiter.try_acquire("a", 2000));
+  EXPECT_EQ(limiter.get_retry_after(), 2U);
+}
+
+TEST(rate_limiter, idle_slots_are_reused) {
+  //! a single slot
+  netflex::misc::rate_limiter limiter(1, 1, 1, 1);
+
+  EXPECT_TRUE(limiter.try_acquire("a", 0));
+
+  //! slot still active: b is not tracked, and not limited
+  EXPECT_TRUE(limiter.try_acquire("b", 500));
+  EXPECT_TRUE(limiter.try_acquire("b", 500));
+  EXPECT_EQ(limiter.get_nb_untracked(), 2U);
+
+  //! a is idle since its bucket is full again, b takes the slot
+  EXPECT_TRUE(limiter.try_acquire("b", 1000));
+  EXPECT_FALSE(limiter.try_acquire("b", 1000));
+  EXPECT_EQ(limiter.get_nb_active(1000), 1U);
+  EXPECT_EQ(limiter.get_nb_active(5000), 0U);
+}
+
+TEST(rate_limiter, saturated_client_chosen_keys) {
+  //! a single slot, taken by a first key
+  netflex::misc::rate_limiter limiter(1, 2, 1, 1);
+
+  EXPECT_TRUE(limiter.try_acquire("key-a", "1.2.3.4", 0));
+
+  //! random keys find no slot, nor does the address: rejected
+  EXPECT_FALSE(limiter.try_acquire("key-b", "1.2.3.4", 0));
+  EXPECT_FALSE(limiter.try_acquire("key-c", "1.2.3.4", 0));
+  EXPECT_EQ(limiter.get_nb_rejected(), 2U);
+  EXPECT_EQ(limiter.get_nb_untracked(), 0U);
+
+  //! the slot owner is still limited by its own bucket
+  EXPECT_TRUE(limiter.try_acquire("key-a", "1.2.3.4", 0));
+  EXPECT_FALSE(limiter.try_acquire("key-a", "1.2.3.4", 0));
+}
+
+TEST(rate_limiter, saturated_keys_fall_back) {
+  //! a single slot, taken by the address
+  netflex::misc::rate_limiter limiter(1, 2, 1, 1);
+
+  EXPECT_TRUE(limiter.try_acquire("1.2.3.4", 0));
+
+  //! random keys are charged to the address
+  EXPECT_TRUE(limiter.try_acquire("key-a", "1.2.3.4", 0));
+  EXPECT_FALSE(limiter.try_acquire("key-b", "1.2.3.4", 0));
+  EXPECT_EQ(limiter.get_nb_active(0), 1U);
+}
+
+TEST(rate_limiter, clock_wrap) {
+  netflex::misc::rate_limiter limiter(1, 1);
+
+  EXPECT_TRUE(limiter.try_acquire("a", 0xFFFFFF00));
+  EXPECT_FALSE(limiter.try_acquire("a", 0xFFFFFF00));
+
+  //! clock wrapped around
+  EXPECT_FALSE(limiter.try_acquire("a", 0x00000010));
+  EXPECT_TRUE(limiter.try_acquire("a", 0x00000400));
+}
+
+TEST(rate_limiter, invalid_config) {
+  EXPECT_THROW(netflex::misc::rate_limiter(0, 1), netflex::netflex_error);
+  EXPECT_THROW(netflex::misc::rate_limiter(1, 0), netflex::netflex_error);
+}
+
+TEST(rate_limiter, concurrent_requests) {
+  netflex::misc::rate_limiter limiter(1, 1000);
+  std::atomic<unsigned int> nb_allowed(0);
+  std::vector<std::thread> threads;
+
+  //! no token is given twice under contention
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&] {
+      for (int j = 0; j < 1000; ++j)
+        if (limiter.try_acquire("a", 0))
+          ++nb_allowed;
+    });
+  }
+
+  for (auto& thread : threads)
+    thread.join();
+
+  EXPECT_EQ(nb_allowed, 1000U);
+  EXPECT_EQ(limiter.get_nb_rejected(), 3000U);
+}
@@ -0,0 +1,75 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <netflex/netflex>
+
+TEST(request_metrics, record) {
+  netflex::misc::request_metrics metrics;
+  netflex::misc::request_timing timing;
+
+  timing.add(netflex::misc::request_phase::parse, 10);
+  timing.add(netflex::misc::request_phase::write, 20);
+  metrics.record(timing);
+
+  EXPECT_EQ(metrics.get_histogram(netflex::misc::request_phase::parse).get_count(), 1UL);
+  EXPECT_EQ(metrics.get_histogram(netflex::misc::request_phase::parse).get_max(), 10UL);
+  EXPECT_EQ(metrics.get_histogram(netflex::misc::request_phase::write).get_max(), 20UL);
+  EXPECT_EQ(metrics.get_histogram(netflex::misc::request_phase::handler).get_max(), 0UL);
+  EXPECT_EQ(metrics.get_total_histogram().get_max(), 30UL);
+
+  metrics.reset();
+  EXPECT_EQ(metrics.get_total_histogram().get_count(), 0UL);
+}
+
+TEST(request_metrics, slow_requests_tracing) {
+  netflex::misc::request_metrics metrics;
+  std::size_t nb_slow_requests = 0;
+
+  EXPECT_FALSE(metrics.is_slow_request_tracing_enabled());
+  metrics.set_slow_request_handler(100, [&](const netflex::misc::request_timing& timing) {
+    EXPECT_EQ(timing.get_description(), "GET / HTTP/1.1");
+    ++nb_slow_requests;
+  });
+  EXPECT_TRUE(metrics.is_slow_request_tracing_enabled());
+
+  netflex::misc::request_timing fast;
+  fast.add(netflex::misc::request_phase::handler, 50);
+  fast.set_description("GET / HTTP/1.1");
+  metrics.record(fast);
+  EXPECT_EQ(nb_slow_requests, 0UL);
+
+  netflex::misc::request_timing slow;
+  slow.add(netflex::misc::request_phase::handler, 150);
+  slow.set_description("GET / HTTP/1.1");
+  metrics.record(slow);
+  EXPECT_EQ(nb_slow_requests, 1UL);
+
+  //! requests are described only once known to be slow
+  EXPECT_FALSE(metrics.is_slow_request(fast));
+  EXPECT_TRUE(metrics.is_slow_request(slow));
+
+  metrics.set_slow_request_handler(100, nullptr);
+  EXPECT_FALSE(metrics.is_slow_request_tracing_enabled());
+  EXPECT_FALSE(metrics.is_slow_request(slow));
+}
@@ -0,0 +1,55 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <netflex/netflex>
+
+TEST(request_timing, add) {
+  netflex::misc::request_timing timing;
+
+  timing.add(netflex::misc::request_phase::parse, 10);
+  timing.add(netflex::misc::request_phase::parse, 5);
+  timing.add(netflex::misc::request_phase::handler, 100);
+
+  EXPECT_EQ(timing.get(netflex::misc::request_phase::parse), 15UL);
+  EXPECT_EQ(timing.get(netflex::misc::request_phase::middleware), 0UL);
+  EXPECT_EQ(timing.get(netflex::misc::request_phase::handler), 100UL);
+  EXPECT_EQ(timing.get_total(), 115UL);
+}
+
+TEST(request_timing, now_is_monotonic) {
+  std::uint64_t before = netflex::misc::request_timing::now();
+  std::uint64_t after  = netflex::misc::request_timing::now();
+
+  EXPECT_LE(before, after);
+}
+
+TEST(request_timing, parser_records_parse_phase) {
+  netflex::parsing::request_parser parser;
+
+  parser << "GET / HTTP/1.1\r\nHost: localhost\r\n\r\n";
+
+  ASSERT_TRUE(parser.request_available());
+  EXPECT_GT(parser.get_front().get_timing().get(netflex::misc::request_phase::parse), 0UL);
+  EXPECT_EQ(parser.get_front().get_timing().get(netflex::misc::request_phase::write), 0UL);
+}
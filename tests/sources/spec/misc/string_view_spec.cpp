@@ -0,0 +1,82 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include <netflex/netflex>
+
+TEST(string_view, empty) {
+  netflex::misc::string_view view;
+
+  EXPECT_TRUE(view.empty());
+  EXPECT_EQ(view.size(), 0UL);
+  EXPECT_EQ(view.to_string(), "");
+}
+
+TEST(string_view, from_strings) {
+  std::string str = "hello";
+  netflex::misc::string_view from_string(str);
+  netflex::misc::string_view from_c_str("hello");
+  netflex::misc::string_view from_data(str.data(), 4);
+
+  EXPECT_EQ(from_string.data(), str.data());
+  EXPECT_EQ(from_string.size(), 5UL);
+  EXPECT_EQ(from_c_str.size(), 5UL);
+  EXPECT_EQ(from_data.to_string(), "hell");
+  EXPECT_EQ(from_string[1], 'e');
+  EXPECT_EQ(std::string(from_string.begin(), from_string.end()), "hello");
+}
+
+TEST(string_view, comparison) {
+  EXPECT_TRUE(netflex::misc::string_view("abc") == "abc");
+  EXPECT_TRUE(netflex::misc::string_view("abc") != "abd");
+  EXPECT_TRUE(netflex::misc::string_view("abc") != "ab");
+  EXPECT_TRUE(netflex::misc::string_view() == "");
+}
+
+TEST(string_view, substr) {
+  netflex::misc::string_view view("hello world");
+
+  EXPECT_EQ(view.substr(6), "world");
+  EXPECT_EQ(view.substr(0, 5), "hello");
+  EXPECT_EQ(view.substr(6, 100), "world");
+  EXPECT_EQ(view.substr(100), "");
+}
+
+TEST(string_view, find) {
+  netflex::misc::string_view view("a=b&c=d");
+
+  EXPECT_EQ(view.find('='), 1UL);
+  EXPECT_EQ(view.find('=', 2), 5UL);
+  EXPECT_EQ(view.find('#'), netflex::misc::string_view::npos);
+  EXPECT_EQ(view.find('a', 100), netflex::misc::string_view::npos);
+}
+
+TEST(string_view, output) {
+  std::stringstream ss;
+  ss << netflex::misc::string_view("hello world").substr(0, 5);
+
+  EXPECT_EQ(ss.str(), "hello");
+}
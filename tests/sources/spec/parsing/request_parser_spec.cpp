@@ -19,3 +19,254 @@
 // LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <netflex/netflex>
+
+TEST(request_parser, fragmented_feed) {
+  netflex::parsing::request_parser parser;
+  std::string request = "GET /index.html HTTP/1.1\r\nHost: localhost\r\nUser-Agent: Mozilla/5.0 (X11; Linux x86_64)\r\n\r\n";
+
+  //! feed one byte at a time
+  for (char c : request)
+    parser << std::string(1, c);
+
+  ASSERT_TRUE(parser.request_available());
+  EXPECT_EQ(parser.get_front().get_target(), "/index.html");
+  EXPECT_EQ(parser.get_front().get_header("Host"), "localhost");
+  EXPECT_EQ(parser.get_front().get_header("User-Agent"), "Mozilla/5.0 (X11; Linux x86_64)");
+}
+
+TEST(request_parser, simple_get) {
+  netflex::parsing::request_parser parser;
+  parser << "GET /users/42 HTTP/1.1\r\nHost: localhost\r\n\r\n";
+
+  ASSERT_TRUE(parser.request_available());
+  EXPECT_EQ(parser.get_front().get_method(), netflex::http::method::GET);
+  EXPECT_EQ(parser.get_front().get_target(), "/users/42");
+  EXPECT_EQ(parser.get_front().get_http_version(), "HTTP/1.1");
+  EXPECT_EQ(parser.get_front().get_body(), "");
+
+  parser.pop_front();
+  EXPECT_FALSE(parser.request_available());
+}
+
+TEST(request_parser, header_field_ows_is_trimmed) {
+  netflex::parsing::request_parser parser;
+  parser << "GET / HTTP/1.1\r\nAccept:  \t text/html, */* \t\r\nX-Empty:\r\n\r\n";
+
+  ASSERT_TRUE(parser.request_available());
+  EXPECT_EQ(parser.get_front().get_header("Accept"), "text/html, */*");
+  EXPECT_EQ(parser.get_front().get_header("X-Empty"), "");
+}
+
+TEST(request_parser, leading_empty_lines_are_ignored) {
+  netflex::parsing::request_parser parser;
+  parser << "\r\n\r\nGET / HTTP/1.1\r\n\r\n";
+
+  ASSERT_TRUE(parser.request_available());
+  EXPECT_EQ(parser.get_front().get_target(), "/");
+}
+
+TEST(request_parser, pipelined_requests) {
+  netflex::parsing::request_parser parser;
+  parser << "GET /a HTTP/1.1\r\n\r\nPOST /b HTTP/1.1\r\nContent-Length: 5\r\n\r\nhelloGET /c HTTP/1.1\r\n\r\n";
+
+  ASSERT_TRUE(parser.request_available());
+  EXPECT_EQ(parser.get_front().get_target(), "/a");
+  parser.pop_front();
+
+  ASSERT_TRUE(parser.request_available());
+  EXPECT_EQ(parser.get_front().get_target(), "/b");
+  EXPECT_EQ(parser.get_front().get_body(), "hello");
+  parser.pop_front();
+
+  ASSERT_TRUE(parser.request_available());
+  EXPECT_EQ(parser.get_front().get_target(), "/c");
+  parser.pop_front();
+
+  EXPECT_FALSE(parser.request_available());
+}
+
+TEST(request_parser, content_length_body_in_several_parts) {
+  netflex::parsing::request_parser parser;
+  parser << "POST / HTTP/1.1\r\nContent-Length: 11\r\n\r\nhello";
+  EXPECT_FALSE(parser.request_available());
+
+  parser << " world";
+  ASSERT_TRUE(parser.request_available());
+  EXPECT_EQ(parser.get_front().get_body(), "hello world");
+}
+
+TEST(request_parser, content_length_leading_zeros) {
+  netflex::parsing::request_parser parser;
+  parser << "POST / HTTP/1.1\r\nContent-Length: 000000000000000000005\r\n\r\nhello";
+
+  EXPECT_FALSE(parser.has_error());
+  ASSERT_TRUE(parser.request_available());
+  EXPECT_EQ(parser.get_front().get_body(), "hello");
+}
+
+TEST(request_parser, chunked_body) {
+  netflex::parsing::request_parser parser;
+  std::string request = "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n5;ext=1\r\nhello\r\n6\r\n world\r\n0\r\nX-Trailer: value\r\n\r\n";
+
+  //! whole request at once
+  parser << request;
+  ASSERT_TRUE(parser.request_available());
+  EXPECT_EQ(parser.get_front().get_body(), "hello world");
+  parser.pop_front();
+
+  //! one byte at a time
+  for (char c : request)
+    parser << std::string(1, c);
+
+  ASSERT_TRUE(parser.request_available());
+  EXPECT_EQ(parser.get_front().get_body(), "hello world");
+}
+
+TEST(request_parser, transfer_encoding_overrides_content_length) {
+  netflex::parsing::request_parser parser;
+  parser << "POST / HTTP/1.1\r\nContent-Length: 3\r\nTransfer-Encoding: gzip, chunked\r\n\r\na\r\n0123456789\r\n0\r\n\r\n";
+
+  ASSERT_TRUE(parser.request_available());
+  EXPECT_EQ(parser.get_front().get_body(), "0123456789");
+  EXPECT_FALSE(parser.get_front().has_header("Content-Length"));
+}
+
+TEST(request_parser, invalid_requests) {
+  struct invalid_request {
+    std::string packet;
+    netflex::parsing::parsing_stage stage;
+    std::size_t offset;
+    unsigned int status;
+  };
+
+  std::vector<invalid_request> requests = {
+    //! invalid http version
+    {"GET / HTTP/11\r\n\r\n", netflex::parsing::parsing_stage::start_line, 14, 400},
+    {"GET / HTTP/2.0\r\n\r\n", netflex::parsing::parsing_stage::start_line, 15, 505},
+    //! missing LF
+    {"GET / HTTP/1.1\rHost: localhost\r\n\r\n", netflex::parsing::parsing_stage::start_line, 15, 400},
+    //! obs-fold
+    {"GET / HTTP/1.1\r\nX-Folded: a\r\n b\r\n\r\n", netflex::parsing::parsing_stage::header_fields, 29, 400},
+    //! whitespace between field name and colon
+    {"GET / HTTP/1.1\r\nHost : localhost\r\n\r\n", netflex::parsing::parsing_stage::header_fields, 20, 400},
+    //! invalid Content-Length
+    {"POST / HTTP/1.1\r\nContent-Length: 1a\r\n\r\n", netflex::parsing::parsing_stage::header_fields, 36, 400},
+    {"POST / HTTP/1.1\r\nContent-Length: -1\r\n\r\n", netflex::parsing::parsing_stage::header_fields, 36, 400},
+    //! conflicting Content-Length
+    {"POST / HTTP/1.1\r\nContent-Length: 1\r\ncontent-length: 2\r\n\r\n", netflex::parsing::parsing_stage::header_fields, 54, 400},
+    //! chunked is not the final encoding
+    {"POST / HTTP/1.1\r\nTransfer-Encoding: chunked, gzip\r\n\r\n", netflex::parsing::parsing_stage::header_fields, 52, 400},
+    //! unknown encoding
+    {"POST / HTTP/1.1\r\nTransfer-Encoding: br, chunked\r\n\r\n", netflex::parsing::parsing_stage::header_fields, 50, 501},
+    //! invalid chunk-size
+    {"POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\nzz\r\n", netflex::parsing::parsing_stage::message_body, 47, 400},
+    //! missing CRLF after chunk-data
+    {"POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n1\r\nab\r\n", netflex::parsing::parsing_stage::message_body, 51, 400}};
+
+  for (const auto& request : requests) {
+    netflex::parsing::request_parser parser;
+    parser << request.packet;
+
+    ASSERT_TRUE(parser.has_error()) << request.packet;
+    EXPECT_FALSE(parser.request_available());
+    EXPECT_EQ(parser.get_error().stage, request.stage) << request.packet;
+    EXPECT_EQ(parser.get_error().offset, request.offset) << request.packet;
+    EXPECT_EQ(parser.get_error().status, request.status) << request.packet;
+
+    //! further data is ignored
+    parser << "GET / HTTP/1.1\r\n\r\n";
+    EXPECT_TRUE(parser.has_error());
+    EXPECT_FALSE(parser.request_available());
+  }
+}
+
+TEST(request_parser, error_offset_is_relative_to_the_request) {
+  netflex::parsing::request_parser parser;
+  parser << "GET / HTTP/1.1\r\n\r\nGET / HTTP/1.1\r\n";
+  parser << "Host : localhost\r\n\r\n";
+
+  //! valid request received before the invalid one is still available
+  EXPECT_TRUE(parser.request_available());
+  ASSERT_TRUE(parser.has_error());
+  EXPECT_EQ(parser.get_error().offset, 20UL);
+  EXPECT_STREQ(parser.get_error().reason, "invalid header field");
+}
+
+TEST(request_parser, size_limits) {
+  struct oversized_request {
+    std::string packet;
+    netflex::parsing::parsing_stage stage;
+    unsigned int status;
+    const char* reason;
+  };
+
+  netflex::parsing::request_limits limits;
+  limits.max_request_line_size   = 32;
+  limits.max_header_field_size   = 32;
+  limits.max_nb_header_fields    = 2;
+  limits.max_header_section_size = 48;
+  limits.max_body_size           = 8;
+
+  std::vector<oversized_request> requests = {
+    {"GET /" + std::string(64, 'a') + " HTTP/1.1\r\n\r\n", netflex::parsing::parsing_stage::start_line, 414, "request-line too long"},
+    {std::string(64, 'G'), netflex::parsing::parsing_stage::start_line, 414, "request-line too long"},
+    {"GET / HTTP/1.1\r\nX-Big: " + std::string(64, 'a') + "\r\n\r\n", netflex::parsing::parsing_stage::header_fields, 431, "header field too large"},
+    {"GET / HTTP/1.1\r\nA: 1\r\nB: 2\r\nC: 3\r\n\r\n", netflex::parsing::parsing_stage::header_fields, 431, "too many header fields"},
+    {"GET / HTTP/1.1\r\nX-A: " + std::string(24, 'a') + "\r\nX-B: " + std::string(24, 'b') + "\r\n\r\n", netflex::parsing::parsing_stage::header_fields, 431, "header section too large"},
+    {"POST / HTTP/1.1\r\nContent-Length: 9\r\n\r\n", netflex::parsing::parsing_stage::message_body, 413, "message body too large"},
+    {"POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n5\r\n12345\r\n4\r\n", netflex::parsing::parsing_stage::message_body, 413, "message body too large"},
+    {"POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\nffffffffffffffff\r\n", netflex::parsing::parsing_stage::message_body, 413, "message body too large"}};
+
+  for (const auto& request : requests) {
+    netflex::parsing::request_parser parser;
+    parser.set_limits(limits);
+    parser << request.packet;
+
+    ASSERT_TRUE(parser.has_error()) << request.packet;
+    EXPECT_EQ(parser.get_error().stage, request.stage) << request.packet;
+    EXPECT_EQ(parser.get_error().status, request.status) << request.packet;
+    EXPECT_STREQ(parser.get_error().reason, request.reason) << request.packet;
+  }
+}
+
+TEST(request_parser, size_limits_content_length_overflow) {
+  //! too many digits to be represented: too large for any body limit
+  netflex::parsing::request_parser parser;
+  parser << "POST / HTTP/1.1\r\nContent-Length: 99999999999999999999\r\n\r\n";
+
+  ASSERT_TRUE(parser.has_error());
+  EXPECT_EQ(parser.get_error().stage, netflex::parsing::parsing_stage::message_body);
+  EXPECT_EQ(parser.get_error().status, 413U);
+  EXPECT_STREQ(parser.get_error().reason, "message body too large");
+}
+
+TEST(request_parser, size_limits_reset_between_requests) {
+  netflex::parsing::request_limits limits;
+  limits.max_nb_header_fields = 1;
+  limits.max_body_size        = 4;
+
+  netflex::parsing::request_parser parser;
+  parser.set_limits(limits);
+  parser << "POST / HTTP/1.1\r\nContent-Length: 4\r\n\r\n1234POST / HTTP/1.1\r\nContent-Length: 4\r\n\r\n1234";
+
+  EXPECT_FALSE(parser.has_error());
+  ASSERT_TRUE(parser.request_available());
+  parser.pop_front();
+  EXPECT_TRUE(parser.request_available());
+}
+
+TEST(request_parser, size_limits_disabled) {
+  netflex::parsing::request_limits limits;
+  limits.max_request_line_size = 0;
+
+  netflex::parsing::request_parser parser;
+  parser.set_limits(limits);
+  parser << "GET /" + std::string(100000, 'a') + " HTTP/1.1\r\n\r\n";
+
+  EXPECT_FALSE(parser.has_error());
+  EXPECT_TRUE(parser.request_available());
+}
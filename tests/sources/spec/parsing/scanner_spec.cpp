@@ -0,0 +1,117 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include <netflex/parsing/scanner.hpp>
+
+using namespace netflex::parsing;
+
+static const scanner::implementation implementations[] = {
+  scanner::implementation::scalar,
+  scanner::implementation::sse4_2,
+  scanner::implementation::avx2};
+
+TEST(scanner, char_set) {
+  scanner::char_set set(std::string("ab\0c", 4));
+
+  EXPECT_EQ(set.get_size(), 3UL);
+  EXPECT_TRUE(set.contains('a'));
+  EXPECT_TRUE(set.contains('c'));
+  EXPECT_FALSE(set.contains('d'));
+  EXPECT_FALSE(set.contains('\0'));
+}
+
+TEST(scanner, default_implementation_is_supported) {
+  EXPECT_TRUE(scanner::is_supported(scanner::get_implementation()));
+  EXPECT_TRUE(scanner::is_supported(scanner::implementation::scalar));
+}
+
+TEST(scanner, find_first_of) {
+  scanner::char_set set(" \t\r:");
+  auto default_impl = scanner::get_implementation();
+
+  for (auto impl : implementations) {
+    if (!scanner::set_implementation(impl))
+      continue;
+
+    //! match at every position, in every block and in the scalar tail
+    for (std::size_t size = 0; size <= 100; ++size) {
+      for (std::size_t position = 0; position <= size; ++position) {
+        std::string input(size, 'x');
+        if (position < size)
+          input[position] = ':';
+
+        EXPECT_EQ(scanner::find_first_of(input.data(), input.size(), set), position);
+        EXPECT_EQ(scanner::find_first_not_of(input.data(), input.size(), scanner::char_set("x")), position);
+      }
+    }
+  }
+
+  scanner::set_implementation(default_impl);
+}
+
+TEST(scanner, nul_bytes_do_not_stop_the_scan) {
+  scanner::char_set set("\r\n");
+  std::string input(std::string(40, '\0') + "\r\n");
+  auto default_impl = scanner::get_implementation();
+
+  for (auto impl : implementations) {
+    if (!scanner::set_implementation(impl))
+      continue;
+
+    EXPECT_EQ(scanner::find_first_of(input.data(), input.size(), set), 40UL);
+  }
+
+  scanner::set_implementation(default_impl);
+}
+
+TEST(scanner, matches_scalar_implementation) {
+  scanner::char_set sets[] = {scanner::char_set(" \t\x0b\x0c\r"), scanner::char_set("\x0b\x0c\r"), scanner::char_set("0123456789abcdef"), scanner::char_set("")};
+  auto default_impl        = scanner::get_implementation();
+  std::mt19937 random(42);
+
+  for (int round = 0; round < 2000; ++round) {
+    //! inputs made of few distinct characters, so that both matches and non-matches are likely
+    std::string input(random() % 128, ' ');
+    for (auto& c : input)
+      c = " \t\r\x0b\x0c" "ab09\x80\xff"[random() % 11];
+
+    for (const auto& set : sets) {
+      scanner::set_implementation(scanner::implementation::scalar);
+      std::size_t expected_of     = scanner::find_first_of(input.data(), input.size(), set);
+      std::size_t expected_not_of = scanner::find_first_not_of(input.data(), input.size(), set);
+
+      for (auto impl : implementations) {
+        if (!scanner::set_implementation(impl))
+          continue;
+
+        EXPECT_EQ(scanner::find_first_of(input.data(), input.size(), set), expected_of);
+        EXPECT_EQ(scanner::find_first_not_of(input.data(), input.size(), set), expected_not_of);
+      }
+    }
+  }
+
+  scanner::set_implementation(default_impl);
+}
@@ -89,7 +89,8 @@ TEST(middleware_chain, proceed) {
   response.set_body("0");
 
   //! build chain
-  netflex::routing::middleware_chain chain(middlewares, request, response);
+  netflex::routing::middleware_pipeline pipeline(middlewares);
+  netflex::routing::middleware_chain chain(pipeline, request, response);
 
   //! proceed
   chain.proceed();
@@ -148,7 +149,8 @@ TEST(middleware_chain, proceed_with_broken_chain) {
   response.set_body("0");
 
   //! build chain
-  netflex::routing::middleware_chain chain(middlewares, request, response);
+  netflex::routing::middleware_pipeline pipeline(middlewares);
+  netflex::routing::middleware_chain chain(pipeline, request, response);
 
   //! proceed
   chain.proceed();
@@ -170,7 +172,8 @@ TEST(middleware_chain, proceed_with_empty_chain) {
   response.set_body("0");
 
   //! build chain
-  netflex::routing::middleware_chain chain(middlewares, request, response);
+  netflex::routing::middleware_pipeline pipeline(middlewares);
+  netflex::routing::middleware_chain chain(pipeline, request, response);
 
   //! proceed
   chain.proceed();
@@ -0,0 +1,76 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <netflex/netflex>
+
+TEST(middleware_pipeline, empty) {
+  netflex::routing::middleware_pipeline pipeline;
+
+  EXPECT_EQ(pipeline.size(), 0UL);
+}
+
+TEST(middleware_pipeline, keeps_order) {
+  std::list<netflex::routing::middleware_t> middlewares;
+  std::string calls;
+
+  for (char c : std::string("abc"))
+    middlewares.push_back([&calls, c](netflex::routing::middleware_chain&, netflex::http::request&, netflex::http::response&) { calls += c; });
+
+  netflex::routing::middleware_pipeline pipeline(middlewares);
+
+  //! pipeline is a snapshot: later changes to the list are not reflected
+  middlewares.clear();
+
+  ASSERT_EQ(pipeline.size(), 3UL);
+
+  netflex::http::request request;
+  netflex::http::response response;
+  netflex::routing::middleware_chain chain(pipeline, request, response);
+
+  for (std::size_t i = 0; i < pipeline.size(); ++i)
+    pipeline[i](chain, request, response);
+
+  EXPECT_EQ(calls, "abc");
+}
+
+TEST(middleware_pipeline, shared_by_chains) {
+  std::list<netflex::routing::middleware_t> middlewares;
+  int nb_calls = 0;
+
+  middlewares.push_back([&nb_calls](netflex::routing::middleware_chain& chain, netflex::http::request&, netflex::http::response&) {
+    ++nb_calls;
+    chain.proceed();
+  });
+
+  netflex::routing::middleware_pipeline pipeline(middlewares);
+  netflex::http::request request;
+  netflex::http::response response;
+
+  for (int i = 0; i < 3; ++i) {
+    netflex::routing::middleware_chain chain(pipeline, request, response);
+    chain.proceed();
+  }
+
+  EXPECT_EQ(nb_calls, 3);
+}
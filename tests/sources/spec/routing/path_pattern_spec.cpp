@@ -0,0 +1,146 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+
+#include <netflex/netflex>
+
+//!
+//! compilation
+//!
+TEST(path_pattern, no_param) {
+  netflex::routing::path_pattern pattern("/users/articles");
+
+  EXPECT_EQ(pattern.get_path(), "/users/articles");
+  EXPECT_TRUE(pattern.get_param_names().empty());
+  EXPECT_TRUE(pattern.get_param_types().empty());
+}
+
+TEST(path_pattern, params) {
+  netflex::routing::path_pattern pattern("/users/:id<u64>/posts/:post-id<i64>/tags/:tag/authors/:name<str>");
+
+  EXPECT_EQ(pattern.get_param_names(), std::vector<std::string>({"id", "post-id", "tag", "name"}));
+  EXPECT_EQ(pattern.get_param_types(), std::vector<netflex::routing::param_type>({netflex::routing::param_type::u64, netflex::routing::param_type::i64, netflex::routing::param_type::str, netflex::routing::param_type::str}));
+}
+
+TEST(path_pattern, incomplete_param) {
+  netflex::routing::path_pattern pattern("/users/:/articles");
+
+  EXPECT_TRUE(pattern.get_param_names().empty());
+}
+
+TEST(path_pattern, invalid_type) {
+  EXPECT_THROW(netflex::routing::path_pattern("/users/:id<u32>"), netflex::netflex_error);
+  EXPECT_THROW(netflex::routing::path_pattern("/users/:id<u64"), netflex::netflex_error);
+}
+
+TEST(path_pattern, param_type_to_string) {
+  EXPECT_EQ(std::string(netflex::routing::param_type_to_string(netflex::routing::param_type::str)), "str");
+  EXPECT_EQ(std::string(netflex::routing::param_type_to_string(netflex::routing::param_type::u64)), "u64");
+  EXPECT_EQ(std::string(netflex::routing::param_type_to_string(netflex::routing::param_type::i64)), "i64");
+}
+
+//!
+//! matching
+//!
+TEST(path_pattern, match_no_param) {
+  netflex::routing::path_pattern pattern("/users/articles");
+  netflex::routing::path_params_t params;
+
+  EXPECT_TRUE(pattern.match("/users/articles", params));
+  EXPECT_TRUE(pattern.match("/users/articles/", params));
+  EXPECT_TRUE(pattern.match("/users/articles?a=b#anchor", params));
+  EXPECT_TRUE(params.empty());
+
+  EXPECT_FALSE(pattern.match("/users/article", params));
+  EXPECT_FALSE(pattern.match("/users/articles//", params));
+  EXPECT_FALSE(pattern.match("/users", params));
+}
+
+TEST(path_pattern, match_root) {
+  netflex::routing::path_pattern pattern("/");
+  netflex::routing::path_params_t params;
+
+  EXPECT_TRUE(pattern.match("/", params));
+  EXPECT_TRUE(pattern.match("/?a=b", params));
+  EXPECT_FALSE(pattern.match("/a", params));
+}
+
+TEST(path_pattern, match_typed_params) {
+  netflex::routing::path_pattern pattern("/users/:id<u64>/posts/:post<i64>/tags/:tag");
+  netflex::routing::path_params_t params;
+
+  ASSERT_TRUE(pattern.match("/users/42/posts/-84/tags/news_1?id=1", params));
+  ASSERT_EQ(params.size(), 3UL);
+
+  EXPECT_EQ(params[0].type, netflex::routing::param_type::u64);
+  EXPECT_EQ(params[0].u64, 42UL);
+  EXPECT_EQ(params[0].str, "42");
+  EXPECT_EQ(params[1].type, netflex::routing::param_type::i64);
+  EXPECT_EQ(params[1].i64, -84);
+  EXPECT_EQ(params[1].str, "-84");
+  EXPECT_EQ(params[2].type, netflex::routing::param_type::str);
+  EXPECT_EQ(params[2].str, "news_1");
+}
+
+TEST(path_pattern, match_literal_suffix) {
+  netflex::routing::path_pattern pattern("/files/:id<u64>.json");
+  netflex::routing::path_params_t params;
+
+  ASSERT_TRUE(pattern.match("/files/12.json", params));
+  EXPECT_EQ(params[0].u64, 12UL);
+  EXPECT_FALSE(pattern.match("/files/12.xml", params));
+}
+
+TEST(path_pattern, unmatch_invalid_values) {
+  netflex::routing::path_pattern pattern("/users/:id<u64>");
+  netflex::routing::path_params_t params;
+
+  EXPECT_FALSE(pattern.match("/users/", params));
+  EXPECT_FALSE(pattern.match("/users/abc", params));
+  EXPECT_FALSE(pattern.match("/users/42abc", params));
+  EXPECT_FALSE(pattern.match("/users/-42", params));
+  EXPECT_FALSE(pattern.match("/users//", params));
+}
+
+TEST(path_pattern, u64_bounds) {
+  netflex::routing::path_pattern pattern("/:id<u64>");
+  netflex::routing::path_params_t params;
+
+  ASSERT_TRUE(pattern.match("/18446744073709551615", params));
+  EXPECT_EQ(params[0].u64, UINT64_MAX);
+  EXPECT_FALSE(pattern.match("/18446744073709551616", params));
+}
+
+TEST(path_pattern, i64_bounds) {
+  netflex::routing::path_pattern pattern("/:id<i64>");
+  netflex::routing::path_params_t params;
+
+  ASSERT_TRUE(pattern.match("/9223372036854775807", params));
+  EXPECT_EQ(params[0].i64, INT64_MAX);
+  ASSERT_TRUE(pattern.match("/-9223372036854775808", params));
+  EXPECT_EQ(params[0].i64, INT64_MIN);
+  EXPECT_FALSE(pattern.match("/9223372036854775808", params));
+  EXPECT_FALSE(pattern.match("/-9223372036854775809", params));
+  EXPECT_FALSE(pattern.match("/-", params));
+}
@@ -0,0 +1,125 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+
+#include <netflex/netflex>
+
+//!
+//! from_target
+//!
+TEST(query, from_target) {
+  EXPECT_EQ(netflex::routing::query::from_target("/users").get_raw(), "");
+  EXPECT_EQ(netflex::routing::query::from_target("/users?").get_raw(), "");
+  EXPECT_EQ(netflex::routing::query::from_target("/users?a=1&b=2").get_raw(), "a=1&b=2");
+  EXPECT_EQ(netflex::routing::query::from_target("/users?a=1#anchor").get_raw(), "a=1");
+  EXPECT_EQ(netflex::routing::query::from_target("/users#anchor?a=1").get_raw(), "");
+}
+
+//!
+//! lookups
+//!
+TEST(query, empty) {
+  netflex::routing::query query;
+
+  EXPECT_TRUE(query.empty());
+  EXPECT_EQ(query.size(), 0UL);
+  EXPECT_FALSE(query.has("a"));
+  EXPECT_EQ(query.get("a", "default"), "default");
+  EXPECT_TRUE(query.get_all("a").empty());
+}
+
+TEST(query, solo_param) {
+  netflex::routing::query query("var=val");
+
+  EXPECT_FALSE(query.empty());
+  EXPECT_EQ(query.size(), 1UL);
+  EXPECT_TRUE(query.has("var"));
+  EXPECT_FALSE(query.has("va"));
+  EXPECT_FALSE(query.has("var_"));
+  EXPECT_EQ(query.get("var"), "val");
+}
+
+TEST(query, multi_params) {
+  netflex::routing::query query("var_1=val_1&var_2=val_2&var_3=val_3");
+
+  EXPECT_EQ(query.size(), 3UL);
+  EXPECT_EQ(query.get("var_1"), "val_1");
+  EXPECT_EQ(query.get("var_2"), "val_2");
+  EXPECT_EQ(query.get("var_3"), "val_3");
+}
+
+TEST(query, multi_values) {
+  netflex::routing::query query("tag=a&other=x&tag=b&tag=c");
+
+  EXPECT_EQ(query.size(), 4UL);
+  EXPECT_EQ(query.count("tag"), 3UL);
+  EXPECT_EQ(query.get("tag"), "a");
+  EXPECT_EQ(query.get_all("tag"), std::vector<std::string>({"a", "b", "c"}));
+}
+
+TEST(query, empty_and_missing_values) {
+  netflex::routing::query query("var_1=&&var_2&var_3==");
+
+  EXPECT_EQ(query.size(), 3UL);
+  EXPECT_TRUE(query.has("var_1"));
+  EXPECT_EQ(query.get("var_1", "default"), "");
+  EXPECT_TRUE(query.has("var_2"));
+  EXPECT_EQ(query.get("var_2", "default"), "");
+  EXPECT_EQ(query.get("var_3"), "=");
+}
+
+TEST(query, raw_value) {
+  netflex::routing::query query("name=John+Doe%21");
+
+  EXPECT_EQ(query.get_raw_value("name"), "John+Doe%21");
+  EXPECT_EQ(query.get_raw_value("missing"), "");
+  EXPECT_EQ(query.get("name"), "John Doe!");
+}
+
+TEST(query, encoded_keys) {
+  netflex::routing::query query("first%20name=John&a+b=c&%3D=equal");
+
+  EXPECT_EQ(query.get("first name"), "John");
+  EXPECT_EQ(query.get("a b"), "c");
+  EXPECT_EQ(query.get("="), "equal");
+  EXPECT_FALSE(query.has("first%20name"));
+}
+
+//!
+//! decode
+//!
+TEST(query, decode) {
+  EXPECT_EQ(netflex::routing::query::decode(""), "");
+  EXPECT_EQ(netflex::routing::query::decode("abc"), "abc");
+  EXPECT_EQ(netflex::routing::query::decode("a+b"), "a b");
+  EXPECT_EQ(netflex::routing::query::decode("%41%62%2b"), "Ab+");
+  EXPECT_EQ(netflex::routing::query::decode("%e2%82%AC"), "\xe2\x82\xac");
+}
+
+TEST(query, decode_invalid_escapes) {
+  EXPECT_EQ(netflex::routing::query::decode("%"), "%");
+  EXPECT_EQ(netflex::routing::query::decode("%4"), "%4");
+  EXPECT_EQ(netflex::routing::query::decode("%zz"), "%zz");
+  EXPECT_EQ(netflex::routing::query::decode("100%"), "100%");
+}
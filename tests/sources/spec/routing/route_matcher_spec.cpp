@@ -50,16 +50,10 @@ public:
   test_build_match_regex(const std::string& path) {
     build_match_regex(path);
   }
-
-  //! matching
-  void
-  test_match_get_params(const std::string& path, netflex::routing::params_t& params) const {
-    match_get_params(path, params);
-  }
 };
 
 //! regex constants
-static const std::string PATH_REGEX_MATCH_SUFIX = "/?((\\?([^=]+)=([^&\\#]*))(&([^=]+)=([^&\\#]*))*)?(\\#.*)*";
+static const std::string PATH_REGEX_MATCH_SUFIX = "/?";
 static const std::string PATH_REGEX_VAR_MATCH   = "/([a-zA-Z0-9_\\-]+)";
 
 //!
@@ -118,11 +112,11 @@ TEST(match, match_alphanum_variable) {
 TEST(match, match_solo_url_params) {
   test_route_matcher matcher("/users/articles");
 
+  //! get params are not part of the route params
   netflex::routing::params_t params;
   EXPECT_EQ(matcher.match("/users/articles?user_id=42", params), true);
 
-  EXPECT_EQ(params.size(), 1UL);
-  EXPECT_EQ(params["user_id"], "42");
+  EXPECT_EQ(params.size(), 0UL);
 }
 
 TEST(match, match_multi_url_params) {
@@ -131,10 +125,7 @@ TEST(match, match_multi_url_params) {
   netflex::routing::params_t params;
   EXPECT_EQ(matcher.match("/users/articles?user_id=42&article_id=84&comment_id=21", params), true);
 
-  EXPECT_EQ(params.size(), 3UL);
-  EXPECT_EQ(params["user_id"], "42");
-  EXPECT_EQ(params["article_id"], "84");
-  EXPECT_EQ(params["comment_id"], "21");
+  EXPECT_EQ(params.size(), 0UL);
 }
 
 TEST(match, match_multi_empty_url_params) {
@@ -143,10 +134,7 @@ TEST(match, match_multi_empty_url_params) {
   netflex::routing::params_t params;
   EXPECT_EQ(matcher.match("/users/articles?user_id=42&article_id=&comment_id=21", params), true);
 
-  EXPECT_EQ(params.size(), 3UL);
-  EXPECT_EQ(params["user_id"], "42");
-  EXPECT_EQ(params["article_id"], "");
-  EXPECT_EQ(params["comment_id"], "21");
+  EXPECT_EQ(params.size(), 0UL);
 }
 
 TEST(match, match_combination) {
@@ -155,24 +143,21 @@ TEST(match, match_combination) {
   netflex::routing::params_t params;
   EXPECT_EQ(matcher.match("/users/42/articles/84/?comment_id=21&source=google", params), true);
 
-  EXPECT_EQ(params.size(), 4UL);
+  EXPECT_EQ(params.size(), 2UL);
   EXPECT_EQ(params["user_id"], "42");
   EXPECT_EQ(params["article_id"], "84");
-  EXPECT_EQ(params["comment_id"], "21");
-  EXPECT_EQ(params["source"], "google");
 }
 
 TEST(match, match_combination_conflict) {
   test_route_matcher matcher("/users/:user_id/articles/:article_id");
 
+  //! get params do not override route params
   netflex::routing::params_t params;
   EXPECT_EQ(matcher.match("/users/42/articles/84/?comment_id=21&user_id=1&source=google", params), true);
 
-  EXPECT_EQ(params.size(), 4UL);
-  EXPECT_EQ(params["user_id"], "1");
+  EXPECT_EQ(params.size(), 2UL);
+  EXPECT_EQ(params["user_id"], "42");
   EXPECT_EQ(params["article_id"], "84");
-  EXPECT_EQ(params["comment_id"], "21");
-  EXPECT_EQ(params["source"], "google");
 }
 
 TEST(match, match_complex) {
@@ -181,12 +166,28 @@ TEST(match, match_complex) {
   netflex::routing::params_t params;
   EXPECT_EQ(matcher.match("/users/42/articles/84/comments/21/author?user_id=1&source=google&test=#anchor", params), true);
 
-  EXPECT_EQ(params.size(), 5UL);
-  EXPECT_EQ(params["user_id"], "1");
+  EXPECT_EQ(params.size(), 3UL);
+  EXPECT_EQ(params["user_id"], "42");
   EXPECT_EQ(params["article_id"], "84");
   EXPECT_EQ(params["comment_id"], "21");
-  EXPECT_EQ(params["source"], "google");
-  EXPECT_EQ(params["test"], "");
+}
+
+TEST(match, match_fragment) {
+  test_route_matcher matcher("/users/:user_id");
+
+  netflex::routing::params_t params;
+  EXPECT_EQ(matcher.match("/users/42#anchor?a=b", params), true);
+
+  EXPECT_EQ(params.size(), 1UL);
+  EXPECT_EQ(params["user_id"], "42");
+}
+
+TEST(match, match_query_string_unmatch) {
+  test_route_matcher matcher("/users/articles");
+
+  //! query string does not make an unmatching path match
+  netflex::routing::params_t params;
+  EXPECT_EQ(matcher.match("/users?/articles", params), false);
 }
 
 TEST(match, match_trailing_slash) {
@@ -303,73 +304,3 @@ TEST(route_matcher, build_match_regex_subsequent_slashes) {
   EXPECT_EQ(matcher.get_match_regex_str(), "//users///1//articles///" + PATH_REGEX_MATCH_SUFIX);
   EXPECT_EQ(matcher.get_url_params().size(), 0UL);
 }
-
-//!
-//! match_get_params
-//!
-TEST(route_matcher, match_get_params) {
-  test_route_matcher matcher("");
-
-  netflex::routing::params_t params;
-  matcher.test_match_get_params("", params);
-
-  EXPECT_EQ(params.size(), 0UL);
-}
-
-TEST(route_matcher, match_get_params_solo_var) {
-  test_route_matcher matcher("");
-
-  netflex::routing::params_t params;
-  matcher.test_match_get_params("?var=val", params);
-
-  EXPECT_EQ(params.size(), 1UL);
-  EXPECT_EQ(params["var"], "val");
-}
-
-TEST(route_matcher, match_get_params_multi_var) {
-  test_route_matcher matcher("");
-
-  netflex::routing::params_t params;
-  matcher.test_match_get_params("?var_1=val_1&var_2=val_2&var_3=val_3", params);
-
-  EXPECT_EQ(params.size(), 3UL);
-  EXPECT_EQ(params["var_1"], "val_1");
-  EXPECT_EQ(params["var_2"], "val_2");
-  EXPECT_EQ(params["var_3"], "val_3");
-}
-
-TEST(route_matcher, match_get_params_multi_var_conflict) {
-  test_route_matcher matcher("");
-
-  netflex::routing::params_t params;
-  matcher.test_match_get_params("?var_1=val_1&var_2=val_2&var_3=val_3&var_2=val_4", params);
-
-  EXPECT_EQ(params.size(), 3UL);
-  EXPECT_EQ(params["var_1"], "val_1");
-  EXPECT_EQ(params["var_2"], "val_4");
-  EXPECT_EQ(params["var_3"], "val_3");
-}
-
-TEST(route_matcher, match_get_params_multi_var_empty) {
-  test_route_matcher matcher("");
-
-  netflex::routing::params_t params;
-  matcher.test_match_get_params("?var_1=val_1&var_2=&var_3=val_3", params);
-
-  EXPECT_EQ(params.size(), 3UL);
-  EXPECT_EQ(params["var_1"], "val_1");
-  EXPECT_EQ(params["var_2"], "");
-  EXPECT_EQ(params["var_3"], "val_3");
-}
-
-TEST(route_matcher, match_get_params_multi_var_special) {
-  test_route_matcher matcher("");
-
-  netflex::routing::params_t params;
-  matcher.test_match_get_params("?var_1==&var_2=&var_3=val_3", params);
-
-  EXPECT_EQ(params.size(), 3UL);
-  EXPECT_EQ(params["var_1"], "=");
-  EXPECT_EQ(params["var_2"], "");
-  EXPECT_EQ(params["var_3"], "val_3");
-}
@@ -116,8 +116,8 @@ TEST(route, match_solo_url_params) {
 
   netflex::routing::params_t params = request.get_params();
   EXPECT_EQ(request.get_path(), "/users/articles");
-  EXPECT_EQ(params.size(), 1UL);
-  EXPECT_EQ(params["user_id"], "42");
+  EXPECT_EQ(params.size(), 0UL);
+  EXPECT_EQ(request.get_query().get("user_id"), "42");
 }
 
 TEST(route, match_multi_url_params) {
@@ -130,10 +130,13 @@ TEST(route, match_multi_url_params) {
 
   netflex::routing::params_t params = request.get_params();
   EXPECT_EQ(request.get_path(), "/users/articles");
-  EXPECT_EQ(params.size(), 3UL);
-  EXPECT_EQ(params["user_id"], "42");
-  EXPECT_EQ(params["article_id"], "84");
-  EXPECT_EQ(params["comment_id"], "21");
+  EXPECT_EQ(params.size(), 0UL);
+
+  netflex::routing::query query = request.get_query();
+  EXPECT_EQ(query.size(), 3UL);
+  EXPECT_EQ(query.get("user_id"), "42");
+  EXPECT_EQ(query.get("article_id"), "84");
+  EXPECT_EQ(query.get("comment_id"), "21");
 }
 
 TEST(route, match_multi_empty_url_params) {
@@ -146,10 +149,14 @@ TEST(route, match_multi_empty_url_params) {
 
   netflex::routing::params_t params = request.get_params();
   EXPECT_EQ(request.get_path(), "/users/articles");
-  EXPECT_EQ(params.size(), 3UL);
-  EXPECT_EQ(params["user_id"], "42");
-  EXPECT_EQ(params["article_id"], "");
-  EXPECT_EQ(params["comment_id"], "21");
+  EXPECT_EQ(params.size(), 0UL);
+
+  netflex::routing::query query = request.get_query();
+  EXPECT_EQ(query.size(), 3UL);
+  EXPECT_EQ(query.get("user_id"), "42");
+  EXPECT_TRUE(query.has("article_id"));
+  EXPECT_EQ(query.get("article_id", "default"), "");
+  EXPECT_EQ(query.get("comment_id"), "21");
 }
 
 TEST(route, match_combination) {
@@ -162,11 +169,14 @@ TEST(route, match_combination) {
 
   netflex::routing::params_t params = request.get_params();
   EXPECT_EQ(request.get_path(), "/users/:user_id/articles/:article_id");
-  EXPECT_EQ(params.size(), 4UL);
+  EXPECT_EQ(params.size(), 2UL);
   EXPECT_EQ(params["user_id"], "42");
   EXPECT_EQ(params["article_id"], "84");
-  EXPECT_EQ(params["comment_id"], "21");
-  EXPECT_EQ(params["source"], "google");
+
+  netflex::routing::query query = request.get_query();
+  EXPECT_EQ(query.size(), 2UL);
+  EXPECT_EQ(query.get("comment_id"), "21");
+  EXPECT_EQ(query.get("source"), "google");
 }
 
 TEST(route, match_combination_conflict) {
@@ -179,11 +189,16 @@ TEST(route, match_combination_conflict) {
 
   netflex::routing::params_t params = request.get_params();
   EXPECT_EQ(request.get_path(), "/users/:user_id/articles/:article_id");
-  EXPECT_EQ(params.size(), 4UL);
-  EXPECT_EQ(params["user_id"], "1");
+  EXPECT_EQ(params.size(), 2UL);
+  EXPECT_EQ(params["user_id"], "42");
   EXPECT_EQ(params["article_id"], "84");
-  EXPECT_EQ(params["comment_id"], "21");
-  EXPECT_EQ(params["source"], "google");
+
+  //! route params and get params are kept separate
+  netflex::routing::query query = request.get_query();
+  EXPECT_EQ(query.size(), 3UL);
+  EXPECT_EQ(query.get("comment_id"), "21");
+  EXPECT_EQ(query.get("user_id"), "1");
+  EXPECT_EQ(query.get("source"), "google");
 }
 
 TEST(route, match_complex) {
@@ -196,12 +211,16 @@ TEST(route, match_complex) {
 
   netflex::routing::params_t params = request.get_params();
   EXPECT_EQ(request.get_path(), "/users/:user_id/articles/:article_id/comments/:comment_id/author");
-  EXPECT_EQ(params.size(), 5UL);
-  EXPECT_EQ(params["user_id"], "1");
+  EXPECT_EQ(params.size(), 3UL);
+  EXPECT_EQ(params["user_id"], "42");
   EXPECT_EQ(params["article_id"], "84");
   EXPECT_EQ(params["comment_id"], "21");
-  EXPECT_EQ(params["source"], "google");
-  EXPECT_EQ(params["test"], "");
+
+  netflex::routing::query query = request.get_query();
+  EXPECT_EQ(query.size(), 3UL);
+  EXPECT_EQ(query.get("user_id"), "1");
+  EXPECT_EQ(query.get("source"), "google");
+  EXPECT_EQ(query.get("test"), "");
 }
 
 TEST(route, match_trailing_slash) {
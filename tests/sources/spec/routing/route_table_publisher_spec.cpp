@@ -0,0 +1,227 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <atomic>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <netflex/netflex>
+
+static netflex::routing::route_table
+make_table(std::size_t nb_middlewares) {
+  std::list<netflex::routing::middleware_t> middlewares(nb_middlewares, [](netflex::routing::middleware_chain&, netflex::http::request&, netflex::http::response&) {});
+
+  netflex::routing::route_table table;
+  table.add("", netflex::routing::middleware_pipeline(middlewares));
+
+  return table;
+}
+
+TEST(route_table_publisher, empty) {
+  netflex::routing::route_table_publisher publisher;
+  netflex::routing::route_table_publisher::reader reader(publisher);
+
+  EXPECT_EQ(reader->size(), 0UL);
+  EXPECT_EQ(publisher.get_nb_retired(), 0UL);
+}
+
+TEST(route_table_publisher, publish) {
+  netflex::routing::route_table_publisher publisher;
+  publisher.publish(make_table(1));
+
+  netflex::routing::route_table_publisher::reader reader(publisher);
+  ASSERT_EQ(reader->size(), 1UL);
+  EXPECT_EQ(reader->resolve("/")->size(), 1UL);
+}
+
+TEST(route_table_publisher, reader_keeps_snapshot) {
+  netflex::routing::route_table_publisher publisher;
+  publisher.publish(make_table(1));
+
+  netflex::routing::route_table_publisher::reader old_reader(publisher);
+  publisher.publish(make_table(2));
+
+  netflex::routing::route_table_publisher::reader new_reader(publisher);
+  EXPECT_EQ(old_reader->resolve("/")->size(), 1UL);
+  EXPECT_EQ(new_reader->resolve("/")->size(), 2UL);
+}
+
+TEST(route_table_publisher, reclaim) {
+  netflex::routing::route_table_publisher publisher;
+  publisher.publish(make_table(1));
+  publisher.publish(make_table(2));
+
+  EXPECT_EQ(publisher.get_nb_retired(), 2UL);
+
+  publisher.reclaim();
+  EXPECT_EQ(publisher.get_nb_retired(), 0UL);
+
+  netflex::routing::route_table_publisher::reader reader(publisher);
+  EXPECT_EQ(reader->resolve("/")->size(), 2UL);
+}
+
+TEST(route_table_publisher, reclaim_from_read_section) {
+  netflex::routing::route_table_publisher publisher;
+
+  {
+    netflex::routing::route_table_publisher::reader reader(publisher);
+    publisher.publish(make_table(1));
+
+    //! would wait for ourselves: deferred
+    publisher.reclaim();
+    EXPECT_EQ(publisher.get_nb_retired(), 1UL);
+    EXPECT_EQ(reader->size(), 0UL);
+  }
+
+  //! reclaimed once the section is left, without any later update
+  EXPECT_EQ(publisher.get_nb_retired(), 0UL);
+}
+
+TEST(route_table_publisher, publish_from_nested_read_sections) {
+  netflex::routing::route_table_publisher publisher;
+
+  {
+    netflex::routing::route_table_publisher::reader outer(publisher);
+    {
+      netflex::routing::route_table_publisher::reader inner(publisher);
+      publisher.publish(make_table(1));
+    }
+
+    //! still used by the outer section
+    EXPECT_EQ(publisher.get_nb_retired(), 1UL);
+    EXPECT_EQ(outer->size(), 0UL);
+  }
+
+  EXPECT_EQ(publisher.get_nb_retired(), 0UL);
+}
+
+TEST(route_table_publisher, reclaim_after_other_readers) {
+  netflex::routing::route_table_publisher publisher;
+
+  std::atomic<bool> reading(false);
+  std::atomic<bool> release(false);
+  std::size_t read_size = 0;
+
+  std::thread reader_thread([&] {
+    netflex::routing::route_table_publisher::reader reader(publisher);
+    reading = true;
+
+    while (!release)
+      std::this_thread::yield();
+
+    read_size = reader->size();
+  });
+
+  while (!reading)
+    std::this_thread::yield();
+
+  //! published from a read-side section while another thread still reads the previous snapshot
+  {
+    netflex::routing::route_table_publisher::reader reader(publisher);
+    publisher.publish(make_table(1));
+  }
+  EXPECT_EQ(publisher.get_nb_retired(), 1UL);
+
+  //! the last reader of the snapshot reclaims it when leaving
+  release = true;
+  reader_thread.join();
+
+  EXPECT_EQ(read_size, 0UL);
+  EXPECT_EQ(publisher.get_nb_retired(), 0UL);
+}
+
+TEST(route_table_publisher, reclaim_waits_for_readers) {
+  netflex::routing::route_table_publisher publisher;
+  publisher.publish(make_table(1));
+
+  std::atomic<bool> reading(false);
+  std::atomic<bool> reclaimed(false);
+  std::atomic<bool> release(false);
+  std::size_t read_size = 0;
+
+  std::thread reader_thread([&] {
+    netflex::routing::route_table_publisher::reader reader(publisher);
+    reading = true;
+
+    while (!release)
+      std::this_thread::yield();
+
+    //! snapshot must still be alive
+    read_size = reader->resolve("/")->size();
+  });
+
+  while (!reading)
+    std::this_thread::yield();
+
+  publisher.publish(make_table(2));
+
+  std::thread reclaimer_thread([&] {
+    publisher.reclaim();
+    reclaimed = true;
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_FALSE(reclaimed);
+
+  release = true;
+  reader_thread.join();
+  reclaimer_thread.join();
+
+  EXPECT_TRUE(reclaimed);
+  EXPECT_EQ(read_size, 1UL);
+  EXPECT_EQ(publisher.get_nb_retired(), 0UL);
+}
+
+TEST(route_table_publisher, concurrent_readers_and_writers) {
+  netflex::routing::route_table_publisher publisher;
+  publisher.publish(make_table(1));
+
+  std::atomic<bool> stop(false);
+  std::atomic<std::size_t> nb_invalid(0);
+  std::vector<std::thread> readers;
+
+  for (int i = 0; i < 3; ++i) {
+    readers.emplace_back([&] {
+      while (!stop) {
+        netflex::routing::route_table_publisher::reader reader(publisher);
+        std::size_t size = reader->resolve("/")->size();
+
+        if (size < 1 || size > 3)
+          ++nb_invalid;
+      }
+    });
+  }
+
+  for (int i = 0; i < 200; ++i) {
+    publisher.publish(make_table(1 + i % 3));
+    publisher.reclaim();
+  }
+
+  stop = true;
+  for (auto& reader : readers)
+    reader.join();
+
+  EXPECT_EQ(nb_invalid, 0UL);
+  EXPECT_EQ(publisher.get_nb_retired(), 0UL);
+}
@@ -0,0 +1,184 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+
+#include <netflex/netflex>
+
+static netflex::routing::middleware_pipeline
+make_pipeline(std::size_t size) {
+  std::list<netflex::routing::middleware_t> middlewares(size, [](netflex::routing::middleware_chain&, netflex::http::request&, netflex::http::response&) {});
+
+  return netflex::routing::middleware_pipeline(middlewares);
+}
+
+TEST(route_table, empty) {
+  netflex::routing::route_table table;
+
+  EXPECT_EQ(table.size(), 0UL);
+  EXPECT_EQ(table.resolve("/"), nullptr);
+}
+
+TEST(route_table, normalize_prefix) {
+  EXPECT_EQ(netflex::routing::route_table::normalize_prefix(""), "");
+  EXPECT_EQ(netflex::routing::route_table::normalize_prefix("/"), "");
+  EXPECT_EQ(netflex::routing::route_table::normalize_prefix("/api"), "/api");
+  EXPECT_EQ(netflex::routing::route_table::normalize_prefix("/api//"), "/api");
+}
+
+TEST(route_table, root_matches_all) {
+  netflex::routing::route_table table;
+  table.add("/", make_pipeline(1));
+
+  ASSERT_NE(table.resolve("/"), nullptr);
+  ASSERT_NE(table.resolve("/api/users"), nullptr);
+  EXPECT_EQ(table.resolve("/api/users")->size(), 1UL);
+}
+
+TEST(route_table, longest_prefix_wins) {
+  netflex::routing::route_table table;
+  table.add("", make_pipeline(1));
+  table.add("/api", make_pipeline(2));
+  table.add("/api/v2/", make_pipeline(3));
+
+  EXPECT_EQ(table.size(), 3UL);
+  EXPECT_EQ(table.resolve("/")->size(), 1UL);
+  EXPECT_EQ(table.resolve("/api")->size(), 2UL);
+  EXPECT_EQ(table.resolve("/api/users")->size(), 2UL);
+  EXPECT_EQ(table.resolve("/api/v2")->size(), 3UL);
+  EXPECT_EQ(table.resolve("/api/v2/users?id=1")->size(), 3UL);
+}
+
+TEST(route_table, prefix_stops_on_segment_boundary) {
+  netflex::routing::route_table table;
+  table.add("", make_pipeline(1));
+  table.add("/api", make_pipeline(2));
+
+  EXPECT_EQ(table.resolve("/apis")->size(), 1UL);
+  EXPECT_EQ(table.resolve("/api?x=1")->size(), 2UL);
+  EXPECT_EQ(table.resolve("/api#top")->size(), 2UL);
+}
+
+TEST(route_table, no_match) {
+  netflex::routing::route_table table;
+  table.add("/api", make_pipeline(1));
+
+  EXPECT_EQ(table.resolve("/static/index.html"), nullptr);
+}
+
+TEST(route_table, first_added_wins_on_same_prefix) {
+  netflex::routing::route_table table;
+  table.add("/api", make_pipeline(1));
+  table.add("/api/", make_pipeline(2));
+
+  EXPECT_EQ(table.resolve("/api/users")->size(), 1UL);
+}
+
+//!
+//! virtual hosts
+//!
+static netflex::routing::route_table
+make_host_table(std::size_t size) {
+  netflex::routing::route_table table;
+  table.add("", make_pipeline(size));
+
+  return table;
+}
+
+TEST(route_table, normalize_host) {
+  EXPECT_EQ(netflex::routing::route_table::normalize_host("Example.COM"), "example.com");
+  EXPECT_EQ(netflex::routing::route_table::normalize_host("example.com:8080"), "example.com");
+  EXPECT_EQ(netflex::routing::route_table::normalize_host("example.com."), "example.com");
+  EXPECT_EQ(netflex::routing::route_table::normalize_host("[::1]:8080"), "[::1]");
+  EXPECT_EQ(netflex::routing::route_table::normalize_host("[::1]"), "[::1]");
+  EXPECT_EQ(netflex::routing::route_table::normalize_host(""), "");
+}
+
+TEST(route_table, no_host) {
+  netflex::routing::route_table table = make_host_table(1);
+
+  EXPECT_EQ(table.get_nb_hosts(), 0UL);
+  EXPECT_EQ(&table.resolve_host("example.com"), &table);
+}
+
+TEST(route_table, exact_host) {
+  netflex::routing::route_table table = make_host_table(1);
+  table.add_host("api.example.com", make_host_table(2));
+
+  EXPECT_EQ(table.get_nb_hosts(), 1UL);
+  EXPECT_EQ(table.resolve_host("api.example.com").resolve("/")->size(), 2UL);
+  EXPECT_EQ(table.resolve_host("API.Example.com:3000").resolve("/")->size(), 2UL);
+  EXPECT_EQ(table.resolve_host("www.example.com").resolve("/")->size(), 1UL);
+  EXPECT_EQ(table.resolve_host("").resolve("/")->size(), 1UL);
+}
+
+TEST(route_table, wildcard_host) {
+  netflex::routing::route_table table = make_host_table(1);
+  table.add_host("*.example.com", make_host_table(2));
+  table.add_host("*.eu.example.com", make_host_table(3));
+  table.add_host("admin.eu.example.com", make_host_table(4));
+
+  EXPECT_EQ(table.resolve_host("a.example.com").resolve("/")->size(), 2UL);
+  EXPECT_EQ(table.resolve_host("a.b.example.com").resolve("/")->size(), 2UL);
+  EXPECT_EQ(table.resolve_host("a.eu.example.com").resolve("/")->size(), 3UL);
+  EXPECT_EQ(table.resolve_host("admin.eu.example.com").resolve("/")->size(), 4UL);
+
+  //! wildcard does not match the domain itself
+  EXPECT_EQ(table.resolve_host("example.com").resolve("/")->size(), 1UL);
+  EXPECT_EQ(table.resolve_host("example.org").resolve("/")->size(), 1UL);
+}
+
+TEST(route_table, first_added_host_wins) {
+  netflex::routing::route_table table = make_host_table(1);
+  table.add_host("example.com", make_host_table(2));
+  table.add_host("EXAMPLE.com", make_host_table(3));
+
+  EXPECT_EQ(table.get_nb_hosts(), 1UL);
+  EXPECT_EQ(table.resolve_host("example.com").resolve("/")->size(), 2UL);
+}
+
+TEST(route_table, copies_share_hosts) {
+  netflex::routing::route_table table = make_host_table(1);
+  table.add_host("example.com", make_host_table(2));
+
+  netflex::routing::route_table copy = table;
+  EXPECT_EQ(&copy.resolve_host("example.com"), &table.resolve_host("example.com"));
+}
+
+TEST(route_table, static_responses) {
+  netflex::routing::route_table table;
+  EXPECT_EQ(table.resolve_static_response(netflex::http::method::GET, "/health"), nullptr);
+
+  auto health = std::make_shared<const netflex::http::static_response>(netflex::http::response());
+  auto ping   = std::make_shared<const netflex::http::static_response>(netflex::http::response());
+  table.add_static_response(netflex::http::method::GET, "/health", health);
+  table.add_static_response(netflex::http::method::POST, "/ping", ping);
+
+  EXPECT_EQ(table.resolve_static_response(netflex::http::method::GET, "/health"), health.get());
+  EXPECT_EQ(table.resolve_static_response(netflex::http::method::GET, "/health?verbose=1"), health.get());
+  EXPECT_EQ(table.resolve_static_response(netflex::http::method::HEAD, "/health"), health.get());
+  EXPECT_EQ(table.resolve_static_response(netflex::http::method::POST, "/health"), nullptr);
+  EXPECT_EQ(table.resolve_static_response(netflex::http::method::GET, "/health/"), nullptr);
+  EXPECT_EQ(table.resolve_static_response(netflex::http::method::POST, "/ping"), ping.get());
+  EXPECT_EQ(table.resolve_static_response(netflex::http::method::HEAD, "/ping"), nullptr);
+}
@@ -0,0 +1,72 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+
+#include <netflex/netflex>
+
+static void
+noop_callback(const netflex::http::request&, netflex::http::response&) {}
+
+TEST(router, empty) {
+  netflex::routing::router router;
+
+  EXPECT_TRUE(router.get_routes().empty());
+  EXPECT_TRUE(router.get_middlewares().empty());
+}
+
+TEST(router, add_routes) {
+  netflex::routing::router router;
+
+  router.add_route({netflex::http::method::GET, "/users", noop_callback})
+    .add_routes({{netflex::http::method::POST, "/users", noop_callback}, {netflex::http::method::GET, "/users/:id", noop_callback}});
+
+  ASSERT_EQ(router.get_routes().size(), 3UL);
+  EXPECT_EQ(router.get_routes()[0].get_method(), netflex::http::method::GET);
+  EXPECT_EQ(router.get_routes()[0].get_path(), "/users");
+  EXPECT_EQ(router.get_routes()[1].get_method(), netflex::http::method::POST);
+  EXPECT_EQ(router.get_routes()[2].get_path(), "/users/:id");
+}
+
+TEST(router, add_middlewares) {
+  netflex::routing::router router;
+  std::string calls;
+
+  auto make_middleware = [&calls](char c) -> netflex::routing::middleware_t {
+    return [&calls, c](netflex::routing::middleware_chain&, netflex::http::request&, netflex::http::response&) { calls += c; };
+  };
+
+  router.add_middleware(make_middleware('a')).add_middlewares({make_middleware('b'), make_middleware('c')});
+
+  ASSERT_EQ(router.get_middlewares().size(), 3UL);
+
+  netflex::routing::middleware_pipeline pipeline(router.get_middlewares());
+  netflex::http::request request;
+  netflex::http::response response;
+  netflex::routing::middleware_chain chain(pipeline, request, response);
+
+  for (std::size_t i = 0; i < pipeline.size(); ++i)
+    pipeline[i](chain, request, response);
+
+  EXPECT_EQ(calls, "abc");
+}
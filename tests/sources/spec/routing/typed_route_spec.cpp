@@ -0,0 +1,157 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include <netflex/netflex>
+
+TEST(typed_route, dispatch_typed_params) {
+  std::uint64_t user_id = 0;
+  std::int64_t offset   = 0;
+  std::string tag;
+
+  netflex::routing::route route = netflex::routing::make_route<std::uint64_t, std::int64_t, netflex::misc::string_view>(
+    netflex::http::method::GET, "/users/:id<u64>/posts/:offset<i64>/:tag",
+    [&](const netflex::http::request&, netflex::http::response&, std::uint64_t id, std::int64_t off, netflex::misc::string_view t) {
+      user_id = id;
+      offset  = off;
+      tag     = t.to_string();
+    });
+
+  netflex::http::request request;
+  netflex::http::response response;
+  request.set_method(netflex::http::method::GET);
+  request.set_target("/users/42/posts/-3/news?sort=desc");
+
+  ASSERT_TRUE(route.match(request));
+  EXPECT_EQ(request.get_path(), "/users/:id<u64>/posts/:offset<i64>/:tag");
+  EXPECT_TRUE(request.get_params().empty());
+  EXPECT_EQ(request.get_path_params().size(), 3UL);
+
+  route.dispatch(request, response);
+  EXPECT_EQ(user_id, 42UL);
+  EXPECT_EQ(offset, -3);
+  EXPECT_EQ(tag, "news");
+}
+
+TEST(typed_route, dispatch_string_param) {
+  std::string name;
+
+  netflex::routing::route route = netflex::routing::make_route<std::string>(
+    netflex::http::method::GET, "/users/:name",
+    [&](const netflex::http::request&, netflex::http::response&, std::string n) { name = n; });
+
+  netflex::http::request request;
+  netflex::http::response response;
+  request.set_method(netflex::http::method::GET);
+  request.set_target("/users/simon");
+
+  ASSERT_TRUE(route.match(request));
+  route.dispatch(request, response);
+  EXPECT_EQ(name, "simon");
+}
+
+TEST(typed_route, copied_request) {
+  netflex::routing::route route = netflex::routing::make_route<std::uint64_t, netflex::misc::string_view>(
+    netflex::http::method::GET, "/u/:id<u64>/:tag",
+    [](const netflex::http::request&, netflex::http::response&, std::uint64_t, netflex::misc::string_view) {});
+
+  //! small target: stored within the request, not shared by copies nor moves
+  std::unique_ptr<netflex::http::request> request(new netflex::http::request);
+  request->set_method(netflex::http::method::GET);
+  request->set_target("/u/7/news");
+  ASSERT_TRUE(route.match(*request));
+
+  netflex::http::request copy(*request);
+  netflex::http::request assigned;
+  assigned = *request;
+  netflex::http::request moved(std::move(*request));
+  request.reset();
+
+  for (const netflex::http::request* r : {&copy, &assigned, &moved}) {
+    ASSERT_EQ(r->get_path_params().size(), 2UL);
+    EXPECT_EQ(r->get_path_params()[0].u64, 7UL);
+    EXPECT_EQ(r->get_path_params()[1].str, "news");
+    EXPECT_EQ(r->get_path_params()[1].str.data(), r->get_target().data() + 5);
+  }
+}
+
+TEST(typed_route, no_param) {
+  bool called = false;
+
+  netflex::routing::route route = netflex::routing::make_route<>(
+    netflex::http::method::GET, "/health",
+    [&](const netflex::http::request&, netflex::http::response&) { called = true; });
+
+  netflex::http::request request;
+  netflex::http::response response;
+  request.set_method(netflex::http::method::GET);
+  request.set_target("/health");
+
+  ASSERT_TRUE(route.match(request));
+  route.dispatch(request, response);
+  EXPECT_TRUE(called);
+}
+
+TEST(typed_route, unmatch) {
+  netflex::routing::route route = netflex::routing::make_route<std::uint64_t>(
+    netflex::http::method::GET, "/users/:id<u64>",
+    [](const netflex::http::request&, netflex::http::response&, std::uint64_t) {});
+
+  netflex::http::request request;
+  request.set_target("/users/simon");
+  request.set_method(netflex::http::method::GET);
+  EXPECT_FALSE(route.match(request));
+
+  request.set_target("/users/42");
+  request.set_method(netflex::http::method::POST);
+  EXPECT_FALSE(route.match(request));
+}
+
+TEST(typed_route, mismatching_handler) {
+  auto handler = [](const netflex::http::request&, netflex::http::response&, std::int64_t) {};
+
+  EXPECT_THROW(netflex::routing::make_route<std::int64_t>(netflex::http::method::GET, "/users/:id<u64>", handler), netflex::netflex_error);
+  EXPECT_THROW(netflex::routing::make_route<std::int64_t>(netflex::http::method::GET, "/users", handler), netflex::netflex_error);
+}
+
+TEST(typed_route, with_path) {
+  std::uint64_t user_id = 0;
+
+  netflex::routing::route route = netflex::routing::make_route<std::uint64_t>(
+    netflex::http::method::GET, "/users/:id<u64>",
+    [&](const netflex::http::request&, netflex::http::response&, std::uint64_t id) { user_id = id; });
+
+  netflex::routing::route mounted = route.with_path("/api/users/:id<u64>");
+
+  netflex::http::request request;
+  netflex::http::response response;
+  request.set_method(netflex::http::method::GET);
+  request.set_target("/api/users/7");
+
+  EXPECT_FALSE(route.match(request));
+  ASSERT_TRUE(mounted.match(request));
+  mounted.dispatch(request, response);
+  EXPECT_EQ(user_id, 7UL);
+}
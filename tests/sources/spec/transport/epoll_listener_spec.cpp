@@ -0,0 +1,355 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifdef __linux__
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <netflex/netflex>
+
+//!
+//! blocking socket connected to the listener, with the given receive buffer size if not 0
+//!
+static int
+connect_to(std::uint32_t port, int receive_buffer_size = 0) {
+  int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+
+  if (receive_buffer_size)
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &receive_buffer_size, sizeof(receive_buffer_size));
+
+  struct sockaddr_in address = {};
+  address.sin_family         = AF_INET;
+  address.sin_port           = htons(port);
+  ::inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+
+  EXPECT_EQ(::connect(fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)), 0);
+
+  return fd;
+}
+
+static std::string
+receive_exactly(int fd, std::size_t size) {
+  std::string data;
+  char buffer[4096];
+
+  while (data.size() < size) {
+    ssize_t nb_bytes = ::recv(fd, buffer, sizeof(buffer), 0);
+    if (nb_bytes <= 0)
+      break;
+
+    data.append(buffer, nb_bytes);
+  }
+
+  return data;
+}
+
+static bool
+wait_for(const std::function<bool(void)>& condition) {
+  for (int i = 0; i < 500 && !condition(); ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  return condition();
+}
+
+//!
+//! write back everything read
+//!
+static void
+echo(const std::shared_ptr<netflex::transport::connection>& connection) {
+  connection->async_read(4096, [connection](netflex::transport::read_result& result) {
+    if (!result.success)
+      return;
+
+    connection->async_write(std::vector<char>(result.data, result.data + result.size), nullptr);
+    echo(connection);
+  });
+}
+
+TEST(epoll_listener, start_stop) {
+  netflex::transport::epoll_listener listener(2);
+  EXPECT_FALSE(listener.is_running());
+  EXPECT_EQ(listener.get_nb_threads(), 2UL);
+
+  listener.start("127.0.0.1", 0, [](const std::shared_ptr<netflex::transport::connection>&) {});
+  EXPECT_TRUE(listener.is_running());
+  EXPECT_NE(listener.get_port(), 0U);
+  EXPECT_THROW(listener.start("127.0.0.1", 0, nullptr), netflex::netflex_error);
+
+  listener.stop();
+  EXPECT_FALSE(listener.is_running());
+}
+
+TEST(epoll_listener, echo) {
+  netflex::transport::epoll_listener listener(2);
+  listener.start("127.0.0.1", 0, echo);
+
+  int fd = connect_to(listener.get_port());
+
+  for (const std::string& message : std::vector<std::string>{"hello", "world", std::string(100000, 'x')}) {
+    ASSERT_EQ(::send(fd, message.data(), message.size(), 0), static_cast<ssize_t>(message.size()));
+    EXPECT_EQ(receive_exactly(fd, message.size()), message);
+  }
+
+  EXPECT_EQ(listener.get_nb_connections(), 1UL);
+
+  ::close(fd);
+  listener.stop();
+}
+
+TEST(epoll_listener, peer_disconnection) {
+  std::atomic<int> nb_disconnections(0);
+  std::atomic<bool> read_failed(false);
+
+  netflex::transport::epoll_listener listener(1);
+  listener.start("127.0.0.1", 0, [&](const std::shared_ptr<netflex::transport::connection>& connection) {
+    connection->set_disconnection_handler([&] { ++nb_disconnections; });
+    connection->async_read(4096, [&](netflex::transport::read_result& result) { read_failed = !result.success; });
+  });
+
+  int fd = connect_to(listener.get_port());
+  ASSERT_TRUE(wait_for([&] { return listener.get_nb_connections() == 1; }));
+
+  //! pending read failed, then disconnection notified
+  ::close(fd);
+  EXPECT_TRUE(wait_for([&] { return nb_disconnections == 1; }));
+  EXPECT_TRUE(read_failed);
+  EXPECT_TRUE(wait_for([&] { return listener.get_nb_connections() == 0; }));
+
+  listener.stop();
+}
+
+TEST(epoll_listener, large_write) {
+  std::string payload(4 * 1024 * 1024, 'x');
+  std::atomic<std::size_t> written(0);
+
+  netflex::transport::epoll_listener listener(1);
+  listener.start("127.0.0.1", 0, [&](const std::shared_ptr<netflex::transport::connection>& connection) {
+    connection->async_write(std::vector<char>(payload.begin(), payload.end()), [&](netflex::transport::write_result& result) {
+      written = result.success ? result.size : 0;
+    });
+  });
+
+  //! written over several EPOLLOUT notifications, as the client reads
+  int fd = connect_to(listener.get_port());
+  EXPECT_EQ(receive_exactly(fd, payload.size()), payload);
+  EXPECT_TRUE(wait_for([&] { return written == payload.size(); }));
+
+  ::close(fd);
+  listener.stop();
+}
+
+TEST(epoll_listener, zerocopy_write) {
+  auto body = std::make_shared<const std::string>(4 * 1024 * 1024, 'x');
+  std::atomic<int> nb_written(0);
+
+  netflex::transport::epoll_listener listener(1);
+  listener.start("127.0.0.1", 0, [&](const std::shared_ptr<netflex::transport::connection>& connection) {
+    for (const std::string& head : std::vector<std::string>{"first:", "second:"}) {
+      connection->async_write_zerocopy(std::vector<char>(head.begin(), head.end()), body, [&, head](netflex::transport::write_result& result) {
+        if (result.success && result.size == head.size() + body->size())
+          ++nb_written;
+      });
+    }
+  });
+
+  //! heads and bodies in order (loopback copies the pages: the second body is sent with a regular copy)
+  int fd = connect_to(listener.get_port());
+  EXPECT_TRUE(receive_exactly(fd, 13 + 2 * body->size()) == "first:" + *body + "second:" + *body);
+  EXPECT_TRUE(wait_for([&] { return nb_written == 2; }));
+
+  //! bodies released once the kernel is done with them
+  EXPECT_TRUE(wait_for([&] { return body.use_count() == 1; }));
+
+  ::close(fd);
+  listener.stop();
+}
+
+TEST(epoll_listener, zerocopy_write_disconnection) {
+  auto body = std::make_shared<const std::string>(16 * 1024 * 1024, 'x');
+  std::shared_ptr<netflex::transport::connection> server_connection;
+  std::mutex mutex;
+
+  netflex::transport::epoll_listener listener(1);
+  listener.start("127.0.0.1", 0, [&](const std::shared_ptr<netflex::transport::connection>& connection) {
+    connection->async_write_zerocopy({'h', 'e', 'a', 'd', ':'}, body, [](netflex::transport::write_result&) {});
+
+    std::lock_guard<std::mutex> lock(mutex);
+    server_connection = connection;
+  });
+
+  //! small receive window: most of the first zero copy send stays queued on the server side
+  int fd = connect_to(listener.get_port(), 256 * 1024);
+  ASSERT_TRUE(wait_for([&] {
+    std::lock_guard<std::mutex> lock(mutex);
+    return server_connection != nullptr;
+  }));
+
+  //! closed while the socket buffers are full, the client not reading yet
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    server_connection->disconnect();
+    server_connection.reset();
+  }
+
+  //! the data queued before the close is delivered intact, then the end of file
+  std::string received;
+  char buffer[65536];
+  ssize_t nb_bytes;
+  while ((nb_bytes = ::recv(fd, buffer, sizeof(buffer), 0)) > 0)
+    received.append(buffer, nb_bytes);
+
+  EXPECT_EQ(nb_bytes, 0);
+  ASSERT_GT(received.size(), 5UL);
+  EXPECT_EQ(received.compare(0, 5, "head:"), 0);
+  EXPECT_EQ(received.find_first_not_of('x', 5), std::string::npos);
+
+  //! body released once the kernel is done with it, and the socket closed
+  EXPECT_TRUE(wait_for([&] { return body.use_count() == 1; }));
+
+  ::close(fd);
+  listener.stop();
+}
+
+TEST(epoll_listener, explicit_disconnection) {
+  std::atomic<int> nb_disconnections(0);
+
+  netflex::transport::epoll_listener listener(1);
+  listener.start("127.0.0.1", 0, [&](const std::shared_ptr<netflex::transport::connection>& connection) {
+    connection->set_disconnection_handler([&] { ++nb_disconnections; });
+    connection->disconnect();
+    EXPECT_FALSE(connection->is_connected());
+  });
+
+  //! peer sees the connection closed, handler not called
+  int fd = connect_to(listener.get_port());
+  char c;
+  EXPECT_EQ(::recv(fd, &c, 1, 0), 0);
+  EXPECT_EQ(nb_disconnections, 0);
+
+  ::close(fd);
+  listener.stop();
+}
+
+TEST(epoll_listener, http_server) {
+  auto listener = std::make_shared<netflex::transport::epoll_listener>(2);
+  netflex::http::server server(listener);
+
+  server.add_route({netflex::http::method::GET, "/hello", [](const netflex::http::request&, netflex::http::response& response) {
+                      response.set_body("world");
+                      response.add_header({"Content-Length", "5"});
+                    }});
+  server.start("127.0.0.1", 0);
+
+  int fd = connect_to(listener->get_port());
+
+  //! keep-alive: both requests on the same connection
+  for (int i = 0; i < 2; ++i) {
+    std::string request = "GET /hello HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    ASSERT_EQ(::send(fd, request.data(), request.size(), 0), static_cast<ssize_t>(request.size()));
+
+    std::string response;
+    char buffer[4096];
+    while (response.find("world") == std::string::npos) {
+      ssize_t nb_bytes = ::recv(fd, buffer, sizeof(buffer), 0);
+      ASSERT_GT(nb_bytes, 0);
+      response.append(buffer, nb_bytes);
+    }
+
+    EXPECT_EQ(response.find("HTTP/1.1 200 OK\r\n"), 0UL);
+  }
+
+  EXPECT_EQ(server.get_nb_connections(), 1UL);
+
+  ::close(fd);
+  EXPECT_TRUE(wait_for([&] { return server.get_nb_connections() == 0; }));
+
+  server.stop();
+}
+
+TEST(epoll_listener, http_server_rate_limit_key_header) {
+  auto listener = std::make_shared<netflex::transport::epoll_listener>(1);
+  netflex::http::server server(listener);
+
+  server.add_route({netflex::http::method::GET, "/hello", [](const netflex::http::request&, netflex::http::response& response) {
+                      response.set_body("world");
+                      response.add_header({"Content-Length", "5"});
+                    }});
+  server.set_rate_limit(1, 2, "X-Api-Key");
+  server.start("127.0.0.1", 0);
+
+  int fd = connect_to(listener->get_port());
+
+  //! a new key on each request: the address of the client is limited anyway
+  std::vector<std::string> statuses;
+  for (int i = 0; i < 3; ++i) {
+    std::string request = "GET /hello HTTP/1.1\r\nHost: localhost\r\nX-Api-Key: key" + std::to_string(i) + "\r\n\r\n";
+    ASSERT_EQ(::send(fd, request.data(), request.size(), 0), static_cast<ssize_t>(request.size()));
+
+    std::string response;
+    char buffer[4096];
+    while (response.find("\r\n\r\n") == std::string::npos || (response.find(" 200 ") != std::string::npos && response.find("world") == std::string::npos)) {
+      ssize_t nb_bytes = ::recv(fd, buffer, sizeof(buffer), 0);
+      ASSERT_GT(nb_bytes, 0);
+      response.append(buffer, nb_bytes);
+    }
+
+    statuses.push_back(response.substr(9, 3));
+  }
+
+  EXPECT_EQ(statuses, std::vector<std::string>({"200", "200", "429"}));
+
+  ::close(fd);
+  server.stop();
+}
+
+TEST(epoll_listener, http_server_settings) {
+  auto listener = std::make_shared<netflex::transport::epoll_listener>(1);
+  netflex::http::server server(listener);
+
+  server.set_request_limits(netflex::parsing::request_limits());
+  server.set_zerocopy_threshold(64 * 1024);
+  server.start("127.0.0.1", 0);
+
+  //! read by the connections of the running server
+  EXPECT_THROW(server.set_request_limits(netflex::parsing::request_limits()), netflex::netflex_error);
+  EXPECT_THROW(server.set_zerocopy_threshold(0), netflex::netflex_error);
+  EXPECT_EQ(server.get_zerocopy_threshold(), 64UL * 1024);
+
+  server.stop();
+}
+
+#endif /* __linux__ */
@@ -0,0 +1,268 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifdef __linux__
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <netflex/netflex>
+
+//!
+//! blocking socket connected to the listener
+//!
+static int
+connect_to(std::uint32_t port) {
+  int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+
+  struct sockaddr_in address = {};
+  address.sin_family         = AF_INET;
+  address.sin_port           = htons(port);
+  ::inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+
+  EXPECT_EQ(::connect(fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)), 0);
+
+  return fd;
+}
+
+static std::string
+receive_exactly(int fd, std::size_t size) {
+  std::string data;
+  char buffer[4096];
+
+  while (data.size() < size) {
+    ssize_t nb_bytes = ::recv(fd, buffer, sizeof(buffer), 0);
+    if (nb_bytes <= 0)
+      break;
+
+    data.append(buffer, nb_bytes);
+  }
+
+  return data;
+}
+
+static bool
+wait_for(const std::function<bool(void)>& condition) {
+  for (int i = 0; i < 500 && !condition(); ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  return condition();
+}
+
+//!
+//! write back everything read
+//!
+static void
+echo(const std::shared_ptr<netflex::transport::connection>& connection, std::size_t read_size) {
+  connection->async_read(read_size, [connection, read_size](netflex::transport::read_result& result) {
+    if (!result.success)
+      return;
+
+    connection->async_write(std::vector<char>(result.data, result.data + result.size), nullptr);
+    echo(connection, read_size);
+  });
+}
+
+TEST(io_uring_listener, start_stop) {
+  netflex::transport::io_uring_listener listener(2);
+  EXPECT_FALSE(listener.is_running());
+  EXPECT_EQ(listener.get_nb_threads(), 2UL);
+
+  listener.start("127.0.0.1", 0, [](const std::shared_ptr<netflex::transport::connection>&) {});
+  EXPECT_TRUE(listener.is_running());
+  EXPECT_EQ(listener.is_using_io_uring(), netflex::transport::io_uring_loop::is_supported());
+  EXPECT_NE(listener.get_port(), 0U);
+  EXPECT_THROW(listener.start("127.0.0.1", 0, nullptr), netflex::netflex_error);
+
+  listener.stop();
+  EXPECT_FALSE(listener.is_running());
+  EXPECT_FALSE(listener.is_using_io_uring());
+}
+
+TEST(io_uring_listener, echo) {
+  netflex::transport::io_uring_listener listener(2);
+  listener.start("127.0.0.1", 0, [](const std::shared_ptr<netflex::transport::connection>& connection) { echo(connection, 4096); });
+
+  int fd = connect_to(listener.get_port());
+
+  for (const std::string& message : std::vector<std::string>{"hello", "world", std::string(100000, 'x')}) {
+    ASSERT_EQ(::send(fd, message.data(), message.size(), 0), static_cast<ssize_t>(message.size()));
+    EXPECT_EQ(receive_exactly(fd, message.size()), message);
+  }
+
+  EXPECT_EQ(listener.get_nb_connections(), 1UL);
+
+  ::close(fd);
+  listener.stop();
+}
+
+TEST(io_uring_listener, partial_reads) {
+  netflex::transport::io_uring_listener listener(1);
+  listener.start("127.0.0.1", 0, [](const std::shared_ptr<netflex::transport::connection>& connection) { echo(connection, 7); });
+
+  //! received chunks handed over several reads smaller than them
+  int fd = connect_to(listener.get_port());
+  std::string message(10000, 'x');
+  for (std::size_t i = 0; i < message.size(); ++i)
+    message[i] = static_cast<char>('a' + i % 26);
+
+  ASSERT_EQ(::send(fd, message.data(), message.size(), 0), static_cast<ssize_t>(message.size()));
+  EXPECT_EQ(receive_exactly(fd, message.size()), message);
+
+  ::close(fd);
+  listener.stop();
+}
+
+TEST(io_uring_listener, buffers_exhausted) {
+  //! few small buffers: receives run out of buffers and are armed again as buffers are recycled
+  netflex::transport::io_uring_listener listener(1, 4, 256);
+  listener.start("127.0.0.1", 0, [](const std::shared_ptr<netflex::transport::connection>& connection) { echo(connection, 4096); });
+
+  std::vector<int> fds;
+  for (int i = 0; i < 4; ++i)
+    fds.push_back(connect_to(listener.get_port()));
+
+  std::string message(64 * 1024, 'y');
+  for (int fd : fds)
+    ASSERT_EQ(::send(fd, message.data(), message.size(), 0), static_cast<ssize_t>(message.size()));
+
+  for (int fd : fds) {
+    EXPECT_EQ(receive_exactly(fd, message.size()), message);
+    ::close(fd);
+  }
+
+  EXPECT_TRUE(wait_for([&] { return listener.get_nb_connections() == 0; }));
+  listener.stop();
+}
+
+TEST(io_uring_listener, peer_disconnection) {
+  std::atomic<int> nb_disconnections(0);
+  std::atomic<bool> read_failed(false);
+
+  netflex::transport::io_uring_listener listener(1);
+  listener.start("127.0.0.1", 0, [&](const std::shared_ptr<netflex::transport::connection>& connection) {
+    connection->set_disconnection_handler([&] { ++nb_disconnections; });
+    connection->async_read(4096, [&](netflex::transport::read_result& result) { read_failed = !result.success; });
+  });
+
+  int fd = connect_to(listener.get_port());
+  ASSERT_TRUE(wait_for([&] { return listener.get_nb_connections() == 1; }));
+
+  //! pending read failed, then disconnection notified
+  ::close(fd);
+  EXPECT_TRUE(wait_for([&] { return nb_disconnections == 1; }));
+  EXPECT_TRUE(read_failed);
+  EXPECT_TRUE(wait_for([&] { return listener.get_nb_connections() == 0; }));
+
+  listener.stop();
+}
+
+TEST(io_uring_listener, large_write) {
+  std::string payload(4 * 1024 * 1024, 'x');
+  std::atomic<std::size_t> written(0);
+
+  netflex::transport::io_uring_listener listener(1);
+  listener.start("127.0.0.1", 0, [&](const std::shared_ptr<netflex::transport::connection>& connection) {
+    connection->async_write(std::vector<char>(payload.begin(), payload.end()), [&](netflex::transport::write_result& result) {
+      written = result.success ? result.size : 0;
+    });
+  });
+
+  //! sent as the client reads
+  int fd = connect_to(listener.get_port());
+  EXPECT_EQ(receive_exactly(fd, payload.size()), payload);
+  EXPECT_TRUE(wait_for([&] { return written == payload.size(); }));
+
+  ::close(fd);
+  listener.stop();
+}
+
+TEST(io_uring_listener, explicit_disconnection) {
+  std::atomic<int> nb_disconnections(0);
+
+  netflex::transport::io_uring_listener listener(1);
+  listener.start("127.0.0.1", 0, [&](const std::shared_ptr<netflex::transport::connection>& connection) {
+    connection->set_disconnection_handler([&] { ++nb_disconnections; });
+    connection->disconnect();
+    EXPECT_FALSE(connection->is_connected());
+  });
+
+  //! peer sees the connection closed, handler not called
+  int fd = connect_to(listener.get_port());
+  char c;
+  EXPECT_EQ(::recv(fd, &c, 1, 0), 0);
+  EXPECT_EQ(nb_disconnections, 0);
+
+  ::close(fd);
+  listener.stop();
+}
+
+TEST(io_uring_listener, http_server) {
+  auto listener = std::make_shared<netflex::transport::io_uring_listener>(2);
+  netflex::http::server server(listener);
+
+  server.add_route({netflex::http::method::GET, "/hello", [](const netflex::http::request&, netflex::http::response& response) {
+                      response.set_body("world");
+                      response.add_header({"Content-Length", "5"});
+                    }});
+  server.start("127.0.0.1", 0);
+
+  int fd = connect_to(listener->get_port());
+
+  //! keep-alive: both requests on the same connection
+  for (int i = 0; i < 2; ++i) {
+    std::string request = "GET /hello HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    ASSERT_EQ(::send(fd, request.data(), request.size(), 0), static_cast<ssize_t>(request.size()));
+
+    std::string response;
+    char buffer[4096];
+    while (response.find("world") == std::string::npos) {
+      ssize_t nb_bytes = ::recv(fd, buffer, sizeof(buffer), 0);
+      ASSERT_GT(nb_bytes, 0);
+      response.append(buffer, nb_bytes);
+    }
+
+    EXPECT_EQ(response.find("HTTP/1.1 200 OK\r\n"), 0UL);
+  }
+
+  EXPECT_EQ(server.get_nb_connections(), 1UL);
+
+  ::close(fd);
+  EXPECT_TRUE(wait_for([&] { return server.get_nb_connections() == 0; }));
+
+  server.stop();
+}
+
+#endif /* __linux__ */
@@ -0,0 +1,292 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2015-2017 Simon Ninon <simon.ninon@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#if defined(__linux__) && defined(__NETFLEX_TLS_ENABLED)
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <openssl/pem.h>
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+
+#include <gtest/gtest.h>
+
+#include <netflex/netflex>
+
+//!
+//! self-signed certificate for localhost, generated once, as PEM files
+//!
+static const std::pair<std::string, std::string>&
+get_certificate_files(void) {
+  static std::pair<std::string, std::string> files;
+
+  if (!files.first.empty())
+    return files;
+
+  files.first  = "/tmp/netflex_tls_context_spec_" + std::to_string(::getpid()) + ".crt";
+  files.second = "/tmp/netflex_tls_context_spec_" + std::to_string(::getpid()) + ".key";
+
+  EVP_PKEY* key             = nullptr;
+  EVP_PKEY_CTX* key_context  = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+  EVP_PKEY_keygen_init(key_context);
+  EVP_PKEY_CTX_set_ec_paramgen_curve_nid(key_context, NID_X9_62_prime256v1);
+  EVP_PKEY_keygen(key_context, &key);
+  EVP_PKEY_CTX_free(key_context);
+
+  X509* certificate = X509_new();
+  ASN1_INTEGER_set(X509_get_serialNumber(certificate), 1);
+  X509_gmtime_adj(X509_getm_notBefore(certificate), 0);
+  X509_gmtime_adj(X509_getm_notAfter(certificate), 3600);
+  X509_set_pubkey(certificate, key);
+
+  X509_NAME* name = X509_get_subject_name(certificate);
+  X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+  X509_set_issuer_name(certificate, name);
+  X509_sign(certificate, key, EVP_sha256());
+
+  FILE* file = std::fopen(files.first.c_str(), "w");
+  PEM_write_X509(file, certificate);
+  std::fclose(file);
+
+  file = std::fopen(files.second.c_str(), "w");
+  PEM_write_PrivateKey(file, key, nullptr, nullptr, 0, nullptr, nullptr);
+  std::fclose(file);
+
+  X509_free(certificate);
+  EVP_PKEY_free(key);
+
+  return files;
+}
+
+//!
+//! client context trusting the self-signed certificate
+//!
+static SSL_CTX*
+create_client_context(const std::string& alpn_protocols) {
+  SSL_CTX* context = SSL_CTX_new(TLS_client_method());
+  SSL_CTX_load_verify_locations(context, get_certificate_files().first.c_str(), nullptr);
+  SSL_CTX_set_verify(context, SSL_VERIFY_PEER, nullptr);
+  SSL_CTX_set_alpn_protos(context, reinterpret_cast<const unsigned char*>(alpn_protocols.data()), alpn_protocols.size());
+
+  return context;
+}
+
+//!
+//! TLS connection to the listener, nullptr if the handshake failed
+//!
+static SSL*
+tls_connect(SSL_CTX* context, std::uint32_t port, SSL_SESSION* session = nullptr) {
+  int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+
+  struct sockaddr_in address = {};
+  address.sin_family         = AF_INET;
+  address.sin_port           = htons(port);
+  ::inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+
+  EXPECT_EQ(::connect(fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)), 0);
+
+  SSL* ssl = SSL_new(context);
+  SSL_set_fd(ssl, fd);
+  SSL_set_tlsext_host_name(ssl, "localhost");
+
+  if (session)
+    SSL_set_session(ssl, session);
+
+  if (SSL_connect(ssl) != 1) {
+    SSL_free(ssl);
+    ::close(fd);
+    return nullptr;
+  }
+
+  return ssl;
+}
+
+//!
+//! close_notify sent, so that the session stays resumable
+//!
+static void
+tls_close(SSL* ssl) {
+  int fd = SSL_get_fd(ssl);
+  SSL_shutdown(ssl);
+  SSL_free(ssl);
+  ::close(fd);
+}
+
+//!
+//! send a GET request and read the response until its body ends with the given suffix
+//!
+static std::string
+tls_get(SSL* ssl, const std::string& path, const std::string& body_end) {
+  std::string request = "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+  EXPECT_EQ(SSL_write(ssl, request.data(), request.size()), static_cast<int>(request.size()));
+
+  std::string response;
+  char buffer[16384];
+
+  while (response.size() < body_end.size() || response.compare(response.size() - body_end.size(), body_end.size(), body_end)) {
+    int nb_bytes = SSL_read(ssl, buffer, sizeof(buffer));
+    if (nb_bytes <= 0)
+      break;
+
+    response.append(buffer, nb_bytes);
+  }
+
+  return response;
+}
+
+//!
+//! TLS server on an epoll listener, serving /hello and a large /export
+//!
+struct tls_server {
+  tls_server(void)
+  : listener(std::make_shared<netflex::transport::epoll_listener>(2))
+  , server(listener) {
+    listener->set_tls_context(std::make_shared<netflex::transport::tls_context>(get_certificate_files().first, get_certificate_files().second));
+
+    server.add_route({netflex::http::method::GET, "/hello", [](const netflex::http::request&, netflex::http::response& response) {
+                        response.set_body("world");
+                        response.add_header({"Content-Length", "5"});
+                      }});
+    server.add_route({netflex::http::method::GET, "/export", [](const netflex::http::request&, netflex::http::response& response) {
+                        response.set_body(std::string(4 * 1024 * 1024, 'x') + "end");
+                        response.add_header({"Content-Length", std::to_string(4 * 1024 * 1024 + 3)});
+                      }});
+
+    //! zero copy is not used on TLS connections: bodies are copied
+    server.set_zerocopy_threshold(64 * 1024);
+    server.start("127.0.0.1", 0);
+  }
+
+  ~tls_server(void) {
+    server.stop();
+  }
+
+  std::shared_ptr<netflex::transport::epoll_listener> listener;
+  netflex::http::server server;
+};
+
+TEST(tls_context, invalid_files) {
+  EXPECT_THROW(netflex::transport::tls_context("/nonexistent.crt", "/nonexistent.key"), netflex::netflex_error);
+  EXPECT_THROW(netflex::transport::tls_context(get_certificate_files().second, get_certificate_files().second), netflex::netflex_error);
+}
+
+TEST(tls_context, configuration) {
+  netflex::transport::tls_context context(get_certificate_files().first, get_certificate_files().second);
+  EXPECT_EQ(context.get_alpn_protocols(), std::vector<std::string>{"http/1.1"});
+  EXPECT_NE(context.get_native_handle(), nullptr);
+
+  context.set_session_cache_size(128);
+  EXPECT_EQ(context.get_session_cache_size(), 128UL);
+
+  EXPECT_THROW(context.set_alpn_protocols({""}), netflex::netflex_error);
+}
+
+TEST(tls_context, https_request) {
+  tls_server server;
+  SSL_CTX* context = create_client_context(std::string("\x02h2\x08http/1.1", 12));
+
+  SSL* ssl = tls_connect(context, server.listener->get_port());
+  ASSERT_NE(ssl, nullptr);
+
+  //! http/1.1 selected among the offered protocols
+  const unsigned char* protocol = nullptr;
+  unsigned int protocol_size    = 0;
+  SSL_get0_alpn_selected(ssl, &protocol, &protocol_size);
+  EXPECT_EQ(std::string(reinterpret_cast<const char*>(protocol), protocol_size), "http/1.1");
+
+  //! keep-alive: both requests on the same connection
+  for (int i = 0; i < 2; ++i)
+    EXPECT_EQ(tls_get(ssl, "/hello", "world").find("HTTP/1.1 200 OK\r\n"), 0UL);
+
+  tls_close(ssl);
+  SSL_CTX_free(context);
+}
+
+TEST(tls_context, large_response) {
+  tls_server server;
+  SSL_CTX* context = create_client_context(std::string("\x08http/1.1", 9));
+
+  SSL* ssl = tls_connect(context, server.listener->get_port());
+  ASSERT_NE(ssl, nullptr);
+
+  std::string response = tls_get(ssl, "/export", "end");
+  std::size_t head_end = response.find("\r\n\r\n");
+  ASSERT_NE(head_end, std::string::npos);
+  EXPECT_EQ(response.size() - head_end - 4, 4UL * 1024 * 1024 + 3);
+
+  tls_close(ssl);
+  SSL_CTX_free(context);
+}
+
+TEST(tls_context, alpn_mismatch) {
+  tls_server server;
+  SSL_CTX* context = create_client_context(std::string("\x02h2", 3));
+
+  //! no_application_protocol alert
+  EXPECT_EQ(tls_connect(context, server.listener->get_port()), nullptr);
+
+  SSL_CTX_free(context);
+}
+
+TEST(tls_context, session_resumption) {
+  tls_server server;
+
+  //! session tickets (TLS 1.3), then session cache (TLS 1.2 without tickets)
+  for (int version : {TLS1_3_VERSION, TLS1_2_VERSION}) {
+    SSL_CTX* context = create_client_context(std::string("\x08http/1.1", 9));
+    SSL_CTX_set_max_proto_version(context, version);
+
+    if (version == TLS1_2_VERSION)
+      SSL_CTX_set_options(context, SSL_OP_NO_TICKET);
+
+    //! tickets are received after the handshake, along with the response
+    SSL* ssl = tls_connect(context, server.listener->get_port());
+    ASSERT_NE(ssl, nullptr);
+    EXPECT_EQ(SSL_session_reused(ssl), 0);
+    tls_get(ssl, "/hello", "world");
+
+    SSL_SESSION* session = SSL_get1_session(ssl);
+    tls_close(ssl);
+
+    //! resumed on a new connection, possibly handled by another loop
+    for (int i = 0; i < 4; ++i) {
+      ssl = tls_connect(context, server.listener->get_port(), session);
+      ASSERT_NE(ssl, nullptr);
+      EXPECT_EQ(SSL_session_reused(ssl), 1);
+      EXPECT_EQ(tls_get(ssl, "/hello", "world").find("HTTP/1.1 200 OK\r\n"), 0UL);
+      tls_close(ssl);
+    }
+
+    SSL_SESSION_free(session);
+    SSL_CTX_free(context);
+  }
+}
+
+#endif /* __linux__ && __NETFLEX_TLS_ENABLED */